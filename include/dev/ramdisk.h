@@ -30,11 +30,31 @@
 	/**
 	 * @brief RAM Disk Size
 	 */
+	#if (NANVIX_VFS_RDISK)
+	#define NANVIX_RAMDISK_SIZE (64*1024)
+	#else
 	#define NANVIX_RAMDISK_SIZE NANVIX_DISK_SIZE
+	#endif
 
 	/**
 	 * @brief Number of RAM Disks
 	 */
-	#define NANVIX_NR_RAMDISKS 1
+	#define NANVIX_NR_RAMDISKS 3
+
+#if (NANVIX_VFS_IMAGE)
+
+	/**
+	 * @brief Image of the First RAM Disk
+	 *
+	 * @details Generated offline by the mkfs tool.
+	 */
+	extern const unsigned char nanvix_ramdisk_image[];
+
+	/**
+	 * @brief Size of the Image of the First RAM Disk (in bytes)
+	 */
+	extern const unsigned long nanvix_ramdisk_image_size;
+
+#endif
 
 #endif /* RAMDISK_H_ */
@@ -0,0 +1,52 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef RDISK_H_
+#define RDISK_H_
+
+	#include <nanvix/config.h>
+
+	/**
+	 * @brief Number of Remote Disks
+	 */
+	#define NANVIX_NR_RDISKS 3
+
+	/**
+	 * @brief Number of Pages in the Cache of Remote Disks
+	 */
+	#define NANVIX_RDISK_CACHE_LENGTH 16
+
+	/**
+	 * @brief Remote Disk Size
+	 *
+	 * @details Remote disks that only serve regression tests are
+	 * large enough to overflow the cache.
+	 */
+	#if (NANVIX_VFS_RDISK)
+	#define NANVIX_RDISK_SIZE NANVIX_DISK_SIZE
+	#else
+	#define NANVIX_RDISK_SIZE (1024*1024)
+	#endif
+
+#endif /* RDISK_H_ */
@@ -45,20 +45,111 @@
 	 */
 	#define NANVIX_ROOT_GID 0
 
+	/**
+	 * @brief Number of Entries in the Name Lookup Cache
+	 */
+	#define NANVIX_NAME_CACHE_LENGTH 16
+
+	/**
+	 * @brief Lifetime of a Cached Name (in cycles)
+	 */
+	#define NANVIX_NAME_CACHE_TTL CLUSTER_FREQ
+
+	/**
+	 * @brief Lifetime of a Cached Missing Name (in cycles)
+	 */
+	#define NANVIX_NAME_CACHE_NEGATIVE_TTL (CLUSTER_FREQ/1000)
+
+	/**
+	 * @brief Lifetime of a Liveness Check (in cycles)
+	 */
+	#define NANVIX_NAME_ALIVE_TTL (CLUSTER_FREQ/100)
+
+	/**
+	 * @brief Time Without Heartbeats Before a Name Expires (in cycles)
+	 */
+	#define NANVIX_NAME_HEARTBEAT_TIMEOUT CLUSTER_FREQ
+
+	/**
+	 * @brief Interval Between Sweeps of Expired Names (in cycles)
+	 */
+	#define NANVIX_NAME_SWEEP_INTERVAL (CLUSTER_FREQ/100)
+
+	/**
+	 * @brief Resolve Names of Servers in a Single Batch at Setup?
+	 */
+	#define NANVIX_NAME_SETUP_BATCHED 1
+
 /*============================================================================*
  * Virtual File System                                                        *
  *============================================================================*/
 
 	/**
-	 * @brief Size of the RAM Disk
+	 * @brief Store the root device in remote memory?
+	 */
+	#define NANVIX_VFS_RDISK 0
+
+	/**
+	 * @brief Does the VFS server talk to remote memory?
+	 *
+	 * @details Regression tests exercise the remote disk driver even
+	 * if the root device is not stored in remote memory.
+	 */
+	#if (NANVIX_VFS_RDISK) || !defined(__SUPPRESS_TESTS)
+	#define NANVIX_VFS_RMEM 1
+	#else
+	#define NANVIX_VFS_RMEM 0
+	#endif
+
+	/**
+	 * @brief Preload the root device with a prepared image?
 	 */
+	#define NANVIX_VFS_IMAGE 0
+
+	/**
+	 * @brief Size of the Root Device
+	 */
+	#if (NANVIX_VFS_RDISK)
+	#define NANVIX_DISK_SIZE (16*1024*1024)
+	#else
 	#define NANVIX_DISK_SIZE (64*1024)
+	#endif
 
 	/**
 	 * @brief Root Device
 	 */
 	#define NANVIX_ROOT_DEV 0
 
+	/**
+	 * @brief Scratch Device (used by regression tests)
+	 */
+	#define NANVIX_SCRATCH_DEV 1
+
+	/**
+	 * @brief Journal Device
+	 */
+	#define NANVIX_JOURNAL_DEV 2
+
+	/**
+	 * @brief Size of the Journal (in bytes)
+	 */
+	#define NANVIX_JOURNAL_SIZE (16*1024)
+
+	/**
+	 * @brief Maximum Number of Records in the Journal
+	 */
+	#define NANVIX_JOURNAL_NR_RECORDS 64
+
+	/**
+	 * @brief Number of Worker Threads in the VFS Server
+	 */
+	#define NANVIX_VFS_NR_WORKERS 2
+
+	/**
+	 * @brief Number of Pending Requests in the VFS Server
+	 */
+	#define NANVIX_VFS_QUEUE_LENGTH 8
+
 	/**
 	 * @brief Number of File System Buffers
 	 */
@@ -69,6 +160,54 @@
 	 */
 	#define NANVIX_NR_INODES 64
 
+	/**
+	 * @brief Number of In-Memory Inodes
+	 */
+	#define NANVIX_INODE_CACHE_LENGTH 32
+
+	/**
+	 * @brief Number of Directory Cache Entries
+	 */
+	#define NANVIX_DCACHE_LENGTH 64
+
+	/**
+	 * @brief Number of Blocks Preallocated for Files
+	 */
+	#define NANVIX_MINIX_PREALLOC_LENGTH 4
+
+	/**
+	 * @brief Number of Pages in the File Data Cache of Clients
+	 */
+	#define NANVIX_VFS_CACHE_NR_PAGES 8
+
+	/**
+	 * @brief Maximum Number of Files Opened by a Client in a VFS Server
+	 *
+	 * @details Servers hand out up to NANVIX_OPEN_MAX file descriptors
+	 * to each process, but clients keep state for fewer of them.
+	 */
+	#define NANVIX_VFS_OPEN_MAX 64
+
+	/**
+	 * @brief Maximum Number of I/O Vectors in a Vectored I/O Operation
+	 */
+	#define NANVIX_VFS_IOV_MAX 16
+
+	/**
+	 * @brief Duration of File Data Leases (in cycles)
+	 */
+	#define NANVIX_VFS_LEASE_TIME (CLUSTER_FREQ/10)
+
+	/**
+	 * @brief Maximum Time to Wait for Holders of Recalled Leases (in cycles)
+	 */
+	#define NANVIX_VFS_RECALL_TIMEOUT (CLUSTER_FREQ/10)
+
+	/**
+	 * @brief Maximum Number of Opened Files Tracked for Lease Recalls
+	 */
+	#define NANVIX_VFS_LEASES_MAX 64
+
 /*============================================================================*
  * Memory Management System                                                   *
  *============================================================================*/
@@ -77,7 +216,6 @@
 	 * @name Name of Servers
 	 */
 	/**@{*/
-	#define VFS_SERVER_NAME  "/vfs"  /**< Virtual File System  */
 	#define SYSV_SERVER_NAME "/sysv" /**< System V Server      */
 	/**@}*/
 
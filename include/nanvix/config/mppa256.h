@@ -57,7 +57,7 @@
 	 * @name Map of Servers
 	 */
 	/**@{*/
-	#define NAME_SERVER_NODE   0 /**< Name Server */
+	#define NAME_SERVER_0_NODE 0 /**< Name Server */
 	#define SYSV_SERVER_NODE   0 /**< RMem Server */
 	#define RMEM_SERVER_0_NODE 4 /**< RMem Server */
 	/**@}*/
@@ -66,7 +66,7 @@
 	 * @name Map of Port Numbers
 	 */
 	/**@{*/
-	#define NAME_SERVER_PORT_NUM   2 /**< Name Server   */
+	#define NAME_SERVER_0_PORT_NUM 2 /**< Name Server 0 */
 	#define RMEM_SERVER_0_PORT_NUM 2 /**< RMem Server 0 */
 	#define SYSV_SERVER_PORT_NUM   3 /**< SYSV Server   */
 	/**@}*/
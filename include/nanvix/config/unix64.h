@@ -36,14 +36,20 @@
 	#define __NANVIX_HAS_SYSV_SERVER  /**< SYSV Server  */
 	/**@}*/
 
+	/**
+	 * @brief Channels to servers of the same node go through shared
+	 * rings rather than through mailboxes and portals.
+	 */
+	#define __NANVIX_HAS_CHANNEL_RINGS
+
 	/**
 	 * @name Number of Servers
 	 */
 	/**@{*/
 	#define SPAWNERS_NUM      4 /**< Spawn Servers */
-	#define NAME_SERVERS_NUM  1 /**< Name Servers  */
+	#define NAME_SERVERS_NUM  4 /**< Name Servers  */
 	#define RMEM_SERVERS_NUM  2 /**< RMem Servers  */
-	#define VFS_SERVERS_NUM   1 /**< VFS Servers   */
+	#define VFS_SERVERS_NUM   2 /**< VFS Servers   */
 	#define SYSV_SERVERS_NUM  1 /**< SYSV Servers  */
 	/**@}*/
 
@@ -61,10 +67,14 @@
 	 * @name Map of Servers
 	 */
 	/**@{*/
-	#define NAME_SERVER_NODE    0 /**< Name Server */
+	#define NAME_SERVER_0_NODE  0 /**< Name Server */
+	#define NAME_SERVER_1_NODE  1 /**< Name Server */
+	#define NAME_SERVER_2_NODE  2 /**< Name Server */
+	#define NAME_SERVER_3_NODE  3 /**< Name Server */
 	#define RMEM_SERVER_0_NODE  1 /**< RMem Server */
 	#define RMEM_SERVER_1_NODE  2 /**< RMem Server */
-	#define VFS_SERVER_NODE     0 /**< VFS Server  */
+	#define VFS_SERVER_0_NODE   0 /**< VFS Server  */
+	#define VFS_SERVER_1_NODE   2 /**< VFS Server  */
 	#define SYSV_SERVER_NODE    3 /**< SYSV Server */
 	/**@}*/
 
@@ -72,11 +82,15 @@
 	 * @name Map of Port Numbers
 	 */
 	/**@{*/
-	#define NAME_SERVER_PORT_NUM   2 /**< Name Server   */
-	#define RMEM_SERVER_0_PORT_NUM 2 /**< RMem Server 0 */
-	#define RMEM_SERVER_1_PORT_NUM 2 /**< RMem Server 1 */
-	#define VFS_SERVER_PORT_NUM    3 /**< VFS Server    */
-	#define SYSV_SERVER_PORT_NUM   2 /**< SYSV Server   */
+	#define NAME_SERVER_0_PORT_NUM 2 /**< Name Server 0 */
+	#define NAME_SERVER_1_PORT_NUM 2 /**< Name Server 1 */
+	#define NAME_SERVER_2_PORT_NUM 2 /**< Name Server 2 */
+	#define NAME_SERVER_3_PORT_NUM 2 /**< Name Server 3 */
+	#define RMEM_SERVER_0_PORT_NUM 3 /**< RMem Server 0 */
+	#define RMEM_SERVER_1_PORT_NUM 3 /**< RMem Server 1 */
+	#define VFS_SERVER_0_PORT_NUM  3 /**< VFS Server 0  */
+	#define VFS_SERVER_1_PORT_NUM  4 /**< VFS Server 1  */
+	#define SYSV_SERVER_PORT_NUM   3 /**< SYSV Server   */
 	/**@}*/
 
 	/**
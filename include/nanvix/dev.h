@@ -25,6 +25,7 @@
 #ifndef NANVIX_DEV_H_
 #define NANVIX_DEV_H_
 
+	#include <nanvix/config.h>
 	#include <posix/sys/types.h>
 
 	/**
@@ -42,6 +43,94 @@
 	 */
 	#define bdev_close(x) (0)
 
+#if (NANVIX_VFS_RDISK)
+
+	/**
+	 * @brief Wrapper to rdisk_init().
+	 */
+	#define bdev_init() rdisk_init()
+
+	/**
+	 * @brief Wrapper to rdisk_shutdown().
+	 */
+	#define bdev_shutdown() rdisk_shutdown()
+
+	/**
+	 * @brief Wrapper to rdisk_flush().
+	 */
+	#define bdev_flush(dev) rdisk_flush(dev)
+
+	/**
+	 * @brief Wrapper to rdisk_discard().
+	 */
+	#define bdev_discard(dev, off, size) rdisk_discard(dev, off, size)
+
+	/**
+	 * @brief Wrapper to rdisk_read().
+	 */
+	#define bdev_readblk(x)               \
+		rdisk_read(                       \
+			(x)->dev,                     \
+			(x)->data,                    \
+			NANVIX_FS_BLOCK_SIZE,         \
+			(x)->num*NANVIX_FS_BLOCK_SIZE \
+		)
+
+	/**
+	 * @brief Wrapper to rdisk_write().
+	 */
+	#define bdev_writeblk(x)              \
+		rdisk_write(                      \
+			(x)->dev,                     \
+			(x)->data,                    \
+			NANVIX_FS_BLOCK_SIZE,         \
+			(x)->num*NANVIX_FS_BLOCK_SIZE \
+		)
+
+	/**
+	 * @brief Wrapper to rdisk_read().
+	 */
+	#define bdev_read(dev, buf, size, off) \
+		rdisk_read(                        \
+			dev,                           \
+			buf,                           \
+			size,                          \
+			off                            \
+		)
+
+	/**
+	 * @brief Wrapper to rdisk_write().
+	 */
+	#define bdev_write(dev, buf, size, off) \
+		rdisk_write(                        \
+			dev,                            \
+			buf,                            \
+			size,                           \
+			off                             \
+		)
+
+#else
+
+	/**
+	 * @brief Wrapper to ramdisk_init().
+	 */
+	#define bdev_init() ramdisk_init()
+
+	/**
+	 * @brief Dummy function.
+	 */
+	#define bdev_shutdown() ((void) 0)
+
+	/**
+	 * @brief Dummy function.
+	 */
+	#define bdev_flush(dev) (0)
+
+	/**
+	 * @brief Wrapper to ramdisk_discard().
+	 */
+	#define bdev_discard(dev, off, size) ramdisk_discard(dev, off, size)
+
 	/**
 	 * @brief Wrapper to ramdisk_read().
 	 */
@@ -86,6 +175,8 @@
 			off                             \
 		)
 
+#endif
+
 /*============================================================================*
  * RAM Disk Driver                                                            *
  *============================================================================*/
@@ -118,9 +209,85 @@
 	 */
 	extern ssize_t ramdisk_read(unsigned minor, char *buf, size_t n, off_t off);
 
+	/**
+	 * @brief Discards data of a RAM disk.
+	 *
+	 * @param minor Target RAM Disk.
+	 * @param off   Discard offset.
+	 * @param n     Number of bytes to discard.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int ramdisk_discard(unsigned minor, off_t off, size_t n);
+
 	/**
 	 * @brief Initializes the RAM Disk devices.
 	 */
 	extern void ramdisk_init(void);
 
+/*============================================================================*
+ * Remote Disk Driver                                                         *
+ *============================================================================*/
+
+	/**
+	 * @brief Writes data to a remote disk.
+	 *
+	 * @param minor Target remote disk.
+	 * @param buf   Target buffer from where data should be read.
+	 * @param n     Number of bytes to write.
+	 * @param off   Write offset.
+	 *
+	 * @returns Upon successful completion, the number of bytes
+	 * effectively written is returned. Upon failure, a negative error
+	 * code is returned instead.
+	 */
+	extern ssize_t rdisk_write(unsigned minor, const char *buf, size_t n, off_t off);
+
+	/**
+	 * @brief Reads data from a remote disk.
+	 *
+	 * @param minor Target remote disk.
+	 * @param buf   Target buffer to where data should be written.
+	 * @param n     Number of bytes to read.
+	 * @param off   Read offset.
+	 *
+	 * @returns Upon successful completion, the number of bytes
+	 * effectively read is returned. Upon failure, a negative error
+	 * code is returned instead.
+	 */
+	extern ssize_t rdisk_read(unsigned minor, char *buf, size_t n, off_t off);
+
+	/**
+	 * @brief Discards data of a remote disk.
+	 *
+	 * @param minor Target remote disk.
+	 * @param off   Discard offset.
+	 * @param n     Number of bytes to discard.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int rdisk_discard(unsigned minor, off_t off, size_t n);
+
+	/**
+	 * @brief Writes cached data of a remote disk back.
+	 *
+	 * @param minor Target remote disk.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int rdisk_flush(unsigned minor);
+
+	/**
+	 * @brief Initializes the remote disk devices.
+	 */
+	extern void rdisk_init(void);
+
+	/**
+	 * @brief Shutdowns the remote disk devices.
+	 */
+	extern void rdisk_shutdown(void);
+
 #endif /* NANVIX_DEV_H_ */
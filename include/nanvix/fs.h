@@ -66,6 +66,6 @@
 	 * otherwise.
 	 */
 	#define NANVIX_VFS_FD_IS_VALID(x) \
-		(WITHIN(fd, 0, NANVIX_OPEN_MAX))
+		(WITHIN((x), 0, NANVIX_OPEN_MAX))
 
 #endif /* NANVIX_FS_H_ */
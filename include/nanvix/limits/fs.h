@@ -37,7 +37,7 @@
 	/**
 	 * @brief Maximum of Opened Files for a Process
 	 */
-	#define NANVIX_OPEN_MAX 16
+	#define NANVIX_OPEN_MAX 512
 
 	/**
 	 * @brief Maximum Name for a File
@@ -55,6 +55,7 @@
 	/**@{*/
 	#define NANVIX_MAILBOX_MESSAGE_SIZE KMAILBOX_MESSAGE_SIZE /**< Maximum size for a mailbox message.             */
 	#define NANVIX_MAILBOX_MAX          KMAILBOX_MAX          /**< Maximum number of mailboxes that can be opened. */
+	#define NANVIX_MAILBOX_BATCH_MAX    32                    /**< Maximum number of messages in a batch.          */
 	/**@}*/
 
 	/**
@@ -62,6 +63,17 @@
 	 */
 	/**@{*/
 	#define NANVIX_PORTAL_MAX KPORTAL_MAX /**< Maximum number of portals that can be opened. */
+	/**@}*/
+
+	/**
+	 * @name Limits on Channels
+	 */
+	/**@{*/
+	#define NANVIX_CHANNEL_MAX                   8 /**< Maximum number of channels that can be connected. */
+	#define NANVIX_CHANNEL_PEERS_MAX             8 /**< Maximum number of clients a server keeps open.   */
+	#define NANVIX_CHANNEL_RING_LENGTH           4 /**< Number of slots in the ring of a channel.        */
+	#define NANVIX_CHANNEL_RING_SLOT_SIZE (4*1024) /**< Size of a slot in the ring of a channel.         */
+	/**@}*/
 
 	/**
 	 * @brief Maximum number of active connections in a server.
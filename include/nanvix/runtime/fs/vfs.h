@@ -25,7 +25,29 @@
 #ifndef NANVIX_RUNTIME_FS_VFS_H_
 #define NANVIX_RUNTIME_FS_VFS_H_
 
+	#include <nanvix/servers/vfs/types.h>
 	#include <posix/sys/types.h>
+	#include <posix/stdint.h>
+
+	/**
+	 * @brief I/O Vector
+	 */
+	struct nanvix_iovec
+	{
+		void *iov_base; /**< Base address of buffer. */
+		size_t iov_len; /**< Length of buffer.       */
+	};
+
+	/**
+	 * @brief Statistics of the File Data Cache
+	 */
+	struct vfs_cache_stats
+	{
+		uint64_t nhits;    /**< Reads served by cached pages.  */
+		uint64_t nmisses;  /**< Reads that filled a page.      */
+		uint64_t nflushes; /**< Dirty pages written back.      */
+		uint64_t nrecalls; /**< Leases recalled by servers.    */
+	};
 
 	/**
 	 * @brief Initializes the VFS Service.
@@ -112,4 +134,162 @@
 	 */
 	extern ssize_t nanvix_vfs_write(int fd, const void *buf, size_t n);
 
+	/**
+	 * @brief Reads data from a file at a given offset.
+	 *
+	 * @param fd  Target file descriptor.
+	 * @param buf Target buffer.
+	 * @param n   Number of bytes to read.
+	 * @param off Offset to read from.
+	 *
+	 * @returns Upon successful completion, the number of bytes
+	 * successfully read is returned. Upon failure, a negative error
+	 * code is returned instead.
+	 */
+	extern ssize_t nanvix_vfs_pread(int fd, void *buf, size_t n, off_t off);
+
+	/**
+	 * @brief Writes data to a file at a given offset.
+	 *
+	 * @param fd  Target file descriptor.
+	 * @param buf Target buffer.
+	 * @param n   Number of bytes to write.
+	 * @param off Offset to write to.
+	 *
+	 * @returns Upon successful completion, the number of bytes
+	 * successfully written is returned. Upon failure, a negative error
+	 * code is returned instead.
+	 */
+	extern ssize_t nanvix_vfs_pwrite(int fd, const void *buf, size_t n, off_t off);
+
+	/**
+	 * @brief Reads data from a file into multiple buffers.
+	 *
+	 * @param fd     Target file descriptor.
+	 * @param iov    Target I/O vectors.
+	 * @param iovcnt Number of I/O vectors.
+	 *
+	 * @returns Upon successful completion, the number of bytes
+	 * successfully read is returned. If a transfer fails after some
+	 * data was read, that number of bytes is returned. Otherwise,
+	 * upon failure, a negative error code is returned instead.
+	 */
+	extern ssize_t nanvix_vfs_readv(int fd, const struct nanvix_iovec *iov, int iovcnt);
+
+	/**
+	 * @brief Writes data from multiple buffers to a file.
+	 *
+	 * @param fd     Target file descriptor.
+	 * @param iov    Source I/O vectors.
+	 * @param iovcnt Number of I/O vectors.
+	 *
+	 * @returns Upon successful completion, the number of bytes
+	 * successfully written is returned. If a transfer fails after some
+	 * data was written, that number of bytes is returned. Otherwise,
+	 * upon failure, a negative error code is returned instead.
+	 */
+	extern ssize_t nanvix_vfs_writev(int fd, const struct nanvix_iovec *iov, int iovcnt);
+
+	/**
+	 * @brief Copies data between files.
+	 *
+	 * @param fd_in   Source file descriptor.
+	 * @param off_in  Source offset (negative to use the file pointer).
+	 * @param fd_out  Target file descriptor.
+	 * @param off_out Target offset (negative to use the file pointer).
+	 * @param n       Number of bytes to copy.
+	 *
+	 * @returns Upon successful completion, the number of bytes
+	 * successfully copied is returned. Upon failure, a negative error
+	 * code is returned instead.
+	 */
+	extern ssize_t nanvix_vfs_copy_range(
+		int fd_in,
+		off_t off_in,
+		int fd_out,
+		off_t off_out,
+		size_t n
+	);
+
+	/**
+	 * @brief Opens several files at once.
+	 *
+	 * @param filenames Names of the target files.
+	 * @param oflag     Open flags.
+	 * @param fds       Location to store the file descriptors.
+	 * @param n         Number of files.
+	 *
+	 * @returns Upon successful completion, zero is returned, and the
+	 * outcome of each open is stored in @p fds. Upon failure, a negative
+	 * error code is returned instead.
+	 */
+	extern int nanvix_vfs_open_multi(
+		const char **filenames,
+		int oflag,
+		int *fds,
+		int n
+	);
+
+	/**
+	 * @brief Gets the attributes of several files at once.
+	 *
+	 * @param filenames Names of the target files.
+	 * @param buf       Location to store the attributes.
+	 * @param status    Location to store the outcome of each lookup.
+	 * @param n         Number of files.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_vfs_stat_multi(
+		const char **filenames,
+		struct vfs_stat *buf,
+		int *status,
+		int n
+	);
+
+	/**
+	 * @brief Gets the attributes of a file.
+	 *
+	 * @param filename Name of the target file.
+	 * @param buf      Location to store the attributes.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_vfs_stat(const char *filename, struct vfs_stat *buf);
+
+	/**
+	 * @brief Reads entries of a directory.
+	 *
+	 * @param fd   Target file descriptor.
+	 * @param dirp Location to store the entries.
+	 * @param n    Maximum number of entries to read.
+	 *
+	 * @returns Upon successful completion, the number of entries read
+	 * is returned. Zero is returned at the end of the directory. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_vfs_getdents(int fd, struct vfs_dirent *dirp, int n);
+
+	/**
+	 * @brief Writes back deferred writes on a file.
+	 *
+	 * @param fd Target file descriptor.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_vfs_fsync(int fd);
+
+	/**
+	 * @brief Gets the statistics of the file data cache.
+	 *
+	 * @param buf Store location for the statistics.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_vfs_stats(struct vfs_cache_stats *buf);
+
 #endif /* NANVIX_RUNTIME_FS_VFS_H_ */
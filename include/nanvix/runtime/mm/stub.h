@@ -44,6 +44,18 @@
 	 */
 	extern rpage_t nanvix_rmem_alloc(void);
 
+	/**
+	 * @brief Allocates many remote memory blocks at once.
+	 *
+	 * @param blknums Store location for the numbers of the blocks.
+	 * @param n       Number of blocks.
+	 *
+	 * @returns Upon successful completion, the number of blocks that
+	 * were allocated is returned. Upon failure, a negative error code is
+	 * returned instead.
+	 */
+	extern int nanvix_rmem_alloc_multi(rpage_t *blknums, int n);
+
 	/**
 	 * @brief Frees a remote memory block.
 	 *
@@ -0,0 +1,254 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NANVIX_RUNTIME_CHANNEL_H_
+#define NANVIX_RUNTIME_CHANNEL_H_
+
+	#ifndef __NEED_CHANNEL_SERVICE
+	#error "do not include this file"
+	#endif
+
+	#include <nanvix/servers/message.h>
+	#include <posix/sys/types.h>
+
+	/**
+	 * @name Client Side
+	 *
+	 * A channel ties a client to a server. The request mailbox and the
+	 * data portal of a channel are opened once, when the channel is
+	 * connected, and replies come back through the standard input
+	 * mailbox and portal of the client. On platforms that feature
+	 * channel rings, data exchanged with servers of the same node is
+	 * copied in a shared ring instead of going through portals.
+	 */
+	/**@{*/
+
+	/**
+	 * @brief Connects a channel to a server.
+	 *
+	 * @param name Name of the server.
+	 * @param port Port number of the server.
+	 *
+	 * @returns Upon successful completion, the ID of the new channel is
+	 * returned. Upon failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_channel_connect(const char *name, int port);
+
+	/**
+	 * @brief Disconnects a channel.
+	 *
+	 * @param chid ID of the target channel.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_channel_disconnect(int chid);
+
+	/**
+	 * @brief Gets the port number of the data portal of a channel.
+	 *
+	 * @param chid ID of the target channel.
+	 *
+	 * @returns Upon successful completion, the port number of the data
+	 * portal of the target channel is returned. Upon failure, a
+	 * negative error code is returned instead.
+	 */
+	extern int nanvix_channel_get_port(int chid);
+
+	/**
+	 * @brief Enables or disables the ring of a channel.
+	 *
+	 * @param chid   ID of the target channel.
+	 * @param enable Enable the ring?
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 *
+	 * @note Only channels to servers of the same node have rings.
+	 */
+	extern int nanvix_channel_set_ring(int chid, int enable);
+
+	/**
+	 * @brief Sends a request through a channel.
+	 *
+	 * @param chid ID of the target channel.
+	 * @param msg  Target request.
+	 * @param size Size of the request.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_channel_send(int chid, const void *msg, size_t size);
+
+	/**
+	 * @brief Sends a batch of requests through a channel.
+	 *
+	 * @param chid  ID of the target channel.
+	 * @param msgs  Target requests.
+	 * @param size  Size of each request.
+	 * @param count Number of requests.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_channel_send_batch(
+		int chid,
+		const void *msgs,
+		size_t size,
+		int count
+	);
+
+	/**
+	 * @brief Receives a reply from a channel.
+	 *
+	 * @param chid ID of the target channel.
+	 * @param msg  Store location for the reply.
+	 * @param size Size of the reply.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_channel_recv(int chid, void *msg, size_t size);
+
+	/**
+	 * @brief Sends a request and receives its reply.
+	 *
+	 * @param chid ID of the target channel.
+	 * @param msg  Target request and store location for the reply.
+	 * @param size Size of the request and the reply.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_channel_call(int chid, void *msg, size_t size);
+
+	/**
+	 * @brief Writes data to the server of a channel.
+	 *
+	 * @param chid ID of the target channel.
+	 * @param buf  Location from where data should be read.
+	 * @param n    Number of bytes to write.
+	 *
+	 * @returns Upon successful completion, the number of bytes written
+	 * is returned. Upon failure, a negative error code is returned
+	 * instead.
+	 */
+	extern ssize_t nanvix_channel_write(int chid, const void *buf, size_t n);
+
+	/**
+	 * @brief Reads data from the server of a channel.
+	 *
+	 * @param chid ID of the target channel.
+	 * @param buf  Location where data should be written.
+	 * @param n    Number of bytes to read.
+	 * @param port Port number of the portal of the server.
+	 *
+	 * @returns Upon successful completion, the number of bytes read is
+	 * returned. Upon failure, a negative error code is returned
+	 * instead.
+	 */
+	extern ssize_t nanvix_channel_read(int chid, void *buf, size_t n, int port);
+
+	/**@}*/
+
+	/**
+	 * @name Server Side
+	 *
+	 * Servers keep the connectors to their clients opened across
+	 * requests, so that they are opened once rather than once per
+	 * reply.
+	 */
+	/**@{*/
+
+	/**
+	 * @brief Sends a reply to a client.
+	 *
+	 * @param to   Header of the request being replied.
+	 * @param msg  Target reply.
+	 * @param size Size of the reply.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 *
+	 * @note This function is @b NOT thread safe.
+	 */
+	extern int nanvix_channel_reply(
+		const message_header *to,
+		const void *msg,
+		size_t size
+	);
+
+	/**
+	 * @brief Sends an acknowledge and then data to a client.
+	 *
+	 * @param to   Header of the request being replied.
+	 * @param ack  Target acknowledge.
+	 * @param size Size of the acknowledge.
+	 * @param buf  Location from where data should be read.
+	 * @param n    Number of bytes to write.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 *
+	 * @note The portal port in the header of @p ack is overwritten.
+	 *
+	 * @note This function is @b NOT thread safe.
+	 */
+	extern int nanvix_channel_reply_data(
+		const message_header *to,
+		void *ack,
+		size_t size,
+		const void *buf,
+		size_t n
+	);
+
+	/**
+	 * @brief Receives data from a client.
+	 *
+	 * @param from     Header of the request being served.
+	 * @param inportal Input portal of the server.
+	 * @param buf      Location where data should be written.
+	 * @param n        Number of bytes to read.
+	 *
+	 * @returns Upon successful completion, the number of bytes read is
+	 * returned. Upon failure, a negative error code is returned
+	 * instead.
+	 */
+	extern ssize_t nanvix_channel_accept(
+		const message_header *from,
+		int inportal,
+		void *buf,
+		size_t n
+	);
+
+	/**
+	 * @brief Closes the connectors to all clients.
+	 *
+	 * @note This function is @b NOT thread safe.
+	 */
+	extern void nanvix_channel_flush(void);
+
+	/**@}*/
+
+#endif /* NANVIX_RUNTIME_CHANNEL_H_ */
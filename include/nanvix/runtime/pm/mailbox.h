@@ -124,6 +124,47 @@
 	 */
 	extern int nanvix_mailbox_write(int mbxid, const void *buf, size_t n);
 
+	/**
+	 * @brief Writes a batch of messages to a mailbox.
+	 *
+	 * @param mbxid    ID of the target mailbox.
+	 * @param portalid ID of the portal to spill messages to (-1 if none).
+	 * @param buf      Location from where messages should be read.
+	 * @param size     Size of each message.
+	 * @param count    Number of messages.
+	 *
+	 * @returns Upon successful completion zero is returned. Upon failure, a
+	 * negative error code is returned instead.
+	 */
+	extern int nanvix_mailbox_write_batch(
+		int mbxid,
+		int portalid,
+		const void *buf,
+		size_t size,
+		int count
+	);
+
+	/**
+	 * @brief Reads a batch of messages.
+	 *
+	 * @param inbox    Underlying input mailbox.
+	 * @param inportal Underlying input portal.
+	 * @param buf      Location where messages should be written.
+	 * @param size     Size of each message.
+	 * @param max      Maximum number of messages to read.
+	 *
+	 * @returns Upon successful completion, the number of messages read
+	 * is returned. If a malformed batch is dropped, zero is returned.
+	 * Upon failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_mailbox_read_batch(
+		int inbox,
+		int inportal,
+		void *buf,
+		size_t size,
+		int max
+	);
+
 	/**
 	 * @brief Closes a mailbox.
 	 *
@@ -35,6 +35,11 @@
 
 #endif /* __NAME_SERVICE */
 
+	/* Must come first. */
+	#define __NEED_LIMITS_PM
+
+	#include <nanvix/limits/pm.h>
+
 	/**
 	 * @brief Initializes the Name Service client.
 	 *
@@ -73,6 +78,42 @@
 	 */
 	extern int nanvix_name_lookup(const char *name);
 
+	/**
+	 * @brief Converts many names into NoC node IDs.
+	 *
+	 * @param names    Target names.
+	 * @param nodenums Store location for the NoC node IDs.
+	 * @param n        Number of names.
+	 *
+	 * @returns Upon successful completion zero is returned, and the NoC
+	 * node ID of each name, or a negative error code if it could not be
+	 * resolved, is stored in @p nodenums. Upon failure, a negative error
+	 * code is returned instead.
+	 */
+	extern int nanvix_name_lookup_multi(const char **names, int *nodenums, int n);
+
+	/**
+	 * @brief Lists names that start with a prefix.
+	 *
+	 * @param prefix Target prefix.
+	 * @param names  Store location for names.
+	 * @param max    Maximum number of names to list.
+	 *
+	 * @returns Upon successful completion, the number of names listed is
+	 * returned. Upon failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_name_list(const char *prefix, char (*names)[NANVIX_PROC_NAME_MAX], int max);
+
+	/**
+	 * @brief Drops a cached name lookup.
+	 *
+	 * @param name Target name. If NULL, all cached lookups are dropped.
+	 *
+	 * @returns Upon successful completion zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_name_invalidate(const char *name);
+
 	/**
 	 * @brief Unlink a process name.
 	 *
@@ -83,11 +124,26 @@
 	 */
 	extern int nanvix_name_unlink(const char *name);
 
+	/**
+	 * @brief Asserts whether or not the process of a name is alive.
+	 *
+	 * @param name Target name.
+	 *
+	 * @returns If the name pointed to by @p name is linked and its
+	 * heartbeats did not stop, zero is returned. Otherwise, a negative
+	 * error code is returned instead.
+	 */
+	extern int nanvix_name_alive(const char *name);
+
 	/**
 	 * @brief Updates the timestamp of a process.
 	 *
 	 * @returns Upons successful completion, zero is returned. Upon
 	 * failure, a negative error code is returned instead.
+	 *
+	 * @note Heartbeats are opt-in. None of the system servers sends
+	 * them, thus their names never expire, and clients of the RMem,
+	 * VFS and SysV servers do not fail over.
 	 */
 	extern int nanvix_name_heartbeat(void);
 
@@ -44,18 +44,11 @@
 	extern int __nanvix_sysv_is_initialized(void);
 
 	/**
-	 * @brief Gets the outbox to the server.
+	 * @brief Gets the channel to the server.
 	 *
-	 * @returns The outbox to the server.
+	 * @returns The channel to the server.
 	 */
-	extern int __nanvix_sysv_outbox(void);
-
-	/**
-	 * @brief Gets the outportal to the server.
-	 *
-	 * @returns The outportal to the server.
-	 */
-	extern int __nanvix_sysv_outportal(void);
+	extern int __nanvix_sysv_channel(void);
 
 #endif /* __SYSV_SERVICE */
 
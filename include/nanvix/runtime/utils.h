@@ -117,6 +117,23 @@
 	 */
 	extern bitmap_t bitmap_first_free(bitmap_t *, size_t);
 
+	/**
+	 * @brief Searches for the next free bit in a bitmap.
+	 *
+	 * @details Searches for the first free bit in a bitmap, starting
+	 *		  from a given bit and wrapping around at the end. In
+	 *		  order to speedup computation, bits are checked in chunks
+	 *		  of 4 bytes.
+	 *
+	 * @param bitmap Bitmap to be searched.
+	 * @param size   Size (in bytes) of the bitmap.
+	 * @param start  Number of the bit to start from.
+	 *
+	 * @returns If a free bit is found, the number of that bit is returned. However,
+	 *		  if no free bit is found #BITMAP_FULL is returned instead.
+	 */
+	extern bitmap_t bitmap_next_free(bitmap_t *, size_t, bitmap_t);
+
 	/**
 	 * @brief Checks what is the value of the nth bit.
 	 *
@@ -129,6 +146,71 @@
 	 */
 	extern bitmap_t bitmap_check_bit(bitmap_t *, bitmap_t);
 
+/*============================================================================*
+ * Resource Index                                                             *
+ *============================================================================*/
+
+	/* Forward definitions. */
+	struct resource_pool;
+
+	/**
+	 * @brief Maximum number of resources in an indexed pool.
+	 */
+	#define RESOURCE_INDEX_MAX (BITMAP_WORD_LENGTH*BITMAP_WORD_LENGTH)
+
+	/**
+	 * @brief Index of free resources in a pool.
+	 *
+	 * @details Free resources are tracked in a two-level bitmap: a bit
+	 * of the summary is set if the matching word of the map has at
+	 * least one free resource, thus the lowest free resource is found
+	 * with two count-trailing-zeros instructions. The index is built
+	 * from the flags of the pool on first use.
+	 */
+	struct resource_index
+	{
+		const struct resource_pool *pool;                    /**< Underlying pool.             */
+		int initialized;                                     /**< Is the index built?          */
+		bitmap_t summary;                                    /**< Words of map with free bits. */
+		bitmap_t map[RESOURCE_INDEX_MAX/BITMAP_WORD_LENGTH]; /**< Free resources.              */
+	};
+
+	/**
+	 * @brief Static initializer for a resource index.
+	 *
+	 * @param p Underlying pool.
+	 */
+	#define RESOURCE_INDEX_INITIALIZER(p) { .pool = (p), .initialized = 0 }
+
+	/**
+	 * @brief Rebuilds a resource index.
+	 *
+	 * @param index Target resource index.
+	 *
+	 * @note The index should be rebuilt whenever the flags of its
+	 * pool are changed by other means than the index itself.
+	 */
+	extern void resource_index_reset(struct resource_index *index);
+
+	/**
+	 * @brief Allocates a resource from an indexed pool.
+	 *
+	 * @param index Target resource index.
+	 *
+	 * @returns Upon successful completion, the ID of the lowest
+	 * resource that was free is returned. Upon failure, a negative
+	 * number is returned instead.
+	 */
+	extern int resource_index_alloc(struct resource_index *index);
+
+	/**
+	 * @brief Releases a resource of an indexed pool.
+	 *
+	 * @param index Target resource index.
+	 * @param id    ID of the target resource.
+	 */
+	extern void resource_index_free(struct resource_index *index, int id);
+
 /*============================================================================*
  * Debug                                                                      *
  *============================================================================*/
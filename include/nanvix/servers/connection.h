@@ -36,6 +36,7 @@
 		nanvix_pid_t remote; /**< PID             */
 		int port;            /**< Port Number     */
 		int count;           /**< Reference Count */
+		unsigned nrequests;  /**< Requests Served */
 	};
 
 	/**
@@ -55,17 +56,41 @@
 	 */
 	extern int lookup(nanvix_pid_t remote, int port);
 
+	/**
+	 * @brief Accounts a request served on a connection.
+	 *
+	 * @param pid  PID of the remote.
+	 * @param port Remote port number.
+	 *
+	 * @returns If the target remote is found, its index in the table of
+	 * connections is returned. Otherwise a negative number is returned
+	 * instead.
+	 */
+	extern int connection_request(nanvix_pid_t remote, int port);
+
 	/**
 	 * @brief Establishes a connection
 	 *
 	 * @param pid  PID of the remote.
 	 * @param port Remote port number.
 	 *
-	 * @returns Upon sucessful completion, zero is returned. Upon failure, a
-	 * negative error code is returned instead.
+	 * @returns Upon sucessful completion, the index of the connection in
+	 * the table of connections is returned. Upon failure, a negative
+	 * error code is returned instead.
 	 */
 	extern int connect(nanvix_pid_t remote, int port);
 
+	/**
+	 * @brief Gets the remote of a connection.
+	 *
+	 * @param connection Target connection.
+	 *
+	 * @returns Upon sucessful completion, the PID of the remote is
+	 * returned. Upon failure, a negative error code is returned
+	 * instead.
+	 */
+	extern nanvix_pid_t connection_get_remote(int connection);
+
 	/**
 	 * @brief Gets port of remote connection.
 	 *
@@ -89,14 +114,31 @@
 	extern int disconnect(nanvix_pid_t remote, int port);
 
 	/**
-	 * @brief Gets active connections.
+	 * @brief Gets the number of active connections.
+	 *
+	 * @returns The number of active connections.
+	 */
+	extern int connections_count(void);
+
+	/**
+	 * @brief Gets the number of requests served on all connections.
+	 *
+	 * @returns The number of requests served on all connections.
+	 */
+	extern unsigned connections_nrequests(void);
+
+	/**
+	 * @brief Gets an active connection.
+	 *
+	 * @param i Position of the target connection, which should be less
+	 * than the number of active connections.
 	 *
-	 * @param buf Buffer to store info on connections.
+	 * @returns Upon successful completion, the target connection is
+	 * returned. Upon failure, NULL is returned instead.
 	 *
-	 * @returns Upon successful completion, the number of connections
-	 * placed in @p buf is returned. Upon failure, a negative error code
-	 * is returned instead.
+	 * @note Connections may move in the list of active connections on
+	 * calls to connect() and disconnect().
 	 */
-	extern int get_connections(struct connection *buf);
+	extern const struct connection *connections_get(int i);
 
 #endif /* SERVERS_CONNECTION_H_ */
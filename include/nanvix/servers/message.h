@@ -38,6 +38,28 @@
 		uint8_t portal_port;  /**< Port Number     */
 	} message_header;
 
+	/**
+	 * @brief Opcode of batched messages.
+	 *
+	 * @details Opcodes of servers must be smaller than this one.
+	 */
+	#define MESSAGE_BATCH 0xff
+
+	/**
+	 * @brief Header of a batch of messages.
+	 *
+	 * @details Messages of a batch are either packed right after the
+	 * header, in the same mailbox message, or sent afterwards through
+	 * the portal whose port is in the message header.
+	 */
+	struct message_batch
+	{
+		message_header header; /**< Message header.                        */
+		uint8_t count;         /**< Number of packed messages.             */
+		uint8_t size;          /**< Size of each message.                  */
+		uint8_t spilled;       /**< Number of messages sent through portal. */
+	};
+
 	/**
 	 * @brief Prints a message header in a string.
 	 *
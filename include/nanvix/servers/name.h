@@ -34,6 +34,7 @@
 
 	#include <nanvix/servers/message.h>
 	#include <nanvix/limits/pm.h>
+	#include <nanvix/config.h>
 	#include <nanvix/ulib.h>
 	#include <posix/stdint.h>
 	#include <posix/errno.h>
@@ -42,15 +43,35 @@
 	 * @brief Operation types for Name Server.
 	 */
 	/**@{*/
-	#define NAME_EXIT    0 /**< Exit request.            */
-	#define NAME_LOOKUP  1 /**< lookup a name.           */
-	#define NAME_LINK    2 /**< Add a new name.          */
-	#define NAME_UNLINK  3 /**< Remove a name.           */
-	#define NAME_SUCCESS 4 /**< Success acknowledgement. */
-	#define NAME_ALIVE   5 /**< Client alive.            */
-	#define NAME_FAIL    6 /**< Failure acknowledgement. */
+	#define NAME_EXIT          0 /**< Exit request.            */
+	#define NAME_LOOKUP        1 /**< lookup a name.           */
+	#define NAME_LINK          2 /**< Add a new name.          */
+	#define NAME_UNLINK        3 /**< Remove a name.           */
+	#define NAME_SUCCESS       4 /**< Success acknowledgement. */
+	#define NAME_ALIVE         5 /**< Client alive.            */
+	#define NAME_FAIL          6 /**< Failure acknowledgement. */
+	#define NAME_UPDATE        7 /**< Update a replica.        */
+	#define NAME_LOOKUP_MULTI  8 /**< Lookup many names.       */
+	#define NAME_LIST          9 /**< List names by prefix.    */
+	#define NAME_SYNC         10 /**< Resync a replica.        */
 	/**@}*/
 
+	/**
+	 * @brief Maximum number of names in a batched lookup.
+	 */
+	#define NAME_LOOKUP_MULTI_MAX 8
+
+	/**
+	 * @brief Size of the buffer of packed names in a message.
+	 *
+	 * @details Names are packed one after the other, each one ended
+	 * by a null character. The buffer takes what is left of a mailbox
+	 * message, after the message header (padded to 8 bytes) and the
+	 * five integers that precede the names in a listing reply.
+	 */
+	#define NAME_PACKED_SIZE \
+		((NANVIX_MAILBOX_MESSAGE_SIZE - sizeof(uint64_t) - 5*sizeof(int)) & ~(sizeof(uint64_t) - 1))
+
 	/**
 	 * @brief Name Server message.
 	 */
@@ -85,6 +106,25 @@
 
 			} heartbeat;
 
+			struct
+			{
+				char name[NANVIX_PROC_NAME_MAX]; /**< Portal name.                */
+				int nodenum;                     /**< NoC node (-1 if unlinked). */
+				unsigned generation;             /**< Name generation.            */
+			} update;
+
+			struct
+			{
+				int count;                    /**< Number of names. */
+				char names[NAME_PACKED_SIZE]; /**< Packed names.    */
+			} lookup_multi;
+
+			struct
+			{
+				int cursor;                        /**< Where to resume listing. */
+				char prefix[NANVIX_PROC_NAME_MAX]; /**< Prefix of names.         */
+			} list;
+
 			struct
 			{
 
@@ -92,12 +132,57 @@
 
 			struct
 			{
-				int nodenum; /**< NoC node.   */
-				int errcode; /**< Error code. */
+				int nodenum;         /**< NoC node.        */
+				int errcode;         /**< Error code.      */
+				unsigned generation; /**< Name generation. */
+
+				/**
+				 * @brief Results of Batched Operations
+				 */
+				union
+				{
+					/**
+					 * @brief NoC nodes (or negative error codes) of names.
+					 */
+					int nodenums[NAME_LOOKUP_MULTI_MAX];
+
+					struct
+					{
+						int cursor;                   /**< Where to resume listing (-1 if done). */
+						int count;                    /**< Number of names.                      */
+						char names[NAME_PACKED_SIZE]; /**< Packed names.                         */
+					} list;
+				} data;
 			} ret;
 		} op;
 	};
 
+	/**
+	 * @brief Asserts that a name server message fits in a mailbox
+	 * message, so that a change to the layout of NAME_PACKED_SIZE
+	 * cannot silently overflow the buffer of packed names.
+	 */
+	typedef char name_message_fits[
+		(sizeof(struct name_message) <= NANVIX_MAILBOX_MESSAGE_SIZE) ? 1 : -1
+	];
+
+#ifdef __NANVIX_HAS_NAME_SERVER
+
+	/**
+	 * @brief Table of Name Servers.
+	 *
+	 * @details The first server is the primary one, which handles all
+	 * updates and propagates them to the other servers. All servers
+	 * answer lookups.
+	 */
+	extern struct name_servers_info
+	{
+		int nodenum;
+		int portnum;
+	} name_servers[NAME_SERVERS_NUM];
+
+#endif
+
 	/**
 	 * @see node_is_valid()
 	 */
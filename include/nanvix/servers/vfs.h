@@ -34,35 +34,81 @@
 
 	#include <nanvix/servers/message.h>
 	#include <nanvix/limits/fs.h>
-
-#ifdef __VFS_SERVER
-	#include <nanvix/servers/vfs/bcache.h>
-	#include <nanvix/servers/vfs/fs.h>
-	#include <nanvix/servers/vfs/minix.h>
-	#include <nanvix/servers/vfs/fprocess.h>
-	#include <nanvix/servers/vfs/vfs.h>
-#endif
+	#include <nanvix/config.h>
 
 	/**
 	 * @bried Virtual File System Operations
 	 */
 	/**@{*/
-	#define VFS_EXIT      0 /**< Exit        */
-	#define VFS_SUCCESS   1 /**< Success     */
-	#define VFS_FAIL      2 /**< Failure     */
-	#define VFS_CREAT     3 /**< Create      */
-	#define VFS_OPEN      4 /**< Open        */
-	#define VFS_UNLINK    5 /**< Unlink      */
-	#define VFS_CLOSE     6 /**< Close       */
-	#define VFS_LINK      7 /**< Link        */
-	#define VFS_TRUNCATE  8 /**< Truncate    */
-	#define VFS_STAT      9 /**< Stat        */
-	#define VFS_READ     10 /**< Read        */
-	#define VFS_WRITE    11 /**< Write       */
-	#define VFS_SEEK     12 /**< Seek        */
-	#define VFS_ACK      12 /**< Acknowledge */
+	#define VFS_EXIT        0 /**< Exit        */
+	#define VFS_SUCCESS     1 /**< Success     */
+	#define VFS_FAIL        2 /**< Failure     */
+	#define VFS_CREAT       3 /**< Create      */
+	#define VFS_OPEN        4 /**< Open        */
+	#define VFS_UNLINK      5 /**< Unlink      */
+	#define VFS_CLOSE       6 /**< Close       */
+	#define VFS_LINK        7 /**< Link        */
+	#define VFS_TRUNCATE    8 /**< Truncate    */
+	#define VFS_STAT        9 /**< Stat        */
+	#define VFS_READ       10 /**< Read        */
+	#define VFS_WRITE      11 /**< Write       */
+	#define VFS_SEEK       12 /**< Seek        */
+	#define VFS_ACK        13 /**< Acknowledge */
+	#define VFS_PREAD      14 /**< Read At     */
+	#define VFS_PWRITE     15 /**< Write At    */
+	#define VFS_COPY_RANGE 16 /**< Copy Range  */
+	#define VFS_MULTI      17 /**< Compound    */
+	#define VFS_GETDENTS   18 /**< Get Entries */
+	#define VFS_RECALL     19 /**< Recall      */
+	#define VFS_RECALL_ACK 20 /**< Recall Done */
+	/**@}*/
+
+	/**
+	 * @brief Maximum Number of Operations in a Compound Request
+	 */
+	#define VFS_MULTI_MAX 16
+
+	/**
+	 * @brief Maximum Number of Entries in a VFS_GETDENTS Request
+	 */
+	#define VFS_GETDENTS_MAX (NANVIX_FS_BLOCK_SIZE/sizeof(struct vfs_dirent))
+
+	/**
+	 * @name Types of Data Leases
+	 */
+	/**@{*/
+	#define VFS_LEASE_NONE  0 /**< No Lease                   */
+	#define VFS_LEASE_READ  1 /**< Read Lease (Cache Reads)   */
+	#define VFS_LEASE_WRITE 2 /**< Write Lease (Write-Behind) */
 	/**@}*/
 
+	/**
+	 * @brief Operation of a Compound Request
+	 *
+	 * Operations are shipped through portals, and each of them carries
+	 * back its own result.
+	 */
+	struct vfs_multi_op
+	{
+		int opcode;                     /**< VFS_OPEN or VFS_STAT      */
+		int oflag;                      /**< Open Flags (VFS_OPEN)     */
+		char filename[NANVIX_NAME_MAX]; /**< File Name                 */
+		int ret;                        /**< File Descriptor or Status */
+		int lease;                      /**< Data Lease (VFS_OPEN)     */
+		unsigned version;               /**< Data Version (VFS_OPEN)   */
+		struct vfs_stat st;             /**< Attributes (VFS_STAT)     */
+	};
+
+	/**
+	 * @brief Asserts that a compound request fits in a block.
+	 *
+	 * Operations are received in the working buffer of a worker thread
+	 * of the server, which is as large as a block.
+	 */
+	typedef char vfs_multi_fits[
+		((VFS_MULTI_MAX*sizeof(struct vfs_multi_op)) <= NANVIX_FS_BLOCK_SIZE) ? 1 : -1
+	];
+
 	/**
 	 * @brief Shared Memory Region message.
 	 */
@@ -78,10 +124,19 @@
 			 */
 			struct
 			{
-				char filename[NANVIX_NAME_MAX]; /**< File Name  */
-				int oflag;                      /**< Open Flags */
+				char filename[NANVIX_NAME_MAX]; /**< File Name              */
+				int oflag;                      /**< Open Flags             */
+				int recall;                     /**< Port of Recall Daemon  */
 			} open;
 
+			/**
+			 * @brief Stat
+			 */
+			struct
+			{
+				char filename[NANVIX_NAME_MAX]; /**< File Name */
+			} stat;
+
 			/**
 			 * @brief Close
 			 */
@@ -105,8 +160,9 @@
 			 */
 			struct
 			{
-				int fd;   /**< File Descriptor */
-				size_t n; /**< Read            */
+				int fd;       /**< File Descriptor            */
+				size_t n;     /**< Read                       */
+				off_t offset; /**< File Offset (VFS_PREAD)    */
 			} read;
 
 			/**
@@ -114,22 +170,99 @@
 			 */
 			struct
 			{
-				int fd;   /**< File Descriptor */
-				size_t n; /**< Write           */
+				int fd;       /**< File Descriptor            */
+				size_t n;     /**< Write                      */
+				off_t offset; /**< File Offset (VFS_PWRITE)   */
 			} write;
 
+			/**
+			 * @brief Copy Range
+			 */
+			struct
+			{
+				int fd_in;     /**< Source File Descriptor      */
+				off_t off_in;  /**< Source Offset (-1: Pointer) */
+				int fd_out;    /**< Target File Descriptor      */
+				off_t off_out; /**< Target Offset (-1: Pointer) */
+				size_t n;      /**< Number of Bytes             */
+			} copy;
+
+			/**
+			 * @brief Compound
+			 */
+			struct
+			{
+				int n;      /**< Number of Operations  */
+				int recall; /**< Port of Recall Daemon */
+			} multi;
+
+			/**
+			 * @brief Get Directory Entries
+			 */
+			struct
+			{
+				int fd; /**< File Descriptor   */
+				int n;  /**< Number of Entries */
+			} getdents;
+
+			/**
+			 * @brief Recall
+			 *
+			 * Recalls are sent to the recall daemon of a lease
+			 * holder, which writes back deferred data in VFS_RECALL_ACK
+			 * messages, one per page, and then sends a last one with
+			 * no data.
+			 */
+			struct
+			{
+				int server;   /**< Index of the Server            */
+				int fd;       /**< File Descriptor                */
+				int port;     /**< Port of the Lease Holder       */
+				int tag;      /**< Tag of the Recall              */
+				unsigned seq; /**< Sequence Number of the Recall  */
+				off_t offset; /**< File Offset of Data            */
+				size_t n;     /**< Number of Bytes (0 if done)    */
+			} recall;
+
 			/* Return Message */
 			struct
 			{
-				int fd;        /**< File Descriptor  */
-				ssize_t count; /**< Read/Write Count */
-				int status;    /**< Status Code      */
-				off_t offset;  /**< File Offset      */
+				int fd;             /**< File Descriptor  */
+				ssize_t count;      /**< Read/Write Count */
+				int status;         /**< Status Code      */
+				off_t offset;       /**< File Offset      */
+				int lease;          /**< Data Lease       */
+				unsigned version;   /**< Data Version     */
+				struct vfs_stat st; /**< Attributes       */
 			} ret;
 		} op;
 	};
 
+#ifdef __NANVIX_HAS_VFS_SERVER
+
+	/**
+	 * @brief Table of VFS Servers.
+	 *
+	 * The first server serves the root of the namespace. Any other
+	 * server serves the subtree that is named after it.
+	 */
+	extern struct vfs_servers_info
+	{
+		int nodenum;
+		int portnum;
+		const char *name;
+	} vfs_servers[VFS_SERVERS_NUM];
+
+#endif
+
 #ifdef __VFS_SERVER
+	#include <nanvix/servers/vfs/bcache.h>
+	#include <nanvix/servers/vfs/dcache.h>
+	#include <nanvix/servers/vfs/journal.h>
+	#include <nanvix/servers/vfs/fs.h>
+	#include <nanvix/servers/vfs/minix.h>
+	#include <nanvix/servers/vfs/fprocess.h>
+	#include <nanvix/servers/vfs/vfs.h>
 
 	/**
 	 * @brief Debug VFS Server?
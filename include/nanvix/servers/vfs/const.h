@@ -33,6 +33,6 @@
 	/**
 	 * @brief Length for Table of Files
 	 */
-	#define NANVIX_NR_FILES 64
+	#define NANVIX_NR_FILES 4096
 
 #endif /* NANVIX_SERVERS_VFS_CONST_H_ */
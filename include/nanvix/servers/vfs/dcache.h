@@ -0,0 +1,84 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NANVIX_SERVERS_VFS_DCACHE_H_
+#define NANVIX_SERVERS_VFS_DCACHE_H_
+
+	#ifndef __VFS_SERVER
+	#error "do not include this file"
+	#endif
+
+	#include <posix/sys/types.h>
+
+ 	/**
+ 	 * @addtogroup Directory
+ 	 */
+	/**@{*/
+
+	/**
+	 * @brief Initializes the directory cache.
+	 */
+	extern void dcache_init(void);
+
+	/**
+	 * @brief Looks up a name in the directory cache.
+	 *
+	 * @param dev  Device number.
+	 * @param dir  Inode number of parent directory.
+	 * @param name Target name.
+	 * @param num  Store location for inode number.
+	 *
+	 * @returns Upon a cache hit, zero is returned and the number of the
+	 * inode named @p name is stored in the location pointed to by @p
+	 * num. If the name is known not to exist, the null inode number is
+	 * stored instead. Upon a cache miss, a negative error code is
+	 * returned instead.
+	 */
+	extern int dcache_lookup(dev_t dev, ino_t dir, const char *name, ino_t *num);
+
+	/**
+	 * @brief Inserts a name in the directory cache.
+	 *
+	 * @param dev  Device number.
+	 * @param dir  Inode number of parent directory.
+	 * @param name Target name.
+	 * @param num  Inode number (null inode number for negative entries).
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int dcache_insert(dev_t dev, ino_t dir, const char *name, ino_t num);
+
+	/**
+	 * @brief Invalidates names in the directory cache.
+	 *
+	 * @param dev  Device number.
+	 * @param name Target name. If NULL, all names of @p dev are
+	 * invalidated.
+	 */
+	extern void dcache_invalidate(dev_t dev, const char *name);
+
+	/**@}*/
+
+#endif /* NANVIX_SERVERS_VFS_DCACHE_H_ */
@@ -33,16 +33,37 @@
 	#define __NEED_LIMITS_FS
 
 	#include <nanvix/limits/fs.h>
+	#include <nanvix/runtime/utils.h>
+
+	/**
+	 * @brief Number of words in the map of file descriptors.
+	 *
+	 * @details The table of opened files is split in chunks of
+	 * BITMAP_WORD_LENGTH entries, one for each word of the map. Chunks
+	 * are allocated on demand, thus processes that open few files pay
+	 * for few entries only.
+	 */
+	#define FPROCESS_OFILES_NCHUNKS (NANVIX_OPEN_MAX/BITMAP_WORD_LENGTH)
+
+	#if ((NANVIX_OPEN_MAX % BITMAP_WORD_LENGTH) != 0)
+	#error "NANVIX_OPEN_MAX should be a multiple of BITMAP_WORD_LENGTH"
+	#endif
+
+	#if (FPROCESS_OFILES_NCHUNKS > BITMAP_WORD_LENGTH)
+	#error "NANVIX_OPEN_MAX is too large"
+	#endif
 
 	/**
 	 * @brief (File System) Process
 	 */
 	struct fprocess
 	{
-		int errcode;                          /**< Error Code        */
-		struct inode *pwd;                    /**< Working Directory */
-		struct inode *root;                   /**< Root Directory    */
-		struct file *ofiles[NANVIX_OPEN_MAX]; /**< Opened Files      */
+		int errcode;                                   /**< Error Code                  */
+		struct inode *pwd;                             /**< Working Directory           */
+		struct inode *root;                            /**< Root Directory              */
+		bitmap_t ofull;                                /**< Full Words of Descriptors   */
+		bitmap_t omap[FPROCESS_OFILES_NCHUNKS];        /**< Map of Used Descriptors     */
+		struct file **ofiles[FPROCESS_OFILES_NCHUNKS]; /**< Opened Files (Chunked)      */
 	};
 
 	/**
@@ -50,6 +71,16 @@
 	 */
 	extern void fprocess_init(void);
 
+	/**
+	 * @brief Resets a file system process.
+	 *
+	 * @param connection Target connection.
+	 *
+	 * @returns Upon sucessful completion, zero is returned. Upon failure, a
+	 * negative error code is returned instead.
+	 */
+	extern int fprocess_reset(int connection);
+
 	/**
 	 * @brief Launches a file system process.
 	 *
@@ -60,10 +91,54 @@
 	 */
 	extern int fprocess_launch(int connection);
 
+	/**
+	 * @brief Gets the file system process of the calling thread.
+	 *
+	 * @returns The file system process that was last launched by the
+	 * calling thread. If none was launched, a NULL pointer is returned
+	 * instead.
+	 */
+	extern struct fprocess *fprocess_current(void);
+
+	/**
+	 * @brief Allocates a file descriptor in the current process.
+	 *
+	 * @param f Opened file to install in the file descriptor.
+	 *
+	 * @returns Upon successful completion, the lowest-numbered file
+	 * descriptor that is free is returned. Upon failure, a negative
+	 * error code is returned instead.
+	 */
+	extern int fprocess_fd_alloc(struct file *f);
+
+	/**
+	 * @brief Releases a file descriptor of the current process.
+	 *
+	 * @param fd Target file descriptor.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int fprocess_fd_free(int fd);
+
+	/**
+	 * @brief Gets the file opened in a file descriptor.
+	 *
+	 * @param fd Target file descriptor.
+	 *
+	 * @returns The file opened in the file descriptor @p fd of the
+	 * current process. If @p fd is not in use, a NULL pointer is returned
+	 * instead.
+	 */
+	extern struct file *fprocess_fd_get(int fd);
+
 	/**
 	 * @brief Current Process
+	 *
+	 * @details Each thread of the server handles a request at a time,
+	 * thus the current process is tracked per thread.
 	 */
-	extern struct fprocess *curr_proc;
+	#define curr_proc (fprocess_current())
 
 #endif /* NANVIX_SERVERS_VFS_FPROCESS_H_*/
 
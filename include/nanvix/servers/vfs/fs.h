@@ -45,6 +45,7 @@
 		dev_t dev;                /**< Underlying Device.         */
 		bitmap_t *imap;           /**< Inode Map                  */
 		bitmap_t *bmap;           /**< Block Map                  */
+		bitmap_t *rmap;           /**< Block Reservation Map      */
 	};
 
 /*============================================================================*
@@ -82,6 +83,16 @@
 	 */
 	extern void fs_shutdown(void);
 
+	/**
+	 * @brief Acquires the file system lock.
+	 */
+	extern void fs_lock(void);
+
+	/**
+	 * @brief Releases the file system lock.
+	 */
+	extern void fs_unlock(void);
+
 	/**
 	 * @brief Opens a file.
 	 *
@@ -131,6 +142,95 @@
 	 */
 	extern ssize_t fs_write(int fd, void *buf, size_t n);
 
+	/**
+	 * @brief Reads data from a file at a given offset.
+	 *
+	 * @param fd  Target file descriptor.
+	 * @param buf Target buffer.
+	 * @param n   Number of bytes to read.
+	 * @param off File offset.
+	 *
+	 * @returns Upon successful completion, the number of bytes
+	 * successfully read is returned. Upon failure, a negative error
+	 * code is returned instead.
+	 */
+	extern ssize_t fs_pread(int fd, void *buf, size_t n, off_t off);
+
+	/**
+	 * @brief Writes data to a file at a given offset.
+	 *
+	 * @param fd  Target file descriptor.
+	 * @param buf Target buffer.
+	 * @param n   Number of bytes to write.
+	 * @param off File offset.
+	 *
+	 * @returns Upon successful completion, the number of bytes
+	 * successfully written is returned. Upon failure, a negative error
+	 * code is returned instead.
+	 */
+	extern ssize_t fs_pwrite(int fd, void *buf, size_t n, off_t off);
+
+	/**
+	 * @brief Copies data between files.
+	 *
+	 * @param fd_in   Source file descriptor.
+	 * @param off_in  Source offset. If negative, the read/write pointer
+	 * of the source file is used and advanced.
+	 * @param fd_out  Target file descriptor.
+	 * @param off_out Target offset. If negative, the read/write pointer
+	 * of the target file is used and advanced.
+	 * @param n       Number of bytes to copy.
+	 *
+	 * @returns Upon successful completion, the number of bytes
+	 * successfully copied is returned. Upon failure, a negative error
+	 * code is returned instead.
+	 *
+	 * @note The caller should hold the file system lock, which is
+	 * released and reacquired between blocks.
+	 */
+	extern ssize_t fs_copy_range(
+		int fd_in,
+		off_t off_in,
+		int fd_out,
+		off_t off_out,
+		size_t n
+	);
+
+	/**
+	 * @brief Gets the attributes of a file.
+	 *
+	 * @param filename Name of the target file.
+	 * @param buf      Location to store the attributes.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int fs_stat(const char *filename, struct vfs_stat *buf);
+
+	/**
+	 * @brief Gets the attributes of an opened file.
+	 *
+	 * @param fd  Target file descriptor.
+	 * @param buf Location to store the attributes.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int fs_fstat(int fd, struct vfs_stat *buf);
+
+	/**
+	 * @brief Reads entries of a directory.
+	 *
+	 * @param fd   Target file descriptor.
+	 * @param dirp Location to store the entries.
+	 * @param n    Maximum number of entries to read.
+	 *
+	 * @returns Upon successful completion, the number of entries read
+	 * is returned. Upon failure, a negative error code is returned
+	 * instead.
+	 */
+	extern int fs_getdents(int fd, struct vfs_dirent *dirp, int n);
+
 	/**
 	 * @brief Repositions the read/write pointer of a file.
 	 *
@@ -144,6 +244,18 @@
 	 */
 	extern off_t fs_lseek(int fd, off_t offset, int whence);
 
+	/**
+	 * @brief Grants a data lease on a file.
+	 *
+	 * @param fd      Target file descriptor.
+	 * @param version Store location for data version of the file.
+	 *
+	 * @returns Upon successful completion, the type of the lease that
+	 * was granted is returned. Upon failure, a negative error code is
+	 * returned instead.
+	 */
+	extern int fs_lease(int fd, unsigned *version);
+
 	/**
 	 * @brief Creates a file system.
 	 *
@@ -239,7 +351,12 @@
 	/**
 	 * @brief Length of Inodes Table
 	 */
-	#define NANVIX_INODES_TABLE_LENGTH (NANVIX_NR_INODES/4)
+	#define NANVIX_INODES_TABLE_LENGTH NANVIX_INODE_CACHE_LENGTH
+
+	/**
+	 * @brief Initializes the table of inodes.
+	 */
+	extern void inode_init(void);
 
 	/**
 	 * @brief Gets disk inode.
@@ -351,4 +468,100 @@
 	 */
 	extern int inode_touch(struct inode *ip);
 
+	/**
+	 * @brief Gets the data version of an inode.
+	 *
+	 * @param ip Target inode.
+	 *
+	 * @returns The data version of the target inode.
+	 */
+	extern unsigned inode_get_version(const struct inode *ip);
+
+	/**
+	 * @brief Increments the data version of an inode.
+	 *
+	 * @param ip Target inode.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int inode_inc_version(struct inode *ip);
+
+	/**
+	 * @brief Attaches an opener to an inode.
+	 *
+	 * @param ip    Target inode.
+	 * @param oflag Flags with which the inode was opened.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int inode_attach(struct inode *ip, int oflag);
+
+	/**
+	 * @brief Detaches an opener from an inode.
+	 *
+	 * @param ip    Target inode.
+	 * @param oflag Flags with which the inode was opened.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int inode_detach(struct inode *ip, int oflag);
+
+	/**
+	 * @brief Gets the number of openers of an inode.
+	 *
+	 * @param ip       Target inode.
+	 * @param nreaders Store location for the number of read-only openers.
+	 * @param nwriters Store location for the number of writable openers.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int inode_get_openers(const struct inode *ip, int *nreaders, int *nwriters);
+
+	/**
+	 * @brief Locks an inode.
+	 *
+	 * @param ip Target inode.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int inode_lock(struct inode *ip);
+
+	/**
+	 * @brief Unlocks an inode.
+	 *
+	 * @param ip Target inode.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int inode_unlock(struct inode *ip);
+
+	/**
+	 * @brief Maps a file byte offset of an inode in a block number.
+	 *
+	 * @param fs     Target file system.
+	 * @param ip     Target inode.
+	 * @param off    File offset.
+	 * @param create Create offset?
+	 * @param len    Store location for the number of contiguous blocks.
+	 *
+	 * @returns Upon successful completion, the block number that is
+	 * allocated for the file byte offset @p off is returned, and the
+	 * number of physically contiguous blocks that are mapped from
+	 * there on is stored in @p len, if it is not a NULL pointer. Upon
+	 * failure, MINIX_BLOCK_NULL is returned instead.
+	 */
+	extern minix_block_t inode_block_map(
+		struct filesystem *fs,
+		struct inode *ip,
+		off_t off,
+		int create,
+		block_t *len
+	);
+
 #endif /* NANVIX_SERVERS_VFS_FS_H_*/
@@ -0,0 +1,156 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef NANVIX_SERVERS_VFS_JOURNAL_H_
+#define NANVIX_SERVERS_VFS_JOURNAL_H_
+
+	#ifndef __VFS_SERVER
+	#error "do not include this file"
+	#endif
+
+	#include <posix/sys/types.h>
+	#include <posix/stdint.h>
+
+	/**
+	 * @addtogroup Journal
+	 */
+	/**@{*/
+
+	/**
+	 * @brief Journal Statistics
+	 */
+	struct journal_stats
+	{
+		unsigned nrecords;     /**< Records appended to the log.      */
+		unsigned nabsorbed;    /**< Updates absorbed by a record.     */
+		unsigned ncommits;     /**< Groups committed to the log.      */
+		unsigned ncheckpoints; /**< Checkpoints.                      */
+	};
+
+	/**
+	 * @brief Activates the journal for a device.
+	 *
+	 * @param dev Device that holds the journaled file system.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 *
+	 * @note Committed groups found in the log are replayed.
+	 */
+	extern int journal_mount(dev_t dev);
+
+	/**
+	 * @brief Deactivates the journal for a device.
+	 *
+	 * @param dev Device that holds the journaled file system.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 *
+	 * @note Pending updates are committed and checkpointed.
+	 */
+	extern int journal_unmount(dev_t dev);
+
+	/**
+	 * @brief Writes metadata to a device.
+	 *
+	 * @param dev Target device.
+	 * @param buf Source buffer.
+	 * @param n   Number of bytes to write.
+	 * @param off Write offset.
+	 *
+	 * @returns Upon successful completion, the number of bytes
+	 * written is returned. Upon failure, a negative error code is
+	 * returned instead.
+	 */
+	extern ssize_t journal_write(dev_t dev, const void *buf, size_t n, off_t off);
+
+	/**
+	 * @brief Reads metadata from a device.
+	 *
+	 * @param dev Target device.
+	 * @param buf Target buffer.
+	 * @param n   Number of bytes to read.
+	 * @param off Read offset.
+	 *
+	 * @returns Upon successful completion, the number of bytes read
+	 * is returned. Upon failure, a negative error code is returned
+	 * instead.
+	 */
+	extern ssize_t journal_read(dev_t dev, void *buf, size_t n, off_t off);
+
+	/**
+	 * @brief Checkpoints logged updates that overlap a range of a device.
+	 *
+	 * @param dev Target device.
+	 * @param n   Number of bytes in the range.
+	 * @param off Offset of the range.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int journal_sync(dev_t dev, size_t n, off_t off);
+
+	/**
+	 * @brief Marks the start of an operation.
+	 *
+	 * @note Operations are never committed halfway.
+	 */
+	extern void journal_begin(void);
+
+	/**
+	 * @brief Commits pending updates to the log.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int journal_commit(void);
+
+	/**
+	 * @brief Applies committed updates to their home locations.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int journal_checkpoint(void);
+
+	/**
+	 * @brief Gets journal statistics.
+	 *
+	 * @param stats Store location for statistics.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int journal_stats_get(struct journal_stats *stats);
+
+	/**
+	 * @brief Initializes the journal.
+	 */
+	extern void journal_init(void);
+
+	/**@}*/
+
+#endif /* NANVIX_SERVERS_VFS_JOURNAL_H_ */
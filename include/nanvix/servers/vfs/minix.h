@@ -39,6 +39,21 @@
  * Block Interface                                                            *
  *============================================================================*/
 
+	/**
+	 * @brief Block Preallocation Window
+	 *
+	 * @details Run of free blocks that is reserved for a file, so that
+	 * its next blocks are placed contiguously on disk. Reservations are
+	 * kept in an in-memory reservation map of the file system, thus
+	 * they never reach the zone map on disk.
+	 */
+	struct minix_prealloc
+	{
+		minix_block_t next;  /**< Next reserved block.       */
+		minix_block_t count; /**< Number of reserved blocks. */
+		bitmap_t *rmap;      /**< Reservation map.           */
+	};
+
 	/**
 	 * @brief Allocates a  file system block.
 	 *
@@ -54,6 +69,22 @@
 		bitmap_t *zmap
 	);
 
+	/**
+	 * @brief Releases the blocks of a preallocation window.
+	 *
+	 * @param sb   Target superblock.
+	 * @param zmap Target zone map.
+	 * @param pa   Target preallocation window.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int minix_block_prealloc_release(
+		const struct d_superblock *sb,
+		bitmap_t *zmap,
+		struct minix_prealloc *pa
+	);
+
 	/**
 	 * @brief Frees a direct file system block.
 	 *
@@ -135,6 +166,31 @@
 		int create
 	);
 
+	/**
+	 * @brief Maps a file byte offset in a run of contiguous blocks.
+	 *
+	 * @param ip     Target inode.
+	 * @param pa     Preallocation window of the inode (may be NULL).
+	 * @param off    File offset.
+	 * @param create Create offset?
+	 * @param len    Store location for the length of the run.
+	 *
+	 * @returns Upon sucessful completion, the block number that is
+	 * allocated for the file byte offset @p off is returned, and the
+	 * number of physically contiguous blocks that follow it within
+	 * the same zone (itself included) is stored in @p len. Upon
+	 * failure, MINIX_BLOCK_NULL is returned instead.
+	 */
+	extern minix_block_t minix_block_map_extent(
+		struct d_superblock *sb,
+		bitmap_t *zmap,
+		struct d_inode *ip,
+		struct minix_prealloc *pa,
+		off_t off,
+		int create,
+		minix_block_t *len
+	);
+
 /*============================================================================*
  * Superblock Interface                                                       *
  *============================================================================*/
@@ -348,6 +404,16 @@
 		minix_gid_t gid
 	);
 
+	/**
+	 * @brief Checks if a device holds a MINIX file system.
+	 *
+	 * @param dev Target device.
+	 *
+	 * @returns If the device @p dev holds a MINIX file system, zero is
+	 * returned. Otherwise, a negative error code is returned instead.
+	 */
+	extern int minix_probe(dev_t dev);
+
 	/**
 	 * @brief Synchronizes a MINIX file system.
 	 *
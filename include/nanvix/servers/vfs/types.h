@@ -25,6 +25,9 @@
 #ifndef NANVIX_SERVERS_VFS_TYPES_H_
 #define NANVIX_SERVERS_VFS_TYPES_H_
 
+	#define __NEED_LIMITS_FS
+
+	#include <nanvix/limits/fs.h>
 	#include <posix/stdint.h>
 
 	/**
@@ -32,5 +35,26 @@
 	 */
 	typedef uint32_t block_t;
 
+	/**
+	 * @brief File Attributes
+	 */
+	struct vfs_stat
+	{
+		uint16_t ino;    /**< Inode Number      */
+		uint16_t mode;   /**< File Mode         */
+		uint16_t nlinks; /**< Number of Links   */
+		uint32_t size;   /**< File Size         */
+		uint32_t time;   /**< Modification Time */
+	};
+
+	/**
+	 * @brief Directory Entry
+	 */
+	struct vfs_dirent
+	{
+		char d_name[NANVIX_NAME_MAX]; /**< Entry Name      */
+		struct vfs_stat d_stat;       /**< File Attributes */
+	};
+
 #endif /* NANVIX_SERVERS_VFS_TYPES_H_ */
 
@@ -128,4 +128,137 @@
 		size_t n
 	);
 
+	/**
+	 * @brief Reads data from a file at a given offset.
+	 *
+	 * @param connection Target connection.
+	 * @param fd         Target file descriptor.
+	 * @param buf        Target buffer.
+	 * @param n          Number of bytes to read.
+	 * @param off        File offset.
+	 *
+	 * @returns Upon successful completion, the number of bytes
+	 * successfully read is returned. Upon failure, a negative error
+	 * code is returned instead.
+	 */
+	extern ssize_t vfs_pread(
+		int connection,
+		int fd,
+		void *buf,
+		size_t n,
+		off_t off
+	);
+
+	/**
+	 * @brief Writes data to a file at a given offset.
+	 *
+	 * @param connection Target connection.
+	 * @param fd         Target file descriptor.
+	 * @param buf        Target buffer.
+	 * @param n          Number of bytes to write.
+	 * @param off        File offset.
+	 *
+	 * @returns Upon successful completion, the number of bytes
+	 * successfully written is returned. Upon failure, a negative error
+	 * code is returned instead.
+	 */
+	extern ssize_t vfs_pwrite(
+		int connection,
+		int fd,
+		void *buf,
+		size_t n,
+		off_t off
+	);
+
+	/**
+	 * @brief Copies data between files.
+	 *
+	 * @param connection Target connection.
+	 * @param fd_in      Source file descriptor.
+	 * @param off_in     Source offset.
+	 * @param fd_out     Target file descriptor.
+	 * @param off_out    Target offset.
+	 * @param n          Number of bytes to copy.
+	 *
+	 * @returns Upon successful completion, the number of bytes
+	 * successfully copied is returned. Upon failure, a negative error
+	 * code is returned instead.
+	 */
+	extern ssize_t vfs_copy_range(
+		int connection,
+		int fd_in,
+		off_t off_in,
+		int fd_out,
+		off_t off_out,
+		size_t n
+	);
+
+	/**
+	 * @brief Gets the attributes of a file.
+	 *
+	 * @param connection Target connection.
+	 * @param filename   Name of the target file.
+	 * @param buf        Location to store the attributes.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int vfs_stat(
+		int connection,
+		const char *filename,
+		struct vfs_stat *buf
+	);
+
+	/**
+	 * @brief Gets the attributes of an opened file.
+	 *
+	 * @param connection Target connection.
+	 * @param fd         Target file descriptor.
+	 * @param buf        Location to store the attributes.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int vfs_fstat(int connection, int fd, struct vfs_stat *buf);
+
+	/**
+	 * @brief Reads entries of a directory.
+	 *
+	 * @param connection Target connection.
+	 * @param fd         Target file descriptor.
+	 * @param dirp       Location to store the entries.
+	 * @param n          Maximum number of entries to read.
+	 *
+	 * @returns Upon successful completion, the number of entries read
+	 * is returned. Upon failure, a negative error code is returned
+	 * instead.
+	 */
+	extern int vfs_getdents(
+		int connection,
+		int fd,
+		struct vfs_dirent *dirp,
+		int n
+	);
+
+	/**
+	 * @brief Grants a data lease on a file.
+	 *
+	 * @param connection Target connection.
+	 * @param fd         Target file descriptor.
+	 * @param version    Store location for data version of the file.
+	 *
+	 * @returns Upon successful completion, the type of the lease that
+	 * was granted is returned. Upon failure, a negative error code is
+	 * returned instead.
+	 */
+	extern int vfs_lease(int connection, int fd, unsigned *version);
+
+	/**
+	 * @brief Commits pending metadata updates.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int vfs_commit(void);
+
 #endif /* NANVIX_SERVERS_VFS_VFS_H_*/
@@ -0,0 +1,44 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/config.h>
+
+#ifdef __NANVIX_HAS_VFS_SERVER
+
+/**
+ * @brief Table of VFS Servers.
+ */
+struct vfs_servers_info
+{
+	int nodenum;
+	int portnum;
+	const char *name;
+} vfs_servers[VFS_SERVERS_NUM] = {
+	{ VFS_SERVER_0_NODE, VFS_SERVER_0_PORT_NUM, "/vfs0" },
+#if (VFS_SERVERS_NUM == 2)
+	{ VFS_SERVER_1_NODE, VFS_SERVER_1_PORT_NUM, "/vfs1" },
+#endif
+};
+
+#endif
@@ -26,6 +26,11 @@
 #define __NEED_FS_VFS_SERVER
 
 #include <nanvix/runtime/runtime.h>
+#include <nanvix/runtime/stdikc.h>
+#include <nanvix/sys/semaphore.h>
+#include <nanvix/sys/mailbox.h>
+#include <nanvix/sys/thread.h>
+#include <nanvix/sys/noc.h>
 #include <nanvix/fs.h>
 #include <nanvix/config.h>
 #include <nanvix/ulib.h>
@@ -34,18 +39,507 @@
 #ifdef __NANVIX_HAS_VFS_SERVER
 
 /**
- * @brief Connection to VFSem Server.
+ * @brief Connections to VFS Servers.
  */
 static struct
 {
-	int initialized; /**< Is the connection initialized? */
-	int outbox;      /**< Output mailbox for requests.   */
-	int outportal;   /**< Output portal for data.        */
+	int initialized; /**< Are connections initialized? */
+
+	/**
+	 * @brief Mount Table
+	 *
+	 * Server i is mounted at the name of server i, which is resolved
+	 * to a node through the name service. Paths that fall under no
+	 * mount point are served by the first server.
+	 */
+	struct
+	{
+		int nodenum; /**< Node of the server.        */
+		int channel; /**< Channel to the server.     */
+		int recall;  /**< Channel for recalled data. */
+	} conns[VFS_SERVERS_NUM];
 } server = {
 	.initialized = 0,
-	.outbox = -1
 };
 
+/**
+ * @name File Descriptors
+ *
+ * File descriptors handed out by server i are mapped to the i-th
+ * range of NANVIX_VFS_OPEN_MAX local file descriptors. Servers hand
+ * out the lowest-numbered free descriptor, thus a file descriptor that
+ * falls out of this range means that too many files are opened.
+ */
+/**@{*/
+#define VFS_FD_MAX          (VFS_SERVERS_NUM*NANVIX_VFS_OPEN_MAX)
+#define VFS_FD(srv, fd)     ((srv)*NANVIX_VFS_OPEN_MAX + (fd))
+#define VFS_FD_SERVER(fd)   ((fd)/NANVIX_VFS_OPEN_MAX)
+#define VFS_FD_REMOTE(fd)   ((fd)%NANVIX_VFS_OPEN_MAX)
+#define VFS_FD_IS_VALID(fd) (WITHIN((fd), 0, VFS_FD_MAX))
+/**@}*/
+
+#if (NANVIX_VFS_OPEN_MAX > NANVIX_OPEN_MAX)
+#error "NANVIX_VFS_OPEN_MAX should not be greater than NANVIX_OPEN_MAX"
+#endif
+
+/**
+ * @brief Gets the connection to the server of a file descriptor.
+ */
+#define VFS_CONN(fd) (&server.conns[VFS_FD_SERVER(fd)])
+
+/**
+ * @brief Client-side State of an Opened File
+ */
+static struct vfs_file
+{
+	int lease;        /**< Data lease held.              */
+	unsigned version; /**< Data version of cached pages. */
+	uint64_t expire;  /**< Lease expiration time.        */
+	off_t pos;        /**< Read/write pointer.           */
+	off_t srvpos;     /**< Read/write pointer at server. */
+} files[VFS_FD_MAX];
+
+/**
+ * @brief Page of the File Data Cache
+ */
+static struct vfs_page
+{
+	int fd;                          /**< File descriptor (-1 if free). */
+	off_t base;                      /**< Base offset in the file.      */
+	size_t len;                      /**< Number of valid bytes.        */
+	int dirty;                       /**< Dirty page?                   */
+	unsigned age;                    /**< Time of last access.          */
+	char data[NANVIX_FS_BLOCK_SIZE]; /**< Data.                         */
+} pages[NANVIX_VFS_CACHE_NR_PAGES];
+
+/**
+ * @brief Clock for page replacement.
+ */
+static unsigned pages_clock = 0;
+
+/**
+ * @brief Recall Daemon
+ *
+ * Servers recall leases through the input mailbox of this thread, so
+ * that leases get recalled even if the client is not talking to them.
+ */
+static struct
+{
+	kthread_t tid;                     /**< Thread ID.                 */
+	int port;                          /**< Port of the input mailbox. */
+	unsigned epoch;                    /**< Number of recalls served.  */
+	struct nanvix_semaphore ready;     /**< Is the daemon listening?   */
+	char buffer[NANVIX_FS_BLOCK_SIZE]; /**< Buffer for recalled data.  */
+} recall;
+
+/**
+ * @brief Lock for the client-side state.
+ *
+ * The lock is released while waiting for servers, so that the recall
+ * daemon may serve recalls that are issued on behalf of the request.
+ */
+static struct nanvix_semaphore client_lock;
+
+/**
+ * @brief Statistics of the file data cache.
+ */
+static struct vfs_cache_stats stats;
+/**
+ * @brief Computes the base offset of the page that contains @p x.
+ */
+#define VFS_PAGE_BASE(x) \
+	((x) & ~((off_t) (NANVIX_FS_BLOCK_SIZE - 1)))
+
+/* Forward definitions. */
+static int do_nanvix_vfs_close(int, int);
+static off_t do_nanvix_vfs_seek(int, off_t, int);
+static ssize_t do_nanvix_vfs_read(int, void *, size_t, off_t);
+static ssize_t do_nanvix_vfs_write(int, const void *, size_t, off_t);
+
+/*============================================================================*
+ * vfs_route()                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Finds out the server of a path.
+ *
+ * @param filename Target path.
+ * @param name     Store location for the path relative to the server.
+ *
+ * @returns The index of the server whose mount point covers @p
+ * filename.
+ */
+static int vfs_route(const char *filename, const char **name)
+{
+	size_t len;
+
+	for (int i = 1; i < VFS_SERVERS_NUM; i++)
+	{
+		len = ustrlen(vfs_servers[i].name);
+
+		/* Mount point. */
+		if (!ustrncmp(filename, vfs_servers[i].name, len) && (filename[len] == '/'))
+		{
+			*name = &filename[len + 1];
+			return (i);
+		}
+	}
+
+	*name = filename;
+
+	return (0);
+}
+
+/*============================================================================*
+ * vfs_lock()                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Locks the client-side state.
+ */
+static inline void vfs_lock(void)
+{
+	nanvix_semaphore_down(&client_lock);
+}
+
+/*============================================================================*
+ * vfs_unlock()                                                               *
+ *============================================================================*/
+
+/**
+ * @brief Unlocks the client-side state.
+ */
+static inline void vfs_unlock(void)
+{
+	nanvix_semaphore_up(&client_lock);
+}
+
+/*============================================================================*
+ * vfs_cache_invalidate()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Drops clean cached pages of a file.
+ *
+ * @param fd Target file descriptor.
+ *
+ * Dirty pages are left untouched, since they hold deferred writes.
+ */
+static void vfs_cache_invalidate(int fd)
+{
+	for (int i = 0; i < NANVIX_VFS_CACHE_NR_PAGES; i++)
+	{
+		if ((pages[i].fd == fd) && !pages[i].dirty)
+			pages[i].fd = -1;
+	}
+}
+
+/*============================================================================*
+ * vfs_lease_update()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Updates the data lease of a file.
+ *
+ * @param fd    Target file descriptor.
+ * @param msg   Reply from the server.
+ * @param epoch Recall epoch when the request was sent.
+ *
+ * The server piggybacks the lease, the current data version and the
+ * read/write pointer of the file on every successful reply. If the
+ * data version has changed since the last reply, cached pages are
+ * invalidated, unless a write lease was held all along, in which case
+ * the client itself is the only one that could have written to the
+ * file. A lease that comes along with a reply that raced with a recall
+ * may be stale, thus it is dropped.
+ */
+static void vfs_lease_update(int fd, const struct vfs_message *msg, unsigned epoch)
+{
+	uint64_t now;
+	struct vfs_file *f = &files[fd];
+	const int recalled = (epoch != recall.epoch);
+
+	/* Cached data is stale. */
+	if (msg->op.ret.version != f->version)
+	{
+		if (recalled || (f->lease != VFS_LEASE_WRITE))
+			vfs_cache_invalidate(fd);
+	}
+
+	/* Read/write pointer at server. */
+	if (msg->op.ret.offset >= 0)
+		f->srvpos = msg->op.ret.offset;
+
+	kclock(&now);
+	f->version = msg->op.ret.version;
+	f->lease = recalled ? VFS_LEASE_NONE : msg->op.ret.lease;
+	f->expire = now + NANVIX_VFS_LEASE_TIME;
+}
+
+/*============================================================================*
+ * vfs_lease_is_valid()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Asserts whether or not a lease of a file is valid.
+ *
+ * @param fd    Target file descriptor.
+ * @param lease Type of the lease.
+ *
+ * @returns Non-zero if a lease at least as strong as @p lease is held
+ * on the file and it has not expired, and zero otherwise.
+ */
+static int vfs_lease_is_valid(int fd, int lease)
+{
+	uint64_t now;
+
+	/* No lease. */
+	if (files[fd].lease < lease)
+		return (0);
+
+	kclock(&now);
+
+	return (now < files[fd].expire);
+}
+
+/*============================================================================*
+ * vfs_sync_pos()                                                             *
+ *============================================================================*/
+
+/**
+ * @brief Moves the read/write pointer of a file at the server.
+ *
+ * @param fd  Target file descriptor.
+ * @param pos Target position.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+static int vfs_sync_pos(int fd, off_t pos)
+{
+	off_t ret;
+
+	/* Nothing to do. */
+	if (files[fd].srvpos == pos)
+		return (0);
+
+	if ((ret = do_nanvix_vfs_seek(fd, pos, SEEK_SET)) < 0)
+		return (ret);
+
+	return (0);
+}
+
+/*============================================================================*
+ * vfs_page_flush()                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Writes back a cached page.
+ *
+ * @param pg Target page.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+static int vfs_page_flush(struct vfs_page *pg)
+{
+	ssize_t nwrite;
+
+	/* Nothing to do. */
+	if (!pg->dirty)
+		return (0);
+
+	/*
+	 * The page stays dirty while it is written back, so that
+	 * recalls that race with us write it back as well.
+	 */
+	if ((nwrite = do_nanvix_vfs_write(pg->fd, pg->data, pg->len, pg->base)) < 0)
+		return (nwrite);
+
+	pg->dirty = 0;
+	stats.nflushes++;
+
+	return (0);
+}
+
+/*============================================================================*
+ * vfs_cache_flush()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Writes back dirty cached pages of a file.
+ *
+ * @param fd Target file descriptor.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+static int vfs_cache_flush(int fd)
+{
+	int ret;
+
+	for (int i = 0; i < NANVIX_VFS_CACHE_NR_PAGES; i++)
+	{
+		/* Skip pages of other files. */
+		if (pages[i].fd != fd)
+			continue;
+
+		if ((ret = vfs_page_flush(&pages[i])) < 0)
+			return (ret);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * vfs_page_lookup()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Searches for a cached page.
+ *
+ * @param fd   Target file descriptor.
+ * @param base Base offset of the target page.
+ *
+ * @returns If the target page is cached, a pointer to it is returned.
+ * Otherwise, a NULL pointer is returned instead.
+ */
+static struct vfs_page *vfs_page_lookup(int fd, off_t base)
+{
+	for (int i = 0; i < NANVIX_VFS_CACHE_NR_PAGES; i++)
+	{
+		/* Found. */
+		if ((pages[i].fd == fd) && (pages[i].base == base))
+		{
+			pages[i].age = ++pages_clock;
+			return (&pages[i]);
+		}
+	}
+
+	return (NULL);
+}
+
+/*============================================================================*
+ * vfs_page_alloc()                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Allocates a page in the file data cache.
+ *
+ * @param pgp Store location for the allocated page.
+ *
+ * A free page is picked, if any. Otherwise, the least recently used
+ * page is evicted, and written back if it is dirty.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+static int vfs_page_alloc(struct vfs_page **pgp)
+{
+	int ret;
+	struct vfs_page *victim = NULL;
+
+	for (int i = 0; i < NANVIX_VFS_CACHE_NR_PAGES; i++)
+	{
+		/* Free page. */
+		if (pages[i].fd < 0)
+		{
+			victim = &pages[i];
+			break;
+		}
+
+		if ((victim == NULL) || (pages[i].age < victim->age))
+			victim = &pages[i];
+	}
+
+	/* Evict page. */
+	if ((victim->fd >= 0) && ((ret = vfs_page_flush(victim)) < 0))
+		return (ret);
+
+	victim->fd = -1;
+	victim->len = 0;
+	victim->dirty = 0;
+	*pgp = victim;
+
+	return (0);
+}
+
+/*============================================================================*
+ * vfs_page_fill()                                                            *
+ *============================================================================*/
+
+/**
+ * @brief Brings a page of a file to the file data cache.
+ *
+ * @param fd   Target file descriptor.
+ * @param base Base offset of the target page.
+ * @param pgp  Store location for the target page.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+static int vfs_page_fill(int fd, off_t base, struct vfs_page **pgp)
+{
+	int ret;
+	ssize_t nread;
+	struct vfs_page *pg;
+
+	if ((ret = vfs_page_alloc(&pg)) < 0)
+		return (ret);
+
+	if ((nread = do_nanvix_vfs_read(fd, pg->data, NANVIX_FS_BLOCK_SIZE, base)) < 0)
+		return (nread);
+
+	/* Zero hole beyond end of file. */
+	umemset(&pg->data[nread], 0, NANVIX_FS_BLOCK_SIZE - nread);
+
+	pg->fd = fd;
+	pg->base = base;
+	pg->len = nread;
+	pg->age = ++pages_clock;
+	*pgp = pg;
+
+	return (0);
+}
+
+/*============================================================================*
+ * vfs_lease_check()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Checks the data lease of a file.
+ *
+ * @param fd Target file descriptor.
+ *
+ * If the lease on the file has expired, deferred writes are written
+ * back and a new lease is requested to the server.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+static int vfs_lease_check(int fd)
+{
+	int ret;
+
+	/* Nothing to do. */
+	if (vfs_lease_is_valid(fd, VFS_LEASE_WRITE))
+		return (0);
+
+	/* Write back deferred data. */
+	if ((ret = vfs_cache_flush(fd)) < 0)
+		return (ret);
+
+	/* Nothing to renew. */
+	if ((files[fd].lease == VFS_LEASE_NONE) || vfs_lease_is_valid(fd, VFS_LEASE_READ))
+		return (0);
+
+	/* Renew lease. */
+	if ((ret = do_nanvix_vfs_seek(fd, files[fd].pos, SEEK_SET)) < 0)
+		return (ret);
+
+	return (0);
+}
+
 /*============================================================================*
  * nanvix_vfs_open()                                                          *
  *============================================================================*/
@@ -61,35 +555,63 @@ static struct
  */
 static int do_nanvix_vfs_open(const char *filename, int oflag)
 {
+	int fd;
+	int srv;
+	unsigned epoch;
+	const char *name;
 	struct vfs_message msg;
 
+	srv = vfs_route(filename, &name);
+
 	/* Build message.*/
 	message_header_build(&msg.header, VFS_OPEN);
-	ustrncpy(msg.op.open.filename, filename, NANVIX_NAME_MAX);
+	ustrncpy(msg.op.open.filename, name, NANVIX_NAME_MAX);
 	msg.op.open.oflag = oflag;
+	msg.op.open.recall = recall.port;
+
+	epoch = recall.epoch;
+	vfs_unlock();
 
 	/* Send operation. */
 	uassert(
-		nanvix_mailbox_write(
-			server.outbox,
-			&msg, sizeof(struct vfs_message)
+		nanvix_channel_send(
+			server.conns[srv].channel,
+			&msg,
+			sizeof(struct vfs_message)
 		) == 0
 	);
 
 	/* Receive reply. */
 	uassert(
-		kmailbox_read(
-			stdinbox_get(),
+		nanvix_channel_recv(
+			server.conns[srv].channel,
 			&msg,
 			sizeof(struct vfs_message)
-		) == sizeof(struct vfs_message)
+		) == 0
 	);
 
+	vfs_lock();
+
 	/* Operation failed. */
 	if (msg.header.opcode == VFS_FAIL)
 		return (msg.op.ret.status);
 
-	return (msg.op.ret.fd);
+	/* Too many opened files. */
+	if (!WITHIN(msg.op.ret.fd, 0, NANVIX_VFS_OPEN_MAX))
+	{
+		do_nanvix_vfs_close(srv, msg.op.ret.fd);
+		return (-EMFILE);
+	}
+
+	fd = VFS_FD(srv, msg.op.ret.fd);
+
+	/* Initialize client-side state. */
+	files[fd].pos = 0;
+	files[fd].lease = VFS_LEASE_NONE;
+	files[fd].version = msg.op.ret.version;
+	vfs_lease_update(fd, &msg, epoch);
+
+	return (fd);
 }
 
 /**
@@ -99,6 +621,8 @@ static int do_nanvix_vfs_open(const char *filename, int oflag)
  */
 int nanvix_vfs_open(const char *filename, int oflag)
 {
+	int ret;
+
 	/* Invalid server ID. */
 	if (!server.initialized)
 		return (-EAGAIN);
@@ -115,7 +639,11 @@ int nanvix_vfs_open(const char *filename, int oflag)
 	if (!ACCMODE_RDONLY(oflag) && !ACCMODE_WRONLY(oflag) && !ACCMODE_RDWR(oflag))
 		return (-EINVAL);
 
-	return (do_nanvix_vfs_open(filename, oflag));
+	vfs_lock();
+		ret = do_nanvix_vfs_open(filename, oflag);
+	vfs_unlock();
+
+	return (ret);
 }
 
 /*============================================================================*
@@ -124,11 +652,11 @@ int nanvix_vfs_open(const char *filename, int oflag)
 
 /**
  * The do_nanvix_vfs_close() function closes the file referred by the
- * file descriptor @p fd.
+ * file descriptor @p fd of the server @p srv.
  *
  * @author Pedro Henrique Penna
  */
-static int do_nanvix_vfs_close(int fd)
+static int do_nanvix_vfs_close(int srv, int fd)
 {
 	struct vfs_message msg;
 
@@ -136,150 +664,1658 @@ static int do_nanvix_vfs_close(int fd)
 	message_header_build(&msg.header, VFS_CLOSE);
 	msg.op.close.fd = fd;
 
+	vfs_unlock();
+
 	/* Send operation. */
 	uassert(
-		nanvix_mailbox_write(
-			server.outbox,
-			&msg, sizeof(struct vfs_message)
+		nanvix_channel_send(
+			server.conns[srv].channel,
+			&msg,
+			sizeof(struct vfs_message)
 		) == 0
 	);
 
-	/* Receive reply. */
-	uassert(
-		kmailbox_read(
-			stdinbox_get(),
-			&msg,
-			sizeof(struct vfs_message)
-		) == sizeof(struct vfs_message)
-	);
+	/* Receive reply. */
+	uassert(
+		nanvix_channel_recv(
+			server.conns[srv].channel,
+			&msg,
+			sizeof(struct vfs_message)
+		) == 0
+	);
+
+	vfs_lock();
+
+	/* Operation failed. */
+	if (msg.header.opcode == VFS_FAIL)
+		return (msg.op.ret.status);
+
+	return (0);
+}
+
+/**
+ * @see do_nanvix_vfs_close().
+ *
+ * @author Pedro Henrique Penna
+ */
+int nanvix_vfs_close(int fd)
+{
+	int ret;
+
+	/* Invalid server ID. */
+	if (!server.initialized)
+		return (-EAGAIN);
+
+	/* Invalid file descriptor. */
+	if (!VFS_FD_IS_VALID(fd))
+		return (-EINVAL);
+
+	vfs_lock();
+
+		/* Write back deferred data. */
+		if ((ret = vfs_cache_flush(fd)) == 0)
+		{
+			vfs_cache_invalidate(fd);
+			files[fd].lease = VFS_LEASE_NONE;
+
+			ret = do_nanvix_vfs_close(VFS_FD_SERVER(fd), VFS_FD_REMOTE(fd));
+		}
+
+	vfs_unlock();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * nanvix_vfs_seek()                                                          *
+ *============================================================================*/
+
+/**
+ * The do_nanvix_vfs_seek() function repositions the read/write pointer
+ * of the file referred by the file descriptor @p fd. The new position
+ * for the read/write pointer is computed according to the value of @p
+ * whence:
+ *
+ * - SEEK_SET sets the read/write pointer is set to @p offset.
+ * - SEEK_CUR increases the read/write pointer by @p offset.
+ * - SEEK_END sets the read/write pointer to the end of the file plus @p offset
+ *
+ * @author Pedro Henrique Penna
+ */
+static off_t do_nanvix_vfs_seek(int fd, off_t offset, int whence)
+{
+	unsigned epoch;
+	struct vfs_message msg;
+
+	/* Build message.*/
+	message_header_build(&msg.header, VFS_SEEK);
+	msg.op.seek.fd = VFS_FD_REMOTE(fd);
+	msg.op.seek.offset = offset;
+	msg.op.seek.whence = whence;
+
+	epoch = recall.epoch;
+	vfs_unlock();
+
+	/* Send operation. */
+	uassert(
+		nanvix_channel_send(
+			VFS_CONN(fd)->channel,
+			&msg,
+			sizeof(struct vfs_message)
+		) == 0
+	);
+
+	/* Receive reply. */
+	uassert(
+		nanvix_channel_recv(
+			VFS_CONN(fd)->channel,
+			&msg,
+			sizeof(struct vfs_message)
+		) == 0
+	);
+
+	vfs_lock();
+
+	/* Operation failed. */
+	if (msg.header.opcode == VFS_FAIL)
+		return (msg.op.ret.status);
+
+	vfs_lease_update(fd, &msg, epoch);
+
+	return (msg.op.ret.offset);
+}
+
+/**
+ * @brief Repositions the read/write pointer of a file.
+ *
+ * @param fd     Target file descriptor.
+ * @param offset Offset for read/write pointer.
+ * @param whence Reposition base location.
+ *
+ * @returns Upon successful completion, the resulting offset is
+ * returned. Upon failure, a negative error code is returned instead.
+ *
+ * @note The client-side state should be locked.
+ */
+static off_t vfs_seek(int fd, off_t offset, int whence)
+{
+	off_t ret;
+
+	if ((ret = vfs_lease_check(fd)) < 0)
+		return (ret);
+
+	/* Reposition locally. */
+	if (vfs_lease_is_valid(fd, VFS_LEASE_READ) && (whence != SEEK_END))
+	{
+		ret = (whence == SEEK_SET) ? offset : files[fd].pos + offset;
+
+		/* Invalid offset. */
+		if (ret < 0)
+			return (-EINVAL);
+
+		return (files[fd].pos = ret);
+	}
+
+	/* Server must see deferred writes. */
+	if ((ret = vfs_cache_flush(fd)) < 0)
+		return (ret);
+
+	/* Server is not aware of local reads. */
+	if (whence == SEEK_CUR)
+	{
+		offset += files[fd].pos;
+		whence = SEEK_SET;
+	}
+
+	if ((ret = do_nanvix_vfs_seek(fd, offset, whence)) < 0)
+		return (ret);
+
+	return (files[fd].pos = ret);
+}
+
+/**
+ * @see do_nanvix_vfs_seek().
+ *
+ * @author Pedro Henrique Penna
+ */
+off_t nanvix_vfs_seek(int fd, off_t offset, int whence)
+{
+	off_t ret;
+
+	/* Invalid server ID. */
+	if (!server.initialized)
+		return (-EAGAIN);
+
+	/* Invalid file descriptor. */
+	if (!VFS_FD_IS_VALID(fd))
+		return (-EINVAL);
+
+	/* Invalid whence. */
+	if ((whence != SEEK_SET) && (whence != SEEK_CUR) && (whence != SEEK_END))
+		return (-EINVAL);
+
+	vfs_lock();
+		ret = vfs_seek(fd, offset, whence);
+	vfs_unlock();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * nanvix_vfs_read()                                                          *
+ *============================================================================*/
+
+/**
+ * The do_nanvix_vfs_read() function reads @p n bytes from the file
+ * referred by the file descriptor @p fd into the buffer pointed to by
+ * @p buf. If @p off is not negative, data is read from that offset and
+ * the read/write pointer of the file is left untouched. Otherwise, data
+ * is read from the read/write pointer of the file.
+ *
+ * @author Pedro Henrique Penna
+ *
+ * @todo TODO: tile data transfers
+ */
+static ssize_t do_nanvix_vfs_read(int fd, void *buf, size_t n, off_t off)
+{
+	unsigned epoch;
+	struct vfs_message msg;
+
+	/* Nothing to do. */
+	if (n == 0)
+		return (0);
+
+	/* Build message.*/
+	message_header_build(&msg.header, (off < 0) ? VFS_READ : VFS_PREAD);
+	msg.op.read.fd = VFS_FD_REMOTE(fd);
+	msg.op.read.n = n;
+	msg.op.read.offset = off;
+
+	epoch = recall.epoch;
+	vfs_unlock();
+
+	/* Send operation header. */
+	uassert(
+		nanvix_channel_send(
+			VFS_CONN(fd)->channel,
+			&msg,
+			sizeof(struct vfs_message)
+		) == 0
+	);
+
+	/* Wait acknowledge. */
+	uassert(
+		nanvix_channel_recv(
+			VFS_CONN(fd)->channel,
+			&msg,
+			sizeof(struct vfs_message)
+		) == 0
+	);
+	uassert(msg.header.opcode == VFS_ACK);
+
+	/* Receive data. */
+	uassert(
+		nanvix_channel_read(
+			VFS_CONN(fd)->channel,
+			buf,
+			n,
+			msg.header.portal_port
+		) >= 0
+	);
+
+	/* Receive reply. */
+	uassert(
+		nanvix_channel_recv(
+			VFS_CONN(fd)->channel,
+			&msg,
+			sizeof(struct vfs_message)
+		) == 0
+	);
+
+	vfs_lock();
+
+	/* Operation failed. */
+	if (msg.header.opcode == VFS_FAIL)
+		return (msg.op.ret.status);
+
+	vfs_lease_update(fd, &msg, epoch);
+
+	return (msg.op.ret.count);
+}
+
+/*============================================================================*
+ * vfs_cached_read()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Reads data from the file data cache.
+ *
+ * @param fd  Target file descriptor.
+ * @param buf Target buffer.
+ * @param n   Number of bytes to read.
+ * @param pos Offset in the file.
+ *
+ * At most one page is read, starting from offset @p pos of the file.
+ * Missing pages are brought from the server. The read/write pointer of
+ * the file is left untouched, since the client-side state may be
+ * unlocked while a page is brought in.
+ *
+ * @returns Upon successful completion, the number of bytes read is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+static ssize_t vfs_cached_read(int fd, char *buf, size_t n, off_t pos)
+{
+	int ret;
+	off_t off;
+	size_t count;
+	off_t base;
+	struct vfs_page *pg;
+
+	base = VFS_PAGE_BASE(pos);
+
+	/* Cache miss. */
+	if ((pg = vfs_page_lookup(fd, base)) == NULL)
+	{
+		stats.nmisses++;
+		if ((ret = vfs_page_fill(fd, base, &pg)) < 0)
+			return (ret);
+	}
+	else
+		stats.nhits++;
+
+	off = pos - base;
+
+	/* End of file. */
+	if (off >= (off_t) pg->len)
+		return (0);
+
+	count = ((pg->len - (size_t) off) < n) ? (pg->len - (size_t) off) : n;
+	umemcpy(buf, &pg->data[off], count);
+
+	return (count);
+}
+
+/*============================================================================*
+ * vfs_direct_read()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Reads data from a file bypassing the file data cache.
+ *
+ * @param fd  Target file descriptor.
+ * @param buf Target buffer.
+ * @param n   Number of bytes to read.
+ *
+ * @returns Upon successful completion, the number of bytes read is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+static ssize_t vfs_direct_read(int fd, char *buf, size_t n)
+{
+	int ret;
+	ssize_t nread;
+
+	if ((ret = vfs_sync_pos(fd, files[fd].pos)) < 0)
+		return (ret);
+
+	if ((nread = do_nanvix_vfs_read(fd, buf, n, -1)) < 0)
+		return (nread);
+
+	files[fd].pos = files[fd].srvpos;
+
+	return (nread);
+}
+
+/**
+ * @brief Reads data from a file.
+ *
+ * @param fd  Target file descriptor.
+ * @param buf Target buffer.
+ * @param n   Number of bytes to read.
+ *
+ * @returns Upon successful completion, the number of bytes read is
+ * returned. Upon failure, a negative error code is returned instead.
+ *
+ * @note The client-side state should be locked.
+ */
+static ssize_t vfs_read(int fd, void *buf, size_t n)
+{
+	int ret;
+	ssize_t nread; /* Bytes Read             */
+	char *pbase;   /* Base Address of Buffer */
+	char *pend;    /* End Address of Buffer  */
+
+	if ((ret = vfs_lease_check(fd)) < 0)
+		return (ret);
+
+	/* Read in chunks. */
+	pbase = buf; pend = ((char *) buf) + n;
+	for (char *p = pbase; p < pend; p += nread)
+	{
+		size_t count;
+
+		count = ((pend - p) < NANVIX_FS_BLOCK_SIZE) ?
+			(size_t)(pend - p) : NANVIX_FS_BLOCK_SIZE;
+
+		/* Serve from local cache. */
+		if (vfs_lease_is_valid(fd, VFS_LEASE_READ))
+		{
+			if ((nread = vfs_cached_read(fd, p, count, files[fd].pos)) > 0)
+				files[fd].pos += nread;
+		}
+		else
+			nread = vfs_direct_read(fd, p, count);
+
+		if (nread < 0)
+			return (nread);
+
+		/* End of file. */
+		if (nread == 0)
+			return ((size_t)(p - pbase));
+	}
+
+	return ((size_t)(pend - pbase));
+}
+
+/**
+ * @see do_nanvix_vfs_read().
+ *
+ * @author Pedro Henrique Penna
+ */
+ssize_t nanvix_vfs_read(int fd, void *buf, size_t n)
+{
+	ssize_t ret;
+
+	/* Invalid server ID. */
+	if (!server.initialized)
+		return (-EAGAIN);
+
+	/* Invalid file descriptor. */
+	if (!VFS_FD_IS_VALID(fd))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	/* Invalid read size. */
+	if (n > NANVIX_MAX_FILE_SIZE)
+		return (-EFBIG);
+
+	vfs_lock();
+		ret = vfs_read(fd, buf, n);
+	vfs_unlock();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * nanvix_vfs_write()                                                         *
+ *============================================================================*/
+
+/**
+ * The do_nanvix_vfs_write() function writes @p n bytes from the buffer
+ * pointed to by @p buf to the filereferred by the file descriptor @p
+ * fd. If @p off is not negative, data is written at that offset and the
+ * read/write pointer of the file is left untouched. Otherwise, data is
+ * written at the read/write pointer of the file.
+ *
+ * @author Pedro Henrique Penna
+ *
+ * @todo TODO: tile data transfers
+ */
+static ssize_t do_nanvix_vfs_write(int fd, const void *buf, size_t n, off_t off)
+{
+	unsigned epoch;
+	struct vfs_message msg;
+
+	/* Nothing to do. */
+	if (n == 0)
+		return (0);
+
+	/* Build message.*/
+	message_header_build2(
+		&msg.header,
+		(off < 0) ? VFS_WRITE : VFS_PWRITE,
+		nanvix_channel_get_port(VFS_CONN(fd)->channel)
+	);
+	msg.op.write.fd = VFS_FD_REMOTE(fd);
+	msg.op.write.n = n;
+	msg.op.write.offset = off;
+
+	epoch = recall.epoch;
+	vfs_unlock();
+
+	/* Send operation header. */
+	uassert(
+		nanvix_channel_send(
+			VFS_CONN(fd)->channel,
+			&msg,
+			sizeof(struct vfs_message)
+		) == 0
+	);
+
+	/* Send data. */
+	uassert(
+		nanvix_channel_write(
+			VFS_CONN(fd)->channel,
+			buf,
+			n
+		) >= 0
+	);
+
+	/* Receive reply. */
+	uassert(
+		nanvix_channel_recv(
+			VFS_CONN(fd)->channel,
+			&msg,
+			sizeof(struct vfs_message)
+		) == 0
+	);
+
+	vfs_lock();
+
+	/* Operation failed. */
+	if (msg.header.opcode == VFS_FAIL)
+		return (msg.op.ret.status);
+
+	vfs_lease_update(fd, &msg, epoch);
+
+	return (msg.op.ret.count);
+}
+
+/*============================================================================*
+ * vfs_cached_write()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Writes data to the file data cache.
+ *
+ * @param fd  Target file descriptor.
+ * @param buf Target buffer.
+ * @param n   Number of bytes to write.
+ * @param pos Offset in the file.
+ *
+ * At most one page is written, starting from offset @p pos of the
+ * file. The page is written back to the server later, either when it
+ * is evicted, or when the lease on the file ends. The read/write
+ * pointer of the file is left untouched.
+ *
+ * @returns Upon successful completion, the number of bytes written is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+static ssize_t vfs_cached_write(int fd, const char *buf, size_t n, off_t pos)
+{
+	int ret;
+	off_t off;
+	off_t base;
+	size_t count;
+	struct vfs_page *pg;
+
+	base = VFS_PAGE_BASE(pos);
+	off = pos - base;
+	count = ((size_t)(NANVIX_FS_BLOCK_SIZE - off) < n) ?
+		(size_t)(NANVIX_FS_BLOCK_SIZE - off) : n;
+
+	/* Cache miss. */
+	if ((pg = vfs_page_lookup(fd, base)) == NULL)
+	{
+		/* Whole page is overwritten. */
+		if (count == NANVIX_FS_BLOCK_SIZE)
+		{
+			if ((ret = vfs_page_alloc(&pg)) < 0)
+				return (ret);
+
+			pg->fd = fd;
+			pg->base = base;
+			pg->age = ++pages_clock;
+		}
+
+		/* Read-modify-write. */
+		else if ((ret = vfs_page_fill(fd, base, &pg)) < 0)
+			return (ret);
+	}
+
+	umemcpy(&pg->data[off], buf, count);
+	if (((size_t) off + count) > pg->len)
+		pg->len = (size_t) off + count;
+	pg->dirty = 1;
+
+	return (count);
+}
+
+/*============================================================================*
+ * vfs_page_drop()                                                            *
+ *============================================================================*/
+
+/**
+ * @brief Drops cached pages overwritten by a direct write.
+ *
+ * @param fd  Target file descriptor.
+ * @param off Offset of the write.
+ * @param n   Number of bytes written.
+ *
+ * Writes never span more than one block, thus at most two pages are
+ * dropped.
+ */
+static void vfs_page_drop(int fd, off_t off, size_t n)
+{
+	struct vfs_page *pg;
+
+	if ((pg = vfs_page_lookup(fd, VFS_PAGE_BASE(off))) != NULL)
+		pg->fd = -1;
+	if ((pg = vfs_page_lookup(fd, VFS_PAGE_BASE(off + (off_t) n - 1))) != NULL)
+		pg->fd = -1;
+}
+
+/*============================================================================*
+ * vfs_direct_write()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Writes data to a file bypassing the file data cache.
+ *
+ * @param fd  Target file descriptor.
+ * @param buf Target buffer.
+ * @param n   Number of bytes to write.
+ *
+ * @returns Upon successful completion, the number of bytes written is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+static ssize_t vfs_direct_write(int fd, const char *buf, size_t n)
+{
+	int ret;
+	off_t pos;
+	ssize_t nwrite;
+
+	if ((ret = vfs_sync_pos(fd, pos = files[fd].pos)) < 0)
+		return (ret);
+
+	if ((nwrite = do_nanvix_vfs_write(fd, buf, n, -1)) < 0)
+		return (nwrite);
+
+	vfs_page_drop(fd, pos, n);
+
+	files[fd].pos = files[fd].srvpos;
+
+	return (nwrite);
+}
+
+/**
+ * @brief Writes data to a file.
+ *
+ * @param fd  Target file descriptor.
+ * @param buf Source buffer.
+ * @param n   Number of bytes to write.
+ *
+ * @returns Upon successful completion, the number of bytes written is
+ * returned. Upon failure, a negative error code is returned instead.
+ *
+ * @note The client-side state should be locked.
+ */
+static ssize_t vfs_write(int fd, const void *buf, size_t n)
+{
+	int ret;
+	ssize_t nwrite;    /* Bytes Written          */
+	const char *pbase; /* Base Address of Buffer */
+	const char *pend;  /* End Address of Buffer  */
+
+	if ((ret = vfs_lease_check(fd)) < 0)
+		return (ret);
+
+	/* Write in chunks. */
+	pbase = buf; pend = ((char *) buf) + n;
+	for (const char *p = pbase; p < pend; p += nwrite)
+	{
+		size_t count;
+
+		count = ((pend - p) < NANVIX_FS_BLOCK_SIZE) ?
+			(size_t)(pend - p) : NANVIX_FS_BLOCK_SIZE;
+
+		/* Defer write. */
+		if (vfs_lease_is_valid(fd, VFS_LEASE_WRITE))
+		{
+			if ((nwrite = vfs_cached_write(fd, p, count, files[fd].pos)) > 0)
+				files[fd].pos += nwrite;
+		}
+		else
+			nwrite = vfs_direct_write(fd, p, count);
+
+		if (nwrite < 0)
+			return (nwrite);
+
+		/* Device is full. */
+		if (nwrite == 0)
+			return ((size_t)(p - pbase));
+	}
+
+	/* Lease was lost on the way. */
+	if (!vfs_lease_is_valid(fd, VFS_LEASE_WRITE))
+	{
+		if ((ret = vfs_cache_flush(fd)) < 0)
+			return (ret);
+	}
+
+	return ((size_t)(pend - pbase));
+}
+
+/**
+ * @see do_nanvix_vfs_write().
+ *
+ * @author Pedro Henrique Penna
+ */
+ssize_t nanvix_vfs_write(int fd, const void *buf, size_t n)
+{
+	ssize_t ret;
+
+	/* Invalid server ID. */
+	if (!server.initialized)
+		return (-EAGAIN);
+
+	/* Invalid file descriptor. */
+	if (!VFS_FD_IS_VALID(fd))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	/* Invalid write size. */
+	if (n > NANVIX_MAX_FILE_SIZE)
+		return (-EFBIG);
+
+	vfs_lock();
+		ret = vfs_write(fd, buf, n);
+	vfs_unlock();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * nanvix_vfs_pread()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Reads data from a file at a given offset.
+ *
+ * @param fd  Target file descriptor.
+ * @param buf Target buffer.
+ * @param n   Number of bytes to read.
+ * @param off Offset in the file.
+ *
+ * @returns Upon successful completion, the number of bytes read is
+ * returned. Upon failure, a negative error code is returned instead.
+ *
+ * @note The client-side state should be locked.
+ */
+static ssize_t vfs_pread(int fd, void *buf, size_t n, off_t off)
+{
+	int ret;
+	ssize_t nread; /* Bytes Read             */
+	char *pbase;   /* Base Address of Buffer */
+	char *pend;    /* End Address of Buffer  */
+
+	if ((ret = vfs_lease_check(fd)) < 0)
+		return (ret);
+
+	/* Read in chunks. */
+	pbase = buf; pend = ((char *) buf) + n;
+	for (char *p = pbase; p < pend; p += nread)
+	{
+		size_t count;
+
+		count = ((pend - p) < NANVIX_FS_BLOCK_SIZE) ?
+			(size_t)(pend - p) : NANVIX_FS_BLOCK_SIZE;
+
+		/* Serve from local cache. */
+		if (vfs_lease_is_valid(fd, VFS_LEASE_READ))
+			nread = vfs_cached_read(fd, p, count, off + (p - pbase));
+		else
+			nread = do_nanvix_vfs_read(fd, p, count, off + (p - pbase));
+
+		if (nread < 0)
+			return (nread);
+
+		/* End of file. */
+		if (nread == 0)
+			return ((size_t)(p - pbase));
+	}
+
+	return ((size_t)(pend - pbase));
+}
+
+/**
+ * The nanvix_vfs_pread() function reads @p n bytes from the file
+ * referred by the file descriptor @p fd, at offset @p off, into the
+ * buffer pointed to by @p buf. The read/write pointer of the file is
+ * left untouched, thus no seek request is issued to the server.
+ */
+ssize_t nanvix_vfs_pread(int fd, void *buf, size_t n, off_t off)
+{
+	ssize_t ret;
+
+	/* Invalid server ID. */
+	if (!server.initialized)
+		return (-EAGAIN);
+
+	/* Invalid file descriptor. */
+	if (!VFS_FD_IS_VALID(fd))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	/* Invalid offset. */
+	if (off < 0)
+		return (-EINVAL);
+
+	/* Invalid read size. */
+	if (n > NANVIX_MAX_FILE_SIZE)
+		return (-EFBIG);
+
+	vfs_lock();
+		ret = vfs_pread(fd, buf, n, off);
+	vfs_unlock();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * nanvix_vfs_pwrite()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Writes data to a file at a given offset.
+ *
+ * @param fd  Target file descriptor.
+ * @param buf Source buffer.
+ * @param n   Number of bytes to write.
+ * @param off Offset in the file.
+ *
+ * @returns Upon successful completion, the number of bytes written is
+ * returned. Upon failure, a negative error code is returned instead.
+ *
+ * @note The client-side state should be locked.
+ */
+static ssize_t vfs_pwrite(int fd, const void *buf, size_t n, off_t off)
+{
+	int ret;
+	ssize_t nwrite;    /* Bytes Written          */
+	const char *pbase; /* Base Address of Buffer */
+	const char *pend;  /* End Address of Buffer  */
+
+	if ((ret = vfs_lease_check(fd)) < 0)
+		return (ret);
+
+	/* Write in chunks. */
+	pbase = buf; pend = ((char *) buf) + n;
+	for (const char *p = pbase; p < pend; p += nwrite)
+	{
+		size_t count;
+
+		count = ((pend - p) < NANVIX_FS_BLOCK_SIZE) ?
+			(size_t)(pend - p) : NANVIX_FS_BLOCK_SIZE;
+
+		/* Defer write. */
+		if (vfs_lease_is_valid(fd, VFS_LEASE_WRITE))
+			nwrite = vfs_cached_write(fd, p, count, off + (p - pbase));
+		else
+		{
+			nwrite = do_nanvix_vfs_write(fd, p, count, off + (p - pbase));
+			if (nwrite > 0)
+				vfs_page_drop(fd, off + (p - pbase), count);
+		}
+
+		if (nwrite < 0)
+			return (nwrite);
+
+		/* Device is full. */
+		if (nwrite == 0)
+			return ((size_t)(p - pbase));
+	}
+
+	/* Lease was lost on the way. */
+	if (!vfs_lease_is_valid(fd, VFS_LEASE_WRITE))
+	{
+		if ((ret = vfs_cache_flush(fd)) < 0)
+			return (ret);
+	}
+
+	return ((size_t)(pend - pbase));
+}
+
+/**
+ * The nanvix_vfs_pwrite() function writes @p n bytes from the buffer
+ * pointed to by @p buf to the file referred by the file descriptor @p
+ * fd, at offset @p off. The read/write pointer of the file is left
+ * untouched, thus no seek request is issued to the server.
+ */
+ssize_t nanvix_vfs_pwrite(int fd, const void *buf, size_t n, off_t off)
+{
+	ssize_t ret;
+
+	/* Invalid server ID. */
+	if (!server.initialized)
+		return (-EAGAIN);
+
+	/* Invalid file descriptor. */
+	if (!VFS_FD_IS_VALID(fd))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	/* Invalid offset. */
+	if (off < 0)
+		return (-EINVAL);
+
+	/* Invalid write size. */
+	if (n > NANVIX_MAX_FILE_SIZE)
+		return (-EFBIG);
+
+	vfs_lock();
+		ret = vfs_pwrite(fd, buf, n, off);
+	vfs_unlock();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * nanvix_vfs_readv()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Vectored I/O
+ *
+ * Data is coalesced in a single staging buffer, thus vectored I/O is
+ * carried out one request at a time. The lock of the client-side state
+ * cannot be used for this purpose, because it is taken by the read and
+ * write calls that transfer the staged data.
+ */
+static struct
+{
+	struct nanvix_semaphore lock;      /**< Lock.           */
+	char buffer[NANVIX_FS_BLOCK_SIZE]; /**< Staging Buffer. */
+} vectored;
+
+/**
+ * @brief Checks a vector of I/O vectors.
+ *
+ * @param iov    Target I/O vectors.
+ * @param iovcnt Number of I/O vectors.
+ *
+ * @returns If @p iov is valid, the total number of bytes that it spans
+ * is returned. Otherwise, a negative error code is returned instead.
+ */
+static ssize_t vfs_iov_check(const struct nanvix_iovec *iov, int iovcnt)
+{
+	size_t total = 0;
+
+	/* Invalid I/O vectors. */
+	if (iov == NULL)
+		return (-EINVAL);
+
+	/* Invalid number of I/O vectors. */
+	if ((iovcnt <= 0) || (iovcnt > NANVIX_VFS_IOV_MAX))
+		return (-EINVAL);
+
+	for (int i = 0; i < iovcnt; i++)
+	{
+		/* Invalid buffer. */
+		if ((iov[i].iov_base == NULL) && (iov[i].iov_len > 0))
+			return (-EINVAL);
+
+		total += iov[i].iov_len;
+
+		/* Invalid size. */
+		if (total > NANVIX_MAX_FILE_SIZE)
+			return (-EFBIG);
+	}
+
+	return (total);
+}
+
+/**
+ * The nanvix_vfs_readv() function reads data from the file referred by
+ * the file descriptor @p fd into the @p iovcnt buffers described by @p
+ * iov. Small buffers are coalesced, so that a single data transfer is
+ * issued for up to NANVIX_FS_BLOCK_SIZE bytes.
+ */
+ssize_t nanvix_vfs_readv(int fd, const struct nanvix_iovec *iov, int iovcnt)
+{
+	ssize_t ret;
+	size_t total;      /* Bytes to Read.               */
+	size_t done = 0;   /* Bytes Read.                  */
+	int i = 0;         /* Current I/O vector.          */
+	size_t iovoff = 0; /* Offset in current I/O vector. */
+
+	if ((ret = vfs_iov_check(iov, iovcnt)) < 0)
+		return (ret);
+
+	total = ret;
+
+	nanvix_semaphore_down(&vectored.lock);
+
+		while (done < total)
+		{
+			size_t count;
+			size_t staged;
+
+			count = ((total - done) < NANVIX_FS_BLOCK_SIZE) ?
+				(total - done) : NANVIX_FS_BLOCK_SIZE;
+
+			if ((ret = nanvix_vfs_read(fd, vectored.buffer, count)) < 0)
+				break;
+
+			/* Scatter. */
+			for (staged = 0; staged < (size_t) ret; /* noop */)
+			{
+				size_t len;
+
+				len = iov[i].iov_len - iovoff;
+				if (len > ((size_t) ret - staged))
+					len = (size_t) ret - staged;
+
+				umemcpy((char *) iov[i].iov_base + iovoff, &vectored.buffer[staged], len);
+				staged += len;
+
+				/* Move to next I/O vector. */
+				if ((iovoff += len) == iov[i].iov_len)
+				{
+					i++;
+					iovoff = 0;
+				}
+			}
+
+			done += ret;
+
+			/* End of file. */
+			if ((size_t) ret < count)
+				break;
+		}
+
+	nanvix_semaphore_up(&vectored.lock);
+
+	/* Report data that was read before the failure. */
+	if ((ret < 0) && (done == 0))
+		return (ret);
+
+	return (done);
+}
+
+/*============================================================================*
+ * nanvix_vfs_writev()                                                        *
+ *============================================================================*/
+
+/**
+ * The nanvix_vfs_writev() function writes data from the @p iovcnt
+ * buffers described by @p iov to the file referred by the file
+ * descriptor @p fd. Small buffers are coalesced, so that a single data
+ * transfer is issued for up to NANVIX_FS_BLOCK_SIZE bytes.
+ */
+ssize_t nanvix_vfs_writev(int fd, const struct nanvix_iovec *iov, int iovcnt)
+{
+	ssize_t ret;
+	size_t total;      /* Bytes to Write.              */
+	size_t done = 0;   /* Bytes Written.               */
+	int i = 0;         /* Current I/O vector.          */
+	size_t iovoff = 0; /* Offset in current I/O vector. */
+
+	if ((ret = vfs_iov_check(iov, iovcnt)) < 0)
+		return (ret);
+
+	total = ret;
+
+	nanvix_semaphore_down(&vectored.lock);
+
+		while (done < total)
+		{
+			size_t count;
+
+			count = ((total - done) < NANVIX_FS_BLOCK_SIZE) ?
+				(total - done) : NANVIX_FS_BLOCK_SIZE;
+
+			/* Gather. */
+			for (size_t staged = 0; staged < count; /* noop */)
+			{
+				size_t len;
+
+				len = iov[i].iov_len - iovoff;
+				if (len > (count - staged))
+					len = count - staged;
+
+				umemcpy(&vectored.buffer[staged], (char *) iov[i].iov_base + iovoff, len);
+				staged += len;
+
+				/* Move to next I/O vector. */
+				if ((iovoff += len) == iov[i].iov_len)
+				{
+					i++;
+					iovoff = 0;
+				}
+			}
+
+			if ((ret = nanvix_vfs_write(fd, vectored.buffer, count)) < 0)
+				break;
+
+			done += ret;
+
+			/* Device is full. */
+			if ((size_t) ret < count)
+				break;
+		}
+
+	nanvix_semaphore_up(&vectored.lock);
+
+	/* Report data that was written before the failure. */
+	if ((ret < 0) && (done == 0))
+		return (ret);
+
+	return (done);
+}
+
+/*============================================================================*
+ * nanvix_vfs_copy_range()                                                    *
+ *============================================================================*/
+
+/**
+ * The do_nanvix_vfs_copy_range() function asks the server to copy @p n
+ * bytes from the file referred by @p fd_in, at offset @p off_in, to the
+ * file referred by @p fd_out, at offset @p off_out.
+ */
+static ssize_t do_nanvix_vfs_copy_range(
+	int fd_in,
+	off_t off_in,
+	int fd_out,
+	off_t off_out,
+	size_t n
+)
+{
+	unsigned epoch;
+	struct vfs_message msg;
+
+	/* Build message.*/
+	message_header_build(&msg.header, VFS_COPY_RANGE);
+	msg.op.copy.fd_in = VFS_FD_REMOTE(fd_in);
+	msg.op.copy.off_in = off_in;
+	msg.op.copy.fd_out = VFS_FD_REMOTE(fd_out);
+	msg.op.copy.off_out = off_out;
+	msg.op.copy.n = n;
+
+	epoch = recall.epoch;
+	vfs_unlock();
+
+	/* Send operation header and receive reply. */
+	uassert(
+		nanvix_channel_call(
+			VFS_CONN(fd_in)->channel,
+			&msg,
+			sizeof(struct vfs_message)
+		) == 0
+	);
+
+	vfs_lock();
+
+	/* Operation failed. */
+	if (msg.header.opcode == VFS_FAIL)
+		return (msg.op.ret.status);
+
+	vfs_lease_update(fd_out, &msg, epoch);
+
+	return (msg.op.ret.count);
+}
+
+/**
+ * @brief Copies data between two files.
+ *
+ * @param fd_in   Source file descriptor.
+ * @param off_in  Offset in the source file.
+ * @param fd_out  Target file descriptor.
+ * @param off_out Offset in the target file.
+ * @param n       Number of bytes to copy.
+ *
+ * @returns Upon successful completion, the number of bytes copied is
+ * returned. Upon failure, a negative error code is returned instead.
+ *
+ * @note The client-side state should be locked.
+ */
+static ssize_t vfs_copy_range(
+	int fd_in,
+	off_t off_in,
+	int fd_out,
+	off_t off_out,
+	size_t n
+)
+{
+	int ret;
+	ssize_t ncopy;
+
+	/* Server must see deferred writes. */
+	if (((ret = vfs_cache_flush(fd_in)) < 0) || ((ret = vfs_cache_flush(fd_out)) < 0))
+		return (ret);
+
+	/* Server is not aware of local file pointers. */
+	ncopy = do_nanvix_vfs_copy_range(
+		fd_in,
+		(off_in < 0) ? files[fd_in].pos : off_in,
+		fd_out,
+		(off_out < 0) ? files[fd_out].pos : off_out,
+		n
+	);
+
+	/* Operation failed. */
+	if (ncopy < 0)
+		return (ncopy);
+
+	if (off_in < 0)
+		files[fd_in].pos += ncopy;
+	if (off_out < 0)
+		files[fd_out].pos += ncopy;
+
+	return (ncopy);
+}
+
+/**
+ * The nanvix_vfs_copy_range() function copies @p n bytes from the file
+ * referred by @p fd_in to the file referred by @p fd_out. Data is copied
+ * by the server, thus it never crosses the network. If an offset is
+ * negative, the read/write pointer of the corresponding file is used
+ * instead, and it is advanced by the number of bytes copied.
+ */
+ssize_t nanvix_vfs_copy_range(
+	int fd_in,
+	off_t off_in,
+	int fd_out,
+	off_t off_out,
+	size_t n
+)
+{
+	ssize_t ret;
+
+	/* Invalid server ID. */
+	if (!server.initialized)
+		return (-EAGAIN);
+
+	/* Invalid file descriptor. */
+	if (!VFS_FD_IS_VALID(fd_in) || !VFS_FD_IS_VALID(fd_out))
+		return (-EINVAL);
+
+	/* Files are served by different servers. */
+	if (VFS_FD_SERVER(fd_in) != VFS_FD_SERVER(fd_out))
+		return (-EXDEV);
+
+	/* Invalid copy size. */
+	if (n > NANVIX_MAX_FILE_SIZE)
+		return (-EFBIG);
+
+	/* Nothing to do. */
+	if (n == 0)
+		return (0);
+
+	vfs_lock();
+		ret = vfs_copy_range(fd_in, off_in, fd_out, off_out, n);
+	vfs_unlock();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * nanvix_vfs_multi()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Compound Requests
+ *
+ * Operations are built in place and then shipped to servers, thus
+ * compound requests are carried out one at a time. The lock of the
+ * client-side state cannot be used for this purpose, because it is
+ * released while waiting for servers.
+ */
+static struct
+{
+	struct nanvix_semaphore lock;           /**< Lock.                        */
+	struct vfs_multi_op ops[VFS_MULTI_MAX]; /**< Operations.                  */
+	int idx[VFS_MULTI_MAX];                 /**< Positions of the operations. */
+} multi;
+
+/**
+ * The do_nanvix_vfs_multi() function ships the @p n operations pointed
+ * to by @p ops to the server @p srv in a single compound request, and
+ * waits for their results, which are stored back in @p ops.
+ */
+static int do_nanvix_vfs_multi(int srv, struct vfs_multi_op *ops, int n)
+{
+	struct vfs_message msg;
+	const size_t size = n*sizeof(struct vfs_multi_op);
+
+	/* Invalid number of operations. */
+	if ((n <= 0) || (n > VFS_MULTI_MAX))
+		return (-EINVAL);
+
+	/* Build message.*/
+	message_header_build2(
+		&msg.header,
+		VFS_MULTI,
+		nanvix_channel_get_port(server.conns[srv].channel)
+	);
+	msg.op.multi.n = n;
+	msg.op.multi.recall = recall.port;
+
+	/* Send operation header. */
+	uassert(
+		nanvix_channel_send(
+			server.conns[srv].channel,
+			&msg,
+			sizeof(struct vfs_message)
+		) == 0
+	);
+
+	/* Send operations. */
+	uassert(
+		nanvix_channel_write(
+			server.conns[srv].channel,
+			ops,
+			size
+		) >= 0
+	);
+
+	/* Wait acknowledge. */
+	uassert(
+		nanvix_channel_recv(
+			server.conns[srv].channel,
+			&msg,
+			sizeof(struct vfs_message)
+		) == 0
+	);
+	uassert(msg.header.opcode == VFS_ACK);
+
+	/* Receive results. */
+	uassert(
+		nanvix_channel_read(
+			server.conns[srv].channel,
+			ops,
+			size,
+			msg.header.portal_port
+		) >= 0
+	);
+
+	/* Receive reply. */
+	uassert(
+		nanvix_channel_recv(
+			server.conns[srv].channel,
+			&msg,
+			sizeof(struct vfs_message)
+		) == 0
+	);
+
+	/* Operation failed. */
+	if (msg.header.opcode == VFS_FAIL)
+		return (msg.op.ret.status);
+
+	return (0);
+}
+
+/*============================================================================*
+ * vfs_multi_build()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Builds a compound request for a server.
+ *
+ * @param srv       Target server.
+ * @param filenames Target file names.
+ * @param n         Number of file names.
+ * @param opcode    Operation to carry out on each file.
+ * @param oflag     Open flags (for VFS_OPEN).
+ *
+ * Operations on files that are not served by @p srv are left out. The
+ * position of each operation in @p filenames is stored in multi.idx.
+ *
+ * @returns Upon successful completion, the number of operations in the
+ * request is returned. Upon failure, a negative error code is returned
+ * instead.
+ */
+static int vfs_multi_build(int srv, const char **filenames, int n, int opcode, int oflag)
+{
+	int nops = 0;
+	const char *name;
+
+	for (int j = 0; j < n; j++)
+	{
+		/* Invalid filename. */
+		if ((filenames[j] == NULL) || (ustrlen(filenames[j]) >= NANVIX_NAME_MAX))
+			return (-EINVAL);
+
+		/* Served by another server. */
+		if (vfs_route(filenames[j], &name) != srv)
+			continue;
+
+		multi.idx[nops] = j;
+		multi.ops[nops].opcode = opcode;
+		multi.ops[nops].oflag = oflag;
+		ustrncpy(multi.ops[nops].filename, name, NANVIX_NAME_MAX);
+		nops++;
+	}
+
+	return (nops);
+}
+
+/*============================================================================*
+ * nanvix_vfs_open_multi()                                                    *
+ *============================================================================*/
+
+/**
+ * The nanvix_vfs_open_multi() function opens the @p n files named in
+ * @p filenames, all of them with the open flags @p oflag. The file
+ * descriptor of each file, or a negative error code, is stored in @p
+ * fds. Up to VFS_MULTI_MAX files are opened in a single request.
+ */
+int nanvix_vfs_open_multi(const char **filenames, int oflag, int *fds, int n)
+{
+	int ret = 0;
+
+	/* Invalid server ID. */
+	if (!server.initialized)
+		return (-EAGAIN);
+
+	/* Invalid arguments. */
+	if ((filenames == NULL) || (fds == NULL) || (n < 0))
+		return (-EINVAL);
 
-	/* Operation failed. */
-	if (msg.header.opcode == VFS_FAIL)
-		return (msg.op.ret.status);
+	/* Invalid access mode.. */
+	if (!ACCMODE_RDONLY(oflag) && !ACCMODE_WRONLY(oflag) && !ACCMODE_RDWR(oflag))
+		return (-EINVAL);
 
-	return (0);
+	nanvix_semaphore_down(&multi.lock);
+
+		for (int i = 0; (ret == 0) && (i < n); i += VFS_MULTI_MAX)
+		{
+			int nfiles = ((n - i) < VFS_MULTI_MAX) ? (n - i) : VFS_MULTI_MAX;
+
+			/* One request per server. */
+			for (int srv = 0; srv < VFS_SERVERS_NUM; srv++)
+			{
+				int nops;
+				unsigned epoch;
+
+				if ((nops = vfs_multi_build(srv, &filenames[i], nfiles, VFS_OPEN, oflag)) < 0)
+				{
+					ret = nops;
+					break;
+				}
+
+				/* Nothing to do. */
+				if (nops == 0)
+					continue;
+
+				vfs_lock();
+					epoch = recall.epoch;
+				vfs_unlock();
+
+				if ((ret = do_nanvix_vfs_multi(srv, multi.ops, nops)) < 0)
+					break;
+
+				for (int j = 0; j < nops; j++)
+				{
+					int fd = multi.ops[j].ret;
+					struct vfs_message msg;
+
+					/* Failed to open file. */
+					if (fd < 0)
+					{
+						fds[i + multi.idx[j]] = fd;
+						continue;
+					}
+
+					/* Too many opened files. */
+					if (fd >= NANVIX_VFS_OPEN_MAX)
+					{
+						vfs_lock();
+							do_nanvix_vfs_close(srv, fd);
+						vfs_unlock();
+
+						fds[i + multi.idx[j]] = -EMFILE;
+						continue;
+					}
+
+					fds[i + multi.idx[j]] = fd = VFS_FD(srv, fd);
+
+					/* Lease granted along with the file. */
+					msg.op.ret.offset = -1;
+					msg.op.ret.lease = multi.ops[j].lease;
+					msg.op.ret.version = multi.ops[j].version;
+
+					/* Initialize client-side state. */
+					vfs_lock();
+						files[fd].pos = 0;
+						files[fd].srvpos = 0;
+						files[fd].lease = VFS_LEASE_NONE;
+						files[fd].version = multi.ops[j].version;
+						vfs_lease_update(fd, &msg, epoch);
+					vfs_unlock();
+				}
+			}
+		}
+
+	nanvix_semaphore_up(&multi.lock);
+
+	return (ret);
 }
 
+/*============================================================================*
+ * nanvix_vfs_stat_multi()                                                    *
+ *============================================================================*/
+
 /**
- * @see do_nanvix_vfs_close().
- *
- * @author Pedro Henrique Penna
+ * The nanvix_vfs_stat_multi() function gets the attributes of the @p n
+ * files named in @p filenames, and stores them in @p buf. The status of
+ * each lookup, zero or a negative error code, is stored in @p status.
+ * Up to VFS_MULTI_MAX files are looked up in a single request.
  */
-int nanvix_vfs_close(int fd)
+int nanvix_vfs_stat_multi(
+	const char **filenames,
+	struct vfs_stat *buf,
+	int *status,
+	int n
+)
 {
+	int ret = 0;
+
 	/* Invalid server ID. */
 	if (!server.initialized)
 		return (-EAGAIN);
 
-	/* Invalid file descriptor. */
-	if (!NANVIX_VFS_FD_IS_VALID(fd))
+	/* Invalid arguments. */
+	if ((filenames == NULL) || (buf == NULL) || (status == NULL) || (n < 0))
 		return (-EINVAL);
 
-	return (do_nanvix_vfs_close(fd));
+	nanvix_semaphore_down(&multi.lock);
+
+		for (int i = 0; (ret == 0) && (i < n); i += VFS_MULTI_MAX)
+		{
+			int nfiles = ((n - i) < VFS_MULTI_MAX) ? (n - i) : VFS_MULTI_MAX;
+
+			/* One request per server. */
+			for (int srv = 0; srv < VFS_SERVERS_NUM; srv++)
+			{
+				int nops;
+
+				if ((nops = vfs_multi_build(srv, &filenames[i], nfiles, VFS_STAT, 0)) < 0)
+				{
+					ret = nops;
+					break;
+				}
+
+				/* Nothing to do. */
+				if (nops == 0)
+					continue;
+
+				if ((ret = do_nanvix_vfs_multi(srv, multi.ops, nops)) < 0)
+					break;
+
+				for (int j = 0; j < nops; j++)
+				{
+					status[i + multi.idx[j]] = multi.ops[j].ret;
+					buf[i + multi.idx[j]] = multi.ops[j].st;
+				}
+			}
+		}
+
+	nanvix_semaphore_up(&multi.lock);
+
+	return (ret);
 }
 
 /*============================================================================*
- * nanvix_vfs_seek()                                                          *
+ * nanvix_vfs_stat()                                                          *
  *============================================================================*/
 
 /**
- * The do_nanvix_vfs_seek() function repositions the read/write pointer
- * of the file referred by the file descriptor @p fd. The new position
- * for the read/write pointer is computed according to the value of @p
- * whence:
- *
- * - SEEK_SET sets the read/write pointer is set to @p offset.
- * - SEEK_CUR increases the read/write pointer by @p offset.
- * - SEEK_END sets the read/write pointer to the end of the file plus @p offset
- *
- * @author Pedro Henrique Penna
+ * The nanvix_vfs_stat() function gets the attributes of the file named
+ * @p filename, and stores them in @p buf.
  */
-static off_t do_nanvix_vfs_seek(int fd, off_t offset, int whence)
+int nanvix_vfs_stat(const char *filename, struct vfs_stat *buf)
 {
+	int srv;
+	const char *name;
 	struct vfs_message msg;
 
+	/* Invalid server ID. */
+	if (!server.initialized)
+		return (-EAGAIN);
+
+	/* Invalid arguments. */
+	if ((filename == NULL) || (buf == NULL))
+		return (-EINVAL);
+
+	/* Invalid filename. */
+	if (ustrlen(filename) >= NANVIX_NAME_MAX)
+		return (-EINVAL);
+
+	srv = vfs_route(filename, &name);
+
 	/* Build message.*/
-	message_header_build(&msg.header, VFS_SEEK);
-	msg.op.seek.fd = fd;
-	msg.op.seek.offset = offset;
-	msg.op.seek.whence = whence;
+	message_header_build(&msg.header, VFS_STAT);
+	ustrncpy(msg.op.stat.filename, name, NANVIX_NAME_MAX);
 
 	/* Send operation. */
 	uassert(
-		nanvix_mailbox_write(
-			server.outbox,
-			&msg, sizeof(struct vfs_message)
+		nanvix_channel_send(
+			server.conns[srv].channel,
+			&msg,
+			sizeof(struct vfs_message)
 		) == 0
 	);
 
 	/* Receive reply. */
 	uassert(
-		kmailbox_read(
-			stdinbox_get(),
+		nanvix_channel_recv(
+			server.conns[srv].channel,
 			&msg,
 			sizeof(struct vfs_message)
-		) == sizeof(struct vfs_message)
+		) == 0
 	);
 
 	/* Operation failed. */
 	if (msg.header.opcode == VFS_FAIL)
 		return (msg.op.ret.status);
 
-	return (msg.op.ret.offset);
-}
-
-/**
- * @see do_nanvix_vfs_seek().
- *
- * @author Pedro Henrique Penna
- */
-off_t nanvix_vfs_seek(int fd, off_t offset, int whence)
-{
-	/* Invalid server ID. */
-	if (!server.initialized)
-		return (-EAGAIN);
-
-	/* Invalid file descriptor. */
-	if (!NANVIX_VFS_FD_IS_VALID(fd))
-		return (-EINVAL);
-
-	/* Invalid whence. */
-	if ((whence != SEEK_SET) && (whence != SEEK_CUR) && (whence != SEEK_END))
-		return (-EINVAL);
+	*buf = msg.op.ret.st;
 
-	return (do_nanvix_vfs_seek(fd, offset, whence));
+	return (0);
 }
 
 /*============================================================================*
- * nanvix_vfs_read()                                                          *
+ * nanvix_vfs_getdents()                                                      *
  *============================================================================*/
 
 /**
- * The do_nanvix_vfs_read() function reads @p n bytes from the file
- * referred by the file descriptor @p fd into the buffer pointed to by
- * @p buf.
- *
- * @author Pedro Henrique Penna
- *
- * @todo TODO: tile data transfers
+ * The do_nanvix_vfs_getdents() function reads up to @p n entries of the
+ * directory referred by the file descriptor @p fd, along with their
+ * attributes, in a single portal transfer.
  */
-static ssize_t do_nanvix_vfs_read(int fd, void *buf, size_t n)
+static int do_nanvix_vfs_getdents(int fd, struct vfs_dirent *dirp, int n)
 {
+	unsigned epoch;
 	struct vfs_message msg;
 
-	/* Nothing to do. */
-	if (n == 0)
-		return (0);
+	/* Invalid number of entries. */
+	if ((n <= 0) || (n > (int) VFS_GETDENTS_MAX))
+		return (-EINVAL);
 
 	/* Build message.*/
-	message_header_build(&msg.header, VFS_READ);
-	msg.op.read.fd = fd;
-	msg.op.read.n = n;
+	message_header_build(&msg.header, VFS_GETDENTS);
+	msg.op.getdents.fd = VFS_FD_REMOTE(fd);
+	msg.op.getdents.n = n;
+
+	epoch = recall.epoch;
+	vfs_unlock();
 
 	/* Send operation header. */
 	uassert(
-		nanvix_mailbox_write(
-			server.outbox,
+		nanvix_channel_send(
+			VFS_CONN(fd)->channel,
 			&msg,
 			sizeof(struct vfs_message)
 		) == 0
@@ -287,194 +2323,328 @@ static ssize_t do_nanvix_vfs_read(int fd, void *buf, size_t n)
 
 	/* Wait acknowledge. */
 	uassert(
-		kmailbox_read(
-			stdinbox_get(),
+		nanvix_channel_recv(
+			VFS_CONN(fd)->channel,
 			&msg,
 			sizeof(struct vfs_message)
-		) == sizeof(struct vfs_message)
+		) == 0
 	);
 	uassert(msg.header.opcode == VFS_ACK);
 
-	/* Receive data. */
+	/* Receive entries. */
 	uassert(
-		kportal_allow(
-			stdinportal_get(),
-			VFS_SERVER_NODE,
+		nanvix_channel_read(
+			VFS_CONN(fd)->channel,
+			dirp,
+			n*sizeof(struct vfs_dirent),
 			msg.header.portal_port
-		) == 0
-	);
-	uassert(
-		kportal_read(
-			stdinportal_get(),
-			buf,
-			n
 		) >= 0
 	);
 
 	/* Receive reply. */
 	uassert(
-		kmailbox_read(
-			stdinbox_get(),
+		nanvix_channel_recv(
+			VFS_CONN(fd)->channel,
 			&msg,
 			sizeof(struct vfs_message)
-		) == sizeof(struct vfs_message)
+		) == 0
 	);
 
+	vfs_lock();
+
 	/* Operation failed. */
 	if (msg.header.opcode == VFS_FAIL)
 		return (msg.op.ret.status);
 
+	vfs_lease_update(fd, &msg, epoch);
+
 	return (msg.op.ret.count);
 }
 
 /**
- * @see do_nanvix_vfs_read().
+ * @brief Reads directory entries.
  *
- * @author Pedro Henrique Penna
+ * @param fd   Target file descriptor.
+ * @param dirp Target buffer.
+ * @param n    Number of entries to read.
+ *
+ * @returns Upon successful completion, the number of entries read is
+ * returned. Upon failure, a negative error code is returned instead.
+ *
+ * @note The client-side state should be locked.
  */
-ssize_t nanvix_vfs_read(int fd, void *buf, size_t n)
+static int vfs_getdents(int fd, struct vfs_dirent *dirp, int n)
+{
+	int ret;
+
+	if ((ret = vfs_sync_pos(fd, files[fd].pos)) < 0)
+		return (ret);
+
+	if ((ret = do_nanvix_vfs_getdents(fd, dirp, n)) < 0)
+		return (ret);
+
+	files[fd].pos = files[fd].srvpos;
+
+	return (ret);
+}
+
+/**
+ * @see do_nanvix_vfs_getdents().
+ */
+int nanvix_vfs_getdents(int fd, struct vfs_dirent *dirp, int n)
 {
-	char *pbase; /* Base Address of Buffer */
-	char *pend;  /* End Address of Buffer  */
+	int ret;
 
 	/* Invalid server ID. */
 	if (!server.initialized)
 		return (-EAGAIN);
 
 	/* Invalid file descriptor. */
-	if (!NANVIX_VFS_FD_IS_VALID(fd))
+	if (!VFS_FD_IS_VALID(fd))
 		return (-EINVAL);
 
 	/* Invalid buffer. */
-	if (buf == NULL)
+	if ((dirp == NULL) || (n <= 0))
 		return (-EINVAL);
 
-	/* Invalid read size. */
-	if (n > NANVIX_MAX_FILE_SIZE)
-		return (-EFBIG);
+	/* Do not overflow a portal transfer. */
+	if (n > (int) VFS_GETDENTS_MAX)
+		n = VFS_GETDENTS_MAX;
 
-	/* Read in chunks. */
-	pbase = buf; pend = ((char *) buf) + n;
-	for (char *p = pbase; p < pend; p += NANVIX_FS_BLOCK_SIZE)
-	{
-		size_t count;
-		ssize_t nread;
+	vfs_lock();
+		ret = vfs_getdents(fd, dirp, n);
+	vfs_unlock();
 
-		count = ((pend - p) < NANVIX_FS_BLOCK_SIZE) ?
-			(size_t)(pend - p) : NANVIX_FS_BLOCK_SIZE;
+	return (ret);
+}
 
-		if ((nread = do_nanvix_vfs_read(fd, p, count)) < 0)
-			return (nread);
-	}
+/*============================================================================*
+ * nanvix_vfs_fsync()                                                         *
+ *============================================================================*/
 
-	return ((size_t)(pend - pbase));
+/**
+ * The nanvix_vfs_fsync() function writes back the deferred writes on
+ * the file referred by the file descriptor @p fd.
+ */
+int nanvix_vfs_fsync(int fd)
+{
+	int ret;
+
+	/* Invalid server ID. */
+	if (!server.initialized)
+		return (-EAGAIN);
+
+	/* Invalid file descriptor. */
+	if (!VFS_FD_IS_VALID(fd))
+		return (-EINVAL);
+
+	vfs_lock();
+		ret = vfs_cache_flush(fd);
+	vfs_unlock();
+
+	return (ret);
 }
 
 /*============================================================================*
- * nanvix_vfs_write()                                                         *
+ * nanvix_vfs_stats()                                                         *
  *============================================================================*/
 
 /**
- * The do_nanvix_vfs_write() function writes @p n bytes from the buffer
- * pointed to by @p buf to the filereferred by the file descriptor @p
- * fd.
+ * The nanvix_vfs_stats() function gets the statistics of the file data
+ * cache and stores them in the location pointed to by @p buf.
+ */
+int nanvix_vfs_stats(struct vfs_cache_stats *buf)
+{
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	vfs_lock();
+		umemcpy(buf, &stats, sizeof(struct vfs_cache_stats));
+	vfs_unlock();
+
+	return (0);
+}
+
+/*============================================================================*
+ * vfs_recall_daemon()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Acknowledges a recall.
  *
- * @author Pedro Henrique Penna
+ * @param srv    Server that issued the recall.
+ * @param req    Recall request.
+ * @param offset Offset of recalled data.
+ * @param n      Number of bytes of recalled data.
  *
- * @todo TODO: tile data transfers
+ * Recalled data, if any, is shipped from the recall buffer.
  */
-ssize_t do_nanvix_vfs_write(int fd, const void *buf, size_t n)
+static void vfs_recall_ack(int srv, const struct vfs_message *req, off_t offset, size_t n)
 {
 	struct vfs_message msg;
-
-	/* Nothing to do. */
-	if (n == 0)
-		return (0);
+	const int channel = server.conns[srv].recall;
 
 	/* Build message.*/
 	message_header_build2(
 		&msg.header,
-		VFS_WRITE,
-		nanvix_portal_get_port(server.outportal)
+		VFS_RECALL_ACK,
+		nanvix_channel_get_port(channel)
 	);
-	msg.op.write.fd = fd;
-	msg.op.write.n = n;
+	msg.op.recall = req->op.recall;
+	msg.op.recall.offset = offset;
+	msg.op.recall.n = n;
 
 	/* Send operation header. */
 	uassert(
-		nanvix_mailbox_write(
-			server.outbox,
+		nanvix_channel_send(
+			channel,
 			&msg,
 			sizeof(struct vfs_message)
 		) == 0
 	);
 
 	/* Send data. */
-	uassert(
-		nanvix_portal_write(
-			server.outportal,
-			buf,
-			n
-		) >= 0
-	);
-
-	/* Receive reply. */
-	uassert(
-		kmailbox_read(
-			stdinbox_get(),
-			&msg,
-			sizeof(struct vfs_message)
-		) == sizeof(struct vfs_message)
-	);
-
-	/* Operation failed. */
-	if (msg.header.opcode == VFS_FAIL)
-		return (msg.op.ret.status);
-
-	return (msg.op.ret.count);
+	if (n > 0)
+	{
+		uassert(
+			nanvix_channel_write(
+				channel,
+				recall.buffer,
+				n
+			) == (ssize_t) n
+		);
+	}
 }
 
 /**
- * @see do_nanvix_vfs_write().
+ * @brief Serves a recall.
  *
- * @author Pedro Henrique Penna
+ * @param req Recall request.
+ *
+ * The lease on the file is dropped, and so are cached pages of the
+ * file. Dirty pages are written back one at a time, and a final empty
+ * acknowledge tells the server that the recall is done. The server is
+ * always acknowledged, even if the request is malformed, otherwise it
+ * would be left waiting for the lease holder.
  */
-ssize_t nanvix_vfs_write(int fd, const void *buf, size_t n)
+static void vfs_recall(const struct vfs_message *req)
 {
-	const char *pbase; /* Base Address of Buffer */
-	const char *pend;  /* End Address of Buffer  */
+	int fd;
+	int srv = req->op.recall.server;
 
-	/* Invalid server ID. */
-	if (!server.initialized)
-		return (-EAGAIN);
+	/* Invalid server. */
+	if (!WITHIN(srv, 0, VFS_SERVERS_NUM))
+	{
+		/* Answer back the node that issued the recall. */
+		for (srv = 0; srv < VFS_SERVERS_NUM; srv++)
+		{
+			if (server.conns[srv].nodenum == req->header.source)
+				break;
+		}
+
+		/* Unknown server. */
+		if (srv == VFS_SERVERS_NUM)
+		{
+			uprintf("[nanvix][vfs] recall from unknown server %d", req->header.source);
+			return;
+		}
+
+		goto done;
+	}
 
 	/* Invalid file descriptor. */
-	if (!NANVIX_VFS_FD_IS_VALID(fd))
-		return (-EINVAL);
+	if (!WITHIN(req->op.recall.fd, 0, NANVIX_VFS_OPEN_MAX))
+		goto done;
 
-	/* Invalid buffer. */
-	if (buf == NULL)
-		return (-EINVAL);
+	fd = VFS_FD(srv, req->op.recall.fd);
 
-	/* Invalid write size. */
-	if (n > NANVIX_MAX_FILE_SIZE)
-		return (-EFBIG);
+	vfs_lock();
 
-	/* Read in chunks. */
-	pbase = buf; pend = ((char *) buf) + n;
-	for (const char *p = pbase; p < pend; p += NANVIX_FS_BLOCK_SIZE)
-	{
-		size_t count;
-		ssize_t nwrite;
+		recall.epoch++;
+		stats.nrecalls++;
+		files[fd].lease = VFS_LEASE_NONE;
 
-		count = ((pend - p) < NANVIX_FS_BLOCK_SIZE) ?
-			(size_t)(pend - p) : NANVIX_FS_BLOCK_SIZE;
+		for (int i = 0; i < NANVIX_VFS_CACHE_NR_PAGES; i++)
+		{
+			off_t base;
+			size_t len;
 
-		if ((nwrite = do_nanvix_vfs_write(fd, p, count)) < 0)
-			return (nwrite);
+			/* Skip pages of other files. */
+			if (pages[i].fd != fd)
+				continue;
+
+			/* Clean page. */
+			if (!pages[i].dirty)
+			{
+				pages[i].fd = -1;
+				continue;
+			}
+
+			base = pages[i].base;
+			len = pages[i].len;
+			umemcpy(recall.buffer, pages[i].data, len);
+			pages[i].fd = -1;
+			pages[i].dirty = 0;
+			stats.nflushes++;
+
+			vfs_unlock();
+				vfs_recall_ack(srv, req, base, len);
+			vfs_lock();
+		}
+
+	vfs_unlock();
+
+done:
+	vfs_recall_ack(srv, req, 0, 0);
+}
+
+/**
+ * @brief Recall daemon.
+ *
+ * @param args Arguments for the thread (unused).
+ *
+ * @returns Always return NULL.
+ */
+static void *vfs_recall_daemon(void *args)
+{
+	struct vfs_message msg;
+
+	UNUSED(args);
+
+	uassert(__stdsync_setup() == 0);
+	uassert(__stdmailbox_setup() == 0);
+	uassert(__stdportal_setup() == 0);
+
+	recall.port = stdinbox_get_port();
+	nanvix_semaphore_up(&recall.ready);
+
+	while (1)
+	{
+		uassert(
+			kmailbox_read(
+				stdinbox_get(),
+				&msg,
+				sizeof(struct vfs_message)
+			) == sizeof(struct vfs_message)
+		);
+
+		/* Shutdown. */
+		if (msg.header.opcode == VFS_EXIT)
+			break;
+
+		/* Unknown request. */
+		if (msg.header.opcode != VFS_RECALL)
+			continue;
+
+		vfs_recall(&msg);
 	}
 
-	return ((size_t)(pend - pbase));
+	uassert(__stdportal_cleanup() == 0);
+	uassert(__stdmailbox_cleanup() == 0);
+	uassert(__stdsync_cleanup() == 0);
+
+	return (NULL);
 }
 
 #endif
@@ -485,7 +2655,7 @@ ssize_t nanvix_vfs_write(int fd, const void *buf, size_t n)
 
 /**
  * The nanvix_vfs_shutdown() function issues the shutdown signal to the
- * VFS server, thus causing the server to terminate.
+ * VFS servers, thus causing the servers to terminate.
  */
 int nanvix_vfs_shutdown(void)
 {
@@ -501,12 +2671,16 @@ int nanvix_vfs_shutdown(void)
 	message_header_build(&msg.header, VFS_EXIT);
 
 	/* Send operation header. */
-	uassert(
-		nanvix_mailbox_write(
-			server.outbox,
-			&msg, sizeof(struct vfs_message)
-		) == 0
-	);
+	for (int i = 0; i < VFS_SERVERS_NUM; i++)
+	{
+		uassert(
+			nanvix_channel_send(
+				server.conns[i].channel,
+				&msg,
+				sizeof(struct vfs_message)
+			) == 0
+		);
+	}
 
 #endif
 
@@ -529,22 +2703,47 @@ int __nanvix_vfs_setup(void)
 	if (server.initialized)
 		return (0);
 
-	/* Open output mailbox */
-	if ((server.outbox = nanvix_mailbox_open(VFS_SERVER_NAME, VFS_SERVER_PORT_NUM)) < 0)
-	{
-		uprintf("[nanvix][vfs] cannot open outbox to server");
-		return (server.outbox);
-	}
+	nanvix_semaphore_init(&client_lock, 1);
+	nanvix_semaphore_init(&multi.lock, 1);
+	nanvix_semaphore_init(&vectored.lock, 1);
+	nanvix_semaphore_init(&recall.ready, 0);
 
-	/* Open underlying IPC connectors. */
-	if ((server.outportal = nanvix_portal_open(VFS_SERVER_NAME, VFS_SERVER_PORT_NUM)) < 0)
+	for (int i = 0; i < VFS_SERVERS_NUM; i++)
 	{
-		uprintf("[nanvix][vfs] cannot open outportal to server");
-		return (server.outportal);
+		/* Resolve mount point. */
+		if ((server.conns[i].nodenum = nanvix_name_lookup(vfs_servers[i].name)) < 0)
+		{
+			uprintf("[nanvix][vfs] cannot resolve %s", vfs_servers[i].name);
+			return (server.conns[i].nodenum);
+		}
+
+		/* Connect channel. */
+		if ((server.conns[i].channel = nanvix_channel_connect(vfs_servers[i].name, vfs_servers[i].portnum)) < 0)
+		{
+			uprintf("[nanvix][vfs] cannot connect to server");
+			return (server.conns[i].channel);
+		}
+
+		/* Connect recall channel. */
+		if ((server.conns[i].recall = nanvix_channel_connect(vfs_servers[i].name, vfs_servers[i].portnum)) < 0)
+		{
+			uprintf("[nanvix][vfs] cannot connect to server");
+			return (server.conns[i].recall);
+		}
 	}
 
+	/* Initialize file data cache. */
+	for (int i = 0; i < NANVIX_VFS_CACHE_NR_PAGES; i++)
+		pages[i].fd = -1;
+	for (int i = 0; i < VFS_FD_MAX; i++)
+		files[i].lease = VFS_LEASE_NONE;
+
+	/* Spawn recall daemon. */
+	uassert(kthread_create(&recall.tid, &vfs_recall_daemon, NULL) == 0);
+	nanvix_semaphore_down(&recall.ready);
+
 	server.initialized = true;
-	uprintf("[nanvix][vfs] connection with server established");
+	uprintf("[nanvix][vfs] connections with servers established");
 
 #endif
 
@@ -564,24 +2763,48 @@ int __nanvix_vfs_cleanup(void)
 
 #ifdef __NANVIX_HAS_VFS_SERVER
 
-	int ret;
+	int ret = 0;
+	int outbox;
+	struct vfs_message msg;
 
 	/* Nothing to do. */
 	if (!server.initialized)
 		return (0);
 
-	/* Close output mailbox. */
-	if ((ret = nanvix_mailbox_close(server.outbox)) < 0)
-	{
-		uprintf("[nanvix][vfs] cannot close outbox to server");
+	/* Write back deferred data. */
+	vfs_lock();
+		for (int i = 0; i < VFS_FD_MAX; i++)
+		{
+			if ((ret = vfs_cache_flush(i)) < 0)
+				break;
+		}
+	vfs_unlock();
+
+	if (ret < 0)
 		return (ret);
-	}
 
-	/* Close underlying IPC connectors. */
-	if (nanvix_portal_close(server.outportal) < 0)
+	/* Shutdown recall daemon. */
+	message_header_build(&msg.header, VFS_EXIT);
+	uassert((outbox = kmailbox_open(knode_get_num(), recall.port)) >= 0);
+	uassert(kmailbox_write(outbox, &msg, sizeof(struct vfs_message)) == sizeof(struct vfs_message));
+	uassert(kmailbox_close(outbox) == 0);
+	uassert(kthread_join(recall.tid, NULL) == 0);
+
+	for (int i = 0; i < VFS_SERVERS_NUM; i++)
 	{
-		uprintf("[nanvix][vfs] cannot close outportal to server");
-		return (-EAGAIN);
+		/* Disconnect channel. */
+		if ((ret = nanvix_channel_disconnect(server.conns[i].channel)) < 0)
+		{
+			uprintf("[nanvix][vfs] cannot disconnect from server");
+			return (ret);
+		}
+
+		/* Disconnect recall channel. */
+		if ((ret = nanvix_channel_disconnect(server.conns[i].recall)) < 0)
+		{
+			uprintf("[nanvix][vfs] cannot disconnect from server");
+			return (ret);
+		}
 	}
 
 	server.initialized = 0;
@@ -23,10 +23,15 @@
  */
 
 #define __NEED_SPAWN_SERVER
+#define __NEED_RMEM_SERVER
+#define __NEED_FS_VFS_SERVER
 #define SPAWN_SERVER
 
 #include <nanvix/runtime/runtime.h>
 #include <nanvix/servers/spawn.h>
+#include <nanvix/servers/rmem.h>
+#include <nanvix/servers/vfs.h>
+#include <nanvix/config.h>
 #include <nanvix/sys/thread.h>
 #include <nanvix/sys/excp.h>
 #include <nanvix/sys/page.h>
@@ -81,6 +86,48 @@ static void *nanvix_exception_handler(void *args)
 	return (NULL);
 }
 
+/**
+ * @brief Number of server names resolved at setup.
+ */
+#ifdef __NANVIX_HAS_VFS_SERVER
+#define RUNTIME_SERVER_NAMES_NUM (RMEM_SERVERS_NUM + VFS_SERVERS_NUM + SYSV_SERVERS_NUM)
+#else
+#define RUNTIME_SERVER_NAMES_NUM (RMEM_SERVERS_NUM + SYSV_SERVERS_NUM)
+#endif
+
+/**
+ * @brief Resolves the names of system servers.
+ *
+ * Names are resolved in a single batch, and they are left in the name
+ * lookup cache. Setup routines of upper rings then look each name up
+ * without reaching the name server. If NANVIX_NAME_SETUP_BATCHED is
+ * not set, setup routines resolve names one at a time instead, so
+ * that the setup time of both approaches may be compared.
+ */
+static void runtime_resolve_servers(void)
+{
+#if (NANVIX_NAME_SETUP_BATCHED)
+	int n = 0;
+	int nodenums[RUNTIME_SERVER_NAMES_NUM];
+	const char *names[RUNTIME_SERVER_NAMES_NUM];
+
+	for (int i = 0; i < RMEM_SERVERS_NUM; i++)
+		names[n++] = rmem_servers[i].name;
+
+#ifdef __NANVIX_HAS_VFS_SERVER
+	for (int i = 0; i < VFS_SERVERS_NUM; i++)
+		names[n++] = vfs_servers[i].name;
+#endif
+
+#ifdef __NANVIX_HAS_SYSV_SERVER
+	names[n++] = SYSV_SERVER_NAME;
+#endif
+
+	/* Failures are reported by setup routines. */
+	nanvix_name_lookup_multi(names, nodenums, n);
+#endif
+}
+
 /**
  * @todo TODO: provide a detailed description for this function.
  */
@@ -125,10 +172,20 @@ int __runtime_setup(int ring)
 	/* Initialize Ring 3. */
 	if ((current_ring[tid] < SPAWN_RING_3) && (ring >= SPAWN_RING_3))
 	{
+		uint64_t t0, t1;
+
 		uprintf("[nanvix][thread %d] initalizing ring 3", tid);
-		uassert(__nanvix_rmem_setup() == 0);
-		uassert(__nanvix_rcache_setup() == 0);
-		uassert(__nanvix_vfs_setup() == 0);
+		kclock(&t0);
+			runtime_resolve_servers();
+			uassert(__nanvix_rmem_setup() == 0);
+			uassert(__nanvix_rcache_setup() == 0);
+			uassert(__nanvix_vfs_setup() == 0);
+		kclock(&t1);
+		uprintf("[nanvix][thread %d] ring 3 initialized in %d cycles (%s name lookups)",
+			tid,
+			(int) (t1 - t0),
+			(NANVIX_NAME_SETUP_BATCHED) ? "batched" : "per-name"
+		);
 	}
 
 	/* Initialize Ring 4. */
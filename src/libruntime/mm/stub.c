@@ -28,6 +28,7 @@
 
 #include <nanvix/runtime/pm.h>
 #include <nanvix/runtime/mm.h>
+#include <nanvix/sys/semaphore.h>
 #include <nanvix/sys/excp.h>
 #include <nanvix/config.h>
 #include <nanvix/ulib.h>
@@ -36,14 +37,17 @@
 
 /**
  * @brief Remote memory server connection.
+ *
+ * @details Each connection has its own lock, so that threads that talk
+ * to different servers do not wait for each other.
  */
 static struct
 {
-	int initialized; /**< Is the connection initialized? */
-	int outbox;      /**< Output mailbox for requests.   */
-	int outportal;   /**< Output portal for data.        */
+	int initialized;              /**< Is the connection initialized? */
+	int channel;                  /**< Channel to the server.         */
+	struct nanvix_semaphore lock; /**< Lock of the channel.           */
 } server[RMEM_SERVERS_NUM] = {
-	[0 ... (RMEM_SERVERS_NUM - 1)] = { 0, -1, -1 }
+	[0 ... (RMEM_SERVERS_NUM - 1)] = { .initialized = 0, .channel = -1 }
 };
 
 /**
@@ -51,6 +55,54 @@ static struct
  */
 static struct rmem_stats stats = { 0, 0, 0, 0 };
 
+/**
+ * @brief Number of successful allocation requests.
+ */
+static unsigned nallocs = 0;
+
+/*============================================================================*
+ * rmem_server_is_initialized()                                               *
+ *============================================================================*/
+
+/**
+ * @brief Asserts whether or not a remote memory server is reachable.
+ *
+ * @param serverid ID of the target server.
+ *
+ * @returns Non-zero if the connection to the target server is
+ * initialized, and zero otherwise.
+ */
+static inline int rmem_server_is_initialized(int serverid)
+{
+	return (server[serverid].initialized);
+}
+
+/*============================================================================*
+ * rmem_server_next()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Picks a remote memory server for allocations.
+ *
+ * @returns The ID of the next server, in round-robin order, to which
+ * the client is connected. If there is no such server, a negative
+ * number is returned instead.
+ */
+static int rmem_server_next(void)
+{
+	for (int i = 0; i < RMEM_SERVERS_NUM; i++)
+	{
+		int serverid;
+
+		serverid = (nallocs + i) % RMEM_SERVERS_NUM;
+
+		if (rmem_server_is_initialized(serverid))
+			return (serverid);
+	}
+
+	return (-1);
+}
+
 /*============================================================================*
  * nanvix_rmem_alloc()                                                        *
  *============================================================================*/
@@ -61,34 +113,25 @@ static struct rmem_stats stats = { 0, 0, 0, 0 };
 rpage_t nanvix_rmem_alloc(void)
 {
 	int serverid;
-	static unsigned nallocs = 0;
 	struct rmem_message msg;
 
-	serverid = nallocs % RMEM_SERVERS_NUM;
-
-	/* Client not initialized.  */
-	if (!server[serverid].initialized)
+	/* No server available. */
+	if ((serverid = rmem_server_next()) < 0)
 		return (RMEM_NULL);
 
 	/* Build operation header. */
 	message_header_build(&msg.header, RMEM_ALLOC);
 
-	/* Send operation header. */
-	uassert(
-		nanvix_mailbox_write(
-			server[serverid].outbox,
-			&msg, sizeof(struct rmem_message)
-		) == 0
-	);
-
-	/* Receive reply. */
-	uassert(
-		kmailbox_read(
-			stdinbox_get(),
-			&msg,
-			sizeof(struct rmem_message)
-		) == sizeof(struct rmem_message)
-	);
+	/* Send operation header and receive reply. */
+	nanvix_semaphore_down(&server[serverid].lock);
+		uassert(
+			nanvix_channel_call(
+				server[serverid].channel,
+				&msg,
+				sizeof(struct rmem_message)
+			) == 0
+		);
+	nanvix_semaphore_up(&server[serverid].lock);
 
 	if (msg.errcode < 0)
 		return RMEM_NULL;
@@ -98,6 +141,78 @@ rpage_t nanvix_rmem_alloc(void)
 	return (msg.blknum);
 }
 
+/*============================================================================*
+ * nanvix_rmem_alloc_multi()                                                  *
+ *============================================================================*/
+
+/**
+ * The nanvix_rmem_alloc_multi() function allocates @p n remote memory
+ * blocks and stores their numbers in the array pointed to by @p
+ * blknums. All requests go to the same server, in a single batch.
+ * Blocks that could not be allocated are set to RMEM_NULL.
+ */
+int nanvix_rmem_alloc_multi(rpage_t *blknums, int n)
+{
+	int serverid;
+	int nblocks = 0;
+	struct rmem_message *msgs;
+	static struct rmem_message batches[RMEM_SERVERS_NUM][NANVIX_MAILBOX_BATCH_MAX];
+
+	/* Invalid store location. */
+	if (blknums == NULL)
+		return (-EINVAL);
+
+	/* Invalid number of blocks. */
+	if ((n < 1) || (n > NANVIX_MAILBOX_BATCH_MAX))
+		return (-EINVAL);
+
+	/* No server available. */
+	if ((serverid = rmem_server_next()) < 0)
+		return (-EAGAIN);
+
+	msgs = batches[serverid];
+
+	nanvix_semaphore_down(&server[serverid].lock);
+
+		/* Build operation headers. */
+		for (int i = 0; i < n; i++)
+			message_header_build(&msgs[i].header, RMEM_ALLOC);
+
+		/* Send operation headers. */
+		uassert(
+			nanvix_channel_send_batch(
+				server[serverid].channel,
+				msgs,
+				sizeof(struct rmem_message),
+				n
+			) == 0
+		);
+
+		/* Receive replies. */
+		for (int i = 0; i < n; i++)
+		{
+			uassert(
+				nanvix_channel_recv(
+					server[serverid].channel,
+					&msgs[i],
+					sizeof(struct rmem_message)
+				) == 0
+			);
+
+			blknums[i] = (msgs[i].errcode < 0) ? RMEM_NULL : msgs[i].blknum;
+
+			if (blknums[i] != RMEM_NULL)
+				nblocks++;
+		}
+
+	nanvix_semaphore_up(&server[serverid].lock);
+
+	nallocs++;
+	stats.nallocs += nblocks;
+
+	return (nblocks);
+}
+
 /*============================================================================*
  * nanvix_rmem_free()                                                         *
  *============================================================================*/
@@ -116,31 +231,24 @@ int nanvix_rmem_free(rpage_t blknum)
 
 	serverid = RMEM_BLOCK_SERVER(blknum);
 
-	/* Client not initialized.  */
-	if (!server[serverid].initialized)
+	/* Client not initialized. */
+	if (!rmem_server_is_initialized(serverid))
 		return (-EINVAL);
 
 	/* Build operation header. */
 	message_header_build(&msg.header, RMEM_MEMFREE);
 	msg.blknum = blknum;
 
-	/* Send operation header. */
-	uassert(
-		nanvix_mailbox_write(
-			server[serverid].outbox,
-			&msg,
-			sizeof(struct rmem_message)
-		) == 0
-	);
-
-	/* Receive reply. */
-	uassert(
-		kmailbox_read(
-			stdinbox_get(),
-			&msg,
-			sizeof(struct rmem_message)
-		) == sizeof(struct rmem_message)
-	);
+	/* Send operation header and receive reply. */
+	nanvix_semaphore_down(&server[serverid].lock);
+		uassert(
+			nanvix_channel_call(
+				server[serverid].channel,
+				&msg,
+				sizeof(struct rmem_message)
+			) == 0
+		);
+	nanvix_semaphore_up(&server[serverid].lock);
 
 	stats.nfrees++;
 	return (msg.errcode);
@@ -168,8 +276,8 @@ size_t nanvix_rmem_read(rpage_t blknum, void *buf)
 
 	serverid = RMEM_BLOCK_SERVER(blknum);
 
-	/* Client not initialized.  */
-	if (!server[serverid].initialized)
+	/* Client not initialized. */
+	if (!rmem_server_is_initialized(serverid))
 		return (0);
 
 	/* Build operation header. */
@@ -177,49 +285,38 @@ size_t nanvix_rmem_read(rpage_t blknum, void *buf)
 
 	msg.blknum = blknum;
 
-	/* Send operation header. */
-	uassert(
-		nanvix_mailbox_write(
-			server[serverid].outbox,
-			&msg,
-			sizeof(struct rmem_message)
-		) == 0
-	);
-
-	/* Wait acknowledge. */
-	uassert(
-		kmailbox_read(
-			stdinbox_get(),
-			&msg,
-			sizeof(struct rmem_message)
-		) == sizeof(struct rmem_message)
-	);
-	uassert(msg.header.opcode == RMEM_ACK);
-
-	/* Receive data. */
-	uassert(
-		kportal_allow(
-			stdinportal_get(),
-			rmem_servers[serverid].nodenum,
-			msg.header.portal_port
-		) == 0
-	);
-	uassert(
-		kportal_read(
-			stdinportal_get(),
-			buf,
-			RMEM_BLOCK_SIZE
-		) == RMEM_BLOCK_SIZE
-	);
-
-	/* Receive reply. */
-	uassert(
-		kmailbox_read(
-			stdinbox_get(),
-			&msg,
-			sizeof(struct rmem_message)
-		) == sizeof(struct rmem_message)
-	);
+	nanvix_semaphore_down(&server[serverid].lock);
+
+		/* Send operation header and wait acknowledge. */
+		uassert(
+			nanvix_channel_call(
+				server[serverid].channel,
+				&msg,
+				sizeof(struct rmem_message)
+			) == 0
+		);
+		uassert(msg.header.opcode == RMEM_ACK);
+
+		/* Receive data. */
+		uassert(
+			nanvix_channel_read(
+				server[serverid].channel,
+				buf,
+				RMEM_BLOCK_SIZE,
+				msg.header.portal_port
+			) == RMEM_BLOCK_SIZE
+		);
+
+		/* Receive reply. */
+		uassert(
+			nanvix_channel_recv(
+				server[serverid].channel,
+				&msg,
+				sizeof(struct rmem_message)
+			) == 0
+		);
+
+	nanvix_semaphore_up(&server[serverid].lock);
 
 	stats.nreads++;
 	return ((msg.errcode < 0) ? 0 : RMEM_BLOCK_SIZE);
@@ -247,43 +344,48 @@ size_t nanvix_rmem_write(rpage_t blknum, const void *buf)
 
 	serverid = RMEM_BLOCK_SERVER(blknum);
 
-	/* Client not initialized.  */
-	if (!server[serverid].initialized)
+	/* Client not initialized. */
+	if (!rmem_server_is_initialized(serverid))
 		return (0);
 
-	/* Build operation header. */
-	message_header_build2(
-		&msg.header,
-		RMEM_WRITE,
-		nanvix_portal_get_port(server[serverid].outportal)
-	);
-	msg.blknum = blknum;
+	nanvix_semaphore_down(&server[serverid].lock);
+
+		/* Build operation header. */
+		message_header_build2(
+			&msg.header,
+			RMEM_WRITE,
+			nanvix_channel_get_port(server[serverid].channel)
+		);
+		msg.blknum = blknum;
+
+		/* Send operation header. */
+		uassert(
+			nanvix_channel_send(
+				server[serverid].channel,
+				&msg,
+				sizeof(struct rmem_message)
+			) == 0
+		);
+
+		/* Send data. */
+		uassert(
+			nanvix_channel_write(
+				server[serverid].channel,
+				buf,
+				RMEM_BLOCK_SIZE
+			) == RMEM_BLOCK_SIZE
+		);
+
+		/* Receive reply. */
+		uassert(
+			nanvix_channel_recv(
+				server[serverid].channel,
+				&msg,
+				sizeof(struct rmem_message)
+			) == 0
+		);
 
-	/* Send operation header. */
-	uassert(
-		nanvix_mailbox_write(
-			server[serverid].outbox,
-			&msg, sizeof(struct rmem_message)
-		) == 0
-	);
-
-	/* Send data. */
-	uassert(
-		nanvix_portal_write(
-			server[serverid].outportal,
-			buf,
-			RMEM_BLOCK_SIZE
-		) == RMEM_BLOCK_SIZE
-	);
-
-	/* Receive reply. */
-	uassert(
-		kmailbox_read(
-			stdinbox_get(),
-			&msg,
-			sizeof(struct rmem_message)
-		) == sizeof(struct rmem_message)
-	);
+	nanvix_semaphore_up(&server[serverid].lock);
 
 	stats.nwrites++;
 	return ((msg.errcode < 0) ? 0 : RMEM_BLOCK_SIZE);
@@ -326,9 +428,10 @@ int nanvix_rmem_shutdown(void)
 	for (int i = 0; i < RMEM_SERVERS_NUM; i++)
 	{
 		uassert(
-			nanvix_mailbox_write(
-				server[i].outbox,
-				&msg, sizeof(struct rmem_message)
+			nanvix_channel_send(
+				server[i].channel,
+				&msg,
+				sizeof(struct rmem_message)
 			) == 0
 		);
 	}
@@ -352,18 +455,13 @@ int __nanvix_rmem_setup(void)
 		if (server[i].initialized)
 			continue;
 
-		/* Open output mailbox */
-		if ((server[i].outbox = nanvix_mailbox_open(rmem_servers[i].name, rmem_servers[i].portnum)) < 0)
-		{
-			uprintf("[nanvix][rmem] cannot open outbox to server");
-			return (server[i].outbox);
-		}
+		nanvix_semaphore_init(&server[i].lock, 1);
 
-		/* Open underlying IPC connectors. */
-		if ((server[i].outportal = nanvix_portal_open(rmem_servers[i].name, rmem_servers[i].portnum)) < 0)
+		/* Connect channel. */
+		if ((server[i].channel = nanvix_channel_connect(rmem_servers[i].name, rmem_servers[i].portnum)) < 0)
 		{
-			uprintf("[nanvix][rmem] cannot open outportal to server");
-			return (server[i].outportal);
+			uprintf("[nanvix][rmem] cannot connect to server");
+			return (server[i].channel);
 		}
 
 		uprintf("[nanvix][rmem] connection with server established");
@@ -400,17 +498,10 @@ int __nanvix_rmem_cleanup(void)
 		if (!server[i].initialized)
 			continue;
 
-		/* Close output mailbox */
-		if (nanvix_mailbox_close(server[i].outbox) < 0)
-		{
-			uprintf("[nanvix][rmem] cannot close outbox to server");
-			return (-EAGAIN);
-		}
-
-		/* Close underlying IPC connectors. */
-		if (nanvix_portal_close(server[i].outportal) < 0)
+		/* Disconnect channel. */
+		if (nanvix_channel_disconnect(server[i].channel) < 0)
 		{
-			uprintf("[nanvix][rmem] cannot close outportal to server");
+			uprintf("[nanvix][rmem] cannot disconnect from server");
 			return (-EAGAIN);
 		}
 
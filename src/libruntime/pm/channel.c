@@ -0,0 +1,897 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __NEED_RESOURCE
+
+#include <nanvix/hal/resource.h>
+#include <nanvix/runtime/pm.h>
+#include <nanvix/runtime/stdikc.h>
+#include <nanvix/runtime/utils.h>
+#include <nanvix/sys/semaphore.h>
+#include <nanvix/sys/noc.h>
+#include <nanvix/config.h>
+#include <nanvix/ulib.h>
+#include <posix/errno.h>
+
+/*============================================================================*
+ * Rings                                                                      *
+ *============================================================================*/
+
+#ifdef __NANVIX_HAS_CHANNEL_RINGS
+
+/**
+ * @brief Port number that tags requests of a channel with a ring.
+ *
+ * Ring ports lie right above the ports of the hardware portals, thus
+ * servers tell apart requests whose data goes through a ring.
+ */
+#define CHANNEL_RING_PORT(chid) (KPORTAL_PORT_NR + (chid))
+
+/**
+ * @brief Asserts whether or not a port number is a ring port.
+ */
+#define CHANNEL_RING_PORT_IS_VALID(port) \
+	WITHIN(port, KPORTAL_PORT_NR, KPORTAL_PORT_NR + NANVIX_CHANNEL_MAX)
+
+/**
+ * @brief Slot of a ring.
+ */
+struct channel_slot
+{
+	size_t len;                                /**< Bytes in the slot.         */
+	int last;                                  /**< Last slot of the transfer? */
+	char data[NANVIX_CHANNEL_RING_SLOT_SIZE];  /**< Data.                      */
+};
+
+/**
+ * @brief Ring of a channel.
+ *
+ * A ring carries data between a client and a server that live in the
+ * same node. Slots are filled in by one end and drained by the other,
+ * and the semaphores count free and full slots.
+ */
+struct channel_ring
+{
+	struct nanvix_semaphore nfree;                       /**< Free slots. */
+	struct nanvix_semaphore nfull;                       /**< Full slots. */
+	int head;                                            /**< First full. */
+	int tail;                                            /**< First free. */
+	struct channel_slot slots[NANVIX_CHANNEL_RING_LENGTH]; /**< Slots.    */
+};
+
+#endif /* __NANVIX_HAS_CHANNEL_RINGS */
+
+/*============================================================================*
+ * Client Side                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Table of channels.
+ */
+static struct channel
+{
+	/*
+	 * XXX: Don't Touch! This Must Come First!
+	 */
+	struct resource resource; /**< Generic resource information. */
+
+	int nodenum;              /**< Node of the server.           */
+	int outbox;               /**< Output mailbox for requests.  */
+	int outportal;            /**< Output portal for data.       */
+
+#ifdef __NANVIX_HAS_CHANNEL_RINGS
+	int ring_enabled;         /**< Is data shipped in the ring?  */
+	struct channel_ring ring; /**< Ring to a same-node server.   */
+#endif
+} channels[NANVIX_CHANNEL_MAX];
+
+/**
+ * @brief Pool of channels.
+ */
+static const struct resource_pool pool_channels = {
+	channels, NANVIX_CHANNEL_MAX, sizeof(struct channel)
+};
+
+/**
+ * @brief Index of free channels.
+ */
+static struct resource_index index_channels = RESOURCE_INDEX_INITIALIZER(&pool_channels);
+
+/*============================================================================*
+ * nanvix_channel_is_valid()                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Asserts whether or not a channel is valid.
+ *
+ * @param chid ID of the target channel.
+ *
+ * @returns One if the channel is valid and connected, and zero
+ * otherwise.
+ */
+static inline int nanvix_channel_is_valid(int chid)
+{
+	/* Invalid channel. */
+	if (!WITHIN(chid, 0, NANVIX_CHANNEL_MAX))
+		return (0);
+
+	return (resource_is_used(&channels[chid].resource));
+}
+
+#ifdef __NANVIX_HAS_CHANNEL_RINGS
+
+/*============================================================================*
+ * channel_ring_init()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Initializes a ring.
+ *
+ * @param ring Target ring.
+ */
+static void channel_ring_init(struct channel_ring *ring)
+{
+	ring->head = 0;
+	ring->tail = 0;
+	nanvix_semaphore_init(&ring->nfree, NANVIX_CHANNEL_RING_LENGTH);
+	nanvix_semaphore_init(&ring->nfull, 0);
+}
+
+/*============================================================================*
+ * channel_ring_put()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Writes data to a ring.
+ *
+ * @param ring Target ring.
+ * @param buf  Location from where data should be read.
+ * @param n    Number of bytes to write.
+ *
+ * @returns The number of bytes written is returned.
+ *
+ * @note At least one slot is filled in, even if @p n is zero, so that
+ * the other end always learns that the transfer is over.
+ */
+static ssize_t channel_ring_put(
+	struct channel_ring *ring,
+	const void *buf,
+	size_t n
+)
+{
+	size_t i = 0;
+	struct channel_slot *slot;
+
+	do
+	{
+		size_t len;
+
+		len = ((n - i) < NANVIX_CHANNEL_RING_SLOT_SIZE) ?
+			(n - i) : NANVIX_CHANNEL_RING_SLOT_SIZE;
+
+		nanvix_semaphore_down(&ring->nfree);
+
+			slot = &ring->slots[ring->tail];
+			ring->tail = (ring->tail + 1) % NANVIX_CHANNEL_RING_LENGTH;
+
+			umemcpy(slot->data, (const char *) buf + i, len);
+			slot->len = len;
+			slot->last = ((i + len) == n);
+
+		nanvix_semaphore_up(&ring->nfull);
+
+		i += len;
+	} while (i < n);
+
+	return ((ssize_t) n);
+}
+
+/*============================================================================*
+ * channel_ring_get()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Reads data from a ring.
+ *
+ * @param ring Target ring.
+ * @param buf  Location where data should be written.
+ * @param n    Number of bytes to read.
+ *
+ * @returns The number of bytes read is returned. Bytes of the
+ * transfer that do not fit in @p buf are dropped.
+ */
+static ssize_t channel_ring_get(
+	struct channel_ring *ring,
+	void *buf,
+	size_t n
+)
+{
+	int last;
+	size_t i = 0;
+	struct channel_slot *slot;
+
+	do
+	{
+		size_t len;
+
+		nanvix_semaphore_down(&ring->nfull);
+
+			slot = &ring->slots[ring->head];
+			ring->head = (ring->head + 1) % NANVIX_CHANNEL_RING_LENGTH;
+
+			len = ((n - i) < slot->len) ? (n - i) : slot->len;
+			umemcpy((char *) buf + i, slot->data, len);
+			last = slot->last;
+
+		nanvix_semaphore_up(&ring->nfree);
+
+		i += len;
+	} while (!last);
+
+	return ((ssize_t) i);
+}
+
+/*============================================================================*
+ * channel_ring_lookup()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Looks up the ring of a request.
+ *
+ * @param h Header of the target request.
+ *
+ * @returns If the request @p h was issued through a channel of the
+ * calling node that ships data through a ring, the ring of that
+ * channel is returned. Otherwise, NULL is returned instead.
+ */
+static struct channel_ring *channel_ring_lookup(const message_header *h)
+{
+	int chid;
+
+	/* Remote client. */
+	if (h->source != knode_get_num())
+		return (NULL);
+
+	/* Not a ring port. */
+	if (!CHANNEL_RING_PORT_IS_VALID(h->portal_port))
+		return (NULL);
+
+	chid = h->portal_port - KPORTAL_PORT_NR;
+
+	/* Stale channel. */
+	if (!nanvix_channel_is_valid(chid) || !channels[chid].ring_enabled)
+		return (NULL);
+
+	return (&channels[chid].ring);
+}
+
+#endif /* __NANVIX_HAS_CHANNEL_RINGS */
+
+/*============================================================================*
+ * nanvix_channel_connect()                                                   *
+ *============================================================================*/
+
+/**
+ * The nanvix_channel_connect() function connects a channel to the
+ * server named @p name, which listens on the port @p port. The request
+ * mailbox and the data portal of the channel are opened right away,
+ * and they are kept opened until the channel is disconnected. If the
+ * server lives in the same node, data is shipped in a ring rather
+ * than through portals.
+ */
+int nanvix_channel_connect(const char *name, int port)
+{
+	int chid;
+	int nodenum;
+
+	/* Invalid name. */
+	if (name == NULL)
+		return (-EINVAL);
+
+	/* Server not found. */
+	if ((nodenum = nanvix_name_lookup(name)) < 0)
+		return (nodenum);
+
+	/* Allocate channel. */
+	if ((chid = resource_index_alloc(&index_channels)) < 0)
+		return (-EAGAIN);
+
+	/* Open request mailbox. */
+	if ((channels[chid].outbox = nanvix_mailbox_open(name, port)) < 0)
+		goto error0;
+
+	/* Open data portal. */
+	if ((channels[chid].outportal = nanvix_portal_open(name, port)) < 0)
+		goto error1;
+
+	channels[chid].nodenum = nodenum;
+
+#ifdef __NANVIX_HAS_CHANNEL_RINGS
+	/* Ship data in a ring to servers of this node. */
+	if ((channels[chid].ring_enabled = (nodenum == knode_get_num())))
+		channel_ring_init(&channels[chid].ring);
+#endif
+
+	return (chid);
+
+error1:
+	uassert(nanvix_mailbox_close(channels[chid].outbox) == 0);
+error0:
+	resource_index_free(&index_channels, chid);
+	return (-EAGAIN);
+}
+
+/*============================================================================*
+ * nanvix_channel_disconnect()                                                *
+ *============================================================================*/
+
+/**
+ * The nanvix_channel_disconnect() function closes the request mailbox
+ * and the data portal of the channel @p chid, and then releases the
+ * channel.
+ */
+int nanvix_channel_disconnect(int chid)
+{
+	int ret;
+
+	/* Invalid channel. */
+	if (!nanvix_channel_is_valid(chid))
+		return (-EINVAL);
+
+	/* Close request mailbox. */
+	if ((ret = nanvix_mailbox_close(channels[chid].outbox)) < 0)
+		return (ret);
+
+	/* Close data portal. */
+	if ((ret = nanvix_portal_close(channels[chid].outportal)) < 0)
+		return (ret);
+
+	resource_index_free(&index_channels, chid);
+
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_channel_get_port()                                                  *
+ *============================================================================*/
+
+/**
+ * The nanvix_channel_get_port() function returns the port number of
+ * the data portal of the channel @p chid. The server should allow
+ * reads from this port before reading data sent with
+ * nanvix_channel_write().
+ */
+int nanvix_channel_get_port(int chid)
+{
+	/* Invalid channel. */
+	if (!nanvix_channel_is_valid(chid))
+		return (-EINVAL);
+
+#ifdef __NANVIX_HAS_CHANNEL_RINGS
+	if (channels[chid].ring_enabled)
+		return (CHANNEL_RING_PORT(chid));
+#endif
+
+	return (nanvix_portal_get_port(channels[chid].outportal));
+}
+
+/*============================================================================*
+ * nanvix_channel_set_ring()                                                  *
+ *============================================================================*/
+
+/**
+ * The nanvix_channel_set_ring() function enables or disables, as
+ * stated by @p enable, the ring of the channel @p chid. When the ring
+ * is disabled, data is shipped through portals, even if the server
+ * lives in the same node.
+ */
+int nanvix_channel_set_ring(int chid, int enable)
+{
+	/* Invalid channel. */
+	if (!nanvix_channel_is_valid(chid))
+		return (-EINVAL);
+
+#ifdef __NANVIX_HAS_CHANNEL_RINGS
+
+	/* Remote server. */
+	if (channels[chid].nodenum != knode_get_num())
+		return (-ENOTSUP);
+
+	if (enable && !channels[chid].ring_enabled)
+		channel_ring_init(&channels[chid].ring);
+
+	channels[chid].ring_enabled = (enable != 0);
+
+	return (0);
+
+#else
+
+	UNUSED(enable);
+
+	return (-ENOTSUP);
+
+#endif
+}
+
+/*============================================================================*
+ * nanvix_channel_send()                                                      *
+ *============================================================================*/
+
+/**
+ * The nanvix_channel_send() function sends the request pointed to by
+ * @p msg, which is @p size bytes long, through the channel @p chid.
+ * If the channel has a ring, the request is tagged with the port of
+ * the ring, so that the server ships data in it.
+ */
+int nanvix_channel_send(int chid, const void *msg, size_t size)
+{
+	/* Invalid channel. */
+	if (!nanvix_channel_is_valid(chid))
+		return (-EINVAL);
+
+	/* Invalid message. */
+	if (msg == NULL)
+		return (-EINVAL);
+
+#ifdef __NANVIX_HAS_CHANNEL_RINGS
+	if (channels[chid].ring_enabled)
+	{
+		union
+		{
+			message_header header;
+			char raw[NANVIX_MAILBOX_MESSAGE_SIZE];
+		} tagged;
+
+		/* Invalid message size. */
+		if (!WITHIN(size, sizeof(message_header), sizeof(tagged) + 1))
+			return (-EINVAL);
+
+		umemcpy(tagged.raw, msg, size);
+		tagged.header.portal_port = CHANNEL_RING_PORT(chid);
+
+		return (nanvix_mailbox_write(channels[chid].outbox, tagged.raw, size));
+	}
+#endif
+
+	return (nanvix_mailbox_write(channels[chid].outbox, msg, size));
+}
+
+/*============================================================================*
+ * nanvix_channel_send_batch()                                                *
+ *============================================================================*/
+
+/**
+ * The nanvix_channel_send_batch() function sends @p count requests,
+ * each of which is @p size bytes long, through the channel @p chid.
+ * Requests that do not fit in mailbox messages are spilled to the data
+ * portal of the channel.
+ */
+int nanvix_channel_send_batch(
+	int chid,
+	const void *msgs,
+	size_t size,
+	int count
+)
+{
+	/* Invalid channel. */
+	if (!nanvix_channel_is_valid(chid))
+		return (-EINVAL);
+
+	return (
+		nanvix_mailbox_write_batch(
+			channels[chid].outbox,
+			channels[chid].outportal,
+			msgs,
+			size,
+			count
+		)
+	);
+}
+
+/*============================================================================*
+ * nanvix_channel_recv()                                                      *
+ *============================================================================*/
+
+/**
+ * The nanvix_channel_recv() function receives a reply that is @p size
+ * bytes long from the server of the channel @p chid, and places it in
+ * the location pointed to by @p msg.
+ */
+int nanvix_channel_recv(int chid, void *msg, size_t size)
+{
+	int ret;
+
+	/* Invalid channel. */
+	if (!nanvix_channel_is_valid(chid))
+		return (-EINVAL);
+
+	/* Invalid message. */
+	if (msg == NULL)
+		return (-EINVAL);
+
+	if ((ret = kmailbox_read(stdinbox_get(), msg, size)) < 0)
+		return (ret);
+
+	return ((ret == (int) size) ? 0 : -EIO);
+}
+
+/*============================================================================*
+ * nanvix_channel_call()                                                      *
+ *============================================================================*/
+
+/**
+ * The nanvix_channel_call() function sends the request pointed to by
+ * @p msg through the channel @p chid, and then waits for the reply,
+ * which overwrites the request.
+ */
+int nanvix_channel_call(int chid, void *msg, size_t size)
+{
+	int ret;
+
+	/* Send request. */
+	if ((ret = nanvix_channel_send(chid, msg, size)) < 0)
+		return (ret);
+
+	/* Receive reply. */
+	return (nanvix_channel_recv(chid, msg, size));
+}
+
+/*============================================================================*
+ * nanvix_channel_write()                                                     *
+ *============================================================================*/
+
+/**
+ * The nanvix_channel_write() function writes @p n bytes from the buffer
+ * pointed to by @p buf to the server of the channel @p chid, through
+ * the data portal or the ring of the channel.
+ */
+ssize_t nanvix_channel_write(int chid, const void *buf, size_t n)
+{
+	/* Invalid channel. */
+	if (!nanvix_channel_is_valid(chid))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+#ifdef __NANVIX_HAS_CHANNEL_RINGS
+	if (channels[chid].ring_enabled)
+		return (channel_ring_put(&channels[chid].ring, buf, n));
+#endif
+
+	return (nanvix_portal_write(channels[chid].outportal, buf, n));
+}
+
+/*============================================================================*
+ * nanvix_channel_read()                                                      *
+ *============================================================================*/
+
+/**
+ * The nanvix_channel_read() function reads @p n bytes from the server
+ * of the channel @p chid into the buffer pointed to by @p buf. Data is
+ * read from the standard input portal, and it is only accepted from
+ * the port @p port of the server. If the channel has a ring, data is
+ * read from the ring instead and @p port is ignored.
+ */
+ssize_t nanvix_channel_read(int chid, void *buf, size_t n, int port)
+{
+	int ret;
+
+	/* Invalid channel. */
+	if (!nanvix_channel_is_valid(chid))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+#ifdef __NANVIX_HAS_CHANNEL_RINGS
+	if (channels[chid].ring_enabled)
+		return (channel_ring_get(&channels[chid].ring, buf, n));
+#endif
+
+	/* Allow remote write. */
+	if ((ret = kportal_allow(stdinportal_get(), channels[chid].nodenum, port)) < 0)
+		return (ret);
+
+	return (kportal_read(stdinportal_get(), buf, n));
+}
+
+/*============================================================================*
+ * Server Side                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Connectors to clients.
+ */
+static struct channel_peer
+{
+	int nodenum;      /**< Node of the client.                      */
+	int mailbox_port; /**< Port of the input mailbox of the client. */
+	int portal_port;  /**< Port of the input portal of the client.  */
+	int outbox;       /**< Output mailbox (-1 if free).             */
+	int outportal;    /**< Output portal (-1 if none).              */
+	unsigned age;     /**< Time of last use.                        */
+} peers[NANVIX_CHANNEL_PEERS_MAX] = {
+	[0 ... (NANVIX_CHANNEL_PEERS_MAX - 1)] = { -1, -1, -1, -1, -1, 0 }
+};
+
+/**
+ * @brief Clock for replacement of connectors.
+ */
+static unsigned peers_clock = 0;
+
+/*============================================================================*
+ * channel_peer_close()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Closes the connectors to a client.
+ *
+ * @param peer Target client.
+ */
+static void channel_peer_close(struct channel_peer *peer)
+{
+	if (peer->outportal >= 0)
+		uassert(kportal_close(peer->outportal) == 0);
+	if (peer->outbox >= 0)
+		uassert(kmailbox_close(peer->outbox) == 0);
+
+	peer->outbox = -1;
+	peer->outportal = -1;
+	peer->portal_port = -1;
+}
+
+/*============================================================================*
+ * channel_peer_get()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Gets the connectors to a client.
+ *
+ * @param to Header of a request of the target client.
+ *
+ * @returns Upon successful completion, the connectors to the client
+ * that sent the request @p to are returned. If these are not opened
+ * yet, the least recently used ones are closed and reused. Upon
+ * failure, NULL is returned instead.
+ */
+static struct channel_peer *channel_peer_get(const message_header *to)
+{
+	struct channel_peer *peer = &peers[0];
+
+	for (int i = 0; i < NANVIX_CHANNEL_PEERS_MAX; i++)
+	{
+		/* Found. */
+		if ((peers[i].outbox >= 0) &&
+			(peers[i].nodenum == to->source) &&
+			(peers[i].mailbox_port == to->mailbox_port))
+		{
+			peer = &peers[i];
+			goto found;
+		}
+
+		/* Free or older. */
+		if ((peer->outbox >= 0) &&
+			((peers[i].outbox < 0) || (peers[i].age < peer->age)))
+			peer = &peers[i];
+	}
+
+	channel_peer_close(peer);
+
+	/* Open mailbox to client. */
+	if ((peer->outbox = kmailbox_open(to->source, to->mailbox_port)) < 0)
+		return (NULL);
+
+	peer->nodenum = to->source;
+	peer->mailbox_port = to->mailbox_port;
+
+found:
+	peer->age = ++peers_clock;
+
+	return (peer);
+}
+
+/*============================================================================*
+ * nanvix_channel_reply()                                                     *
+ *============================================================================*/
+
+/**
+ * The nanvix_channel_reply() function sends the reply pointed to by @p
+ * msg, which is @p size bytes long, to the client that issued the
+ * request whose header is pointed to by @p to. The mailbox to the
+ * client is kept opened for later replies.
+ */
+int nanvix_channel_reply(
+	const message_header *to,
+	const void *msg,
+	size_t size
+)
+{
+	int ret;
+	struct channel_peer *peer;
+
+	/* Invalid header. */
+	if (to == NULL)
+		return (-EINVAL);
+
+	/* Invalid message. */
+	if (msg == NULL)
+		return (-EINVAL);
+
+	/* Cannot reach client. */
+	if ((peer = channel_peer_get(to)) == NULL)
+		return (-EAGAIN);
+
+	if ((ret = kmailbox_write(peer->outbox, msg, size)) < 0)
+		return (ret);
+
+	return ((ret == (int) size) ? 0 : -EIO);
+}
+
+/*============================================================================*
+ * nanvix_channel_reply_data()                                                *
+ *============================================================================*/
+
+/**
+ * The nanvix_channel_reply_data() function acknowledges the client
+ * that issued the request whose header is pointed to by @p to with the
+ * message pointed to by @p ack, and then writes @p n bytes from the
+ * buffer pointed to by @p buf to the input portal of the client. The
+ * acknowledge carries the port of the portal through which data is
+ * shipped. Both the mailbox and the portal to the client are kept
+ * opened for later replies. Clients of the same node that have a ring
+ * get data in the ring instead.
+ */
+int nanvix_channel_reply_data(
+	const message_header *to,
+	void *ack,
+	size_t size,
+	const void *buf,
+	size_t n
+)
+{
+	int ret;
+	struct channel_peer *peer;
+
+	/* Invalid header. */
+	if (to == NULL)
+		return (-EINVAL);
+
+	/* Invalid acknowledge. */
+	if ((ack == NULL) || (size < sizeof(message_header)))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	/* Cannot reach client. */
+	if ((peer = channel_peer_get(to)) == NULL)
+		return (-EAGAIN);
+
+#ifdef __NANVIX_HAS_CHANNEL_RINGS
+	{
+		struct channel_ring *ring;
+
+		/* Ship data in the ring of the client. */
+		if ((ring = channel_ring_lookup(to)) != NULL)
+		{
+			((message_header *) ack)->portal_port = to->portal_port;
+
+			/* Send acknowledge. */
+			if ((ret = kmailbox_write(peer->outbox, ack, size)) < 0)
+				return (ret);
+
+			return ((channel_ring_put(ring, buf, n) == (ssize_t) n) ? 0 : -EIO);
+		}
+	}
+#endif
+
+	/* Open portal to client. */
+	if (peer->portal_port != to->portal_port)
+	{
+		if (peer->outportal >= 0)
+			uassert(kportal_close(peer->outportal) == 0);
+
+		peer->portal_port = -1;
+		if ((peer->outportal = kportal_open(knode_get_num(), to->source, to->portal_port)) < 0)
+			return (-EAGAIN);
+		peer->portal_port = to->portal_port;
+	}
+
+	((message_header *) ack)->portal_port =
+		kcomm_get_port(peer->outportal, COMM_TYPE_PORTAL);
+
+	/* Send acknowledge. */
+	if ((ret = kmailbox_write(peer->outbox, ack, size)) < 0)
+		return (ret);
+
+	/* Send data. */
+	if ((ret = kportal_write(peer->outportal, buf, n)) < 0)
+		return (ret);
+
+	return ((ret == (int) n) ? 0 : -EIO);
+}
+
+/*============================================================================*
+ * nanvix_channel_accept()                                                    *
+ *============================================================================*/
+
+/**
+ * The nanvix_channel_accept() function reads @p n bytes of data that
+ * is sent by the client that issued the request whose header is
+ * pointed to by @p from, and places them in the buffer pointed to by
+ * @p buf. Data is read from the ring of the client, if it has one, or
+ * from the input portal @p inportal otherwise.
+ */
+ssize_t nanvix_channel_accept(
+	const message_header *from,
+	int inportal,
+	void *buf,
+	size_t n
+)
+{
+	int ret;
+
+	/* Invalid header. */
+	if (from == NULL)
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+#ifdef __NANVIX_HAS_CHANNEL_RINGS
+	{
+		struct channel_ring *ring;
+
+		/* Read data from the ring of the client. */
+		if ((ring = channel_ring_lookup(from)) != NULL)
+			return (channel_ring_get(ring, buf, n));
+	}
+#endif
+
+	/* Allow remote write. */
+	if ((ret = kportal_allow(inportal, from->source, from->portal_port)) < 0)
+		return (ret);
+
+	return (kportal_read(inportal, buf, n));
+}
+
+/*============================================================================*
+ * nanvix_channel_flush()                                                     *
+ *============================================================================*/
+
+/**
+ * The nanvix_channel_flush() function closes all connectors that the
+ * calling server keeps opened to its clients.
+ */
+void nanvix_channel_flush(void)
+{
+	for (int i = 0; i < NANVIX_CHANNEL_PEERS_MAX; i++)
+		channel_peer_close(&peers[i]);
+}
@@ -0,0 +1,45 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/config.h>
+
+#ifdef __NANVIX_HAS_NAME_SERVER
+
+/**
+ * @brief Table of Name Servers.
+ */
+struct name_servers_info
+{
+	int nodenum;
+	int portnum;
+} name_servers[NAME_SERVERS_NUM] = {
+	{ NAME_SERVER_0_NODE, NAME_SERVER_0_PORT_NUM },
+#if (NAME_SERVERS_NUM == 4)
+	{ NAME_SERVER_1_NODE, NAME_SERVER_1_PORT_NUM },
+	{ NAME_SERVER_2_NODE, NAME_SERVER_2_PORT_NUM },
+	{ NAME_SERVER_3_NODE, NAME_SERVER_3_PORT_NUM },
+#endif
+};
+
+#endif
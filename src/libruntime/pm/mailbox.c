@@ -29,6 +29,8 @@
 
 #include <nanvix/limits/pm.h>
 #include <nanvix/runtime/pm.h>
+#include <nanvix/runtime/utils.h>
+#include <nanvix/servers/message.h>
 #include <nanvix/ulib.h>
 #include <posix/errno.h>
 
@@ -59,6 +61,26 @@ static const struct resource_pool pool_mailboxes = {
 	mailboxes, NANVIX_MAILBOX_MAX, sizeof(struct named_mailbox)
 };
 
+/**
+ * @brief Index of free named mailboxes.
+ */
+static struct resource_index index_mailboxes = RESOURCE_INDEX_INITIALIZER(&pool_mailboxes);
+
+/**
+ * @brief Room for messages in a batch.
+ */
+#define MAILBOX_BATCH_SIZE \
+	(NANVIX_MAILBOX_MESSAGE_SIZE - sizeof(struct message_batch))
+
+/**
+ * @brief Mailbox message that carries a batch.
+ */
+struct mailbox_batch
+{
+	struct message_batch header;    /**< Batch header.    */
+	char data[MAILBOX_BATCH_SIZE]; /**< Packed messages. */
+};
+
 /**
  * @brief Input HAL mailbox.
  */
@@ -136,7 +158,7 @@ int nanvix_mailbox_create(const char *name)
 		return (-EAGAIN);
 
 	/* Allocate mailbox. */
-	if ((mbxid = resource_alloc(&pool_mailboxes)) < 0)
+	if ((mbxid = resource_index_alloc(&index_mailboxes)) < 0)
 		return (-EAGAIN);
 
 	nodenum = knode_get_num();
@@ -157,7 +179,7 @@ int nanvix_mailbox_create(const char *name)
 	return (mbxid);
 
 error0:
-	resource_free(&pool_mailboxes, mbxid);
+	resource_index_free(&index_mailboxes, mbxid);
 	return (-EAGAIN);
 }
 
@@ -191,7 +213,7 @@ int nanvix_mailbox_create2(const char *name, int port)
 	nodenum = knode_get_num();
 
 	/* Allocate mailbox. */
-	if ((mbxid = resource_alloc(&pool_mailboxes)) < 0)
+	if ((mbxid = resource_index_alloc(&index_mailboxes)) < 0)
 		return (-EAGAIN);
 
 	/* Creates the underlying NoC connector. */
@@ -216,7 +238,7 @@ error1:
 		upanic("Could not clean an erroneus call to nanvix_mailbox_create2(). Aborting.");
 
 error0:
-	resource_free(&pool_mailboxes, mbxid);
+	resource_index_free(&index_mailboxes, mbxid);
 	return (-EAGAIN);
 }
 
@@ -242,7 +264,7 @@ int nanvix_mailbox_open(const char *name, int port)
 		return (-EAGAIN);
 
 	/* Allocate a mailbox. */
-	if ((mbxid = resource_alloc(&pool_mailboxes)) < 0)
+	if ((mbxid = resource_index_alloc(&index_mailboxes)) < 0)
 		return (-EAGAIN);
 
 	/* Open underlying HW channel. */
@@ -257,7 +279,8 @@ int nanvix_mailbox_open(const char *name, int port)
 	return (mbxid);
 
 error0:
-	resource_free(&pool_mailboxes, mbxid);
+	resource_index_free(&index_mailboxes, mbxid);
+	nanvix_name_invalidate(name);
 	return (-EAGAIN);
 }
 
@@ -361,6 +384,222 @@ int nanvix_mailbox_write(int mbxid, const void *buf, size_t n)
 	return (0);
 }
 
+/*============================================================================*
+ * nanvix_mailbox_write_batch()                                               *
+ *============================================================================*/
+
+/**
+ * The nanvix_mailbox_write_batch() function writes @p count messages
+ * of @p size bytes each, from the buffer pointed to by @p buf, to the
+ * mailbox @p mbxid. As many messages as fit are packed in each mailbox
+ * message. If they do not fit in a single one and @p portalid refers
+ * to a portal, only the header of the batch goes through the mailbox,
+ * and the messages are written from @p buf straight to the portal.
+ */
+int nanvix_mailbox_write_batch(
+	int mbxid,
+	int portalid,
+	const void *buf,
+	size_t size,
+	int count
+)
+{
+	int fd;
+	int perframe;
+	struct mailbox_batch batch;
+
+	/* Invalid mailbox ID.*/
+	if (!nanvix_mailbox_is_valid(mbxid))
+		return (-EINVAL);
+
+	/* Bad mailbox. */
+	if (!resource_is_used(&mailboxes[mbxid].resource))
+		return (-EINVAL);
+
+	/* Not the owner. */
+	if (mailboxes[mbxid].owner != knode_get_num())
+		return (-EPERM);
+
+	/*  Invalid mailbox. */
+	if (!resource_is_wronly(&mailboxes[mbxid].resource))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	/* Invalid message size. */
+	if ((size < sizeof(message_header)) || (size > MAILBOX_BATCH_SIZE))
+		return (-EINVAL);
+
+	/* Invalid number of messages. */
+	if ((count < 1) || (count > NANVIX_MAILBOX_BATCH_MAX))
+		return (-EINVAL);
+
+	/* Nothing to batch. */
+	if (count == 1)
+		return (nanvix_mailbox_write(mbxid, buf, size));
+
+	fd = mailboxes[mbxid].fd;
+	perframe = MAILBOX_BATCH_SIZE/size;
+	batch.header.size = size;
+
+	/* Spill to portal. */
+	if ((count > perframe) && (portalid >= 0))
+	{
+		message_header_build2(
+			&batch.header.header,
+			MESSAGE_BATCH,
+			nanvix_portal_get_port(portalid)
+		);
+		batch.header.count = 0;
+		batch.header.spilled = count;
+
+		if (kmailbox_write(fd, &batch, sizeof(struct message_batch)) < 0)
+			return (-EINVAL);
+
+		if (nanvix_portal_write(portalid, buf, count*size) < 0)
+			return (-EINVAL);
+
+		return (0);
+	}
+
+	/* Pack messages. */
+	for (int i = 0; i < count; i += perframe)
+	{
+		int n;
+
+		n = ((count - i) < perframe) ? (count - i) : perframe;
+
+		message_header_build(&batch.header.header, MESSAGE_BATCH);
+		batch.header.count = n;
+		batch.header.spilled = 0;
+		umemcpy(batch.data, &((const char *) buf)[i*size], n*size);
+
+		if (kmailbox_write(fd, &batch, sizeof(struct message_batch) + n*size) < 0)
+			return (-EINVAL);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * mailbox_batch_drain()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Throws away the spilled messages of a batch.
+ *
+ * @param inportal Underlying input portal.
+ * @param n        Number of bytes that were spilled.
+ *
+ * The portal should be allowed beforehand.
+ *
+ * @note This function is @b NOT thread safe.
+ */
+static void mailbox_batch_drain(int inportal, size_t n)
+{
+	size_t chunk;
+	static char scratch[NANVIX_MAILBOX_BATCH_MAX*NANVIX_MAILBOX_MESSAGE_SIZE];
+
+	for (size_t i = 0; i < n; i += chunk)
+	{
+		chunk = ((n - i) < sizeof(scratch)) ? (n - i) : sizeof(scratch);
+
+		if (kportal_read(inportal, scratch, chunk) != (ssize_t) chunk)
+			break;
+	}
+}
+
+/*============================================================================*
+ * nanvix_mailbox_read_batch()                                                *
+ *============================================================================*/
+
+/**
+ * The nanvix_mailbox_read_batch() function reads a mailbox message
+ * from the input mailbox @p inbox and unpacks the messages that it
+ * carries in the buffer pointed to by @p buf. Messages that were
+ * spilled are read from the input portal @p inportal straight into
+ * @p buf. A mailbox message that is not a batch is read as a batch of
+ * one message. Messages are @p size bytes long, and @p buf should have
+ * room for @p max of them.
+ *
+ * A batch that is malformed or that does not fit in @p buf is dropped,
+ * so that a faulty client cannot bring a server down. In this case,
+ * zero is returned and the caller should read the next message. Spilled
+ * messages of a dropped batch are still read from the portal, and
+ * thrown away, otherwise the sender would block forever.
+ *
+ * @note Servers should ask for at least NANVIX_MAILBOX_BATCH_MAX
+ * messages, otherwise they may be unable to take a batch.
+ */
+int nanvix_mailbox_read_batch(
+	int inbox,
+	int inportal,
+	void *buf,
+	size_t size,
+	int max
+)
+{
+	int n;
+	struct mailbox_batch batch;
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	/* Invalid message size. */
+	if ((size < sizeof(message_header)) || (size > NANVIX_MAILBOX_MESSAGE_SIZE))
+		return (-EINVAL);
+
+	/* Invalid number of messages. */
+	if (max < 1)
+		return (-EINVAL);
+
+	if (kmailbox_read(inbox, &batch, sizeof(struct mailbox_batch)) < 0)
+		return (-EINVAL);
+
+	/* Single message. */
+	if (batch.header.header.opcode != MESSAGE_BATCH)
+	{
+		umemcpy(buf, &batch, size);
+		return (1);
+	}
+
+	/* Bad batch, drop it. */
+	if (batch.header.size != size)
+		return (0);
+
+	/* Spilled messages. */
+	if ((n = batch.header.spilled) != 0)
+	{
+		/* Sender cannot be reached, drop it. */
+		if (kportal_allow(inportal, batch.header.header.source, batch.header.header.portal_port) < 0)
+			return (0);
+
+		/* Bad batch or not enough room, drain and drop it. */
+		if ((n > max) || (batch.header.count != 0))
+		{
+			mailbox_batch_drain(inportal, n*size);
+			return (0);
+		}
+
+		if (kportal_read(inportal, buf, n*size) != (ssize_t) (n*size))
+			return (0);
+
+		return (n);
+	}
+
+	/* Bad batch or not enough room, drop it. */
+	n = batch.header.count;
+	if ((n < 1) || (n > max) || ((n*size) > MAILBOX_BATCH_SIZE))
+		return (0);
+
+	umemcpy(buf, batch.data, n*size);
+
+	return (n);
+}
+
 /*============================================================================*
  * mailbox_close()                                                            *
  *============================================================================*/
@@ -391,7 +630,7 @@ int nanvix_mailbox_close(int mbxid)
 	if ((r = kmailbox_close(mailboxes[mbxid].fd)) != 0)
 		return (r);
 
-	resource_free(&pool_mailboxes, mbxid);
+	resource_index_free(&index_mailboxes, mbxid);
 
 	return (0);
 }
@@ -425,7 +664,7 @@ int nanvix_mailbox_unlink(int mbxid)
 	if (nanvix_name_unlink(mailboxes[mbxid].name) != 0)
 		return (-EAGAIN);
 
-	resource_free(&pool_mailboxes, mbxid);
+	resource_index_free(&index_mailboxes, mbxid);
 
 	return (0);
 }
@@ -32,17 +32,216 @@
 #include <nanvix/ulib.h>
 #include <posix/errno.h>
 #include <posix/stdbool.h>
+#include <posix/stdint.h>
 
 /**
  * @brief Mailbox for small messages.
+ *
+ * @details Updates are sent to the primary name server.
  */
 static int server;
 
+/**
+ * @brief Mailbox to the nearest name server.
+ *
+ * @details Lookups are sent to the nearest name server, which may be
+ * the primary one.
+ */
+static int nearest;
+
 /**
  * @brief Is the name service initialized ?
  */
 static bool initialized = false;
 
+/**
+ * @brief Name Lookup Cache
+ *
+ * @details Lookups are cached for NANVIX_NAME_CACHE_TTL cycles, and
+ * lookups of missing names for NANVIX_NAME_CACHE_NEGATIVE_TTL cycles.
+ * Every reply of the name server carries the generation of names,
+ * which changes when names are linked or unlinked. Whenever a newer
+ * generation is seen, the whole cache is dropped.
+ */
+static struct
+{
+	unsigned generation; /**< Last generation seen. */
+
+	/**
+	 * @brief Cached Lookups
+	 */
+	struct
+	{
+		char name[NANVIX_PROC_NAME_MAX]; /**< Name.                             */
+		int nodenum;                     /**< NoC node, or a negative error.   */
+		uint64_t stamp;                  /**< Time of the lookup.              */
+		uint64_t expire;                 /**< Expiration time (zero if free). */
+	} entries[NANVIX_NAME_CACHE_LENGTH];
+} cache;
+
+/*============================================================================*
+ * name_cache_flush()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Drops all entries of the name lookup cache.
+ */
+static void name_cache_flush(void)
+{
+	for (int i = 0; i < NANVIX_NAME_CACHE_LENGTH; i++)
+		cache.entries[i].expire = 0;
+}
+
+/*============================================================================*
+ * name_cache_search()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Searches for a name in the name lookup cache.
+ *
+ * @param name Target name.
+ *
+ * @returns If @p name is cached, the index of its entry is returned.
+ * Otherwise, a negative number is returned instead.
+ */
+static int name_cache_search(const char *name)
+{
+	for (int i = 0; i < NANVIX_NAME_CACHE_LENGTH; i++)
+	{
+		/* Skip free entries. */
+		if (cache.entries[i].expire == 0)
+			continue;
+
+		/* Found. */
+		if (!ustrcmp(cache.entries[i].name, name))
+			return (i);
+	}
+
+	return (-1);
+}
+
+/*============================================================================*
+ * name_cache_update()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Updates the name lookup cache with a reply of the name server.
+ *
+ * @param generation Generation of names carried by the reply.
+ */
+static void name_cache_update(unsigned generation)
+{
+	/* Names changed. */
+	if (generation != cache.generation)
+	{
+		name_cache_flush();
+		cache.generation = generation;
+	}
+}
+
+/*============================================================================*
+ * name_cache_insert()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Inserts a lookup in the name lookup cache.
+ *
+ * @param name    Target name.
+ * @param nodenum NoC node of @p name, or a negative error code.
+ * @param now     Current time.
+ *
+ * The entry that expires first is evicted, if the cache is full.
+ */
+static void name_cache_insert(const char *name, int nodenum, uint64_t now)
+{
+	int idx;
+
+	/* Pick a victim. */
+	if ((idx = name_cache_search(name)) < 0)
+	{
+		idx = 0;
+		for (int i = 1; i < NANVIX_NAME_CACHE_LENGTH; i++)
+		{
+			if (cache.entries[i].expire < cache.entries[idx].expire)
+				idx = i;
+		}
+	}
+
+	ustrncpy(cache.entries[idx].name, name, NANVIX_PROC_NAME_MAX - 1);
+	cache.entries[idx].name[NANVIX_PROC_NAME_MAX - 1] = '\0';
+	cache.entries[idx].nodenum = nodenum;
+	cache.entries[idx].stamp = now;
+	cache.entries[idx].expire = now + ((nodenum < 0) ?
+		NANVIX_NAME_CACHE_NEGATIVE_TTL : NANVIX_NAME_CACHE_TTL
+	);
+}
+
+/*============================================================================*
+ * nanvix_name_invalidate()                                                   *
+ *============================================================================*/
+
+/**
+ * The nanvix_name_invalidate() function drops the cached lookup of the
+ * name pointed to by @p name. If @p name is a NULL pointer, all cached
+ * lookups are dropped.
+ */
+int nanvix_name_invalidate(const char *name)
+{
+	int idx;
+
+	/* Drop all names. */
+	if (name == NULL)
+	{
+		name_cache_flush();
+		return (0);
+	}
+
+	/* Not cached. */
+	if ((idx = name_cache_search(name)) < 0)
+		return (-ENOENT);
+
+	cache.entries[idx].expire = 0;
+
+	return (0);
+}
+
+/*============================================================================*
+ * name_server_nearest()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Picks the name server nearest to the calling node.
+ *
+ * @returns The ID of the name server whose node number is the closest
+ * to the one of the calling node.
+ */
+static int name_server_nearest(void)
+{
+	int id = 0;
+	int nodenum;
+	int distance;
+
+	nodenum = knode_get_num();
+	distance = name_servers[0].nodenum - nodenum;
+	distance = (distance < 0) ? -distance : distance;
+
+	for (int i = 1; i < NAME_SERVERS_NUM; i++)
+	{
+		int d;
+
+		d = name_servers[i].nodenum - nodenum;
+		d = (d < 0) ? -d : d;
+
+		if (d < distance)
+		{
+			id = i;
+			distance = d;
+		}
+	}
+
+	return (id);
+}
+
 /*============================================================================*
  * __nanvix_name_setup()                                                      *
  *============================================================================*/
@@ -52,14 +251,26 @@ static bool initialized = false;
  */
 int __nanvix_name_setup(void)
 {
+	int id;
+
 	/* Nothing to do. */
 	if (initialized)
 		return (0);
 
 	/* Open connection with Name Server. */
-	if ((server = kmailbox_open(NAME_SERVER_NODE, NAME_SERVER_PORT_NUM)) < 0)
+	if ((server = kmailbox_open(name_servers[0].nodenum, name_servers[0].portnum)) < 0)
+		return (-1);
+
+	/* Open connection with nearest Name Server. */
+	if ((id = name_server_nearest()) == 0)
+		nearest = server;
+	else if ((nearest = kmailbox_open(name_servers[id].nodenum, name_servers[id].portnum)) < 0)
+	{
+		uassert(kmailbox_close(server) == 0);
 		return (-1);
+	}
 
+	name_cache_flush();
 	initialized = true;
 
 	return (0);
@@ -78,6 +289,10 @@ int __nanvix_name_cleanup(void)
 	if (!initialized)
 		return (0);
 
+	/* Close connection with nearest Name Server. */
+	if ((nearest != server) && (kmailbox_close(nearest) < 0))
+		return (-EAGAIN);
+
 	/* Close connection with Name Server. */
 	if (kmailbox_close(server) < 0)
 		return (-EAGAIN);
@@ -92,11 +307,18 @@ int __nanvix_name_cleanup(void)
  *============================================================================*/
 
 /**
- * @todo TODO: provide a long description for this function.
+ * The nanvix_name_lookup() function converts the name pointed to by
+ * @p name into a NoC node number. Lookups are served from the name
+ * lookup cache while they have not expired. Otherwise, the name server
+ * is queried, and its answer is cached. Missing names are cached as
+ * well, so that clients polling for a server that did not come up yet
+ * do not flood the name server.
  */
 int nanvix_name_lookup(const char *name)
 {
 	int ret;
+	int idx;
+	uint64_t now;
 	struct name_message msg;
 
 	/* Initilize name client. */
@@ -107,19 +329,254 @@ int nanvix_name_lookup(const char *name)
 	if ((ret = nanvix_name_is_valid(name)) < 0)
 		return (ret);
 
+	if ((ret = kernel_clock(&now)) < 0)
+		return (ret);
+
+	/* Cache hit. */
+	if ((idx = name_cache_search(name)) >= 0)
+	{
+		if (now < cache.entries[idx].expire)
+			return (cache.entries[idx].nodenum);
+
+		cache.entries[idx].expire = 0;
+	}
+
 	/* Build operation header. */
 	message_header_build(&msg.header, NAME_LOOKUP);
 	ustrcpy(msg.op.lookup.name, name);
 
-	if ((ret = kmailbox_write(server, &msg, sizeof(struct name_message))) != sizeof(struct name_message))
+	if ((ret = kmailbox_write(nearest, &msg, sizeof(struct name_message))) != sizeof(struct name_message))
 		return (ret);
 
 	if ((ret = kmailbox_read(stdinbox_get(), &msg, sizeof(struct name_message))) != sizeof(struct name_message))
 		return (ret);
 
+	name_cache_update(msg.op.ret.generation);
+
+	/* Name not found. */
+	if (msg.header.opcode == NAME_FAIL)
+	{
+		if (msg.op.ret.errcode == -ENOENT)
+			name_cache_insert(name, -ENOENT, now);
+
+		return (msg.op.ret.errcode);
+	}
+
+	name_cache_insert(name, msg.op.ret.nodenum, now);
+
 	return (msg.op.ret.nodenum);
 }
 
+/*============================================================================*
+ * name_lookup_batch()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Sends a batch of lookups to the name server.
+ *
+ * @param names    Names to look up.
+ * @param nodenums Store location for the outcome of each lookup.
+ * @param n        Number of names.
+ * @param now      Current time.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+static int name_lookup_batch(const char **names, int **nodenums, int n, uint64_t now)
+{
+	int ret;
+	size_t off;
+	struct name_message msg;
+
+	/* Build operation header. */
+	message_header_build(&msg.header, NAME_LOOKUP_MULTI);
+	msg.op.lookup_multi.count = n;
+	off = 0;
+	for (int i = 0; i < n; i++)
+	{
+		size_t len = ustrlen(names[i]) + 1;
+
+		umemcpy(&msg.op.lookup_multi.names[off], names[i], len);
+		off += len;
+	}
+
+	if ((ret = kmailbox_write(nearest, &msg, sizeof(struct name_message))) != sizeof(struct name_message))
+		return (ret);
+
+	if ((ret = kmailbox_read(stdinbox_get(), &msg, sizeof(struct name_message))) != sizeof(struct name_message))
+		return (ret);
+
+	name_cache_update(msg.op.ret.generation);
+
+	/* Failed. */
+	if (msg.header.opcode == NAME_FAIL)
+		return (msg.op.ret.errcode);
+
+	for (int i = 0; i < n; i++)
+	{
+		*nodenums[i] = msg.op.ret.data.nodenums[i];
+
+		/* Cache outcome. */
+		if ((*nodenums[i] >= 0) || (*nodenums[i] == -ENOENT))
+			name_cache_insert(names[i], *nodenums[i], now);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_name_lookup_multi()                                                 *
+ *============================================================================*/
+
+/**
+ * The nanvix_name_lookup_multi() function converts the @p n names in
+ * the array pointed to by @p names into NoC node numbers. The outcome
+ * of each lookup, that is either a NoC node number or a negative error
+ * code, is stored in the array pointed to by @p nodenums. Names that
+ * are not cached are sent to the name server in batches of up to
+ * NAME_LOOKUP_MULTI_MAX names.
+ */
+int nanvix_name_lookup_multi(const char **names, int *nodenums, int n)
+{
+	int ret;
+	int nbatch;
+	size_t size;
+	uint64_t now;
+	const char *batch[NAME_LOOKUP_MULTI_MAX];
+	int *results[NAME_LOOKUP_MULTI_MAX];
+
+	/* Initilize name client. */
+	if (!initialized)
+		return (-EAGAIN);
+
+	/* Invalid arguments. */
+	if ((names == NULL) || (nodenums == NULL) || (n < 0))
+		return (-EINVAL);
+
+	if ((ret = kernel_clock(&now)) < 0)
+		return (ret);
+
+	nbatch = 0;
+	size = 0;
+	for (int i = 0; i < n; i++)
+	{
+		int idx;
+		size_t len;
+
+		/* Invalid name. */
+		if ((nodenums[i] = nanvix_name_is_valid(names[i])) < 0)
+			continue;
+
+		/* Cache hit. */
+		if ((idx = name_cache_search(names[i])) >= 0)
+		{
+			if (now < cache.entries[idx].expire)
+			{
+				nodenums[i] = cache.entries[idx].nodenum;
+				continue;
+			}
+
+			cache.entries[idx].expire = 0;
+		}
+
+		len = ustrlen(names[i]) + 1;
+
+		/* Name does not fit in a batch. */
+		if (len > NAME_PACKED_SIZE)
+		{
+			nodenums[i] = nanvix_name_lookup(names[i]);
+			continue;
+		}
+
+		/* Flush batch. */
+		if ((nbatch == NAME_LOOKUP_MULTI_MAX) || ((size + len) > NAME_PACKED_SIZE))
+		{
+			if ((ret = name_lookup_batch(batch, results, nbatch, now)) < 0)
+				return (ret);
+
+			nbatch = 0;
+			size = 0;
+		}
+
+		batch[nbatch] = names[i];
+		results[nbatch++] = &nodenums[i];
+		size += len;
+	}
+
+	/* Flush last batch. */
+	if (nbatch > 0)
+	{
+		if ((ret = name_lookup_batch(batch, results, nbatch, now)) < 0)
+			return (ret);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_name_list()                                                         *
+ *============================================================================*/
+
+/**
+ * The nanvix_name_list() function lists names that start with the
+ * prefix pointed to by @p prefix. Up to @p max names are copied to the
+ * array pointed to by @p names. An empty prefix lists all names.
+ */
+int nanvix_name_list(const char *prefix, char (*names)[NANVIX_PROC_NAME_MAX], int max)
+{
+	int ret;
+	int count;
+	int cursor;
+	struct name_message msg;
+
+	/* Initilize name client. */
+	if (!initialized)
+		return (-EAGAIN);
+
+	/* Invalid arguments. */
+	if ((prefix == NULL) || (names == NULL) || (max < 0))
+		return (-EINVAL);
+
+	/* Prefix too long. */
+	if (ustrlen(prefix) >= NANVIX_PROC_NAME_MAX)
+		return (-ENAMETOOLONG);
+
+	count = 0;
+	cursor = 0;
+	do
+	{
+		size_t off;
+
+		/* Build operation header. */
+		message_header_build(&msg.header, NAME_LIST);
+		msg.op.list.cursor = cursor;
+		ustrcpy(msg.op.list.prefix, prefix);
+
+		if ((ret = kmailbox_write(nearest, &msg, sizeof(struct name_message))) != sizeof(struct name_message))
+			return (ret);
+
+		if ((ret = kmailbox_read(stdinbox_get(), &msg, sizeof(struct name_message))) != sizeof(struct name_message))
+			return (ret);
+
+		name_cache_update(msg.op.ret.generation);
+
+		/* Failed. */
+		if (msg.header.opcode == NAME_FAIL)
+			return (msg.op.ret.errcode);
+
+		off = 0;
+		for (int i = 0; (i < msg.op.ret.data.list.count) && (count < max); i++)
+		{
+			ustrcpy(names[count++], &msg.op.ret.data.list.names[off]);
+			off += ustrlen(&msg.op.ret.data.list.names[off]) + 1;
+		}
+
+		cursor = msg.op.ret.data.list.cursor;
+	} while ((cursor >= 0) && (count < max));
+
+	return (count);
+}
+
 /*============================================================================*
  * nanvix_name_link()                                                         *
  *============================================================================*/
@@ -154,6 +611,9 @@ int nanvix_name_link(int nodenum, const char *name)
 	if ((ret = kmailbox_read(stdinbox_get(), &msg, sizeof(struct name_message))) != sizeof(struct name_message))
 		return (ret);
 
+	name_cache_update(msg.op.ret.generation);
+	nanvix_name_invalidate(name);
+
 	if (msg.header.opcode == NAME_SUCCESS)
 		return (0);
 
@@ -190,18 +650,63 @@ int nanvix_name_unlink(const char *name)
 	if ((ret = kmailbox_read(stdinbox_get(), &msg, sizeof(struct name_message))) != sizeof(struct name_message))
 		return (ret);
 
+	name_cache_update(msg.op.ret.generation);
+	nanvix_name_invalidate(name);
+
 	if (msg.header.opcode == NAME_SUCCESS)
 		return (0);
 
 	return (msg.op.ret.errcode);
 }
 
+/*============================================================================*
+ * nanvix_name_alive()                                                        *
+ *============================================================================*/
+
+/**
+ * The nanvix_name_alive() function asserts whether or not the process
+ * that linked the name pointed to by @p name is alive. The name server
+ * drops names whose heartbeats stop, thus the check is a lookup of @p
+ * name that is served from the name lookup cache only if it was cached
+ * less than NANVIX_NAME_ALIVE_TTL cycles ago. Only names of processes
+ * that send heartbeats ever expire, thus system servers are always
+ * reported alive.
+ */
+int nanvix_name_alive(const char *name)
+{
+	int ret;
+	int idx;
+	uint64_t now;
+
+	/* Initilize name client. */
+	if (!initialized)
+		return (-EAGAIN);
+
+	/* Invalid name. */
+	if ((ret = nanvix_name_is_valid(name)) < 0)
+		return (ret);
+
+	if ((ret = kernel_clock(&now)) < 0)
+		return (ret);
+
+	/* Cached lookup is too old. */
+	if (((idx = name_cache_search(name)) >= 0) && ((now - cache.entries[idx].stamp) >= NANVIX_NAME_ALIVE_TTL))
+		cache.entries[idx].expire = 0;
+
+	return (((ret = nanvix_name_lookup(name)) < 0) ? ret : 0);
+}
+
 /*============================================================================*
  * nanvix_name_heartbeat()                                                    *
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * The nanvix_name_heartbeat() function tells the primary name server
+ * that the calling process is alive. Once a process sends a heartbeat,
+ * the names that it linked expire unless it keeps sending heartbeats
+ * at least every NANVIX_NAME_HEARTBEAT_TIMEOUT cycles. Processes have
+ * to call this function on their own: the runtime does not send
+ * heartbeats in the background.
  */
 int nanvix_name_heartbeat(void)
 {
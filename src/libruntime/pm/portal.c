@@ -27,6 +27,7 @@
 
 #include <nanvix/limits/pm.h>
 #include <nanvix/runtime/pm.h>
+#include <nanvix/runtime/utils.h>
 #include <nanvix/sys/thread.h>
 #include <nanvix/ulib.h>
 #include <posix/errno.h>
@@ -53,6 +54,11 @@ static const struct resource_pool pool_portals = {
 	portals, NANVIX_PORTAL_MAX, sizeof(struct named_portal)
 };
 
+/**
+ * @brief Index of free named portals.
+ */
+static struct resource_index index_portals = RESOURCE_INDEX_INITIALIZER(&pool_portals);
+
 /*============================================================================*
  * nanvix_portal_is_valid()                                                   *
  *============================================================================*/
@@ -200,7 +206,7 @@ int nanvix_portal_create(const char *name)
 		return (-EAGAIN);
 
 	/* Allocate portal. */
-	if ((id = resource_alloc(&pool_portals)) < 0)
+	if ((id = resource_index_alloc(&index_portals)) < 0)
 		return (-EAGAIN);
 
 	nodenum = knode_get_num();
@@ -219,7 +225,7 @@ int nanvix_portal_create(const char *name)
 	return (id);
 
 error0:
-	resource_free(&pool_portals, id);
+	resource_index_free(&index_portals, id);
 	return (-EAGAIN);
 }
 
@@ -261,7 +267,7 @@ int nanvix_portal_create2(const char *name, int port)
 	nodenum = knode_get_num();
 
 	/* Allocate portal. */
-	if ((portalid = resource_alloc(&pool_portals)) < 0)
+	if ((portalid = resource_index_alloc(&index_portals)) < 0)
 		return (-EAGAIN);
 
 	/* Creates the underlying NoC connector. */
@@ -286,7 +292,7 @@ error1:
 		upanic("Could not clean an erroneus call to nanvix_portal_create2(). Aborting.");
 
 error0:
-	resource_free(&pool_portals, portalid);
+	resource_index_free(&index_portals, portalid);
 	return (-EAGAIN);
 }
 
@@ -390,7 +396,7 @@ int nanvix_portal_open(const char *name, int port)
 		return (-EAGAIN);
 
 	/* Allocate a portal. */
-	if ((id = resource_alloc(&pool_portals)) < 0)
+	if ((id = resource_index_alloc(&index_portals)) < 0)
 		return (-EAGAIN);
 
 	/* Open underlying unnamed portal. */
@@ -405,7 +411,8 @@ int nanvix_portal_open(const char *name, int port)
 	return (id);
 
 error0:
-	resource_free(&pool_portals, id);
+	resource_index_free(&index_portals, id);
+	nanvix_name_invalidate(name);
 	return (-EAGAIN);
 }
 
@@ -539,7 +546,7 @@ int nanvix_portal_close(int id)
 	if ((err = kportal_close(portals[id].portalid)) != 0)
 		return (err);
 
-	resource_free(&pool_portals, id);
+	resource_index_free(&index_portals, id);
 
 	return (0);
 }
@@ -585,7 +592,7 @@ int nanvix_portal_unlink(int id)
 	 * destroyed when unloading the runtime system
 	 */
 
-	resource_free(&pool_portals, id);
+	resource_index_free(&index_portals, id);
 
 	return (0);
 }
@@ -58,8 +58,8 @@ static int __do_nanvix_msg_get(key_t key, int msgflg)
 
 	/* Send operation header. */
 	uassert(
-		nanvix_mailbox_write(
-			__nanvix_sysv_outbox(),
+		nanvix_channel_send(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
 		) == 0
@@ -67,11 +67,11 @@ static int __do_nanvix_msg_get(key_t key, int msgflg)
 
 	/* Receive reply. */
 	uassert(
-		kmailbox_read(
-			stdinbox_get(),
+		nanvix_channel_recv(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
-		) == sizeof(struct sysv_message)
+		) == 0
 	);
 
 	if (msg.payload.ret.status < 0)
@@ -114,8 +114,8 @@ int __do_nanvix_msg_close(int msgid)
 
 	/* Send operation header. */
 	uassert(
-		nanvix_mailbox_write(
-			__nanvix_sysv_outbox(),
+		nanvix_channel_send(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
 		) == 0
@@ -123,11 +123,11 @@ int __do_nanvix_msg_close(int msgid)
 
 	/* Receive reply. */
 	uassert(
-		kmailbox_read(
-			stdinbox_get(),
+		nanvix_channel_recv(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
-		) == sizeof(struct sysv_message)
+		) == 0
 	);
 
 	return (msg.payload.ret.status);
@@ -175,7 +175,7 @@ int __do_nanvix_msg_send(
 	message_header_build2(
 		&msg.header,
 		SYSV_MSG_SEND,
-		kcomm_get_port(__nanvix_sysv_outportal(), COMM_TYPE_PORTAL)
+		nanvix_channel_get_port(__nanvix_sysv_channel())
 	);
 	msg.payload.msg.send.msgid = msgid;
 	msg.payload.msg.send.msgsz = msgsz;
@@ -183,8 +183,8 @@ int __do_nanvix_msg_send(
 
 	/* Send operation header. */
 	uassert(
-		nanvix_mailbox_write(
-			__nanvix_sysv_outbox(),
+		nanvix_channel_send(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
 		) == 0
@@ -192,8 +192,8 @@ int __do_nanvix_msg_send(
 
 	/* Send data. */
 	uassert(
-		nanvix_portal_write(
-			__nanvix_sysv_outportal(),
+		nanvix_channel_write(
+			__nanvix_sysv_channel(),
 			msgp,
 			msgsz	
 		) == (ssize_t) msgsz 
@@ -201,11 +201,11 @@ int __do_nanvix_msg_send(
 
 	/* Receive reply. */
 	uassert(
-		kmailbox_read(
-			stdinbox_get(),
+		nanvix_channel_recv(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
-		) == sizeof(struct sysv_message)
+		) == 0
 	);
 
 	return (msg.payload.ret.status);
@@ -270,8 +270,8 @@ int __do_nanvix_msg_receive(
 
 	/* Send operation header. */
 	uassert(
-		nanvix_mailbox_write(
-			__nanvix_sysv_outbox(),
+		nanvix_channel_send(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
 		) == 0
@@ -279,11 +279,11 @@ int __do_nanvix_msg_receive(
 
 	/* Wait acknowledge. */
 	uassert(
-		kmailbox_read(
-			stdinbox_get(),
+		nanvix_channel_recv(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
-		) == sizeof(struct sysv_message)
+		) == 0
 	);
 
 	/* Operation not permitted*/
@@ -292,27 +292,21 @@ int __do_nanvix_msg_receive(
 
 	/* Receive data. */
 	uassert(
-		kportal_allow(
-			stdinportal_get(),
-			SYSV_SERVER_NODE,
-			msg.header.portal_port
-		) == 0
-	);
-	uassert(
-		kportal_read(
-			stdinportal_get(),
+		nanvix_channel_read(
+			__nanvix_sysv_channel(),
 			msgp,
-			msgsz
+			msgsz,
+			msg.header.portal_port
 		) == (ssize_t) msgsz 
 	);
 
 	/* Receive reply. */
 	uassert(
-		kmailbox_read(
-			stdinbox_get(),
+		nanvix_channel_recv(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
-		) == sizeof(struct sysv_message)
+		) == 0
 	);
 
 	return (msg.payload.ret.status);
@@ -56,8 +56,8 @@ static int __do_nanvix_semget(key_t key, int semflg)
 
 	/* Send operation header. */
 	uassert(
-		nanvix_mailbox_write(
-			__nanvix_sysv_outbox(),
+		nanvix_channel_send(
+			__nanvix_sysv_channel(),
 			&sem,
 			sizeof(struct sysv_message)
 		) == 0
@@ -65,11 +65,11 @@ static int __do_nanvix_semget(key_t key, int semflg)
 
 	/* Receive reply. */
 	uassert(
-		kmailbox_read(
-			stdinbox_get(),
+		nanvix_channel_recv(
+			__nanvix_sysv_channel(),
 			&sem,
 			sizeof(struct sysv_message)
-		) == sizeof(struct sysv_message)
+		) == 0
 	);
 
 	if (sem.payload.ret.status < 0)
@@ -110,8 +110,8 @@ int __do_nanvix_sem_close(int semid)
 
 	/* Send operation header. */
 	uassert(
-		nanvix_mailbox_write(
-			__nanvix_sysv_outbox(),
+		nanvix_channel_send(
+			__nanvix_sysv_channel(),
 			&sem,
 			sizeof(struct sysv_message)
 		) == 0
@@ -119,11 +119,11 @@ int __do_nanvix_sem_close(int semid)
 
 	/* Receive reply. */
 	uassert(
-		kmailbox_read(
-			stdinbox_get(),
+		nanvix_channel_recv(
+			__nanvix_sysv_channel(),
 			&sem,
 			sizeof(struct sysv_message)
-		) == sizeof(struct sysv_message)
+		) == 0
 	);
 
 	return (sem.payload.ret.status);
@@ -173,8 +173,8 @@ int __do_nanvix_semop(int semid, const struct nanvix_sembuf *sops, size_t nsops)
 
 	/* Send operation header. */
 	uassert(
-		nanvix_mailbox_write(
-			__nanvix_sysv_outbox(),
+		nanvix_channel_send(
+			__nanvix_sysv_channel(),
 			&sem,
 			sizeof(struct sysv_message)
 		) == 0
@@ -182,11 +182,11 @@ int __do_nanvix_semop(int semid, const struct nanvix_sembuf *sops, size_t nsops)
 
 	/* Receive reply. */
 	uassert(
-		kmailbox_read(
-			stdinbox_get(),
+		nanvix_channel_recv(
+			__nanvix_sysv_channel(),
 			&sem,
 			sizeof(struct sysv_message)
-		) == sizeof(struct sysv_message)
+		) == 0
 	);
 
 	return (sem.payload.ret.status);
@@ -31,6 +31,7 @@
 #include <nanvix/runtime/pm.h>
 #include <nanvix/runtime/mm.h>
 #include <nanvix/runtime/stdikc.h>
+#include <nanvix/runtime/utils.h>
 #include <nanvix/sys/thread.h>
 #include <nanvix/config.h>
 #include <nanvix/ulib.h>
@@ -69,6 +70,11 @@ struct resource_pool pool = {
 	oregions, NANVIX_SHM_OPEN_MAX, sizeof(struct oregion)
 };
 
+/**
+ * @brief Index of free open shared memory regions.
+ */
+static struct resource_index pool_index = RESOURCE_INDEX_INITIALIZER(&pool);
+
 /*============================================================================*
  * __nanvix_shm_lookup_name()                                                 *
  *============================================================================*/
@@ -203,8 +209,8 @@ static int __do_nanvix_shm_ftruncate(int shmid, off_t size)
 
 	/* Send operation. */
 	uassert(
-		nanvix_mailbox_write(
-			__nanvix_sysv_outbox(),
+		nanvix_channel_send(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
 		) == 0
@@ -212,17 +218,17 @@ static int __do_nanvix_shm_ftruncate(int shmid, off_t size)
 
 	/* Receive reply. */
 	uassert(
-		kmailbox_read(
-			stdinbox_get(),
+		nanvix_channel_recv(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
-		) == sizeof(struct sysv_message)
+		) == 0
 	);
 
 	/* Failed to truncate shared memory region. */
 	if (msg.header.opcode == SYSV_SHM_FAIL)
 	{
-		resource_free(&pool, oshmid);
+		resource_index_free(&pool_index, oshmid);
 		return (msg.payload.ret.status);
 	}
 
@@ -280,12 +286,12 @@ static int __do_nanvix_shm_create(const char *name, int oflags, mode_t mode)
 	 * Allocate an entry in the local
 	 * table of opened shared memory regions.
 	 */
-	if ((oshmid = resource_alloc(&pool)) < 0)
+	if ((oshmid = resource_index_alloc(&pool_index)) < 0)
 		return (-ENFILE);
 
 	if (!(oflags & (O_RDWR | O_WRONLY)))
 	{
-		resource_free(&pool, oshmid);
+		resource_index_free(&pool_index, oshmid);
 		return (-EACCES);
 	}
 
@@ -297,8 +303,8 @@ static int __do_nanvix_shm_create(const char *name, int oflags, mode_t mode)
 
 	/* Send operation. */
 	uassert(
-		nanvix_mailbox_write(
-			__nanvix_sysv_outbox(),
+		nanvix_channel_send(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
 		) == 0
@@ -306,17 +312,17 @@ static int __do_nanvix_shm_create(const char *name, int oflags, mode_t mode)
 
 	/* Receive reply. */
 	uassert(
-		kmailbox_read(
-			stdinbox_get(),
+		nanvix_channel_recv(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
-		) == sizeof(struct sysv_message)
+		) == 0
 	);
 
 	/* Failed to open shared memory region. */
 	if (msg.header.opcode == SYSV_SHM_FAIL)
 	{
-		resource_free(&pool, oshmid);
+		resource_index_free(&pool_index, oshmid);
 		return (msg.payload.ret.status);
 	}
 
@@ -395,7 +401,7 @@ static int __do_nanvix_shm_open(const char *name, int oflags, mode_t mode)
 	 * Allocate an entry in the local
 	 * table of opened shared memory regions.
 	 */
-	if ((oshmid = resource_alloc(&pool)) < 0)
+	if ((oshmid = resource_index_alloc(&pool_index)) < 0)
 		return (-ENFILE);
 
 	/* Build message.*/
@@ -405,8 +411,8 @@ static int __do_nanvix_shm_open(const char *name, int oflags, mode_t mode)
 
 	/* Send operation. */
 	uassert(
-		nanvix_mailbox_write(
-			__nanvix_sysv_outbox(),
+		nanvix_channel_send(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
 		) == 0
@@ -414,17 +420,17 @@ static int __do_nanvix_shm_open(const char *name, int oflags, mode_t mode)
 
 	/* Receive reply. */
 	uassert(
-		kmailbox_read(
-			stdinbox_get(),
+		nanvix_channel_recv(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
-		) == sizeof(struct sysv_message)
+		) == 0
 	);
 
 	/* Failed to open shared memory region. */
 	if (msg.header.opcode == SYSV_SHM_FAIL)
 	{
-		resource_free(&pool, oshmid);
+		resource_index_free(&pool_index, oshmid);
 		return (msg.payload.ret.status);
 	}
 
@@ -498,8 +504,8 @@ static int __do_nanvix_shm_unlink(const char *name)
 
 	/* Send operation. */
 	uassert(
-		nanvix_mailbox_write(
-			__nanvix_sysv_outbox(),
+		nanvix_channel_send(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
 		) == 0
@@ -507,11 +513,11 @@ static int __do_nanvix_shm_unlink(const char *name)
 
 	/* Receive reply. */
 	uassert(
-		kmailbox_read(
-			stdinbox_get(),
+		nanvix_channel_recv(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
-		) == sizeof(struct sysv_message)
+		) == 0
 	);
 
 	/* Failed to unlink shared memory region. */
@@ -519,7 +525,7 @@ static int __do_nanvix_shm_unlink(const char *name)
 		return (msg.payload.ret.status);
 
 	/* Release region. */
-	resource_free(&pool, oshmid);
+	resource_index_free(&pool_index, oshmid);
 
 	return (0);
 }
@@ -578,8 +584,8 @@ static int __do_nanvix_shm_close(int shmid)
 
 		/* Send operation. */
 		uassert(
-			nanvix_mailbox_write(
-				__nanvix_sysv_outbox(),
+			nanvix_channel_send(
+				__nanvix_sysv_channel(),
 				&msg,
 				sizeof(struct sysv_message)
 			) == 0
@@ -587,11 +593,11 @@ static int __do_nanvix_shm_close(int shmid)
 
 		/* Receive reply. */
 		uassert(
-			kmailbox_read(
-				stdinbox_get(),
+			nanvix_channel_recv(
+				__nanvix_sysv_channel(),
 				&msg,
 				sizeof(struct sysv_message)
-			) == sizeof(struct sysv_message)
+			) == 0
 		);
 
 		/* Failed to close shared memory region. */
@@ -602,7 +608,7 @@ static int __do_nanvix_shm_close(int shmid)
 	/* Release region. */
 	oregions[oshmid].refcount--;
 	if ((oregions[oshmid].refcount == 0) && !(oregions[oshmid].oflags & O_CREAT))
-		resource_free(&pool, oshmid);
+		resource_index_free(&pool_index, oshmid);
 
 	return (0);
 }
@@ -781,8 +787,8 @@ static int __do_nanvix_shm_inval(int shmid)
 
 	/* Send operation. */
 	uassert(
-		nanvix_mailbox_write(
-			__nanvix_sysv_outbox(),
+		nanvix_channel_send(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
 		) == 0
@@ -790,11 +796,11 @@ static int __do_nanvix_shm_inval(int shmid)
 
 	/* Receive reply. */
 	uassert(
-		kmailbox_read(
-			stdinbox_get(),
+		nanvix_channel_recv(
+			__nanvix_sysv_channel(),
 			&msg,
 			sizeof(struct sysv_message)
-		) == sizeof(struct sysv_message)
+		) == 0
 	);
 
 	/* Failed to close shared memory region. */
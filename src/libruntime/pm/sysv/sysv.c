@@ -39,12 +39,10 @@
 static struct
 {
 	int initialized; /**< Is the connection initialized? */
-	int outbox;      /**< Output mailbox for requests.   */
-	int outportal;   /**< Output portal for data.        */
+	int channel;     /**< Channel to the server.         */
 } server = {
 	.initialized = 0,
-	.outbox = -1,
-	.outportal = -1
+	.channel = -1
 };
 
 #endif
@@ -54,7 +52,8 @@ static struct
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * The __nanvix_sysv_is_initialized() function asserts whether or not
+ * the connection to the System V server is initialized.
  */
 int __nanvix_sysv_is_initialized(void)
 {
@@ -62,27 +61,16 @@ int __nanvix_sysv_is_initialized(void)
 }
 
 /*============================================================================*
- * __nanvix_sysv_outbox()                                                     *
+ * __nanvix_sysv_channel()                                                    *
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * The __nanvix_sysv_channel() function returns the channel through
+ * which requests are sent to the System V server.
  */
-int __nanvix_sysv_outbox(void)
+int __nanvix_sysv_channel(void)
 {
-	return (server.outbox);
-}
-
-/*============================================================================*
- * __nanvix_sysv_outportal()                                                  *
- *============================================================================*/
-
-/**
- * @todo TODO: provide a detailed description for this function.
- */
-int __nanvix_sysv_outportal(void)
-{
-	return (server.outportal);
+	return (server.channel);
 }
 
 /*============================================================================*
@@ -108,9 +96,10 @@ int nanvix_sysv_shutdown(void)
 
 	/* Send operation header. */
 	uassert(
-		nanvix_mailbox_write(
-			server.outbox,
-			&msg, sizeof(struct sysv_message)
+		nanvix_channel_send(
+			server.channel,
+			&msg,
+			sizeof(struct sysv_message)
 		) == 0
 	);
 
@@ -135,18 +124,11 @@ int __nanvix_sysv_setup(void)
 	if (server.initialized)
 		return (0);
 
-	/* Open output mailbox */
-	if ((server.outbox = nanvix_mailbox_open(SYSV_SERVER_NAME, SYSV_SERVER_PORT_NUM)) < 0)
+	/* Connect channel. */
+	if ((server.channel = nanvix_channel_connect(SYSV_SERVER_NAME, SYSV_SERVER_PORT_NUM)) < 0)
 	{
-		uprintf("[nanvix][sysv] cannot open outbox to server");
-		return (server.outbox);
-	}
-
-	/* Open underlying IPC connectors. */
-	if ((server.outportal = nanvix_portal_open(SYSV_SERVER_NAME, SYSV_SERVER_PORT_NUM)) < 0)
-	{
-		uprintf("[nanvix][sysv] cannot open outportal to server");
-		return (server.outportal);
+		uprintf("[nanvix][sysv] cannot connect to server");
+		return (server.channel);
 	}
 
 	__nanvix_shm_setup();
@@ -179,20 +161,13 @@ int __nanvix_sysv_cleanup(void)
 
 	__nanvix_shm_cleanup();
 
-	/* Close output mailbox. */
-	if ((ret = nanvix_mailbox_close(server.outbox)) < 0)
+	/* Disconnect channel. */
+	if ((ret = nanvix_channel_disconnect(server.channel)) < 0)
 	{
-		uprintf("[nanvix][sysv] cannot close outbox to server");
+		uprintf("[nanvix][sysv] cannot disconnect from server");
 		return (ret);
 	}
 
-	/* Close underlying IPC connectors. */
-	if (nanvix_portal_close(server.outportal) < 0)
-	{
-		uprintf("[nanvix][sysv] cannot close outportal to server");
-		return (-EAGAIN);
-	}
-
 	server.initialized = 0;
 
 #endif
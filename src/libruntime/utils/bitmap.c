@@ -100,6 +100,46 @@ bitmap_t bitmap_first_free(bitmap_t *bitmap, size_t size)
 	return (BITMAP_FULL);
 }
 
+/**
+ * The bitmap_next_free() function searches for the first free bit in
+ * the bitmap pointed to by @p bitmap, starting from bit @p start and
+ * wrapping around at the end. Bits are checked one word at a time, so
+ * that full words are skipped at once.
+ */
+bitmap_t bitmap_next_free(bitmap_t *bitmap, size_t size, bitmap_t start)
+{
+	bitmap_t idx;    /* Word index.      */
+	bitmap_t chunk;  /* Working chunk.   */
+	bitmap_t nwords; /* Number of words. */
+
+	nwords = (size >> 2);
+
+	/* Nothing to do. */
+	if (nwords == 0)
+		return (BITMAP_FULL);
+
+	/* Start over. */
+	if (IDX(start) >= nwords)
+		start = 0;
+
+	/* Skip bits that come before the start point. */
+	idx = IDX(start);
+	chunk = bitmap[idx] | ((1U << OFF(start)) - 1);
+
+	/* Revisit the first word at the end, without the mask. */
+	for (bitmap_t i = 0; i <= nwords; i++)
+	{
+		/* Index found. */
+		if (chunk != 0xffffffff)
+			return ((idx << BITMAP_WORD_SHIFT) + __builtin_ctz(~chunk));
+
+		idx = (idx + 1) % nwords;
+		chunk = bitmap[idx];
+	}
+
+	return (BITMAP_FULL);
+}
+
 /**
  * @todo TODO: provide a detailed description for this function.
  */
@@ -0,0 +1,141 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __NEED_RESOURCE
+
+#include <nanvix/hal/resource.h>
+#include <nanvix/runtime/utils.h>
+#include <nanvix/ulib.h>
+
+/*============================================================================*
+ * resource_index_get()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Gets a resource of the pool of an index.
+ *
+ * @param index Target resource index.
+ * @param id    ID of the target resource.
+ *
+ * @returns The resource @p id of the pool of @p index.
+ */
+static inline struct resource *resource_index_get(
+	const struct resource_index *index,
+	int id
+)
+{
+	return ((struct resource *)(
+		(char *) index->pool->resources + id*index->pool->resource_size
+	));
+}
+
+/*============================================================================*
+ * resource_index_reset()                                                     *
+ *============================================================================*/
+
+/**
+ * The resource_index_reset() function rebuilds the index pointed to by
+ * @p index. Resources that are not in use in the underlying pool are
+ * marked as free in the index.
+ */
+void resource_index_reset(struct resource_index *index)
+{
+	uassert(index->pool->nresources <= RESOURCE_INDEX_MAX);
+
+	index->summary = 0;
+	umemset(index->map, 0, sizeof(index->map));
+
+	for (int i = 0; i < index->pool->nresources; i++)
+	{
+		if (!resource_is_used(resource_index_get(index, i)))
+		{
+			bitmap_set(index->map, i);
+			index->summary |= (1U << IDX(i));
+		}
+	}
+
+	index->initialized = 1;
+}
+
+/*============================================================================*
+ * resource_index_alloc()                                                     *
+ *============================================================================*/
+
+/**
+ * The resource_index_alloc() function allocates the free resource with
+ * the lowest ID in the pool of the index pointed to by @p index. It
+ * picks the same resource as resource_alloc() would, but in constant
+ * time rather than with a linear scan of the pool.
+ *
+ * @note This function is @b NOT thread safe.
+ */
+int resource_index_alloc(struct resource_index *index)
+{
+	int w;
+	int id;
+
+	if (!index->initialized)
+		resource_index_reset(index);
+
+	/* No free resource. */
+	if (index->summary == 0)
+		return (-1);
+
+	w = __builtin_ctz(index->summary);
+	id = (w << BITMAP_WORD_SHIFT) + __builtin_ctz(index->map[w]);
+
+	bitmap_clear(index->map, id);
+	if (index->map[w] == 0)
+		index->summary &= ~(1U << w);
+
+	resource_set_used(resource_index_get(index, id));
+
+	return (id);
+}
+
+/*============================================================================*
+ * resource_index_free()                                                      *
+ *============================================================================*/
+
+/**
+ * The resource_index_free() function releases the resource @p id of
+ * the pool of the index pointed to by @p index.
+ *
+ * @note This function is @b NOT thread safe.
+ */
+void resource_index_free(struct resource_index *index, int id)
+{
+	if (!index->initialized)
+		resource_index_reset(index);
+
+	/* Invalid resource. */
+	if ((id < 0) || (id >= index->pool->nresources))
+		return;
+
+	resource_free(index->pool, id);
+
+	bitmap_set(index->map, id);
+	index->summary |= (1U << IDX(id));
+}
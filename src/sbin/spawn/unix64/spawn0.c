@@ -37,7 +37,11 @@
  */
 const struct serverinfo spawn_servers[SPAWN_SERVERS_NUM] = {
 	{ .ring = SPAWN_RING_0, .main = name_server },
+#if (NANVIX_VFS_RMEM)
+	{ .ring = SPAWN_RING_2, .main = vfs_server  }, /* Remote disk needs mailboxes/portals. */
+#else
 	{ .ring = SPAWN_RING_1, .main = vfs_server  },
+#endif
 };
 
 SPAWN_SERVERS(SPAWN_SERVERS_NUM, spawn_servers, SPAWN_SERVER_0_NAME)
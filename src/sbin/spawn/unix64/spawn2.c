@@ -30,13 +30,19 @@
 /**
  * @brief Number of servers.
  */
-#define SPAWN_SERVERS_NUM 1
+#define SPAWN_SERVERS_NUM 3
 
 /**
  * @brief Table of servers.
  */
 const struct serverinfo spawn_servers[SPAWN_SERVERS_NUM] = {
+	{ .ring = SPAWN_RING_0, .main = name_server },
 	{ .ring = SPAWN_RING_1, .main = rmem_server },
+#if (NANVIX_VFS_RMEM)
+	{ .ring = SPAWN_RING_2, .main = vfs_server  }, /* Remote disk needs mailboxes/portals. */
+#else
+	{ .ring = SPAWN_RING_1, .main = vfs_server  },
+#endif
 };
 
 SPAWN_SERVERS(SPAWN_SERVERS_NUM, spawn_servers, SPAWN_SERVER_2_NAME)
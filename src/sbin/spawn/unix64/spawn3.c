@@ -30,12 +30,13 @@
 /**
  * @brief Number of servers.
  */
-#define SPAWN_SERVERS_NUM 1
+#define SPAWN_SERVERS_NUM 2
 
 /**
  * @brief Table of servers.
  */
 const struct serverinfo spawn_servers[SPAWN_SERVERS_NUM] = {
+	{ .ring = SPAWN_RING_0, .main = name_server },
 	{ .ring = SPAWN_RING_3, .main = sysv_server },
 };
 
@@ -22,23 +22,70 @@
  * SOFTWARE.
  */
 
+#include <nanvix/servers/connection.h>
 #include <nanvix/limits.h>
 #include <nanvix/types.h>
 #include <nanvix/ulib.h>
 #include <posix/errno.h>
 
+/**
+ * @brief Number of hash buckets in the table of connections.
+ */
+#define CONNECTIONS_HASH_LENGTH (NANVIX_CONNECTIONS_MAX/2)
+
 /**
  * @brief Connections
  */
-static struct connection
+static struct
 {
-	nanvix_pid_t remote; /**< PID.                  */
-	int port;            /**< Port Number.          */
-	int count;           /**< Number of Connections */
+	struct connection conn; /**< Connection.                             */
+	int hnext;              /**< Next in hash chain or in free list.     */
+	int pos;                /**< Position in the list of active entries. */
 } connections[NANVIX_CONNECTIONS_MAX];
 
+/**
+ * @brief Hash table for the table of connections.
+ */
+static int buckets[CONNECTIONS_HASH_LENGTH];
+
+/**
+ * @brief List of free connections.
+ */
+static int freelist = -1;
+
+/**
+ * @brief Dense list of active connections.
+ */
+static struct
+{
+	int n;                             /**< Number of active connections. */
+	int list[NANVIX_CONNECTIONS_MAX];  /**< Active connections.           */
+} active = { 0, { 0 } };
+
+/**
+ * @brief Number of requests served on all connections.
+ */
+static unsigned nrequests = 0;
+
 /*============================================================================*
- * connect()                                                                  *
+ * connection_hash()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Hashes a connection.
+ *
+ * @param remote PID of the remote.
+ * @param port   Remote port number.
+ *
+ * @returns The hash value of the target connection.
+ */
+static inline int connection_hash(nanvix_pid_t remote, int port)
+{
+	return (((unsigned) remote*31 + (unsigned) port)%CONNECTIONS_HASH_LENGTH);
+}
+
+/*============================================================================*
+ * lookup()                                                                   *
  *============================================================================*/
 
 /**
@@ -56,23 +103,48 @@ int lookup(nanvix_pid_t remote, int port)
 		return (-EINVAL);
 
 	/* Lookup connection. */
-	for (int i = 0; i < NANVIX_CONNECTIONS_MAX; i++)
+	for (int i = buckets[connection_hash(remote, port)]; i >= 0; i = connections[i].hnext)
 	{
 		/* Found. */
-		if ((connections[i].remote == remote) && (connections[i].port == port))
+		if ((connections[i].conn.remote == remote) && (connections[i].conn.port == port))
 			return (i);
 	}
-	
+
 	return (-ENOENT);
 }
 
+/*============================================================================*
+ * connection_request()                                                       *
+ *============================================================================*/
+
+/**
+ * The connection_request() function accounts a request that the running
+ * server has received from the process @p remote, on the port @p port.
+ * Servers should call it once per request, in their dispatch path.
+ */
+int connection_request(nanvix_pid_t remote, int port)
+{
+	int i;
+
+	/* Unregistered remote. */
+	if ((i = lookup(remote, port)) < 0)
+		return (i);
+
+	connections[i].conn.nrequests++;
+	nrequests++;
+
+	return (i);
+}
+
 /*============================================================================*
  * connect()                                                                  *
  *============================================================================*/
 
 /**
  * The connect() function connects the remote client @p remote to the
- * running server.
+ * running server. Connections are reference counted, and a remote
+ * keeps the same index in the table of connections until its last
+ * reference is dropped.
  */
 int connect(nanvix_pid_t remote, int port)
 {
@@ -89,27 +161,32 @@ int connect(nanvix_pid_t remote, int port)
 	/* Registered remote? */
 	if ((i = lookup(remote, port)) < 0)
 	{
-		/* Looks for an empty slot in the table of connections. */
-		for (i = 0; i < NANVIX_CONNECTIONS_MAX; i++)
-		{
-			/* Found. */
-			if (connections[i].remote < 0)
-			{
-				connections[i].remote = remote;
-				connections[i].port = port;
-				connections[i].count = 0;
-				goto out;
-			}
-		}
+		int hash;
+
+		/* Table of connections is full. */
+		if ((i = freelist) < 0)
+			return (-EAGAIN);
 
-		return (-EAGAIN);
+		freelist = connections[i].hnext;
+
+		connections[i].conn.remote = remote;
+		connections[i].conn.port = port;
+		connections[i].conn.count = 0;
+		connections[i].conn.nrequests = 0;
+
+		/* Insert in the hash table. */
+		hash = connection_hash(remote, port);
+		connections[i].hnext = buckets[hash];
+		buckets[hash] = i;
+
+		/* Insert in the list of active connections. */
+		connections[i].pos = active.n;
+		active.list[active.n++] = i;
 	}
 
-out:
+	connections[i].conn.count++;
 
-	connections[i].count++;
-	
-	return (0);
+	return (i);
 }
 
 /*============================================================================*
@@ -123,6 +200,7 @@ out:
 int disconnect(nanvix_pid_t remote, int port)
 {
 	int i;
+	int *p;
 
 	/* Invalid PID. */
 	if (remote < 0)
@@ -136,42 +214,96 @@ int disconnect(nanvix_pid_t remote, int port)
 	if ((i = lookup(remote, port)) < 0)
 		return (-ENOENT);
 
+	/* Still in use. */
+	if (--connections[i].conn.count > 0)
+		return (0);
+
+	/* Remove from the hash table. */
+	for (p = &buckets[connection_hash(remote, port)]; *p >= 0; p = &connections[*p].hnext)
+	{
+		/* Found. */
+		if (*p == i)
+		{
+			*p = connections[i].hnext;
+			break;
+		}
+	}
+
+	/* Remove from the list of active connections. */
+	active.list[connections[i].pos] = active.list[--active.n];
+	connections[active.list[connections[i].pos]].pos = connections[i].pos;
+
 	/* Unlink remote. */
-	if (connections[i].count-- == 1)
-		connections[i].remote = -1;
-	
+	connections[i].conn.remote = -1;
+	connections[i].conn.port = -1;
+	connections[i].pos = -1;
+	connections[i].hnext = freelist;
+	freelist = i;
+
 	return (0);
 }
 
 /*============================================================================*
- * connect()                                                                  *
+ * connections_count()                                                        *
  *============================================================================*/
 
 /**
- * The get_connections() returns the connections that are established
- * with the running server. Connections are place in the buffer pointed
- * to by @p buf.
+ * The connections_count() function returns the number of connections
+ * that are established with the running server.
  */
-int get_connections(struct connection *buf)
+int connections_count(void)
 {
-	int count;
+	return (active.n);
+}
 
-	/* Invalid buffer. */
-	if (buf == NULL)
-		return (-EINVAL);
+/*============================================================================*
+ * connections_nrequests()                                                    *
+ *============================================================================*/
 
-	/* Traverse table of connections. */
-	count = 0;
-	for (int i = 0; i < NANVIX_CONNECTIONS_MAX; i++)
-	{
-		/* Skip invalid connections. */
-		if (connections[i].remote < 0)
-			continue;
+/**
+ * The connections_nrequests() function returns the number of requests
+ * that the running server has served on all connections, including the
+ * ones that are already closed.
+ */
+unsigned connections_nrequests(void)
+{
+	return (nrequests);
+}
 
-		umemcpy(&buf[count++], &connections[i], sizeof(struct connection));
-	}
-	
-	return (count);
+/*============================================================================*
+ * connections_get()                                                          *
+ *============================================================================*/
+
+/**
+ * The connections_get() function returns the @p i-th connection that
+ * is established with the running server. Connections are not copied,
+ * thus the returned one is only valid until the next call to
+ * connect() or disconnect().
+ */
+const struct connection *connections_get(int i)
+{
+	/* Invalid position. */
+	if (!WITHIN(i, 0, active.n))
+		return (NULL);
+
+	return (&connections[active.list[i]].conn);
+}
+
+/*============================================================================*
+ * connection_get_remote()                                                    *
+ *============================================================================*/
+
+/**
+ * The connection_get_remote() function returns the PID of the remote
+ * of the connection @p connection.
+ */
+nanvix_pid_t connection_get_remote(int connection)
+{
+	/* Invalid connection. */
+	if ((connection < 0) || (connection >= NANVIX_CONNECTIONS_MAX))
+		return (-EINVAL);
+
+	return (connections[connection].conn.remote);
 }
 
 /*============================================================================*
@@ -179,7 +311,8 @@ int get_connections(struct connection *buf)
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * The connection_get_port() function returns the remote port number of
+ * the connection @p connection.
  */
 int connection_get_port(int connection)
 {
@@ -187,7 +320,7 @@ int connection_get_port(int connection)
 	if ((connection < 0) || (connection >= NANVIX_CONNECTIONS_MAX))
 		return (-EINVAL);
 
-	return (connections[connection].port);
+	return (connections[connection].conn.port);
 }
 
 /*============================================================================*
@@ -199,10 +332,22 @@ int connection_get_port(int connection)
  */
 void connections_setup(void)
 {
-	for (int i = 0; i < NANVIX_CONNECTIONS_MAX; i++)
+	for (int i = 0; i < CONNECTIONS_HASH_LENGTH; i++)
+		buckets[i] = -1;
+
+	/* Chain all connections in the free list. */
+	freelist = -1;
+	for (int i = NANVIX_CONNECTIONS_MAX - 1; i >= 0; i--)
 	{
-		connections[i].remote = -1;
-		connections[i].count = 0;
-		connections[i].port = -1;
+		connections[i].conn.remote = -1;
+		connections[i].conn.count = 0;
+		connections[i].conn.port = -1;
+		connections[i].conn.nrequests = 0;
+		connections[i].pos = -1;
+		connections[i].hnext = freelist;
+		freelist = i;
 	}
+
+	active.n = 0;
+	nrequests = 0;
 }
@@ -28,6 +28,7 @@
 
 #include <nanvix/hal/resource.h>
 #include <nanvix/servers/vfs.h>
+#include <nanvix/sys/semaphore.h>
 #include <nanvix/config.h>
 #include <nanvix/dev.h>
 #include <nanvix/ulib.h>
@@ -63,6 +64,11 @@ struct buffer
  */
 static struct buffer buffers[NANVIX_FS_NR_BUFFERS];
 
+/**
+ * @brief Block cache lock.
+ */
+static struct nanvix_semaphore lock;
+
 /**
  * The buffer_get_data() function gets a reference to the underlying
  * data of the block buffer pointed to by @p buf.
@@ -95,7 +101,9 @@ int buffer_set_dirty(struct buffer *buf)
 	if ((buf < &buffers[0]) || (buf >= &buffers[NANVIX_FS_NR_BUFFERS]))
 		return (-EINVAL);
 
-	resource_set_dirty(&buf->flags);
+	nanvix_semaphore_down(&lock);
+		resource_set_dirty(&buf->flags);
+	nanvix_semaphore_up(&lock);
 
 	return (0);
 }
@@ -120,6 +128,8 @@ int buffer_is_dirty(struct buffer *buf)
 /**
  * @brief Evits a block from the block cache.
  *
+ * @note The block cache lock should be held.
+ *
  * @returns Upon successful completion, a pointer to a free block buffer
  * is returned. Else, a NULL pointer is returned instead.
  */
@@ -170,6 +180,8 @@ static struct buffer *evict(void)
 /**
  * @brief Gets a block buffer from the block cache.
  *
+ * @note The block cache lock should be held.
+ *
  * @param dev Number of target device.
  * @param num Number of target lcok.
  *
@@ -212,6 +224,20 @@ found:
 	return (buf);
 }
 
+/**
+ * @brief Releases a block buffer.
+ *
+ * @param buf Target block buffer.
+ *
+ * @note The block cache lock should be held.
+ */
+static void do_brelse(struct buffer *buf)
+{
+	/* Release buffer. */
+	if (buf->count-- == 1)
+		resource_set_unused(&buf->flags);
+}
+
 /**
  * The brelse function releases the block poitned to by @p buf. If its
  * reference count drops to zero, the block buffer is put into the block
@@ -219,6 +245,8 @@ found:
  */
 int brelse(struct buffer *buf)
 {
+	int ret = 0;
+
 	/* Invalid buffer. */
 	if (buf == NULL)
 		return (-EINVAL);
@@ -227,15 +255,17 @@ int brelse(struct buffer *buf)
 	if ((buf < &buffers[0]) || (buf >= &buffers[NANVIX_FS_NR_BUFFERS]))
 		return (-EINVAL);
 
-	/* Bad buffer. */
-	if (buf->count == 0)
-		return (-EINVAL);
+	nanvix_semaphore_down(&lock);
 
-	/* Release buffer. */
-	if (buf->count-- == 1)
-		resource_set_unused(&buf->flags);
+		/* Bad buffer. */
+		if (buf->count == 0)
+			ret = -EINVAL;
+		else
+			do_brelse(buf);
 
-	return (0);
+	nanvix_semaphore_up(&lock);
+
+	return (ret);
 }
 
 /**
@@ -247,21 +277,27 @@ struct buffer *bread(dev_t dev, block_t num)
 {
 	struct buffer *buf = NULL;
 
-	/* Get block buffer. */
-	if ((buf = getblk(dev, num)) == NULL)
-		return (NULL);
+	nanvix_semaphore_down(&lock);
 
-	/* Read-in block. */
-	if (!resource_is_valid(&buf->flags))
-	{
-		if (bdev_readblk(buf) < 0)
+		/* Get block buffer. */
+		if ((buf = getblk(dev, num)) == NULL)
+			goto out;
+
+		/* Read-in block. */
+		if (!resource_is_valid(&buf->flags))
 		{
-			uassert(brelse(buf) == 0);
-			return (NULL);
+			if (bdev_readblk(buf) < 0)
+			{
+				do_brelse(buf);
+				buf = NULL;
+				goto out;
+			}
+
+			resource_set_valid(&buf->flags);
 		}
 
-		resource_set_valid(&buf->flags);
-	}
+out:
+	nanvix_semaphore_up(&lock);
 
 	return (buf);
 }
@@ -280,19 +316,26 @@ int bwrite2(struct buffer *buf)
 	if ((buf < &buffers[0]) || (buf >= &buffers[NANVIX_FS_NR_BUFFERS]))
 		return (-EINVAL);
 
-	/* Bad buffer. */
-	if (buf->count == 0)
-		return (-EINVAL);
+	nanvix_semaphore_down(&lock);
 
-	/* Write back. */
-	if (resource_is_valid(&buf->flags))
-	{
-		if (resource_is_dirty(&buf->flags))
+		/* Bad buffer. */
+		if (buf->count == 0)
 		{
-			bdev_writeblk(buf);
-			resource_set_clean(&buf->flags);
+			nanvix_semaphore_up(&lock);
+			return (-EINVAL);
 		}
-	}
+
+		/* Write back. */
+		if (resource_is_valid(&buf->flags))
+		{
+			if (resource_is_dirty(&buf->flags))
+			{
+				bdev_writeblk(buf);
+				resource_set_clean(&buf->flags);
+			}
+		}
+
+	nanvix_semaphore_up(&lock);
 
 	return (0);
 }
@@ -321,6 +364,8 @@ void binit(void)
 {
 	uprintf("[nanvix][vfs] initializing block cache...");
 
+	nanvix_semaphore_init(&lock, 1);
+
 	/* Initialize buffers. */
 	for (int i = 0; i < NANVIX_FS_NR_BUFFERS; i++)
 	{
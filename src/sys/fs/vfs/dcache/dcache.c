@@ -0,0 +1,285 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __VFS_SERVER
+#define __NEED_RESOURCE
+
+#include <nanvix/hal/resource.h>
+#include <nanvix/runtime/utils.h>
+#include <nanvix/servers/vfs.h>
+#include <nanvix/config.h>
+#include <nanvix/ulib.h>
+#include <posix/errno.h>
+
+/**
+ * @brief Number of hash buckets in the directory cache.
+ */
+#define DCACHE_HASH_LENGTH 32
+
+/**
+ * @brief Directory Cache Entry
+ */
+struct dentry
+{
+	/* Must come first. */
+	struct resource resource;
+
+	dev_t dev;                  /**< Device.                  */
+	ino_t dir;                  /**< Parent directory.        */
+	ino_t num;                  /**< Inode (null if negative) */
+	char name[MINIX_NAME_MAX];  /**< Name.                    */
+	unsigned age;               /**< Time of last access.     */
+	int next;                   /**< Next entry in bucket.    */
+};
+
+/**
+ * @brief Table of Directory Cache Entries
+ */
+static struct dentry dentries[NANVIX_DCACHE_LENGTH];
+
+/**
+ * @brief Pool of Directory Cache Entries
+ */
+static struct resource_pool pool = {
+	.resources = dentries,
+	.nresources = NANVIX_DCACHE_LENGTH,
+	.resource_size = sizeof(struct dentry)
+};
+
+/**
+ * @brief Index of free directory cache entries.
+ */
+static struct resource_index pool_index = RESOURCE_INDEX_INITIALIZER(&pool);
+
+/**
+ * @brief Hash table for the directory cache.
+ */
+static int buckets[DCACHE_HASH_LENGTH];
+
+/**
+ * @brief Clock for entry replacement.
+ */
+static unsigned dcache_clock = 0;
+
+/*============================================================================*
+ * dcache_hash()                                                              *
+ *============================================================================*/
+
+/**
+ * @brief Hashes a name.
+ *
+ * @param dev  Device number.
+ * @param name Target name.
+ *
+ * @note The parent directory is left out of the hash on purpose, so
+ * that all entries for a name can be invalidated by visiting a single
+ * bucket.
+ *
+ * @returns The hash value of @p name.
+ */
+static unsigned dcache_hash(dev_t dev, const char *name)
+{
+	unsigned hash = 5381 + dev;
+
+	for (int i = 0; (i < MINIX_NAME_MAX) && (name[i] != '\0'); i++)
+		hash = ((hash << 5) + hash) + name[i];
+
+	return (hash%DCACHE_HASH_LENGTH);
+}
+
+/*============================================================================*
+ * dcache_unlink()                                                            *
+ *============================================================================*/
+
+/**
+ * @brief Removes an entry from the directory cache.
+ *
+ * @param idx Index of target entry.
+ */
+static void dcache_unlink(int idx)
+{
+	int *p;
+
+	p = &buckets[dcache_hash(dentries[idx].dev, dentries[idx].name)];
+
+	/* Unlink entry from bucket. */
+	for (/* noop */; *p >= 0; p = &dentries[*p].next)
+	{
+		if (*p == idx)
+		{
+			*p = dentries[idx].next;
+			break;
+		}
+	}
+
+	resource_index_free(&pool_index, idx);
+}
+
+/*============================================================================*
+ * dcache_lookup()                                                            *
+ *============================================================================*/
+
+/**
+ * The dcache_lookup() function searches the directory cache for the
+ * entry named @p name in the directory @p dir of the device @p dev.
+ */
+int dcache_lookup(dev_t dev, ino_t dir, const char *name, ino_t *num)
+{
+	/* Invalid name. */
+	if (name == NULL)
+		return (-EINVAL);
+
+	/* Invalid store location. */
+	if (num == NULL)
+		return (-EINVAL);
+
+	for (int i = buckets[dcache_hash(dev, name)]; i >= 0; i = dentries[i].next)
+	{
+		/* Found. */
+		if ((dentries[i].dev == dev) &&
+			(dentries[i].dir == dir) &&
+			!ustrncmp(dentries[i].name, name, MINIX_NAME_MAX))
+		{
+			dentries[i].age = ++dcache_clock;
+			*num = dentries[i].num;
+			return (0);
+		}
+	}
+
+	return (-ENOENT);
+}
+
+/*============================================================================*
+ * dcache_insert()                                                            *
+ *============================================================================*/
+
+/**
+ * The dcache_insert() function inserts an entry named @p name that
+ * refers to the inode @p num, in the directory @p dir of the device @p
+ * dev. If there is no room left in the directory cache, the least
+ * recently used entry is evicted.
+ */
+int dcache_insert(dev_t dev, ino_t dir, const char *name, ino_t num)
+{
+	int idx;
+	unsigned hash;
+
+	/* Invalid name. */
+	if (name == NULL)
+		return (-EINVAL);
+
+	/* Bad name. */
+	if (ustrlen(name) > MINIX_NAME_MAX)
+		return (-ENAMETOOLONG);
+
+	/* Drop stale entry. */
+	dcache_invalidate(dev, name);
+
+	/* Evict least recently used entry. */
+	if ((idx = resource_index_alloc(&pool_index)) < 0)
+	{
+		idx = 0;
+		for (int i = 1; i < NANVIX_DCACHE_LENGTH; i++)
+		{
+			if (dentries[i].age < dentries[idx].age)
+				idx = i;
+		}
+
+		dcache_unlink(idx);
+		uassert(resource_index_alloc(&pool_index) == idx);
+	}
+
+	hash = dcache_hash(dev, name);
+
+	/* Initialize entry. */
+	dentries[idx].dev = dev;
+	dentries[idx].dir = dir;
+	dentries[idx].num = num;
+	ustrncpy(dentries[idx].name, name, MINIX_NAME_MAX);
+	dentries[idx].age = ++dcache_clock;
+	dentries[idx].next = buckets[hash];
+	buckets[hash] = idx;
+
+	return (0);
+}
+
+/*============================================================================*
+ * dcache_invalidate()                                                        *
+ *============================================================================*/
+
+/**
+ * The dcache_invalidate() function drops all entries named @p name of
+ * the device @p dev from the directory cache, regardless of their
+ * parent directory. If @p name is NULL, all entries of @p dev are
+ * dropped instead.
+ */
+void dcache_invalidate(dev_t dev, const char *name)
+{
+	/* Drop all entries of the device. */
+	if (name == NULL)
+	{
+		for (int i = 0; i < NANVIX_DCACHE_LENGTH; i++)
+		{
+			if (resource_is_used(&dentries[i].resource) && (dentries[i].dev == dev))
+				dcache_unlink(i);
+		}
+
+		return;
+	}
+
+	for (int i = buckets[dcache_hash(dev, name)], next; i >= 0; i = next)
+	{
+		next = dentries[i].next;
+
+		if ((dentries[i].dev == dev) && !ustrncmp(dentries[i].name, name, MINIX_NAME_MAX))
+			dcache_unlink(i);
+	}
+}
+
+/*============================================================================*
+ * dcache_init()                                                              *
+ *============================================================================*/
+
+/**
+ * The dcache_init() function initializes the directory cache.
+ */
+void dcache_init(void)
+{
+	uprintf("[nanvix][vfs] initializing directory cache...");
+
+	for (int i = 0; i < DCACHE_HASH_LENGTH; i++)
+		buckets[i] = -1;
+
+	for (int i = 0; i < NANVIX_DCACHE_LENGTH; i++)
+	{
+		dentries[i].resource = RESOURCE_INITIALIZER;
+		dentries[i].next = -1;
+		dentries[i].age = 0;
+	}
+
+	resource_index_reset(&pool_index);
+
+	uprintf("[nanvix][vfs] %d slots in the directory cache", NANVIX_DCACHE_LENGTH);
+}
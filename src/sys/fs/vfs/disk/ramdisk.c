@@ -113,6 +113,29 @@ ssize_t ramdisk_read(unsigned minor, char *buf, size_t n, off_t off)
 	return ((ssize_t) n);
 }
 
+/**
+ * The ramdisk_discard() function discards @p n bytes of the ramdisk
+ * device @p minor at offset @p off. Discarded data reads as zeros.
+ */
+int ramdisk_discard(unsigned minor, off_t off, size_t n)
+{
+	/* Invalid device. */
+	if (minor >= NANVIX_NR_RAMDISKS)
+		return (-EINVAL);
+
+	/* Invalid offset. */
+	if ((off < 0) || (off >= NANVIX_RAMDISK_SIZE))
+		return (-EINVAL);
+
+	/* Invalid discard size. */
+	if (n > (size_t)(NANVIX_RAMDISK_SIZE - off))
+		return (-EINVAL);
+
+	umemset(ramdisks[minor].data + off, 0, n);
+
+	return (0);
+}
+
 /**
  * The ramdisk_init() function initializes ramdisk devices.
  */
@@ -122,4 +145,13 @@ void ramdisk_init(void)
 
 	for (unsigned i = 0; i < NANVIX_NR_RAMDISKS; i++)
 		umemset(ramdisks[i].data, 0, NANVIX_RAMDISK_SIZE);
+
+#if (NANVIX_VFS_IMAGE)
+
+	/* Preload first RAM disk. */
+	uassert(nanvix_ramdisk_image_size <= NANVIX_RAMDISK_SIZE);
+	umemcpy(ramdisks[0].data, nanvix_ramdisk_image, nanvix_ramdisk_image_size);
+	uprintf("[nanvix][dev] ramdisk preloaded with %d bytes", (int) nanvix_ramdisk_image_size);
+
+#endif
 }
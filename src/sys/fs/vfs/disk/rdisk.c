@@ -0,0 +1,591 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __NEED_MM_RMEM_STUB
+
+#include <dev/rdisk.h>
+#include <nanvix/runtime/mm.h>
+#include <nanvix/sys/semaphore.h>
+#include <nanvix/ulib.h>
+#include <posix/sys/types.h>
+#include <posix/errno.h>
+
+/**
+ * @brief Number of remote pages in a remote disk.
+ */
+#define RDISK_NR_PAGES (NANVIX_RDISK_SIZE/RMEM_BLOCK_SIZE)
+
+/**
+ * @brief Remote Disk
+ *
+ * @details Transfers to a remote disk are serialized by the lock of the
+ * disk, thus different disks are accessed concurrently.
+ */
+static struct
+{
+	rpage_t pages[RDISK_NR_PAGES]; /**< Underlying Remote Pages */
+	struct nanvix_semaphore lock;  /**< Lock of the Disk        */
+} rdisks[NANVIX_NR_RDISKS];
+
+/**
+ * @brief Cache of Remote Pages
+ *
+ * @details A page is busy while a thread transfers it, either to copy
+ * data in and out, or to write it back to remote memory on eviction.
+ * Threads that need a busy page wait on its lock.
+ */
+static struct rdisk_page
+{
+	unsigned minor;               /**< Remote Disk      */
+	int pgnum;                    /**< Page Number      */
+	int dirty;                    /**< Dirty?           */
+	int busy;                     /**< Busy?            */
+	unsigned age;                 /**< Last Access Time */
+	struct nanvix_semaphore lock; /**< Page Lock        */
+	char data[RMEM_BLOCK_SIZE];   /**< Cached Data      */
+} cache[NANVIX_RDISK_CACHE_LENGTH];
+
+/**
+ * @brief Logical clock for the cache.
+ */
+static unsigned ticks = 0;
+
+/**
+ * @brief Lock for the cache.
+ *
+ * @details Guards the table of cached pages only. It is never held
+ * across requests to remote memory.
+ */
+static struct nanvix_semaphore lock;
+
+/*============================================================================*
+ * rdisk_page_writeback()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Writes a cached page back to remote memory.
+ *
+ * @param pg Target page.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+static int rdisk_page_writeback(struct rdisk_page *pg)
+{
+	rpage_t *rpage;
+
+	/* Nothing to do. */
+	if ((pg->pgnum < 0) || (!pg->dirty))
+		return (0);
+
+	rpage = &rdisks[pg->minor].pages[pg->pgnum];
+
+	/* Allocate backing page on first write. */
+	if (*rpage == RMEM_NULL)
+	{
+		if ((*rpage = nanvix_rmem_alloc()) == RMEM_NULL)
+			return (-ENOMEM);
+	}
+
+	if (nanvix_rmem_write(*rpage, pg->data) != RMEM_BLOCK_SIZE)
+		return (-EIO);
+
+	pg->dirty = 0;
+
+	return (0);
+}
+
+/*============================================================================*
+ * rdisk_page_get()                                                           *
+ *============================================================================*/
+
+/*============================================================================*
+ * rdisk_page_lookup()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Searches for a cached page and takes it.
+ *
+ * @param minor Target remote disk.
+ * @param pgnum Target page.
+ *
+ * If the page is busy, the calling thread waits until it is released.
+ * A page that is being evicted is no longer cached once it is released.
+ *
+ * @returns If the page is cached, a pointer to it is returned, and it
+ * is busy. Otherwise, a NULL pointer is returned instead.
+ */
+static struct rdisk_page *rdisk_page_lookup(unsigned minor, int pgnum)
+{
+	struct rdisk_page *pg;
+
+again:
+
+	nanvix_semaphore_down(&lock);
+
+		for (int i = 0; i < NANVIX_RDISK_CACHE_LENGTH; i++)
+		{
+			pg = &cache[i];
+
+			/* Skip other pages. */
+			if ((pg->pgnum != pgnum) || (pg->minor != minor))
+				continue;
+
+			/* Wait for page. */
+			if (pg->busy)
+			{
+				nanvix_semaphore_up(&lock);
+				nanvix_semaphore_down(&pg->lock);
+				nanvix_semaphore_up(&pg->lock);
+				goto again;
+			}
+
+			pg->busy = 1;
+			pg->age = ++ticks;
+			nanvix_semaphore_down(&pg->lock);
+
+			nanvix_semaphore_up(&lock);
+			return (pg);
+		}
+
+	nanvix_semaphore_up(&lock);
+
+	return (NULL);
+}
+
+/*============================================================================*
+ * rdisk_page_put()                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Releases a cached page.
+ *
+ * @param pg Target page.
+ */
+static void rdisk_page_put(struct rdisk_page *pg)
+{
+	nanvix_semaphore_down(&lock);
+		pg->busy = 0;
+		nanvix_semaphore_up(&pg->lock);
+	nanvix_semaphore_up(&lock);
+}
+
+/*============================================================================*
+ * rdisk_page_get()                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Gets a page of a remote disk in the cache.
+ *
+ * @param minor Target remote disk.
+ * @param pgnum Target page.
+ * @param fill  Fetch the contents of the page?
+ *
+ * The least recently used page that is not busy is evicted to make
+ * room. It keeps its identity until it is written back, so that threads
+ * that look for it wait rather than read stale data from remote memory.
+ *
+ * @returns Upon successful completion, a pointer to the cached page is
+ * returned, and it is busy. Upon failure, a NULL pointer is returned
+ * instead.
+ *
+ * @note The lock of the remote disk @p minor should be held.
+ */
+static struct rdisk_page *rdisk_page_get(unsigned minor, int pgnum, int fill)
+{
+	struct rdisk_page *pg;
+	rpage_t rpage;
+
+	/* Found. */
+	if ((pg = rdisk_page_lookup(minor, pgnum)) != NULL)
+		return (pg);
+
+	nanvix_semaphore_down(&lock);
+
+		/* Pick least recently used. */
+		pg = NULL;
+		for (int i = 0; i < NANVIX_RDISK_CACHE_LENGTH; i++)
+		{
+			/* Skip busy pages. */
+			if (cache[i].busy)
+				continue;
+
+			if ((pg == NULL) || (cache[i].pgnum < 0) || ((pg->pgnum >= 0) && (cache[i].age < pg->age)))
+				pg = &cache[i];
+		}
+
+		/* All pages are busy. */
+		if (pg == NULL)
+		{
+			nanvix_semaphore_up(&lock);
+			return (NULL);
+		}
+
+		pg->busy = 1;
+		nanvix_semaphore_down(&pg->lock);
+
+	nanvix_semaphore_up(&lock);
+
+	/* Evict page. */
+	if (rdisk_page_writeback(pg) < 0)
+	{
+		rdisk_page_put(pg);
+		return (NULL);
+	}
+
+	nanvix_semaphore_down(&lock);
+		pg->minor = minor;
+		pg->pgnum = pgnum;
+		pg->dirty = 0;
+		pg->age = ++ticks;
+	nanvix_semaphore_up(&lock);
+
+	/* Fetch page. */
+	if (fill)
+	{
+		/* Pages that were never written read as zeros. */
+		if ((rpage = rdisks[minor].pages[pgnum]) == RMEM_NULL)
+			umemset(pg->data, 0, RMEM_BLOCK_SIZE);
+
+		else if (nanvix_rmem_read(rpage, pg->data) != RMEM_BLOCK_SIZE)
+		{
+			nanvix_semaphore_down(&lock);
+				pg->pgnum = -1;
+			nanvix_semaphore_up(&lock);
+
+			rdisk_page_put(pg);
+			return (NULL);
+		}
+	}
+
+	return (pg);
+}
+
+/*============================================================================*
+ * rdisk_rw()                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Reads/writes data from/to a remote disk.
+ *
+ * @param minor Target remote disk.
+ * @param buf   Target buffer.
+ * @param n     Number of bytes to transfer.
+ * @param off   Transfer offset.
+ * @param write Write data?
+ *
+ * @returns Upon successful completion, the number of bytes transferred
+ * is returned. Upon failure, a negative error code is returned instead.
+ */
+static ssize_t rdisk_rw(unsigned minor, char *buf, size_t n, off_t off, int write)
+{
+	size_t chunk;          /* Bytes in current page. */
+	size_t pgoff;          /* Offset in page.        */
+	struct rdisk_page *pg; /* Working page.          */
+
+	/* Invalid device. */
+	if (minor >= NANVIX_NR_RDISKS)
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	/* Invalid offset. */
+	if ((off < 0) || (off >= NANVIX_RDISK_SIZE))
+		return (-EINVAL);
+
+	/* Invalid size. */
+	if (n > (size_t)(NANVIX_RDISK_SIZE - off))
+		return (-EINVAL);
+
+	for (size_t i = 0; i < n; i += chunk)
+	{
+		pgoff = (off + i)%RMEM_BLOCK_SIZE;
+		chunk = RMEM_BLOCK_SIZE - pgoff;
+		if (chunk > n - i)
+			chunk = n - i;
+
+		/* Whole pages that are overwritten need not be fetched. */
+		pg = rdisk_page_get(
+			minor,
+			(off + i)/RMEM_BLOCK_SIZE,
+			!(write && (chunk == RMEM_BLOCK_SIZE))
+		);
+
+		/* Failed to get page. */
+		if (pg == NULL)
+			return (-EIO);
+
+		if (write)
+		{
+			umemcpy(&pg->data[pgoff], &buf[i], chunk);
+			pg->dirty = 1;
+		}
+		else
+			umemcpy(&buf[i], &pg->data[pgoff], chunk);
+
+		rdisk_page_put(pg);
+	}
+
+	return ((ssize_t) n);
+}
+
+/*============================================================================*
+ * rdisk_write()                                                              *
+ *============================================================================*/
+
+/**
+ * The rdisk_write() function writes @p n bytes from the buffer pointed
+ * to by @p buf in the remote disk @p minor at offset @p off. Data is
+ * written back to remote memory lazily, one whole page at a time.
+ */
+ssize_t rdisk_write(unsigned minor, const char *buf, size_t n, off_t off)
+{
+	ssize_t ret;
+
+	/* Invalid device. */
+	if (minor >= NANVIX_NR_RDISKS)
+		return (-EINVAL);
+
+	nanvix_semaphore_down(&rdisks[minor].lock);
+		ret = rdisk_rw(minor, (char *) buf, n, off, 1);
+	nanvix_semaphore_up(&rdisks[minor].lock);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * rdisk_read()                                                               *
+ *============================================================================*/
+
+/**
+ * The rdisk_read() function reads @p n bytes from the remote disk @p
+ * minor at offset @p off to the buffer pointed to by @p buf. Data is
+ * fetched from remote memory one whole page at a time.
+ */
+ssize_t rdisk_read(unsigned minor, char *buf, size_t n, off_t off)
+{
+	ssize_t ret;
+
+	/* Invalid device. */
+	if (minor >= NANVIX_NR_RDISKS)
+		return (-EINVAL);
+
+	nanvix_semaphore_down(&rdisks[minor].lock);
+		ret = rdisk_rw(minor, buf, n, off, 0);
+	nanvix_semaphore_up(&rdisks[minor].lock);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * rdisk_discard()                                                            *
+ *============================================================================*/
+
+/**
+ * The rdisk_discard() function discards @p n bytes of the remote disk
+ * @p minor at offset @p off. Pages that are wholly discarded are
+ * dropped from the cache and their remote memory is released, so that
+ * they read as zeros until they are written again. Pages that are
+ * partially discarded are zeroed in the cache.
+ */
+int rdisk_discard(unsigned minor, off_t off, size_t n)
+{
+	int pgnum;             /* Working page.          */
+	size_t chunk;          /* Bytes in current page. */
+	size_t pgoff;          /* Offset in page.        */
+	rpage_t *rpage;        /* Backing remote page.   */
+	struct rdisk_page *pg; /* Cached page.           */
+
+	/* Invalid device. */
+	if (minor >= NANVIX_NR_RDISKS)
+		return (-EINVAL);
+
+	/* Invalid offset. */
+	if ((off < 0) || (off >= NANVIX_RDISK_SIZE))
+		return (-EINVAL);
+
+	/* Invalid size. */
+	if (n > (size_t)(NANVIX_RDISK_SIZE - off))
+		return (-EINVAL);
+
+	nanvix_semaphore_down(&rdisks[minor].lock);
+
+	for (size_t i = 0; i < n; i += chunk)
+	{
+		pgnum = (off + i)/RMEM_BLOCK_SIZE;
+		pgoff = (off + i)%RMEM_BLOCK_SIZE;
+		chunk = RMEM_BLOCK_SIZE - pgoff;
+		if (chunk > n - i)
+			chunk = n - i;
+
+		/* Partial page. */
+		if (chunk != RMEM_BLOCK_SIZE)
+		{
+			if ((pg = rdisk_page_get(minor, pgnum, 1)) == NULL)
+				goto error;
+
+			umemset(&pg->data[pgoff], 0, chunk);
+			pg->dirty = 1;
+			rdisk_page_put(pg);
+
+			continue;
+		}
+
+		/* Drop cached copy. */
+		if ((pg = rdisk_page_lookup(minor, pgnum)) != NULL)
+		{
+			nanvix_semaphore_down(&lock);
+				pg->pgnum = -1;
+				pg->dirty = 0;
+			nanvix_semaphore_up(&lock);
+
+			rdisk_page_put(pg);
+		}
+
+		/* Release backing page. */
+		rpage = &rdisks[minor].pages[pgnum];
+		if (*rpage != RMEM_NULL)
+		{
+			if (nanvix_rmem_free(*rpage) != 0)
+				goto error;
+			*rpage = RMEM_NULL;
+		}
+	}
+
+	nanvix_semaphore_up(&rdisks[minor].lock);
+
+	return (0);
+
+error:
+	nanvix_semaphore_up(&rdisks[minor].lock);
+	return (-EIO);
+}
+
+/*============================================================================*
+ * rdisk_flush()                                                              *
+ *============================================================================*/
+
+/**
+ * The rdisk_flush() function writes all dirty pages of the remote
+ * disk @p minor that are cached back to remote memory.
+ */
+int rdisk_flush(unsigned minor)
+{
+	int err = 0;
+
+	/* Invalid device. */
+	if (minor >= NANVIX_NR_RDISKS)
+		return (-EINVAL);
+
+	nanvix_semaphore_down(&rdisks[minor].lock);
+
+	for (int i = 0; i < NANVIX_RDISK_CACHE_LENGTH; i++)
+	{
+		struct rdisk_page *pg;
+
+		/* Skip pages of other devices. */
+		if ((cache[i].minor != minor) || (cache[i].pgnum < 0))
+			continue;
+
+		/* Evicted meanwhile. */
+		if ((pg = rdisk_page_lookup(minor, cache[i].pgnum)) == NULL)
+			continue;
+
+		err = rdisk_page_writeback(pg);
+		rdisk_page_put(pg);
+
+		if (err < 0)
+			break;
+	}
+
+	nanvix_semaphore_up(&rdisks[minor].lock);
+
+	return (err);
+}
+
+/*============================================================================*
+ * rdisk_init()                                                               *
+ *============================================================================*/
+
+/**
+ * The rdisk_init() function initializes remote disk devices. Remote
+ * pages are allocated on first write back, thus no remote memory is
+ * used at this point.
+ */
+void rdisk_init(void)
+{
+	uprintf("[nanvix][dev] initializing remote disk device driver");
+
+	uassert(__nanvix_rmem_setup() == 0);
+
+	nanvix_semaphore_init(&lock, 1);
+
+	for (unsigned i = 0; i < NANVIX_NR_RDISKS; i++)
+	{
+		nanvix_semaphore_init(&rdisks[i].lock, 1);
+		for (int j = 0; j < RDISK_NR_PAGES; j++)
+			rdisks[i].pages[j] = RMEM_NULL;
+	}
+
+	for (int i = 0; i < NANVIX_RDISK_CACHE_LENGTH; i++)
+	{
+		cache[i].minor = 0;
+		cache[i].pgnum = -1;
+		cache[i].dirty = 0;
+		cache[i].busy = 0;
+		cache[i].age = 0;
+		nanvix_semaphore_init(&cache[i].lock, 1);
+	}
+}
+
+/*============================================================================*
+ * rdisk_shutdown()                                                           *
+ *============================================================================*/
+
+/**
+ * The rdisk_shutdown() function shutdowns remote disk devices, and
+ * releases all the remote memory they use.
+ */
+void rdisk_shutdown(void)
+{
+	uprintf("[nanvix][dev] shutting down remote disk device driver");
+
+	for (int i = 0; i < NANVIX_RDISK_CACHE_LENGTH; i++)
+		cache[i].pgnum = -1;
+
+	for (unsigned i = 0; i < NANVIX_NR_RDISKS; i++)
+	{
+		for (int j = 0; j < RDISK_NR_PAGES; j++)
+		{
+			if (rdisks[i].pages[j] != RMEM_NULL)
+				uassert(nanvix_rmem_free(rdisks[i].pages[j]) == 0);
+			rdisks[i].pages[j] = RMEM_NULL;
+		}
+	}
+
+	uassert(__nanvix_rmem_cleanup() == 0);
+}
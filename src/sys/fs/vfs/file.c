@@ -26,31 +26,152 @@
 #define __VFS_SERVER
 
 #include <nanvix/servers/vfs.h>
+#include <nanvix/dev.h>
+#include <nanvix/ulib.h>
 #include <posix/sys/types.h>
 #include <posix/errno.h>
 
+#define ROUND(x) (((x) == 0) ? 1 : (x))
+
+/*============================================================================*
+ * file_chunk()                                                               *
+ *============================================================================*/
+
+/**
+ * @brief Computes the size of the next device transfer.
+ *
+ * @param off Current file offset.
+ * @param len Number of contiguous blocks mapped at @p off.
+ * @param n   Number of bytes left.
+ *
+ * @returns The number of bytes that may be transferred from/to the
+ * device at once, starting at @p off.
+ */
+static inline size_t file_chunk(off_t off, block_t len, size_t n)
+{
+	size_t chunk;
+
+	chunk = ((size_t) ROUND(len))*MINIX_BLOCK_SIZE - off%MINIX_BLOCK_SIZE;
+
+	return ((chunk < n) ? chunk : n);
+}
+
+/*============================================================================*
+ * file_read()                                                                *
+ *============================================================================*/
+
 /**
- * @todo TODO: Provide a detailed description for this function.
+ * The file_read() function reads @p n bytes from the regular file
+ * pointed to by @p ip, starting at the offset @p off, to the buffer
+ * pointed to by @p buf. Runs of physically contiguous blocks are read
+ * from the underlying device at once, and holes are read as zeros.
  */
 ssize_t file_read(struct inode *ip, void *buf, size_t n, off_t off)
 {
-	((void) ip);
-	((void) buf);
-	((void) n);
-	((void) off);
+	char *p;           /* Working buffer.          */
+	size_t i;          /* Bytes read so far.       */
+	size_t chunk;      /* Size of current chunk.   */
+	block_t len;       /* Length of current run.   */
+	minix_block_t blk; /* Working block.           */
+	struct d_inode *dip;
+
+	/* Invalid inode. */
+	if (ip == NULL)
+		return (curr_proc->errcode = -EINVAL);
+
+	/* Invalid offset. */
+	if (off < 0)
+		return (curr_proc->errcode = -EINVAL);
+
+	dip = inode_disk_get(ip);
+
+	/* End of file. */
+	if ((size_t) off >= dip->i_size)
+		return (0);
 
-	return (-ENOTSUP);
+	/* Do not read beyond the end of file. */
+	if (n > (size_t)(dip->i_size - off))
+		n = dip->i_size - off;
+
+	p = buf;
+	for (i = 0; i < n; i += chunk)
+	{
+		blk = inode_block_map(&fs_root, ip, off + i, 0, &len);
+		chunk = file_chunk(off + i, len, n - i);
+
+		/* Hole. */
+		if (blk == MINIX_BLOCK_NULL)
+		{
+			umemset(p + i, 0, chunk);
+			continue;
+		}
+
+		/* Read run of blocks. */
+		if (journal_read(inode_get_dev(ip), p + i, chunk, blk*MINIX_BLOCK_SIZE + (off + i)%MINIX_BLOCK_SIZE) != (ssize_t) chunk)
+			return (curr_proc->errcode = -EIO);
+	}
+
+	return (n);
 }
 
+/*============================================================================*
+ * file_write()                                                               *
+ *============================================================================*/
+
 /**
- * @todo TODO: Provide a detailed description for this function.
+ * The file_write() function writes @p n bytes from the buffer pointed
+ * to by @p buf to the regular file pointed to by @p ip, starting at the
+ * offset @p off. Blocks are allocated as required, and runs of
+ * physically contiguous blocks are written to the underlying device at
+ * once.
  */
 ssize_t file_write(struct inode *ip, void *buf, size_t n, off_t off)
 {
-	((void) ip);
-	((void) buf);
-	((void) n);
-	((void) off);
+	char *p;           /* Working buffer.          */
+	size_t i;          /* Bytes written so far.    */
+	size_t chunk;      /* Size of current chunk.   */
+	block_t len;       /* Length of current run.   */
+	minix_block_t blk; /* Working block.           */
+	struct d_inode *dip;
+
+	/* Invalid inode. */
+	if (ip == NULL)
+		return (curr_proc->errcode = -EINVAL);
+
+	/* Invalid offset. */
+	if (off < 0)
+		return (curr_proc->errcode = -EINVAL);
+
+	dip = inode_disk_get(ip);
+
+	p = buf;
+	for (i = 0; i < n; i += chunk)
+	{
+		/* File system full. */
+		if ((blk = inode_block_map(&fs_root, ip, off + i, 1, &len)) == MINIX_BLOCK_NULL)
+			break;
+
+		chunk = file_chunk(off + i, len, n - i);
+
+		/* Block may have held metadata. */
+		if (journal_sync(inode_get_dev(ip), chunk, blk*MINIX_BLOCK_SIZE + (off + i)%MINIX_BLOCK_SIZE) < 0)
+			return (curr_proc->errcode = -EIO);
+
+		/* Write run of blocks. */
+		if (bdev_write(inode_get_dev(ip), p + i, chunk, blk*MINIX_BLOCK_SIZE + (off + i)%MINIX_BLOCK_SIZE) != (ssize_t) chunk)
+			return (curr_proc->errcode = -EIO);
+	}
+
+	/* Nothing written. */
+	if (i == 0)
+		return (curr_proc->errcode = -ENOSPC);
+
+	/* Grow file. */
+	if ((size_t) off + i > dip->i_size)
+		dip->i_size = off + i;
+
+	inode_touch(ip);
+	inode_set_dirty(ip);
 
-	return (-ENOTSUP);
+	return (i);
 }
@@ -26,6 +26,7 @@
 #define __VFS_SERVER
 
 #include <nanvix/servers/vfs.h>
+#include <nanvix/sys/thread.h>
 #include <nanvix/limits.h>
 #include <nanvix/ulib.h>
 #include <posix/sys/types.h>
@@ -37,9 +38,11 @@
 static struct fprocess processes[NANVIX_CONNECTIONS_MAX];
 
 /**
- * Current Process
+ * @brief Current process of each thread.
  */
-struct fprocess *curr_proc = NULL;
+static struct fprocess *contexts[THREAD_MAX + 1] = {
+	[0 ... (THREAD_MAX)] = NULL
+};
 
 /*============================================================================*
  * fprocess_launch()                                                          *
@@ -47,7 +50,8 @@ struct fprocess *curr_proc = NULL;
 
 /**
  * The fprocess_launc() function starts the file system process. This
- * process is hooked up to the connection @p connection.
+ * process is hooked up to the connection @p connection, and it becomes
+ * the current process of the calling thread.
  */
 int fprocess_launch(int connection)
 {
@@ -55,7 +59,7 @@ int fprocess_launch(int connection)
 	if (!WITHIN(connection, 0, NANVIX_CONNECTIONS_MAX))
 		return (-EINVAL);
 
-	curr_proc = &processes[connection];
+	contexts[kthread_self()] = &processes[connection];
 
 	/* Initialize process. */
 	curr_proc->errcode = 0;
@@ -63,6 +67,158 @@ int fprocess_launch(int connection)
 	return (0);
 }
 
+/*============================================================================*
+ * fprocess_current()                                                         *
+ *============================================================================*/
+
+/**
+ * The fprocess_current() function returns the file system process that
+ * was last launched by the calling thread.
+ */
+struct fprocess *fprocess_current(void)
+{
+	return (contexts[kthread_self()]);
+}
+
+/*============================================================================*
+ * fprocess_fd_alloc()                                                        *
+ *============================================================================*/
+
+/**
+ * The fprocess_fd_alloc() function allocates the lowest-numbered free
+ * file descriptor of the current process, and installs the opened file
+ * @p f in it. The first word of the map that has a free descriptor is
+ * found in the summary of full words, thus allocation takes constant
+ * time regardless of the number of opened files.
+ */
+int fprocess_fd_alloc(struct file *f)
+{
+	int fd;
+	int chunk;
+	struct fprocess *p;
+
+	/* Invalid file. */
+	if (f == NULL)
+		return (-EINVAL);
+
+	p = curr_proc;
+
+	/* Too many opened files. */
+	if (p->ofull == BITMAP_FULL)
+		return (-EMFILE);
+
+	chunk = __builtin_ctz(~p->ofull);
+	fd = chunk*BITMAP_WORD_LENGTH + __builtin_ctz(~p->omap[chunk]);
+
+	/* Grow table of opened files. */
+	if (p->ofiles[chunk] == NULL)
+	{
+		if ((p->ofiles[chunk] = ucalloc(BITMAP_WORD_LENGTH, sizeof(struct file *))) == NULL)
+			return (-ENOMEM);
+	}
+
+	p->ofiles[chunk][OFF(fd)] = f;
+	bitmap_set(p->omap, fd);
+	if (p->omap[chunk] == BITMAP_FULL)
+		p->ofull |= (1U << chunk);
+
+	return (fd);
+}
+
+/*============================================================================*
+ * fprocess_fd_free()                                                         *
+ *============================================================================*/
+
+/**
+ * The fprocess_fd_free() function releases the file descriptor @p fd
+ * of the current process.
+ */
+int fprocess_fd_free(int fd)
+{
+	int chunk;
+	struct fprocess *p;
+
+	/* Bad file descriptor. */
+	if (fprocess_fd_get(fd) == NULL)
+		return (-EBADF);
+
+	p = curr_proc;
+	chunk = IDX(fd);
+
+	p->ofiles[chunk][OFF(fd)] = NULL;
+	bitmap_clear(p->omap, fd);
+	p->ofull &= ~(1U << chunk);
+
+	return (0);
+}
+
+/*============================================================================*
+ * fprocess_fd_get()                                                          *
+ *============================================================================*/
+
+/**
+ * The fprocess_fd_get() function gets the file that is opened in the
+ * file descriptor @p fd of the current process.
+ */
+struct file *fprocess_fd_get(int fd)
+{
+	struct file **ofiles;
+
+	/* Invalid file descriptor. */
+	if (!WITHIN(fd, 0, NANVIX_OPEN_MAX))
+		return (NULL);
+
+	/* Chunk not allocated. */
+	if ((ofiles = curr_proc->ofiles[IDX(fd)]) == NULL)
+		return (NULL);
+
+	return (ofiles[OFF(fd)]);
+}
+
+/*============================================================================*
+ * fprocess_reset()                                                           *
+ *============================================================================*/
+
+/**
+ * The fprocess_reset() function resets the file system process that is
+ * hooked up to the connection @p connection, so that a remote that gets
+ * this connection anew does not inherit anything from the previous one.
+ * Chunks of the table of opened files are kept, since reads may still
+ * look file descriptors up without the file system lock, but they are
+ * cleared.
+ */
+int fprocess_reset(int connection)
+{
+	struct fprocess *p;
+
+	/* Invalid connection. */
+	if (!WITHIN(connection, 0, NANVIX_CONNECTIONS_MAX))
+		return (-EINVAL);
+
+	p = &processes[connection];
+
+	p->errcode = 0;
+	p->pwd = fs_root.root;
+	p->root = fs_root.root;
+
+	/* Words past the end of the map are never free. */
+	p->ofull = (bitmap_t) ~((1ULL << FPROCESS_OFILES_NCHUNKS) - 1);
+
+	for (int j = 0; j < FPROCESS_OFILES_NCHUNKS; j++)
+	{
+		p->omap[j] = 0;
+
+		/* Chunk not allocated. */
+		if (p->ofiles[j] == NULL)
+			continue;
+
+		for (int k = 0; k < BITMAP_WORD_LENGTH; k++)
+			p->ofiles[j][k] = NULL;
+	}
+
+	return (0);
+}
+
 /*============================================================================*
  * fprocess_init()                                                            *
  *============================================================================*/
@@ -74,12 +230,19 @@ int fprocess_launch(int connection)
 void fprocess_init(void)
 {
 	/* Initialize table of file system processes. */
-	for (int i = 0; i < NANVIX_PROC_MAX; i++)
+	for (int i = 0; i < NANVIX_CONNECTIONS_MAX; i++)
 	{
 		processes[i].errcode = 0;
 		processes[i].pwd = fs_root.root;
 		processes[i].root = fs_root.root;
-		for (int j = 0; j < NANVIX_OPEN_MAX; j++)
+
+		/* Words past the end of the map are never free. */
+		processes[i].ofull = (bitmap_t) ~((1ULL << FPROCESS_OFILES_NCHUNKS) - 1);
+
+		for (int j = 0; j < FPROCESS_OFILES_NCHUNKS; j++)
+		{
+			processes[i].omap[j] = 0;
 			processes[i].ofiles[j] = NULL;
+		}
 	}
 }
@@ -27,6 +27,7 @@
 
 #include <nanvix/config.h>
 #include <nanvix/servers/vfs.h>
+#include <nanvix/sys/semaphore.h>
 #include <nanvix/dev.h>
 #include <nanvix/limits.h>
 #include <posix/sys/types.h>
@@ -45,6 +46,20 @@ struct filesystem fs_root;
  */
 static struct file filetab[NANVIX_NR_FILES];
 
+/**
+ * @brief Free Entries of the Table of Files
+ */
+static struct
+{
+	int nfree;                             /**< Number of free entries. */
+	struct file *entries[NANVIX_NR_FILES]; /**< Stack of free entries.  */
+} freefiles;
+
+/**
+ * @brief File System Lock
+ */
+static struct nanvix_semaphore lock;
+
 /**
  * @brief Initializes a file.
  */
@@ -63,47 +78,39 @@ static struct file filetab[NANVIX_NR_FILES];
 /**
  * @brief Gets an empty file.
  *
- * The getfile() function searches the table of files for a free entry.
+ * The getfile() function pops a free entry from the stack of free
+ * entries of the table of files.
  *
  * @returns Upon successful completion, a pointer to an empty file is
  * returned. Upon failure, a NULL pointer is returned instead.
  */
 static struct file *getfile(void)
 {
-	struct file *f;
-
-	/* Look for empty file table entry. */
-	for (f = &filetab[0]; f < &filetab[NANVIX_NR_FILES]; f++)
-	{
-		/* Found. */
-		if (f->count == 0)
-			return (f);
-	}
+	/* Table of files is full. */
+	if (freefiles.nfree == 0)
+		return (NULL);
 
-	return (NULL);
+	return (freefiles.entries[--freefiles.nfree]);
 }
 
 /*============================================================================*
- * getfildes()                                                                *
+ * putfile()                                                                  *
  *============================================================================*/
 
 /**
- * @brief Gets a file descriptor.
+ * @brief Releases a file.
  *
- * @returns Upon successful completion, a free file descriptor is
- * returned. Upon failure, a negative error code is returned instead.
+ * The putfile() function pushes the file pointed to by @p f back onto
+ * the stack of free entries of the table of files.
+ *
+ * @param f Target file.
  */
-static int getfildes(void)
+static void putfile(struct file *f)
 {
-	/* Look for empty file descriptor table entry. */
-	for (int i = 0; i < NANVIX_OPEN_MAX; i++)
-	{
-		/* Found. */
-		if (curr_proc->ofiles[i] == NULL)
-			return (i);
-	}
+	uassert(freefiles.nfree < NANVIX_NR_FILES);
 
-	return (-EMFILE);
+	FILE_INITIALIZER(f);
+	freefiles.entries[freefiles.nfree++] = f;
 }
 
 /*============================================================================*
@@ -168,8 +175,12 @@ static struct inode *do_open(const char *filename, int oflag, mode_t mode)
 	/* Directory. */
 	else if (S_ISDIR(inode_disk_get(ip)->i_mode))
 	{
-		curr_proc->errcode = -ENOTSUP;
-		goto error;
+		/* Directories are read-only. */
+		if (ACCMODE(oflag) != O_RDONLY)
+		{
+			curr_proc->errcode = -EISDIR;
+			goto error;
+		}
 	}
 
 	return (ip);
@@ -191,10 +202,6 @@ int fs_open(const char *filename, int oflag, mode_t mode)
 	struct file *f;   /* File             */
 	struct inode *i;  /* Underlying Inode */
 
-	/* Get a free file descriptor. */
-	if ((fd = getfildes()) < 0)
-		return (-EMFILE);
-
 	/* Grab a free entry in the file table. */
 	if ((f = getfile()) == NULL)
 		return (-ENFILE);
@@ -204,10 +211,18 @@ int fs_open(const char *filename, int oflag, mode_t mode)
 	 * may want to use this file table entry also.  */
 	f->count = 1;
 
+	/* Get a free file descriptor. */
+	if ((fd = fprocess_fd_alloc(f)) < 0)
+	{
+		putfile(f);
+		return (fd);
+	}
+
 	/* Open file. */
 	if ((i = do_open(filename, oflag, mode)) == NULL)
 	{
-		f->count = 0;
+		uassert(fprocess_fd_free(fd) == 0);
+		putfile(f);
 		return (curr_proc->errcode);
 	}
 
@@ -216,7 +231,7 @@ int fs_open(const char *filename, int oflag, mode_t mode)
 	f->pos = 0;
 	f->inode = i;
 
-	curr_proc->ofiles[fd] = f;
+	uassert(inode_attach(i, oflag) == 0);
 
 	return (fd);
 }
@@ -234,16 +249,18 @@ int fs_close(int fd)
 	struct inode *ip; /* Underlying Inode */
 
 	/* Bad file descriptor. */
-	if ((f = curr_proc->ofiles[fd]) == NULL)
+	if ((f = fprocess_fd_get(fd)) == NULL)
 		return (curr_proc->errcode = -EBADF);
 
-	curr_proc->ofiles[fd] = NULL;
+	uassert(fprocess_fd_free(fd) == 0);
 
 	/* File is opened by others. */
 	if (f->count-- > 1)
 		return (0);
 
 	ip = f->inode;
+	uassert(inode_detach(ip, f->oflag) == 0);
+	putfile(f);
 
 	/* Block special file. */
 	if (S_ISBLK(inode_disk_get(ip)->i_mode))
@@ -258,7 +275,7 @@ int fs_close(int fd)
 
 	/* Directory. */
 	else if (S_ISDIR(inode_disk_get(ip)->i_mode))
-		return (curr_proc->errcode = -ENOTSUP);
+		/* noop */ ;
 
 	/* Unknown file type. */
 	else
@@ -268,21 +285,106 @@ int fs_close(int fd)
 }
 
 /*============================================================================*
- * fs_read()                                                                  *
+ * do_inode_read()                                                            *
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @brief Reads data from the file pointed to by an inode.
+ *
+ * @param ip  Target inode.
+ * @param buf Target buffer.
+ * @param n   Number of bytes to read.
+ * @param off Read offset.
+ *
+ * @returns Upon successful completion, the number of bytes read is
+ * returned. Upon failure, a negative error code is returned instead.
+ *
+ * @note The inode should be locked.
  */
-ssize_t fs_read(int fd, void *buf, size_t n)
+static ssize_t do_inode_read(struct inode *ip, void *buf, size_t n, off_t off)
+{
+	dev_t dev;
+
+	/* Block special file. */
+	if (S_ISBLK(inode_disk_get(ip)->i_mode))
+	{
+		dev = inode_disk_get(ip)->i_zones[0];
+		return (journal_read(dev, buf, n, off));
+	}
+
+	/* Regular file/directory. */
+	if ((S_ISDIR(inode_disk_get(ip)->i_mode)) || (S_ISREG(inode_disk_get(ip)->i_mode)))
+		return (file_read(ip, buf, n, off));
+
+	/* Unknown file type. */
+	return (curr_proc->errcode = -ENOTSUP);
+}
+
+/*============================================================================*
+ * do_inode_write()                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Writes data to the file pointed to by an inode.
+ *
+ * @param ip  Target inode.
+ * @param buf Target buffer.
+ * @param n   Number of bytes to write.
+ * @param off Write offset.
+ *
+ * @returns Upon successful completion, the number of bytes written is
+ * returned. Upon failure, a negative error code is returned instead.
+ *
+ * @note The inode should be locked.
+ */
+static ssize_t do_inode_write(struct inode *ip, void *buf, size_t n, off_t off)
+{
+	dev_t dev;
+
+	/* Block special file. */
+	if (S_ISBLK(inode_disk_get(ip)->i_mode))
+	{
+		dev = inode_disk_get(ip)->i_zones[0];
+
+		/* Do not let logged metadata overwrite raw data. */
+		if (journal_sync(dev, n, off) < 0)
+			return (curr_proc->errcode = -EIO);
+
+		return (bdev_write(dev, buf, n, off));
+	}
+
+	/* Regular file. */
+	if (S_ISREG(inode_disk_get(ip)->i_mode))
+		return (file_write(ip, buf, n, off));
+
+	return (0);
+}
+
+/*============================================================================*
+ * do_fs_read()                                                               *
+ *============================================================================*/
+
+/**
+ * @brief Reads data from a file.
+ *
+ * @param fd  Target file descriptor.
+ * @param buf Target buffer.
+ * @param n   Number of bytes to read.
+ * @param off Read offset. If NULL, data is read from the read/write
+ * pointer of the file, and the pointer is advanced.
+ *
+ * @returns Upon successful completion, the number of bytes read is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+static ssize_t do_fs_read(int fd, void *buf, size_t n, const off_t *off)
 {
-	dev_t dev;        /* Device number.       */
+	off_t pos;        /* Read offset.         */
 	struct file *f;   /* File.                */
 	struct inode *ip; /* Inode.               */
 	ssize_t count;    /* Bytes actually read. */
 
 	/* Bad file descriptor. */
-	if ((f = curr_proc->ofiles[fd]) == NULL)
+	if ((f = fprocess_fd_get(fd)) == NULL)
 		return (-EBADF);
 
 	/* File not opened for reading. */
@@ -293,48 +395,83 @@ ssize_t fs_read(int fd, void *buf, size_t n)
 	if (n == 0)
 		return (0);
 
-	 ip = f->inode;
+	ip = f->inode;
+
+	uassert(inode_lock(ip) == 0);
 
-	/* Block special file. */
-	if (S_ISBLK(inode_disk_get(ip)->i_mode))
-	{
-		dev = inode_disk_get(ip)->i_zones[0];
-		count = bdev_read(dev, buf, n, f->pos);
-	}
+	pos = (off != NULL) ? *off : f->pos;
 
-	/* Regular file/directory. */
-	else if ((S_ISDIR(inode_disk_get(ip)->i_mode)) || (S_ISREG(inode_disk_get(ip)->i_mode)))
-		count = file_read(ip, buf, n, f->pos);
+	count = do_inode_read(ip, buf, n, pos);
 
-	/* Unknown file type. */
-	else
-		return (-ENOTSUP);
+	if ((count >= 0) && (off == NULL))
+		f->pos += count;
+
+	uassert(inode_unlock(ip) == 0);
 
 	/* Failed to read. */
 	if (count < 0)
 		return (curr_proc->errcode);
 
-	f->pos += count;
-
 	return (count);
 }
 
 /*============================================================================*
- * fs_write()                                                                 *
+ * fs_read()                                                                  *
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * The fs_read() function reads @p n bytes from the file referred by @p
+ * fd into the buffer pointed to by @p buf. Data is read from the
+ * read/write pointer of the file, and the pointer is advanced.
  */
-ssize_t fs_write(int fd, void *buf, size_t n)
+ssize_t fs_read(int fd, void *buf, size_t n)
+{
+	return (do_fs_read(fd, buf, n, NULL));
+}
+
+/*============================================================================*
+ * fs_pread()                                                                 *
+ *============================================================================*/
+
+/**
+ * The fs_pread() function reads @p n bytes from the file referred by
+ * @p fd, at offset @p off, into the buffer pointed to by @p buf. The
+ * read/write pointer of the file is left untouched.
+ */
+ssize_t fs_pread(int fd, void *buf, size_t n, off_t off)
+{
+	/* Invalid offset. */
+	if (off < 0)
+		return (-EINVAL);
+
+	return (do_fs_read(fd, buf, n, &off));
+}
+
+/*============================================================================*
+ * do_fs_write()                                                              *
+ *============================================================================*/
+
+/**
+ * @brief Writes data to a file.
+ *
+ * @param fd  Target file descriptor.
+ * @param buf Target buffer.
+ * @param n   Number of bytes to write.
+ * @param off Write offset. If NULL, data is written at the read/write
+ * pointer of the file, and the pointer is advanced.
+ *
+ * @returns Upon successful completion, the number of bytes written is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+static ssize_t do_fs_write(int fd, void *buf, size_t n, const off_t *off)
 {
-	dev_t dev;         /* Device number.          */
-	struct file *f;    /* File.                   */
-	struct inode *ip;  /* Inode.                  */
-	ssize_t count = 0; /* Bytes actually written. */
+	off_t pos;        /* Write offset.           */
+	struct file *f;   /* File.                   */
+	struct inode *ip; /* Inode.                  */
+	ssize_t count;    /* Bytes actually written. */
 
 	/* Bad file descriptor. */
-	if ((f = curr_proc->ofiles[fd]) == NULL)
+	if ((f = fprocess_fd_get(fd)) == NULL)
 		return (-EBADF);
 
 	/* File not opened for writing. */
@@ -347,26 +484,331 @@ ssize_t fs_write(int fd, void *buf, size_t n)
 
 	ip = f->inode;
 
+	uassert(inode_lock(ip) == 0);
+
 	/* Append mode. */
-	if (f->oflag & O_APPEND)
+	if ((off == NULL) && (f->oflag & O_APPEND))
 		f->pos = inode_disk_get(ip)->i_size;
 
-	/* Block special file. */
-	if (S_ISBLK(inode_disk_get(ip)->i_mode))
+	pos = (off != NULL) ? *off : f->pos;
+
+	count = do_inode_write(ip, buf, n, pos);
+
+	if (count > 0)
 	{
-		dev = inode_disk_get(ip)->i_zones[0];
-		count = bdev_write(dev, buf, n, f->pos);
+		/* Invalidate remote copies. */
+		inode_inc_version(ip);
+
+		if (off == NULL)
+			f->pos += count;
 	}
 
-	/* Regular file. */
-	else if (S_ISREG(inode_disk_get(ip)->i_mode))
-		count = file_write(ip, buf, n, f->pos);
+	uassert(inode_unlock(ip) == 0);
 
 	/* Failed to write. */
 	if (count < 0)
 		return (curr_proc->errcode);
 
-	f->pos += count;
+	return (count);
+}
+
+/*============================================================================*
+ * fs_write()                                                                 *
+ *============================================================================*/
+
+/**
+ * The fs_write() function writes @p n bytes from the buffer pointed to
+ * by @p buf to the file referred by @p fd. Data is written at the
+ * read/write pointer of the file, and the pointer is advanced.
+ */
+ssize_t fs_write(int fd, void *buf, size_t n)
+{
+	return (do_fs_write(fd, buf, n, NULL));
+}
+
+/*============================================================================*
+ * fs_pwrite()                                                                *
+ *============================================================================*/
+
+/**
+ * The fs_pwrite() function writes @p n bytes from the buffer pointed to
+ * by @p buf to the file referred by @p fd, at offset @p off. The
+ * read/write pointer of the file is left untouched.
+ */
+ssize_t fs_pwrite(int fd, void *buf, size_t n, off_t off)
+{
+	/* Invalid offset. */
+	if (off < 0)
+		return (-EINVAL);
+
+	return (do_fs_write(fd, buf, n, &off));
+}
+
+/*============================================================================*
+ * fs_copy_range()                                                            *
+ *============================================================================*/
+
+/**
+ * @brief Staging buffer for fs_copy_range().
+ *
+ * @note Copies run with the file system lock held, thus a single buffer
+ * suffices.
+ */
+static char copy_buffer[NANVIX_FS_BLOCK_SIZE];
+
+/**
+ * The fs_copy_range() function copies @p n bytes from the file referred
+ * by @p fd_in, at offset @p off_in, to the file referred by @p fd_out,
+ * at offset @p off_out. Data is copied one block at a time, and it never
+ * leaves the server. If an offset is negative, the read/write pointer of
+ * the corresponding file is used instead, and it is advanced by the
+ * number of bytes copied.
+ *
+ * The file system lock is released between blocks, so that a long copy
+ * does not stall other requests. Each block is thus copied in an
+ * operation of the journal of its own, and the copy stops short if
+ * either file is closed meanwhile.
+ */
+ssize_t fs_copy_range(
+	int fd_in,
+	off_t off_in,
+	int fd_out,
+	off_t off_out,
+	size_t n
+)
+{
+	size_t i;          /* Bytes copied so far.   */
+	size_t chunk;      /* Size of current chunk. */
+	ssize_t count = 0; /* Bytes transferred.     */
+	struct file *fin;  /* Source file.           */
+	struct file *fout; /* Target file.           */
+	struct inode *in;  /* Source inode.          */
+	struct inode *out; /* Target inode.          */
+	struct inode *ip1; /* Inode locked first.    */
+	struct inode *ip2; /* Inode locked second.   */
+	off_t pin;         /* Source offset.         */
+	off_t pout;        /* Target offset.         */
+
+	/* Bad file descriptor. */
+	if (((fin = fprocess_fd_get(fd_in)) == NULL) || ((fout = fprocess_fd_get(fd_out)) == NULL))
+		return (-EBADF);
+
+	/* Source file not opened for reading. */
+	if (ACCMODE(fin->oflag) == O_WRONLY)
+		return (-EBADF);
+
+	/* Target file not opened for writing. */
+	if (ACCMODE(fout->oflag) == O_RDONLY)
+		return (-EBADF);
+
+	/* Nothing to do. */
+	if (n == 0)
+		return (0);
+
+	in = fin->inode;
+	out = fout->inode;
+
+	/* Lock inodes in a fixed order. */
+	ip1 = (inode_get_num(in) <= inode_get_num(out)) ? in : out;
+	ip2 = (ip1 == in) ? out : in;
+
+	pin = (off_in < 0) ? fin->pos : off_in;
+	pout = (off_out < 0) ? fout->pos : off_out;
+
+	/* Overlapping ranges. */
+	if ((in == out) && (pin < pout + (off_t) n) && (pout < pin + (off_t) n))
+		return (curr_proc->errcode = -EINVAL);
+
+	for (i = 0; i < n; i += count)
+	{
+		chunk = ((n - i) < NANVIX_FS_BLOCK_SIZE) ? (n - i) : NANVIX_FS_BLOCK_SIZE;
+
+		/* Let other requests in. */
+		if (i > 0)
+		{
+			fs_unlock();
+			fs_lock();
+
+			/* File closed meanwhile. */
+			if ((fprocess_fd_get(fd_in) != fin) || (fprocess_fd_get(fd_out) != fout))
+				break;
+		}
+
+		uassert(inode_lock(ip1) == 0);
+		if (ip2 != ip1)
+			uassert(inode_lock(ip2) == 0);
+
+		/* End of file or device is full. */
+		if ((count = do_inode_read(in, copy_buffer, chunk, pin + i)) > 0)
+			count = do_inode_write(out, copy_buffer, count, pout + i);
+
+		if (count > 0)
+		{
+			/* Invalidate remote copies. */
+			inode_inc_version(out);
+
+			if (off_in < 0)
+				fin->pos += count;
+			if (off_out < 0)
+				fout->pos += count;
+		}
+
+		if (ip2 != ip1)
+			uassert(inode_unlock(ip2) == 0);
+		uassert(inode_unlock(ip1) == 0);
+
+		if (count <= 0)
+			break;
+	}
+
+	/* Failed to copy. */
+	if ((i == 0) && (count < 0))
+		return (curr_proc->errcode);
+
+	return (i);
+}
+
+/*============================================================================*
+ * fs_stat()                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Fills the attributes of a file.
+ *
+ * @param ip  Target inode.
+ * @param buf Location to store the attributes.
+ */
+static void do_fs_stat(struct inode *ip, struct vfs_stat *buf)
+{
+	struct d_inode *dip;
+
+	dip = inode_disk_get(ip);
+
+	buf->ino = inode_get_num(ip);
+	buf->mode = dip->i_mode;
+	buf->nlinks = dip->i_nlinks;
+	buf->size = dip->i_size;
+	buf->time = dip->i_time;
+}
+
+/**
+ * The fs_stat() function gets the attributes of the file named @p
+ * filename and stores them in the location pointed to by @p buf. The
+ * file does not need to be opened.
+ */
+int fs_stat(const char *filename, struct vfs_stat *buf)
+{
+	struct inode *ip;
+
+	/* Invalid filename. */
+	if (filename == NULL)
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	/* File not found. */
+	if ((ip = inode_name(&fs_root, filename)) == NULL)
+		return (curr_proc->errcode);
+
+	do_fs_stat(ip, buf);
+
+	return (inode_put(&fs_root, ip));
+}
+
+/*============================================================================*
+ * fs_fstat()                                                                 *
+ *============================================================================*/
+
+/**
+ * The fs_fstat() function gets the attributes of the file referred by
+ * the file descriptor @p fd and stores them in the location pointed to
+ * by @p buf.
+ */
+int fs_fstat(int fd, struct vfs_stat *buf)
+{
+	struct file *f;
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	/* Bad file descriptor. */
+	if ((f = fprocess_fd_get(fd)) == NULL)
+		return (-EBADF);
+
+	do_fs_stat(f->inode, buf);
+
+	return (0);
+}
+
+/*============================================================================*
+ * fs_getdents()                                                              *
+ *============================================================================*/
+
+/**
+ * The fs_getdents() function reads up to @p n entries of the directory
+ * referred by @p fd, starting from the read/write pointer of the file,
+ * and stores them in the array pointed to by @p dirp. Attributes of
+ * each entry are looked up as well, so that listing a directory does
+ * not require further requests. The read/write pointer is advanced past
+ * the entries read.
+ */
+int fs_getdents(int fd, struct vfs_dirent *dirp, int n)
+{
+	int count = 0;       /* Entries read.      */
+	ssize_t nread;       /* Bytes read.        */
+	struct file *f;      /* Directory.         */
+	struct inode *ip;    /* Directory inode.   */
+	struct inode *entry; /* Inode of entry.    */
+	struct d_dirent d;   /* Raw entry.         */
+
+	/* Bad file descriptor. */
+	if ((f = fprocess_fd_get(fd)) == NULL)
+		return (-EBADF);
+
+	/* Invalid buffer. */
+	if ((dirp == NULL) || (n <= 0))
+		return (-EINVAL);
+
+	ip = f->inode;
+
+	/* Not a directory. */
+	if (!S_ISDIR(inode_disk_get(ip)->i_mode))
+		return (-ENOTDIR);
+
+	uassert(inode_lock(ip) == 0);
+
+	while (count < n)
+	{
+		/* End of directory. */
+		if ((nread = file_read(ip, &d, sizeof(struct d_dirent), f->pos)) < (ssize_t) sizeof(struct d_dirent))
+			break;
+
+		f->pos += nread;
+
+		/* Free entry. */
+		if (d.d_ino == MINIX_INODE_NULL)
+			continue;
+
+		/* Dangling entry. */
+		if ((entry = inode_get(&fs_root, d.d_ino)) == NULL)
+			continue;
+
+		umemset(dirp[count].d_name, 0, NANVIX_NAME_MAX);
+		umemcpy(dirp[count].d_name, d.d_name, MINIX_NAME_MAX);
+		do_fs_stat(entry, &dirp[count].d_stat);
+		uassert(inode_put(&fs_root, entry) == 0);
+
+		count++;
+	}
+
+	uassert(inode_unlock(ip) == 0);
+
+	/* Failed to read. */
+	if ((nread < 0) && (count == 0))
+		return (curr_proc->errcode);
 
 	return (count);
 }
@@ -384,7 +826,7 @@ off_t fs_lseek(int fd, off_t offset, int whence)
 	struct file *f; /* File.               */
 
 	/* Bad file descriptor. */
-	if ((f = curr_proc->ofiles[fd]) == NULL)
+	if ((f = fprocess_fd_get(fd)) == NULL)
 		return (-EBADF);
 
 	/* Pipe file. */
@@ -422,6 +864,62 @@ off_t fs_lseek(int fd, off_t offset, int whence)
 	return (f->pos);
 }
 
+/*============================================================================*
+ * fs_lease()                                                                 *
+ *============================================================================*/
+
+/**
+ * The fs_lease() function grants a data lease on the file referred by
+ * the file descriptor @p fd. A read lease allows the holder to serve
+ * reads from its local cache, and it is granted as long as no one else
+ * has the file opened for writing. A write lease further allows the
+ * holder to defer writes, and it is granted only if the holder is the
+ * only one that has the file opened. The current data version of the
+ * file is stored in the location pointed to by @p version, so that the
+ * holder may validate its cached data.
+ */
+int fs_lease(int fd, unsigned *version)
+{
+	struct file *f; /* File.                  */
+	int nreaders;   /* Other readers of file. */
+	int nwriters;   /* Other writers of file. */
+
+	/* Invalid version. */
+	if (version == NULL)
+		return (-EINVAL);
+
+	/* Bad file descriptor. */
+	if ((f = fprocess_fd_get(fd)) == NULL)
+		return (-EBADF);
+
+	*version = inode_get_version(f->inode);
+
+	/* Look for other users of the file. */
+	uassert(inode_get_openers(f->inode, &nreaders, &nwriters) == 0);
+	if (ACCMODE(f->oflag) == O_RDONLY)
+		nreaders--;
+	else
+		nwriters--;
+
+	/* Write sharing. */
+	if (nwriters > 0)
+		return (VFS_LEASE_NONE);
+
+	/* Read only. */
+	if (ACCMODE(f->oflag) == O_RDONLY)
+		return (VFS_LEASE_READ);
+
+	/* Shared or appending. */
+	if ((nreaders > 0) || (f->oflag & O_APPEND))
+		return (VFS_LEASE_NONE);
+
+	/* Write-behind requires fetching partial blocks. */
+	if (ACCMODE(f->oflag) == O_WRONLY)
+		return (VFS_LEASE_NONE);
+
+	return (VFS_LEASE_WRITE);
+}
+
 /*============================================================================*
  * fs_make()                                                                  *
  *============================================================================*/
@@ -441,6 +939,9 @@ int fs_make(
 	gid_t gid
 )
 {
+	/* Drop cached lookups. */
+	dcache_invalidate(dev, NULL);
+
 	return (
 		minix_mkfs(
 			dev,
@@ -465,6 +966,9 @@ int fs_make(
  */
 int fs_mount(struct filesystem *fs, dev_t dev)
 {
+	int err;
+	int journaled;
+
 	/* Invalid argument. */
 	if (fs == NULL)
 		return (curr_proc->errcode = -EINVAL);
@@ -473,6 +977,14 @@ int fs_mount(struct filesystem *fs, dev_t dev)
 	if ((fs->super = umalloc(sizeof(struct superblock))) == NULL)
 		return (curr_proc->errcode = -ENOMEM);
 
+	/* Replay journal, unless it serves another file system. */
+	if (((err = journal_mount(dev)) < 0) && (err != -EBUSY))
+	{
+		curr_proc->errcode = err;
+		goto error0;
+	}
+	journaled = (err == 0);
+
 	/* Mount file system. */
 	uprintf("[nanvix][vfs][minix] mounting file system on device %d", dev);
 	if (minix_mount(
@@ -482,20 +994,34 @@ int fs_mount(struct filesystem *fs, dev_t dev)
 			fs->dev = dev
 		) < 0
 	)
-		goto error0;
+		goto error1;
+
+	/* Allocate block reservation map, which is never persisted. */
+	fs->super->rmap = ucalloc(fs->super->data.s_bmap_nblocks, MINIX_BLOCK_SIZE);
+	if (fs->super->rmap == NULL)
+	{
+		curr_proc->errcode = -ENOMEM;
+		goto error2;
+	}
 
 	/* Get reference root inode. */
 	if ((fs->root = inode_get(fs, MINIX_INODE_ROOT)) == NULL)
 	{
 		curr_proc->errcode = -ENOMEM;
-		goto error1;
+		goto error3;
 	}
 
 	return (0);
 
+error3:
+	ufree(fs->super->rmap);
+error2:
+	minix_unmount(&fs->super->data, fs->super->imap, fs->super->bmap, dev);
 error1:
-	ufree(fs->super);
+	if (journaled)
+		journal_unmount(dev);
 error0:
+	ufree(fs->super);
 	return (curr_proc->errcode);
 }
 
@@ -533,43 +1059,93 @@ int fs_unmount(struct filesystem *fs)
 	)
 		return (curr_proc->errcode = err);
 
+	/* Checkpoint journal. */
+	if (((err = journal_unmount(fs->dev)) < 0) && (err != -EINVAL))
+		return (curr_proc->errcode = err);
+
+	/* Write cached device data back. */
+	if ((err = bdev_flush(fs->dev)) < 0)
+		return (curr_proc->errcode = err);
+
 	/* House keeping. */
+	dcache_invalidate(fs->dev, NULL);
+	ufree(fs->super->rmap);
 	ufree(fs->super);
 
 	return (0);
 }
 
+/*============================================================================*
+ * fs_lock()                                                                  *
+ *============================================================================*/
+
+/**
+ * The fs_lock() function acquires the file system lock. This lock
+ * serializes changes to the namespace, to the tables of files and
+ * inodes, and to the maps of the superblock. File data is guarded by
+ * the lock of the underlying inode instead. Each critical section is
+ * an operation of the journal.
+ */
+void fs_lock(void)
+{
+	nanvix_semaphore_down(&lock);
+	journal_begin();
+}
+
+/*============================================================================*
+ * fs_unlock()                                                                *
+ *============================================================================*/
+
+/**
+ * The fs_unlock() function releases the file system lock.
+ */
+void fs_unlock(void)
+{
+	nanvix_semaphore_up(&lock);
+}
+
 /*============================================================================*
  * fs_init()                                                                  *
  *============================================================================*/
 
 /**
  * The fs_init() function initializes the file system. It brings the
- * underlying devices up, formats the file system and initialize the
- * table of tiles.
+ * underlying devices up, formats the file system if the root device
+ * does not hold one yet, and initialize the table of tiles.
  */
 void fs_init(void)
 {
-	ramdisk_init();
+	nanvix_semaphore_init(&lock, 1);
+
+	bdev_init();
 	binit();
+	journal_init();
+	dcache_init();
+	inode_init();
 
-	/* Create root file system. */
-	uassert(
-		fs_make(
-			NANVIX_ROOT_DEV,
-			NANVIX_NR_INODES,
-			NANVIX_DISK_SIZE/NANVIX_FS_BLOCK_SIZE,
-			NANVIX_ROOT_UID,
-			NANVIX_ROOT_GID
-		) == 0
-	);
+	/* Create root file system, unless the device was preloaded. */
+	if (minix_probe(NANVIX_ROOT_DEV) < 0)
+	{
+		uassert(
+			fs_make(
+				NANVIX_ROOT_DEV,
+				NANVIX_NR_INODES,
+				NANVIX_DISK_SIZE/NANVIX_FS_BLOCK_SIZE,
+				NANVIX_ROOT_UID,
+				NANVIX_ROOT_GID
+			) == 0
+		);
+	}
+	else
+		uprintf("[nanvix][vfs] booting from preloaded file system");
 
 	/* Mount root file system. */
 	uassert(fs_mount(&fs_root, NANVIX_ROOT_DEV) == 0);
 
 	/* Initialize table of files. */
-	for (int i = 0; i < NANVIX_NR_FILES; i++)
-		FILE_INITIALIZER(&filetab[i]);
+	freefiles.nfree = 0;
+	for (int i = NANVIX_NR_FILES - 1; i >= 0; i--)
+		putfile(&filetab[i]);
 }
 
 /*============================================================================*
@@ -583,4 +1159,6 @@ void fs_shutdown(void)
 {
 	/* Unmount root file system. */
 	uassert(fs_unmount(&fs_root) == 0);
+
+	bdev_shutdown();
 }
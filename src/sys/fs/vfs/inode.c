@@ -25,7 +25,9 @@
 /* Must come first. */
 #define __VFS_SERVER
 
+#include <nanvix/runtime/utils.h>
 #include <nanvix/servers/vfs.h>
+#include <nanvix/sys/semaphore.h>
 #include <nanvix/sys/perf.h>
 #include <nanvix/config.h>
 #include <nanvix/dev.h>
@@ -33,6 +35,7 @@
 #include <nanvix/ulib.h>
 #include <posix/sys/types.h>
 #include <posix/errno.h>
+#include <posix/fcntl.h>
 
 /**
  * @brief In-Memory Inode
@@ -46,13 +49,52 @@ struct inode
 	dev_t dev;           /**< Underlying Device      */
 	ino_t num;           /**< Inode Number           */
 	int count;           /**< Reference count        */
+	unsigned version;    /**< Data Version           */
+	int nreaders;        /**< Read-only Openers      */
+	int nwriters;        /**< Writable Openers       */
+	int hnext;           /**< Next Inode in Bucket   */
+	int lprev;           /**< Previous Inode in LRU  */
+	int lnext;           /**< Next Inode in LRU      */
+
+	/**
+	 * @brief Last Mapped Extent
+	 */
+	struct
+	{
+		block_t logic;      /**< First logical block.  */
+		minix_block_t phys; /**< First physical block. */
+		block_t len;        /**< Number of blocks.     */
+	} map;
+
+	struct minix_prealloc prealloc; /**< Preallocated Blocks */
+
+	struct nanvix_semaphore lock; /**< Inode Lock */
 };
 
+/**
+ * @brief Number of hash buckets in the table of inodes.
+ */
+#define INODES_HASH_LENGTH (NANVIX_INODES_TABLE_LENGTH/2)
+
 /**
  * @brief Table of Inodes
  */
 static struct inode inodes[NANVIX_INODES_TABLE_LENGTH];
 
+/**
+ * @brief Hash table for the table of inodes.
+ */
+static int buckets[INODES_HASH_LENGTH];
+
+/**
+ * @brief List of unreferenced inodes (least recently used first).
+ */
+static struct
+{
+	int head; /**< Least recently used.  */
+	int tail; /**< Most recently used.   */
+} lru = { -1, -1 };
+
 /**
  * @brief Pool of Inodes
  */
@@ -62,6 +104,188 @@ static struct resource_pool pool = {
 	.resource_size = sizeof(struct inode)
 };
 
+/**
+ * @brief Index of free inodes.
+ */
+static struct resource_index pool_index = RESOURCE_INDEX_INITIALIZER(&pool);
+
+/**
+ * @brief Clock of data versions.
+ *
+ * Data versions are drawn from a single clock, so that an inode that
+ * is evicted and then read back never reuses a version that remote
+ * clients may still hold.
+ */
+static unsigned versions = 0;
+
+/*============================================================================*
+ * inode_hash()                                                               *
+ *============================================================================*/
+
+/**
+ * @brief Hashes an inode.
+ *
+ * @param dev Device number.
+ * @param num Inode number.
+ *
+ * @returns The hash value of the target inode.
+ */
+static inline int inode_hash(dev_t dev, ino_t num)
+{
+	return ((unsigned)(dev ^ num)%INODES_HASH_LENGTH);
+}
+
+/*============================================================================*
+ * inode_hash_insert()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Inserts an inode in the hash table.
+ *
+ * @param idx Index of target inode.
+ */
+static void inode_hash_insert(int idx)
+{
+	int hash;
+
+	hash = inode_hash(inodes[idx].dev, inodes[idx].num);
+	inodes[idx].hnext = buckets[hash];
+	buckets[hash] = idx;
+}
+
+/*============================================================================*
+ * inode_hash_remove()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Removes an inode from the hash table.
+ *
+ * @param idx Index of target inode.
+ */
+static void inode_hash_remove(int idx)
+{
+	int *p;
+
+	p = &buckets[inode_hash(inodes[idx].dev, inodes[idx].num)];
+
+	for (/* noop */; *p >= 0; p = &inodes[*p].hnext)
+	{
+		/* Found. */
+		if (*p == idx)
+		{
+			*p = inodes[idx].hnext;
+			break;
+		}
+	}
+
+	inodes[idx].hnext = -1;
+}
+
+/*============================================================================*
+ * inode_hash_lookup()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Searches for an inode in the hash table.
+ *
+ * @param dev Device number.
+ * @param num Inode number.
+ *
+ * @returns If the target inode is in memory, its index in the table of
+ * inodes is returned. Otherwise, a negative number is returned instead.
+ */
+static int inode_hash_lookup(dev_t dev, ino_t num)
+{
+	for (int i = buckets[inode_hash(dev, num)]; i >= 0; i = inodes[i].hnext)
+	{
+		/* Found. */
+		if ((inodes[i].dev == dev) && (inodes[i].num == num))
+			return (i);
+	}
+
+	return (-1);
+}
+
+/*============================================================================*
+ * inode_lru_insert()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Appends an unreferenced inode to the LRU list.
+ *
+ * @param idx Index of target inode.
+ */
+static void inode_lru_insert(int idx)
+{
+	inodes[idx].lnext = -1;
+	inodes[idx].lprev = lru.tail;
+
+	if (lru.tail >= 0)
+		inodes[lru.tail].lnext = idx;
+	else
+		lru.head = idx;
+
+	lru.tail = idx;
+}
+
+/*============================================================================*
+ * inode_lru_remove()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Removes an inode from the LRU list.
+ *
+ * @param idx Index of target inode.
+ */
+static void inode_lru_remove(int idx)
+{
+	if (inodes[idx].lprev >= 0)
+		inodes[inodes[idx].lprev].lnext = inodes[idx].lnext;
+	else
+		lru.head = inodes[idx].lnext;
+
+	if (inodes[idx].lnext >= 0)
+		inodes[inodes[idx].lnext].lprev = inodes[idx].lprev;
+	else
+		lru.tail = inodes[idx].lprev;
+
+	inodes[idx].lprev = -1;
+	inodes[idx].lnext = -1;
+}
+
+/*============================================================================*
+ * inode_reclaim()                                                            *
+ *============================================================================*/
+
+/**
+ * @brief Allocates a slot in the table of inodes.
+ *
+ * A free slot is used, if any. Otherwise, the least recently used
+ * unreferenced inode is reclaimed. Unreferenced inodes are always
+ * clean, because inode_put() writes them back.
+ *
+ * @returns Upon successful completion, the index of the allocated slot
+ * is returned. Upon failure, a negative error code is returned
+ * instead.
+ */
+static int inode_reclaim(void)
+{
+	int idx;
+
+	/* Free slot. */
+	if ((idx = resource_index_alloc(&pool_index)) >= 0)
+		return (idx);
+
+	/* No unreferenced inode. */
+	if ((idx = lru.head) < 0)
+		return (-ENFILE);
+
+	inode_lru_remove(idx);
+	inode_hash_remove(idx);
+
+	return (idx);
+}
+
 /*============================================================================*
  * inode_disk_get()                                                           *
  *============================================================================*/
@@ -190,31 +414,39 @@ static struct inode *inode_read(struct filesystem *fs, ino_t num)
 		return (NULL);
 
 	/* Allocate memory inode. */
-	if ((idx = resource_alloc(&pool)) < 0)
+	if ((idx = inode_reclaim()) < 0)
 	{
 		uprintf("[nanvix][vfs] inodes table overflow");
-		curr_proc->errcode = -ENOMEM;
-		goto error0;
+		curr_proc->errcode = idx;
+		return (NULL);
 	}
 
 	ip = &inodes[idx];
 
 	/* Read disk inode. */
 	if (minix_inode_read(fs->dev, &fs->super->data, &ip->data, num) < 0)
-		goto error1;
+	{
+		resource_index_free(&pool_index, idx);
+		curr_proc->errcode = -EIO;
+		return (NULL);
+	}
 
 	/* Initialize inode. */
 	ip->count = 1;
 	ip->num = num;
 	ip->dev = fs->dev;
+	ip->version = ++versions;
+	ip->nreaders = 0;
+	ip->nwriters = 0;
+	ip->lprev = -1;
+	ip->lnext = -1;
+	ip->map.len = 0;
+	ip->prealloc.next = MINIX_BLOCK_NULL;
+	ip->prealloc.count = 0;
+	ip->prealloc.rmap = fs->super->rmap;
+	inode_hash_insert(idx);
 
 	return (ip);
-
-error1:
-	resource_free(&pool, idx);
-error0:
-	uassert(minix_inode_free(&fs->super->data, fs->super->imap, num) == 0);
-	return (NULL);
 }
 
 /*============================================================================*
@@ -243,6 +475,187 @@ int inode_touch(struct inode *ip)
 	return (0);
 }
 
+/*============================================================================*
+ * inode_get_version()                                                        *
+ *============================================================================*/
+
+/**
+ * The inode_get_version() function gets the data version of the inode
+ * pointed to by @p ip. The data version is bumped whenever the contents
+ * of the inode change, and it is used by remote clients to validate
+ * their cached data.
+ */
+unsigned inode_get_version(const struct inode *ip)
+{
+	/* Invalid inode. */
+	if (ip == NULL)
+		return (0);
+
+	/* Bad inode. */
+	if (ip->count == 0)
+		return (0);
+
+	return (ip->version);
+}
+
+/*============================================================================*
+ * inode_inc_version()                                                        *
+ *============================================================================*/
+
+/**
+ * The inode_inc_version() function increments the data version of the
+ * inode pointed to by @p ip. The new version is taken from the clock of
+ * data versions, thus it is larger than any version handed out before.
+ */
+int inode_inc_version(struct inode *ip)
+{
+	/* Invalid inode. */
+	if (ip == NULL)
+		return (curr_proc->errcode = -EINVAL);
+
+	/* Bad inode. */
+	if (ip->count == 0)
+		return (curr_proc->errcode = -EINVAL);
+
+	ip->version = ++versions;
+
+	return (0);
+}
+
+/*============================================================================*
+ * inode_attach()                                                             *
+ *============================================================================*/
+
+/**
+ * The inode_attach() function accounts for a new opener of the inode
+ * pointed to by @p ip, which has opened it with the flags @p oflag.
+ */
+int inode_attach(struct inode *ip, int oflag)
+{
+	/* Invalid inode. */
+	if (ip == NULL)
+		return (curr_proc->errcode = -EINVAL);
+
+	/* Bad inode. */
+	if (ip->count == 0)
+		return (curr_proc->errcode = -EINVAL);
+
+	if (ACCMODE(oflag) == O_RDONLY)
+		ip->nreaders++;
+	else
+		ip->nwriters++;
+
+	return (0);
+}
+
+/*============================================================================*
+ * inode_detach()                                                             *
+ *============================================================================*/
+
+/**
+ * The inode_detach() function accounts for an opener of the inode
+ * pointed to by @p ip, which had opened it with the flags @p oflag, to
+ * have gone away.
+ */
+int inode_detach(struct inode *ip, int oflag)
+{
+	int *nopeners;
+
+	/* Invalid inode. */
+	if (ip == NULL)
+		return (curr_proc->errcode = -EINVAL);
+
+	/* Bad inode. */
+	if (ip->count == 0)
+		return (curr_proc->errcode = -EINVAL);
+
+	nopeners = (ACCMODE(oflag) == O_RDONLY) ? &ip->nreaders : &ip->nwriters;
+
+	/* Not attached. */
+	if (*nopeners == 0)
+		return (curr_proc->errcode = -EINVAL);
+
+	(*nopeners)--;
+
+	return (0);
+}
+
+/*============================================================================*
+ * inode_get_openers()                                                        *
+ *============================================================================*/
+
+/**
+ * The inode_get_openers() function gets the number of openers of the
+ * inode pointed to by @p ip. The number of read-only openers is stored
+ * in the location pointed to by @p nreaders, and the number of writable
+ * openers in the location pointed to by @p nwriters.
+ */
+int inode_get_openers(const struct inode *ip, int *nreaders, int *nwriters)
+{
+	/* Invalid inode. */
+	if (ip == NULL)
+		return (-EINVAL);
+
+	/* Invalid storage locations. */
+	if ((nreaders == NULL) || (nwriters == NULL))
+		return (-EINVAL);
+
+	/* Bad inode. */
+	if (ip->count == 0)
+		return (-EINVAL);
+
+	*nreaders = ip->nreaders;
+	*nwriters = ip->nwriters;
+
+	return (0);
+}
+
+/*============================================================================*
+ * inode_lock()                                                               *
+ *============================================================================*/
+
+/**
+ * The inode_lock() function locks the inode pointed to by @p ip. While
+ * an inode is locked, other threads of the server may not read or
+ * change its contents.
+ */
+int inode_lock(struct inode *ip)
+{
+	/* Invalid inode. */
+	if (ip == NULL)
+		return (curr_proc->errcode = -EINVAL);
+
+	/* Bad inode. */
+	if (ip->count == 0)
+		return (curr_proc->errcode = -EINVAL);
+
+	nanvix_semaphore_down(&ip->lock);
+
+	return (0);
+}
+
+/*============================================================================*
+ * inode_unlock()                                                             *
+ *============================================================================*/
+
+/**
+ * The inode_unlock() function unlocks the inode pointed to by @p ip.
+ */
+int inode_unlock(struct inode *ip)
+{
+	/* Invalid inode. */
+	if (ip == NULL)
+		return (curr_proc->errcode = -EINVAL);
+
+	/* Bad inode. */
+	if (ip->count == 0)
+		return (curr_proc->errcode = -EINVAL);
+
+	nanvix_semaphore_up(&ip->lock);
+
+	return (0);
+}
+
 /*============================================================================*
  * inode_free()                                                               *
  *============================================================================*/
@@ -270,22 +683,31 @@ static int inode_free(struct filesystem *fs, struct inode *ip)
 	if (ip->count == 0)
 		return (curr_proc->errcode = -EBUSY);
 	
-	/* Release inode. */
-	if (ip->count-- == 1)
+	/* Still referenced. */
+	if (--ip->count > 0)
+		return (0);
+
+	/* Give back blocks that were not used. */
+	minix_block_prealloc_release(&fs->super->data, fs->super->bmap, &ip->prealloc);
+
+	/* Keep inode cached. */
+	if (ip->data.i_nlinks > 0)
 	{
-		if (ip->data.i_nlinks-- == 1)
-		{
-			if (minix_inode_free(&fs->super->data, fs->super->imap, ip->num) < 0)
-			{
-				uprintf("[nanvix][vfs] failed to release inode %d", ip->num);
-				return (curr_proc->errcode = -EAGAIN);
-			}
-		}
+		inode_lru_insert(idx);
+		return (0);
+	}
 
-		/* House keeping. */
-		resource_free(&pool, idx);
+	/* Release unlinked inode. */
+	if (minix_inode_free(&fs->super->data, fs->super->imap, ip->num) < 0)
+	{
+		uprintf("[nanvix][vfs] failed to release inode %d", ip->num);
+		return (curr_proc->errcode = -EAGAIN);
 	}
 
+	/* House keeping. */
+	inode_hash_remove(idx);
+	resource_index_free(&pool_index, idx);
+
 	return (0);
 }
 
@@ -373,6 +795,94 @@ int inode_write(struct filesystem *fs, struct inode *ip)
 	return (0);
 }
 
+/*============================================================================*
+ * inode_block_map()                                                          *
+ *============================================================================*/
+
+/**
+ * The inode_block_map() function maps the byte offset @p off in the
+ * inode pointed to by @p ip to a physical block of the file system
+ * pointed to by @p fs. The last extent that was mapped is kept in the
+ * inode, so that sequential accesses resolve from memory, and only go
+ * to the underlying file system once per run of contiguous blocks.
+ */
+minix_block_t inode_block_map(
+	struct filesystem *fs,
+	struct inode *ip,
+	off_t off,
+	int create,
+	block_t *len
+)
+{
+	block_t logic;      /* Logic. blk. #.     */
+	minix_block_t phys; /* Phys. blk. #.      */
+	minix_block_t n;    /* Length of new run. */
+
+	/* Invalid file system */
+	if (fs == NULL)
+		return (MINIX_BLOCK_NULL);
+
+	/* Invalid inode. */
+	if (ip == NULL)
+		return (MINIX_BLOCK_NULL);
+
+	/* Bad inode. */
+	if ((fs->dev != ip->dev) || (ip->count == 0))
+		return (MINIX_BLOCK_NULL);
+
+	/* Bad offset. */
+	if (off < 0)
+		return (MINIX_BLOCK_NULL);
+
+	logic = off/MINIX_BLOCK_SIZE;
+
+	/* Hit. */
+	if ((logic >= ip->map.logic) && (logic - ip->map.logic < ip->map.len))
+	{
+		if (len != NULL)
+			*len = ip->map.len - (logic - ip->map.logic);
+
+		return (ip->map.phys + (logic - ip->map.logic));
+	}
+
+	/* Miss. */
+	phys = minix_block_map_extent(
+		&fs->super->data,
+		fs->super->bmap,
+		&ip->data,
+		&ip->prealloc,
+		off,
+		create,
+		&n
+	);
+
+	/* Do not cache holes. */
+	if (phys == MINIX_BLOCK_NULL)
+	{
+		if (len != NULL)
+			*len = 0;
+
+		return (MINIX_BLOCK_NULL);
+	}
+
+	/* Grow cached extent. */
+	if ((ip->map.len > 0) && (logic == ip->map.logic + ip->map.len) && (phys == ip->map.phys + ip->map.len))
+		ip->map.len += n;
+
+	/* Replace cached extent. */
+	else
+	{
+		ip->map.logic = logic;
+		ip->map.phys = phys;
+		ip->map.len = n;
+	}
+
+	if (len != NULL)
+		*len = n;
+
+	return (phys);
+}
+
 /*============================================================================*
  * inode_get()                                                                *
  *============================================================================*/
@@ -383,6 +893,8 @@ int inode_write(struct filesystem *fs, struct inode *ip)
  */
 struct inode *inode_get(struct filesystem *fs, ino_t num)
 {
+	int idx;
+
 	/* Invalid file system. */
 	if (fs == NULL)
 	{
@@ -398,18 +910,13 @@ struct inode *inode_get(struct filesystem *fs, ino_t num)
 	}
 
 	/* Search for inode in the table of inodes. */
-	for (int i = 0; i < NANVIX_INODES_TABLE_LENGTH; i++)
+	if ((idx = inode_hash_lookup(fs->dev, num)) >= 0)
 	{
-		/* Skip invalid entries. */
-		if (!resource_is_used(&inodes[i].resource))
-			continue;
+		/* Revive unreferenced inode. */
+		if (inodes[idx].count++ == 0)
+			inode_lru_remove(idx);
 
-		/* Found. */
-		if ((inodes[i].dev == fs->dev) && (inodes[i].num == num))
-		{
-			inodes[i].count++;
-			return (&inodes[i]);
-		}
+		return (&inodes[idx]);
 	}
 
 	/* Read inode in. */
@@ -430,7 +937,9 @@ struct inode *inode_alloc(
 	gid_t gid
 )
 {
+	int idx;
 	ino_t num;
+	struct inode *ip;
 
 	/* Invalid file system */
 	if (fs == NULL)
@@ -453,7 +962,26 @@ struct inode *inode_alloc(
 		return (NULL);
 	}
 
-	return (inode_read(fs, num));
+	/* Drop stale copy. */
+	if ((idx = inode_hash_lookup(fs->dev, num)) >= 0)
+	{
+		uassert(inodes[idx].count == 0);
+		inode_lru_remove(idx);
+		inode_hash_remove(idx);
+		resource_index_free(&pool_index, idx);
+	}
+
+	/* Bring inode to memory. */
+	if ((ip = inode_read(fs, num)) == NULL)
+	{
+		uassert(minix_inode_free(&fs->super->data, fs->super->imap, num) == 0);
+		return (NULL);
+	}
+
+	/* Not linked to any directory yet. */
+	ip->data.i_nlinks = 0;
+
+	return (ip);
 }
 
 /*============================================================================*
@@ -471,6 +999,8 @@ struct inode *inode_alloc(
 struct inode *inode_name(struct filesystem *fs, const char *name)
 {
 	struct inode *dinode;   /* Directory's inode.     */
+	ino_t dnum;             /* Directory's number.    */
+	ino_t num;              /* Number of Target Inode */
 	off_t off;              /* Offset of Target Inode */
 	struct d_dirent dirent; /* Directory Entry        */
 
@@ -497,20 +1027,41 @@ struct inode *inode_name(struct filesystem *fs, const char *name)
 		return (NULL);
 	}
 
+	dnum = inode_get_num(dinode);
+
+	/* Lookup directory cache. */
+	if (dcache_lookup(fs->dev, dnum, name, &num) == 0)
+	{
+		/* Known not to exist. */
+		if (num == MINIX_INODE_NULL)
+		{
+			curr_proc->errcode = -ENOENT;
+			return (NULL);
+		}
+
+		return (inode_get(&fs_root, num));
+	}
+
 	/* Search file. */
 	if ((off = minix_dirent_search(fs->dev, &fs->super->data, fs->super->bmap, inode_disk_get(dinode), name, 0)) < 0)
 	{
+		/* Remember missing name. */
+		if (off == -1)
+			dcache_insert(fs->dev, dnum, name, MINIX_INODE_NULL);
+
 		curr_proc->errcode = -ENOENT;
 		return (NULL);
 	}
 
 	/* Read Directory entry */
-	if (bdev_read(fs->dev, (char *) &dirent, sizeof(struct d_dirent), off) < 0)
+	if (journal_read(fs->dev, &dirent, sizeof(struct d_dirent), off) < 0)
 	{
 		curr_proc->errcode = -EIO;
 		return (NULL);
 	}
 
+	dcache_insert(fs->dev, dnum, name, dirent.d_ino);
+
 	return (inode_get(&fs_root, dirent.d_ino));
 }
 
@@ -523,11 +1074,29 @@ struct inode *inode_name(struct filesystem *fs, const char *name)
  */
 void inode_init(void)
 {
+	for (int i = 0; i < INODES_HASH_LENGTH; i++)
+		buckets[i] = -1;
+
 	for (int i = 0; i < NANVIX_INODES_TABLE_LENGTH; i++)
 	{
 		inodes[i].resource = RESOURCE_INITIALIZER;
 		inodes[i].dev = -1;
 		inodes[i].num = MINIX_INODE_NULL;
 		inodes[i].count = 0;
+		inodes[i].hnext = -1;
+		inodes[i].lprev = -1;
+		inodes[i].lnext = -1;
+		inodes[i].map.len = 0;
+		inodes[i].prealloc.next = MINIX_BLOCK_NULL;
+		inodes[i].prealloc.count = 0;
+		inodes[i].prealloc.rmap = NULL;
+		nanvix_semaphore_init(&inodes[i].lock, 1);
 	}
+
+	resource_index_reset(&pool_index);
+
+	lru.head = -1;
+	lru.tail = -1;
+
+	uprintf("[nanvix][vfs] %d slots in the inode cache", NANVIX_INODES_TABLE_LENGTH);
 }
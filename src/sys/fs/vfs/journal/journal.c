@@ -0,0 +1,888 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __VFS_SERVER
+
+#include <nanvix/servers/vfs.h>
+#include <nanvix/sys/semaphore.h>
+#include <nanvix/config.h>
+#include <nanvix/dev.h>
+#include <nanvix/ulib.h>
+#include <posix/errno.h>
+
+/**
+ * @brief Magic number for journal structures.
+ */
+#define JOURNAL_MAGIC 0x4c4e524a
+
+/**
+ * @brief Size of the log area (in bytes).
+ *
+ * The first block of the journal device holds the log header.
+ */
+#define JOURNAL_LOG_SIZE (NANVIX_JOURNAL_SIZE - NANVIX_FS_BLOCK_SIZE)
+
+/**
+ * @brief Offset of the log area in the journal device.
+ */
+#define JOURNAL_LOG_OFF NANVIX_FS_BLOCK_SIZE
+
+/**
+ * @brief Rounds up the length of a record.
+ */
+#define JOURNAL_ALIGN(x) (((x) + 3) & ~3)
+
+#if (JOURNAL_LOG_SIZE <= 0)
+#error "the journal should be larger than a block"
+#endif
+
+/**
+ * @brief Log Header
+ */
+struct journal_header
+{
+	uint32_t magic; /**< Magic number.            */
+	uint32_t seq;   /**< Sequence of first group. */
+};
+
+/**
+ * @brief Log Record
+ *
+ * A record with no data marks the commit of a group.
+ */
+struct journal_record
+{
+	uint32_t magic; /**< Magic number.              */
+	uint32_t seq;   /**< Sequence of the group.     */
+	uint32_t off;   /**< Offset in the home device. */
+	uint16_t dev;   /**< Home device.               */
+	uint16_t len;   /**< Length of data.            */
+};
+
+/**
+ * @brief Journal
+ *
+ * Records past the start of the current operation are never committed
+ * on their own, so that groups only ever hold whole operations.
+ */
+static struct
+{
+	int active;                                     /**< Active?               */
+	dev_t dev;                                      /**< Journaled device.     */
+	uint32_t seq;                                   /**< Current group.        */
+	unsigned epoch;                                 /**< Device write epoch.   */
+	size_t tail;                                    /**< End of log.           */
+	size_t committed;                               /**< End of committed log. */
+	size_t opstart;                                 /**< Start of current op.  */
+	int opfirst;                                    /**< First record of op.   */
+	int nrecords;                                   /**< Logged records.       */
+	size_t records[NANVIX_JOURNAL_NR_RECORDS];      /**< Offsets of records.   */
+	char log[JOURNAL_LOG_SIZE];                     /**< In-memory log.        */
+	struct journal_stats stats;                     /**< Statistics.           */
+} journal;
+
+/**
+ * @brief Journal lock.
+ */
+static struct nanvix_semaphore lock;
+
+/*============================================================================*
+ * journal_record_get()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Gets a record of the in-memory log.
+ *
+ * @param pos Offset of the record in the log.
+ *
+ * @returns A pointer to the target record.
+ */
+static inline struct journal_record *journal_record_get(size_t pos)
+{
+	return ((struct journal_record *) &journal.log[pos]);
+}
+
+/*============================================================================*
+ * journal_move()                                                             *
+ *============================================================================*/
+
+/**
+ * @brief Moves a range of the in-memory log.
+ *
+ * @param to   Target offset in the log.
+ * @param from Source offset in the log.
+ * @param n    Number of bytes to move.
+ *
+ * The source and target ranges may overlap.
+ */
+static void journal_move(size_t to, size_t from, size_t n)
+{
+	if (to < from)
+	{
+		for (size_t i = 0; i < n; i++)
+			journal.log[to + i] = journal.log[from + i];
+	}
+	else
+	{
+		for (size_t i = n; i > 0; i--)
+			journal.log[to + i - 1] = journal.log[from + i - 1];
+	}
+}
+
+/*============================================================================*
+ * journal_header_write()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Writes the log header.
+ *
+ * @param seq Sequence number of the next group.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+static int journal_header_write(uint32_t seq)
+{
+	char buf[NANVIX_FS_BLOCK_SIZE];
+	struct journal_header *hdr;
+
+	umemset(buf, 0, NANVIX_FS_BLOCK_SIZE);
+	hdr = (struct journal_header *) buf;
+	hdr->magic = JOURNAL_MAGIC;
+	hdr->seq = seq;
+
+	if (bdev_write(NANVIX_JOURNAL_DEV, buf, NANVIX_FS_BLOCK_SIZE, 0) != NANVIX_FS_BLOCK_SIZE)
+		return (-EIO);
+
+	return (bdev_flush(NANVIX_JOURNAL_DEV));
+}
+
+/*============================================================================*
+ * journal_append()                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Appends a record to the in-memory log.
+ *
+ * @param dev Home device.
+ * @param buf Record data.
+ * @param n   Length of record data.
+ * @param off Offset in the home device.
+ *
+ * @note The journal lock should be held.
+ * @note The caller should ensure that there is enough space in the log.
+ */
+static void journal_append(dev_t dev, const void *buf, size_t n, off_t off)
+{
+	struct journal_record *rec;
+
+	rec = journal_record_get(journal.tail);
+	rec->magic = JOURNAL_MAGIC;
+	rec->seq = journal.seq;
+	rec->off = off;
+	rec->dev = dev;
+	rec->len = n;
+
+	/* Data records are indexed. */
+	if (n > 0)
+	{
+		umemcpy(rec + 1, buf, n);
+		journal.records[journal.nrecords++] = journal.tail;
+		journal.stats.nrecords++;
+	}
+
+	journal.tail += sizeof(struct journal_record) + JOURNAL_ALIGN(n);
+}
+
+/*============================================================================*
+ * do_journal_commit()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Commits pending updates to the log.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ *
+ * @note The journal lock should be held.
+ */
+static int do_journal_commit(void)
+{
+	size_t n;
+
+	/* Nothing to do. */
+	if (journal.tail == journal.committed)
+		return (0);
+
+	/* Close group. */
+	journal_append(journal.dev, NULL, 0, 0);
+
+	/* Write group in a single sequential write. */
+	n = journal.tail - journal.committed;
+	if (bdev_write(NANVIX_JOURNAL_DEV, &journal.log[journal.committed], n, JOURNAL_LOG_OFF + journal.committed) != (ssize_t) n)
+		return (-EIO);
+
+	journal.committed = journal.tail;
+	journal.opstart = journal.tail;
+	journal.opfirst = journal.nrecords;
+	journal.seq++;
+	journal.stats.ncommits++;
+
+	return (bdev_flush(NANVIX_JOURNAL_DEV));
+}
+
+/*============================================================================*
+ * do_journal_writeback()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Writes committed records back to their home locations.
+ *
+ * @param nrecords Number of records to write back.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ *
+ * The log header is then updated, so that written back groups are not
+ * replayed anymore.
+ *
+ * @note The journal lock should be held.
+ */
+static int do_journal_writeback(int nrecords)
+{
+	int err;
+	struct journal_record *rec;
+
+	/* Readers that raced with us should read again. */
+	journal.epoch++;
+
+	/* Write back records in log order. */
+	for (int i = 0; i < nrecords; i++)
+	{
+		rec = journal_record_get(journal.records[i]);
+		if (bdev_write(rec->dev, (char *)(rec + 1), rec->len, rec->off) != rec->len)
+			return (-EIO);
+	}
+
+	if ((err = bdev_flush(journal.dev)) < 0)
+		return (err);
+
+	/* Retire log. */
+	if ((err = journal_header_write(journal.seq)) < 0)
+		return (err);
+
+	journal.stats.ncheckpoints++;
+
+	return (0);
+}
+
+/*============================================================================*
+ * do_journal_checkpoint()                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Applies logged updates to their home locations.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ *
+ * @note The journal lock should be held.
+ */
+static int do_journal_checkpoint(void)
+{
+	int err;
+
+	if ((err = do_journal_commit()) < 0)
+		return (err);
+
+	/* Nothing to do. */
+	if (journal.committed == 0)
+		return (0);
+
+	if ((err = do_journal_writeback(journal.nrecords)) < 0)
+		return (err);
+
+	journal.tail = 0;
+	journal.committed = 0;
+	journal.opstart = 0;
+	journal.opfirst = 0;
+	journal.nrecords = 0;
+
+	return (0);
+}
+
+/*============================================================================*
+ * do_journal_retire()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Makes room in the log in the middle of an operation.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ *
+ * Whole operations that precede the current one are committed and
+ * checkpointed. Records of the current operation are kept in the log,
+ * and they are moved to its beginning, so that they join the next
+ * group.
+ *
+ * @note The journal lock should be held.
+ */
+static int do_journal_retire(void)
+{
+	int err;
+	int nrecords;
+	size_t n;
+	struct journal_record *rec;
+	const size_t opstart = journal.opstart;
+	const size_t skip = sizeof(struct journal_record);
+
+	/* Nothing but the current operation. */
+	if (opstart == 0)
+		return (-ENOSPC);
+
+	/* Move records of current operation past the commit record. */
+	n = journal.tail - opstart;
+	nrecords = journal.nrecords - journal.opfirst;
+	journal_move(opstart + skip, opstart, n);
+	journal.tail = opstart;
+	journal.nrecords = journal.opfirst;
+
+	if ((err = do_journal_commit()) < 0)
+		return (err);
+
+	if ((err = do_journal_writeback(journal.nrecords)) < 0)
+		return (err);
+
+	/* Bring records of current operation back in. */
+	journal_move(0, opstart + skip, n);
+	for (int i = 0; i < nrecords; i++)
+	{
+		journal.records[i] = journal.records[journal.opfirst + i] - (opstart + skip);
+		rec = journal_record_get(journal.records[i]);
+		rec->seq = journal.seq;
+	}
+
+	journal.tail = n;
+	journal.committed = 0;
+	journal.opstart = 0;
+	journal.opfirst = 0;
+	journal.nrecords = nrecords;
+
+	return (0);
+}
+
+/*============================================================================*
+ * journal_replay()                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Replays the log.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ *
+ * Only groups that were completely committed, and that carry
+ * consecutive sequence numbers from the one in the log header, are
+ * replayed. Anything else is a leftover from a previous use of the
+ * log or an interrupted commit.
+ *
+ * @note The journal lock should be held.
+ */
+static int journal_replay(void)
+{
+	size_t pos;
+	size_t group;
+	struct journal_record *rec;
+	char buf[NANVIX_FS_BLOCK_SIZE];
+	struct journal_header *hdr;
+
+	if (bdev_read(NANVIX_JOURNAL_DEV, buf, NANVIX_FS_BLOCK_SIZE, 0) != NANVIX_FS_BLOCK_SIZE)
+		return (-EIO);
+
+	/* No log yet. */
+	hdr = (struct journal_header *) buf;
+	if (hdr->magic != JOURNAL_MAGIC)
+	{
+		journal.seq = 1;
+		return (journal_header_write(journal.seq));
+	}
+
+	journal.seq = hdr->seq;
+
+	if (bdev_read(NANVIX_JOURNAL_DEV, journal.log, JOURNAL_LOG_SIZE, JOURNAL_LOG_OFF) != JOURNAL_LOG_SIZE)
+		return (-EIO);
+
+	/* Collect committed groups. */
+	for (pos = 0, group = 0; pos + sizeof(struct journal_record) <= JOURNAL_LOG_SIZE; /* noop */)
+	{
+		rec = journal_record_get(pos);
+
+		/* End of log. */
+		if ((rec->magic != JOURNAL_MAGIC) || (rec->seq != journal.seq))
+			break;
+
+		/* Corrupted record. */
+		if (pos + sizeof(struct journal_record) + JOURNAL_ALIGN(rec->len) > JOURNAL_LOG_SIZE)
+			break;
+
+		pos += sizeof(struct journal_record) + JOURNAL_ALIGN(rec->len);
+
+		/* Commit record. */
+		if (rec->len == 0)
+		{
+			journal.seq++;
+			group = pos;
+			continue;
+		}
+
+		/* Too many records. */
+		if (journal.nrecords == NANVIX_JOURNAL_NR_RECORDS)
+			break;
+
+		journal.records[journal.nrecords++] = pos - sizeof(struct journal_record) - JOURNAL_ALIGN(rec->len);
+	}
+
+	/* Drop incomplete group. */
+	while ((journal.nrecords > 0) && (journal.records[journal.nrecords - 1] >= group))
+		journal.nrecords--;
+
+	journal.tail = group;
+	journal.committed = group;
+	journal.opstart = group;
+	journal.opfirst = journal.nrecords;
+
+	if (journal.nrecords > 0)
+		uprintf("[nanvix][vfs][journal] replaying %d records", journal.nrecords);
+
+	return (do_journal_checkpoint());
+}
+
+/*============================================================================*
+ * journal_mount()                                                            *
+ *============================================================================*/
+
+/**
+ * The journal_mount() function activates the journal for the device
+ * @p dev. Committed updates that are found in the log are replayed
+ * first, so that the file system is brought back to a consistent
+ * state. A single device may be journaled at a time.
+ */
+int journal_mount(dev_t dev)
+{
+	int err;
+
+	/* Invalid device. */
+	if (dev == NANVIX_JOURNAL_DEV)
+		return (-EINVAL);
+
+	nanvix_semaphore_down(&lock);
+
+		/* Journal is busy. */
+		if (journal.active)
+		{
+			nanvix_semaphore_up(&lock);
+			return (-EBUSY);
+		}
+
+		journal.dev = dev;
+		journal.tail = 0;
+		journal.committed = 0;
+		journal.opstart = 0;
+		journal.opfirst = 0;
+		journal.nrecords = 0;
+
+		if ((err = journal_replay()) == 0)
+			journal.active = 1;
+
+	nanvix_semaphore_up(&lock);
+
+	return (err);
+}
+
+/*============================================================================*
+ * journal_unmount()                                                          *
+ *============================================================================*/
+
+/**
+ * The journal_unmount() function deactivates the journal for the
+ * device @p dev. Pending updates are committed and checkpointed
+ * beforehand.
+ */
+int journal_unmount(dev_t dev)
+{
+	int err;
+
+	nanvix_semaphore_down(&lock);
+
+		/* Device is not journaled. */
+		if (!journal.active || (journal.dev != dev))
+		{
+			nanvix_semaphore_up(&lock);
+			return (-EINVAL);
+		}
+
+		if ((err = do_journal_checkpoint()) == 0)
+			journal.active = 0;
+
+	nanvix_semaphore_up(&lock);
+
+	return (err);
+}
+
+/*============================================================================*
+ * journal_write()                                                            *
+ *============================================================================*/
+
+/**
+ * @brief Logs an update.
+ *
+ * @param dev Home device.
+ * @param buf Update data.
+ * @param n   Length of update data.
+ * @param off Offset in the home device.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ *
+ * @note The journal lock should be held.
+ */
+static int do_journal_write(dev_t dev, const void *buf, size_t n, off_t off)
+{
+	int err;
+	size_t len;
+	struct journal_record *rec;
+
+	len = sizeof(struct journal_record) + JOURNAL_ALIGN(n);
+
+	/* Absorb update. */
+	for (int i = journal.nrecords - 1; i >= 0; i--)
+	{
+		/* Committed records are immutable. */
+		if (journal.records[i] < journal.committed)
+			break;
+
+		rec = journal_record_get(journal.records[i]);
+		if ((rec->off == (uint32_t) off) && (rec->len == n))
+		{
+			umemcpy(rec + 1, buf, n);
+			journal.stats.nabsorbed++;
+			return (0);
+		}
+
+		/* Absorbing past an overlapping record would reorder updates. */
+		if ((off < (off_t) (rec->off + rec->len)) && ((off_t) rec->off < (off_t) (off + n)))
+			break;
+	}
+
+	/* Make room. */
+	if ((journal.nrecords == NANVIX_JOURNAL_NR_RECORDS) ||
+		(journal.tail + len + sizeof(struct journal_record) > JOURNAL_LOG_SIZE))
+	{
+		if ((err = do_journal_retire()) < 0)
+			return (err);
+
+		/* Operation is too large for the log. */
+		if ((journal.nrecords == NANVIX_JOURNAL_NR_RECORDS) ||
+			(journal.tail + len + sizeof(struct journal_record) > JOURNAL_LOG_SIZE))
+			return (-ENOSPC);
+	}
+
+	journal_append(dev, buf, n, off);
+
+	return (0);
+}
+
+/**
+ * The journal_write() function writes @p n bytes from the buffer
+ * pointed to by @p buf to the device @p dev, at offset @p off. If the
+ * device is journaled, the update is appended to the in-memory log
+ * instead, one block at a time, and it reaches the device once it is
+ * committed and checkpointed. An update to the same location as a
+ * record that was not committed yet is absorbed by that record. If the
+ * log fills up, only operations that precede the current one are
+ * committed, and the update fails if the current operation alone does
+ * not fit in the log.
+ */
+ssize_t journal_write(dev_t dev, const void *buf, size_t n, off_t off)
+{
+	int err;
+	size_t count;
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	/* Invalid offset. */
+	if (off < 0)
+		return (-EINVAL);
+
+	/* Nothing to do. */
+	if (n == 0)
+		return (0);
+
+	nanvix_semaphore_down(&lock);
+
+		/* Device is not journaled. */
+		if (!journal.active || (journal.dev != dev))
+			goto bypass;
+
+		/* Log in block-sized records. */
+		for (size_t i = 0; i < n; i += count)
+		{
+			count = ((n - i) < NANVIX_FS_BLOCK_SIZE) ? (n - i) : NANVIX_FS_BLOCK_SIZE;
+
+			if ((err = do_journal_write(dev, (const char *) buf + i, count, off + i)) < 0)
+				goto error;
+		}
+
+	nanvix_semaphore_up(&lock);
+	return (n);
+
+bypass:
+	nanvix_semaphore_up(&lock);
+	return (bdev_write(dev, buf, n, off));
+
+error:
+	nanvix_semaphore_up(&lock);
+	return (err);
+}
+
+/*============================================================================*
+ * journal_read()                                                             *
+ *============================================================================*/
+
+/**
+ * The journal_read() function reads @p n bytes from the device @p dev,
+ * starting at offset @p off, into the buffer pointed to by @p buf. If
+ * the device is journaled, logged updates that were not checkpointed
+ * yet are applied on top of the data read from the device. The journal
+ * lock is not held across the device read, thus the read is retried if
+ * the journal wrote to the device in the meantime.
+ */
+ssize_t journal_read(dev_t dev, void *buf, size_t n, off_t off)
+{
+	ssize_t ret;
+	unsigned epoch;
+	off_t start, end;
+	struct journal_record *rec;
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+again:
+
+	nanvix_semaphore_down(&lock);
+		epoch = journal.epoch;
+	nanvix_semaphore_up(&lock);
+
+	if ((ret = bdev_read(dev, buf, n, off)) < 0)
+		return (ret);
+
+	nanvix_semaphore_down(&lock);
+
+		/* Device is not journaled. */
+		if (!journal.active || (journal.dev != dev))
+			goto out;
+
+		/* Logged updates were written back meanwhile. */
+		if (journal.epoch != epoch)
+		{
+			nanvix_semaphore_up(&lock);
+			goto again;
+		}
+
+		/* Overlay records in log order. */
+		for (int i = 0; i < journal.nrecords; i++)
+		{
+			rec = journal_record_get(journal.records[i]);
+
+			start = ((off_t) rec->off > off) ? (off_t) rec->off : off;
+			end = ((off_t) (rec->off + rec->len) < off + ret) ?
+				(off_t) (rec->off + rec->len) : off + ret;
+
+			if (start < end)
+			{
+				umemcpy(
+					(char *) buf + (start - off),
+					(char *)(rec + 1) + (start - rec->off),
+					end - start
+				);
+			}
+		}
+
+out:
+	nanvix_semaphore_up(&lock);
+	return (ret);
+}
+
+/*============================================================================*
+ * journal_sync()                                                             *
+ *============================================================================*/
+
+/**
+ * The journal_sync() function checkpoints the journal if any logged
+ * update overlaps the range of @p n bytes starting at offset @p off of
+ * the device @p dev. It should be called before writing data that
+ * bypasses the journal, so that stale metadata is not written on top of
+ * it later on. Records of the current operation are not checkpointed,
+ * since that would commit the operation halfway.
+ */
+int journal_sync(dev_t dev, size_t n, off_t off)
+{
+	int err = 0;
+	struct journal_record *rec;
+
+	nanvix_semaphore_down(&lock);
+
+		/* Device is not journaled. */
+		if (!journal.active || (journal.dev != dev))
+			goto out;
+
+		for (int i = 0; i < journal.nrecords; i++)
+		{
+			rec = journal_record_get(journal.records[i]);
+
+			/* Current operation. */
+			if (i >= journal.opfirst)
+				break;
+
+			/* Overlap. */
+			if ((off < (off_t) (rec->off + rec->len)) && ((off_t) rec->off < (off_t) (off + n)))
+			{
+				err = do_journal_retire();
+				break;
+			}
+		}
+
+out:
+	nanvix_semaphore_up(&lock);
+	return (err);
+}
+
+/*============================================================================*
+ * journal_begin()                                                            *
+ *============================================================================*/
+
+/**
+ * The journal_begin() function marks the start of a new operation.
+ * Updates logged from now on are committed along with each other, and
+ * never apart.
+ */
+void journal_begin(void)
+{
+	nanvix_semaphore_down(&lock);
+		journal.opstart = journal.tail;
+		journal.opfirst = journal.nrecords;
+	nanvix_semaphore_up(&lock);
+}
+
+/*============================================================================*
+ * journal_commit()                                                           *
+ *============================================================================*/
+
+/**
+ * The journal_commit() function writes all pending updates to the log
+ * as a single group, with one sequential write. Updates that arrive
+ * while the journal is being committed join the next group.
+ */
+int journal_commit(void)
+{
+	int err = 0;
+
+	nanvix_semaphore_down(&lock);
+
+		if (journal.active)
+			err = do_journal_commit();
+
+	nanvix_semaphore_up(&lock);
+
+	return (err);
+}
+
+/*============================================================================*
+ * journal_checkpoint()                                                       *
+ *============================================================================*/
+
+/**
+ * The journal_checkpoint() function commits pending updates, applies
+ * all logged updates to their home locations, and retires the log.
+ */
+int journal_checkpoint(void)
+{
+	int err = 0;
+
+	nanvix_semaphore_down(&lock);
+
+		if (journal.active)
+			err = do_journal_checkpoint();
+
+	nanvix_semaphore_up(&lock);
+
+	return (err);
+}
+
+/*============================================================================*
+ * journal_stats_get()                                                        *
+ *============================================================================*/
+
+/**
+ * The journal_stats_get() function stores statistics of the journal in
+ * the location pointed to by @p stats.
+ */
+int journal_stats_get(struct journal_stats *stats)
+{
+	/* Invalid storage location. */
+	if (stats == NULL)
+		return (-EINVAL);
+
+	nanvix_semaphore_down(&lock);
+		umemcpy(stats, &journal.stats, sizeof(struct journal_stats));
+	nanvix_semaphore_up(&lock);
+
+	return (0);
+}
+
+/*============================================================================*
+ * journal_init()                                                             *
+ *============================================================================*/
+
+/**
+ * The journal_init() function initializes the journal.
+ */
+void journal_init(void)
+{
+	nanvix_semaphore_init(&lock, 1);
+
+	journal.active = 0;
+	journal.epoch = 0;
+	journal.tail = 0;
+	journal.committed = 0;
+	journal.opstart = 0;
+	journal.opfirst = 0;
+	journal.nrecords = 0;
+	umemset(&journal.stats, 0, sizeof(struct journal_stats));
+}
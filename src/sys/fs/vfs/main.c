@@ -29,12 +29,14 @@
 #include <nanvix/runtime/runtime.h>
 #include <nanvix/sys/semaphore.h>
 #include <nanvix/sys/mailbox.h>
+#include <nanvix/sys/thread.h>
 #include <nanvix/sys/noc.h>
 #include <nanvix/config.h>
 #include <nanvix/dev.h>
 #include <nanvix/fs.h>
 #include <nanvix/types.h>
 #include <nanvix/ulib.h>
+#include <posix/unistd.h>
 
 /* Import definitions. */
 extern void vfs_test(void);
@@ -47,323 +49,1684 @@ static struct
 	int nodenum;  /**< Node number.  */
 	int inbox;    /**< Input mailbox */
 	int inportal; /**< Input Portal  */
+	int index;    /**< Server Index  */
 	const char *name;
 } server = {
-	-1, -1, -1, VFS_SERVER_NAME
+	-1, -1, -1, -1, NULL
 };
 
+#if (NANVIX_VFS_NR_WORKERS < 1)
+#error "the VFS server needs at least one worker thread"
+#endif
+
+/**
+ * @brief Queue of Pending Requests
+ */
+struct queue
+{
+	int head;                                             /**< First Request     */
+	int tail;                                             /**< Next Free Slot    */
+	struct nanvix_semaphore lock;                         /**< Queue Lock        */
+	struct nanvix_semaphore nslots;                       /**< Free Slots        */
+	struct nanvix_semaphore nrequests;                    /**< Pending Requests  */
+	struct vfs_message requests[NANVIX_VFS_QUEUE_LENGTH]; /**< Requests          */
+};
+
+/**
+ * @brief Requests for worker threads.
+ */
+static struct queue queue;
+
+/**
+ * @brief Write backs of recalled leases.
+ */
+static struct queue writebacks;
+
+/**
+ * @brief Worker Threads
+ */
+static struct worker
+{
+	kthread_t tid;                     /**< Thread ID                        */
+	char buffer[NANVIX_FS_BLOCK_SIZE]; /**< Buffer for Read/Write Requests   */
+} workers[NANVIX_VFS_NR_WORKERS];
+
+/**
+ * @brief Lock for the table of connections.
+ */
+static struct nanvix_semaphore connections_lock;
+
+/**
+ * @brief Lock for the input portal.
+ */
+static struct nanvix_semaphore portal_lock;
+
+/**
+ * @brief Lock for the connectors to clients.
+ */
+static struct nanvix_semaphore channel_lock;
+
+/**
+ * @brief Table of Data Leases
+ *
+ * Files opened by clients that run a recall daemon are tracked here,
+ * so that leases on them may be recalled once someone else opens them.
+ */
+static struct lease
+{
+	int node;   /**< Node of the client (-1 if free). */
+	int port;   /**< Port of the client.             */
+	int recall; /**< Port of the recall daemon.      */
+	int fd;     /**< File descriptor.                */
+	int ino;    /**< Inode number of the file.       */
+	int type;   /**< Type of the lease held.         */
+} leases[NANVIX_VFS_LEASES_MAX];
+
+/**
+ * @brief Lock for the table of leases.
+ */
+static struct nanvix_semaphore leases_lock;
+
+/**
+ * @brief Pending Recalls
+ *
+ * Recalls are issued by worker threads, thus there are at most as many
+ * pending recalls as workers. Acknowledges are only taken from the
+ * lease holders that were recalled, and only for the current sequence
+ * number of the slot, so that late ones are not mistaken for others.
+ */
+static struct
+{
+	int used;                     /**< Is this slot used?            */
+	unsigned seq;                 /**< Sequence number of the slot.  */
+	int err;                      /**< Error of write backs.         */
+	int ntargets;                 /**< Number of lease holders.      */
+	struct
+	{
+		int node;                 /**< Node of the lease holder.     */
+		int port;                 /**< Port of the lease holder.     */
+		int fd;                   /**< File descriptor.              */
+		int done;                 /**< Is the lease holder done?     */
+	} targets[NANVIX_VFS_LEASES_MAX];
+	struct nanvix_semaphore done; /**< Lease holders that are done.  */
+} recalls[NANVIX_VFS_NR_WORKERS];
+
+/**
+ * @brief Write-Back Thread
+ *
+ * Data of recalled leases is written back by a thread of its own,
+ * since worker threads may all be waiting for it.
+ */
+static struct
+{
+	kthread_t tid;                     /**< Thread ID               */
+	char buffer[NANVIX_FS_BLOCK_SIZE]; /**< Buffer for Written Data */
+} writeback;
+
+/*============================================================================*
+ * vfs_server_get_index()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Gets the index of this server in the table of VFS servers.
+ */
+static int vfs_server_get_index(void)
+{
+	/* Search for server. */
+	for (int i = 0; i < VFS_SERVERS_NUM; i++)
+	{
+		/* Found. */
+		if (server.nodenum == vfs_servers[i].nodenum)
+			return (i);
+	}
+
+	/* Should not happen. */
+	return (-EINVAL);
+}
+
+/*============================================================================*
+ * do_vfs_server_connect()                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Thread-safe wrapper to connect().
+ *
+ * A connection that is handed out anew gets a clean file system
+ * process.
+ */
+static int do_vfs_server_connect(nanvix_pid_t pid, int port)
+{
+	int ret;
+	int fresh;
+
+	nanvix_semaphore_down(&connections_lock);
+		fresh = (lookup(pid, port) < 0);
+		if (((ret = connect(pid, port)) >= 0) && fresh)
+			fprocess_reset(ret);
+	nanvix_semaphore_up(&connections_lock);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * do_vfs_server_lookup()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Thread-safe wrapper to lookup().
+ */
+static int do_vfs_server_lookup(nanvix_pid_t pid, int port)
+{
+	int ret;
+
+	nanvix_semaphore_down(&connections_lock);
+		ret = lookup(pid, port);
+	nanvix_semaphore_up(&connections_lock);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * do_vfs_server_request()                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Thread-safe wrapper to connection_request().
+ */
+static int do_vfs_server_request(nanvix_pid_t pid, int port)
+{
+	int ret;
+
+	nanvix_semaphore_down(&connections_lock);
+		ret = connection_request(pid, port);
+	nanvix_semaphore_up(&connections_lock);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * do_vfs_server_disconnect()                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Drops the leases of a client.
+ *
+ * @param pid  PID of the client.
+ * @param port Port of the client.
+ *
+ * Pending recalls do not wait for the client any longer.
+ */
+static void do_vfs_server_leases_drop(nanvix_pid_t pid, int port)
+{
+	nanvix_semaphore_down(&leases_lock);
+
+		for (int i = 0; i < NANVIX_VFS_LEASES_MAX; i++)
+		{
+			if ((leases[i].node == pid) && (leases[i].port == port))
+				leases[i].node = -1;
+		}
+
+		for (int tag = 0; tag < NANVIX_VFS_NR_WORKERS; tag++)
+		{
+			/* Free slot. */
+			if (!recalls[tag].used)
+				continue;
+
+			for (int i = 0; i < recalls[tag].ntargets; i++)
+			{
+				/* Other lease holder. */
+				if ((recalls[tag].targets[i].node != pid) || (recalls[tag].targets[i].port != port))
+					continue;
+
+				/* Already done. */
+				if (recalls[tag].targets[i].done)
+					continue;
+
+				recalls[tag].targets[i].done = 1;
+				nanvix_semaphore_up(&recalls[tag].done);
+			}
+		}
+
+	nanvix_semaphore_up(&leases_lock);
+}
+
+/**
+ * @brief Thread-safe wrapper to disconnect().
+ *
+ * Leases of clients that are gone are dropped.
+ */
+static int do_vfs_server_disconnect(nanvix_pid_t pid, int port)
+{
+	int ret;
+	int gone;
+
+	nanvix_semaphore_down(&connections_lock);
+		ret = disconnect(pid, port);
+		gone = (lookup(pid, port) < 0);
+	nanvix_semaphore_up(&connections_lock);
+
+	if ((ret == 0) && gone)
+		do_vfs_server_leases_drop(pid, port);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * do_vfs_server_recv()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Receives the data of a request from a remote client.
+ *
+ * @param request Target request.
+ * @param buffer  Target buffer.
+ * @param n       Number of bytes to receive.
+ */
+static void do_vfs_server_recv(
+	const struct vfs_message *request,
+	char *buffer,
+	size_t n
+)
+{
+	/* Nothing to receive. */
+	if (n == 0)
+		return;
+
+	nanvix_semaphore_down(&portal_lock);
+
+		/* Read data in. */
+		uassert(
+			nanvix_channel_accept(
+				&request->header,
+				server.inportal,
+				buffer,
+				n
+			) == (ssize_t) n
+		);
+
+	nanvix_semaphore_up(&portal_lock);
+}
+
+/*============================================================================*
+ * do_vfs_server_send()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Sends the data of a reply to a remote client.
+ *
+ * @param request Target request.
+ * @param buffer  Source buffer.
+ * @param n       Number of bytes to send.
+ *
+ * The remote client is first acknowledged with the port of the portal
+ * through which data is shipped.
+ */
+static void do_vfs_server_send(
+	const struct vfs_message *request,
+	const char *buffer,
+	size_t n
+)
+{
+	struct vfs_message msg;
+
+	/* Build operation header. */
+	message_header_build(&msg.header, VFS_ACK);
+
+	nanvix_semaphore_down(&channel_lock);
+
+		/* Send acknowledge only. */
+		if (n == 0)
+		{
+			uassert(
+				nanvix_channel_reply(
+					&request->header,
+					&msg,
+					sizeof(struct vfs_message)
+				) == 0
+			);
+		}
+
+		/* Send acknowledge and data. */
+		else
+		{
+			uassert(
+				nanvix_channel_reply_data(
+					&request->header,
+					&msg,
+					sizeof(struct vfs_message),
+					buffer,
+					n
+				) == 0
+			);
+		}
+
+	nanvix_semaphore_up(&channel_lock);
+}
+
+/*============================================================================*
+ * do_vfs_server_reply()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Thread-safe wrapper to nanvix_channel_reply().
+ */
+static void do_vfs_server_reply(
+	const struct vfs_message *request,
+	const struct vfs_message *response
+)
+{
+	nanvix_semaphore_down(&channel_lock);
+
+		uassert(
+			nanvix_channel_reply(
+				&request->header,
+				response,
+				sizeof(struct vfs_message)
+			) == 0
+		);
+
+	nanvix_semaphore_up(&channel_lock);
+}
+
+/*============================================================================*
+ * do_vfs_server_lease_lookup()                                               *
+ *============================================================================*/
+
+/**
+ * @brief Searches for the lease of an opened file.
+ *
+ * @param h  Header of a request of the client.
+ * @param fd Target file descriptor.
+ *
+ * @returns If the opened file is tracked, its lease is returned.
+ * Otherwise, NULL is returned instead.
+ *
+ * @note The table of leases should be locked.
+ */
+static struct lease *do_vfs_server_lease_lookup(const message_header *h, int fd)
+{
+	for (int i = 0; i < NANVIX_VFS_LEASES_MAX; i++)
+	{
+		/* Found. */
+		if ((leases[i].node == h->source) &&
+			(leases[i].port == h->mailbox_port) &&
+			(leases[i].fd == fd))
+			return (&leases[i]);
+	}
+
+	return (NULL);
+}
+
+/*============================================================================*
+ * do_vfs_server_lease()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Piggybacks a data lease on a response.
+ *
+ * @param request    Target request.
+ * @param connection Target connection.
+ * @param fd         Target file descriptor.
+ * @param response   Response.
+ *
+ * The lease, the current data version and the read/write pointer of
+ * the target file are carried back on every reply, so that the client
+ * may validate its local cache without issuing extra requests. Leases
+ * are only granted on files that are tracked in the table of leases,
+ * since others could not be recalled.
+ */
+static void do_vfs_server_lease(
+	const struct vfs_message *request,
+	int connection,
+	int fd,
+	struct vfs_message *response
+)
+{
+	int lease;
+	off_t offset;
+	unsigned version;
+	struct lease *l;
+
+	/* Read/write pointer. */
+	if ((offset = vfs_seek(connection, fd, 0, SEEK_CUR)) >= 0)
+		response->op.ret.offset = offset;
+
+	nanvix_semaphore_down(&leases_lock);
+
+		/* Deny lease on failure. */
+		if ((lease = vfs_lease(connection, fd, &version)) < 0)
+		{
+			lease = VFS_LEASE_NONE;
+			version = 0;
+		}
+
+		/* Cannot be recalled. */
+		if ((l = do_vfs_server_lease_lookup(&request->header, fd)) == NULL)
+			lease = VFS_LEASE_NONE;
+		else
+			l->type = lease;
+
+	nanvix_semaphore_up(&leases_lock);
+
+	response->op.ret.lease = lease;
+	response->op.ret.version = version;
+}
+
+/*============================================================================*
+ * do_vfs_server_recall()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Recalls a lease.
+ *
+ * @param l   Target lease.
+ * @param tag Tag of the recall.
+ *
+ * The recall daemon of the lease holder is asked to drop its cached
+ * data and to write back deferred writes. The lease is revoked right
+ * away, thus it is not recalled twice.
+ *
+ * @note The table of leases should be locked.
+ */
+static void do_vfs_server_recall(struct lease *l, int tag)
+{
+	int i;
+	message_header to;
+	struct vfs_message msg;
+
+	/* Record lease holder. */
+	i = recalls[tag].ntargets++;
+	recalls[tag].targets[i].node = l->node;
+	recalls[tag].targets[i].port = l->port;
+	recalls[tag].targets[i].fd = l->fd;
+	recalls[tag].targets[i].done = 0;
+
+	/* Recall daemon of the lease holder. */
+	message_header_build(&to, VFS_RECALL);
+	to.source = l->node;
+	to.mailbox_port = l->recall;
+
+	/* Build operation header. */
+	message_header_build(&msg.header, VFS_RECALL);
+	msg.op.recall.server = server.index;
+	msg.op.recall.fd = l->fd;
+	msg.op.recall.port = l->port;
+	msg.op.recall.tag = tag;
+	msg.op.recall.seq = recalls[tag].seq;
+	msg.op.recall.offset = 0;
+	msg.op.recall.n = 0;
+
+	nanvix_semaphore_down(&channel_lock);
+
+		uassert(
+			nanvix_channel_reply(
+				&to,
+				&msg,
+				sizeof(struct vfs_message)
+			) == 0
+		);
+
+	nanvix_semaphore_up(&channel_lock);
+
+	l->type = VFS_LEASE_NONE;
+}
+
+/*============================================================================*
+ * do_vfs_server_open_file()                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Opens a file on behalf of a client.
+ *
+ * @param h          Header of the request.
+ * @param connection Target connection.
+ * @param filename   Name of the target file.
+ * @param oflag      Open flags.
+ * @param recall     Port of the recall daemon of the client.
+ *
+ * Leases that conflict with the new opening are recalled, and the
+ * calling thread waits until their holders have written back deferred
+ * data, or until NANVIX_VFS_RECALL_TIMEOUT cycles have elapsed. Opening
+ * a file for writing conflicts with any lease on it, whereas opening it
+ * for reading conflicts with write leases only. If deferred data could
+ * not be written back, the opening fails.
+ *
+ * @returns Upon successful completion, the file descriptor of the
+ * opened file is returned. Upon failure, a negative error code is
+ * returned instead.
+ */
+static int do_vfs_server_open_file(
+	const message_header *h,
+	int connection,
+	const char *filename,
+	int oflag,
+	int recall
+)
+{
+	int fd;
+	int err;
+	int tag = -1;
+	int nrecalls = 0;
+	struct lease *l;
+	struct vfs_stat st;
+	uint64_t now, deadline;
+
+	nanvix_semaphore_down(&leases_lock);
+
+		/* Operation failed. */
+		if ((fd = vfs_open(connection, filename, oflag, 0)) < 0)
+			goto out;
+
+		uassert(vfs_fstat(connection, fd, &st) == 0);
+
+		/* Recall conflicting leases. */
+		for (int i = 0; i < NANVIX_VFS_LEASES_MAX; i++)
+		{
+			/* Skip other files. */
+			if ((leases[i].node < 0) || (leases[i].ino != st.ino))
+				continue;
+
+			/* Nothing to recall. */
+			if (leases[i].type == VFS_LEASE_NONE)
+				continue;
+
+			/* Readers share the file. */
+			if (ACCMODE_RDONLY(oflag) && (leases[i].type == VFS_LEASE_READ))
+				continue;
+
+			/* Allocate recall slot. */
+			if (tag < 0)
+			{
+				for (tag = 0; tag < NANVIX_VFS_NR_WORKERS; tag++)
+				{
+					if (!recalls[tag].used)
+						break;
+				}
+
+				/* At most one pending recall per worker. */
+				if (tag == NANVIX_VFS_NR_WORKERS)
+				{
+					vfs_close(connection, fd);
+					fd = -EAGAIN;
+					tag = -1;
+					goto out;
+				}
+
+				recalls[tag].used = 1;
+				recalls[tag].err = 0;
+				recalls[tag].ntargets = 0;
+			}
+
+			do_vfs_server_recall(&leases[i], tag);
+			nrecalls++;
+		}
+
+		/* Track opened file. */
+		if (recall >= 0)
+		{
+			if ((l = do_vfs_server_lease_lookup(h, fd)) == NULL)
+			{
+				for (int i = 0; i < NANVIX_VFS_LEASES_MAX; i++)
+				{
+					/* Free entry. */
+					if (leases[i].node < 0)
+					{
+						l = &leases[i];
+						break;
+					}
+				}
+			}
+
+			/* Files that are not tracked never get a lease. */
+			if (l != NULL)
+			{
+				l->node = h->source;
+				l->port = h->mailbox_port;
+				l->recall = recall;
+				l->fd = fd;
+				l->ino = st.ino;
+				l->type = VFS_LEASE_NONE;
+			}
+		}
+
+out:
+	nanvix_semaphore_up(&leases_lock);
+
+	/* Wait for lease holders. */
+	if (tag >= 0)
+	{
+		kclock(&now);
+		deadline = now + NANVIX_VFS_RECALL_TIMEOUT;
+		for (int i = 0; i < nrecalls; /* noop */)
+		{
+			if (nanvix_semaphore_trydown(&recalls[tag].done) == 0)
+			{
+				i++;
+				continue;
+			}
+
+			kclock(&now);
+
+			/* Lease holders are dead or too slow. */
+			if (now >= deadline)
+			{
+				uprintf("[nanvix][vfs] recall timed out, %d lease holders missing", nrecalls - i);
+				break;
+			}
+		}
+
+		nanvix_semaphore_down(&leases_lock);
+
+			err = recalls[tag].err;
+
+			/* Late acknowledges are not taken any longer. */
+			recalls[tag].seq++;
+			recalls[tag].used = 0;
+			while (nanvix_semaphore_trydown(&recalls[tag].done) == 0)
+				/* noop */;
+
+		nanvix_semaphore_up(&leases_lock);
+
+		/* Deferred data was lost. */
+		if (err < 0)
+		{
+			vfs_close(connection, fd);
+			fd = err;
+		}
+	}
+
+	return (fd);
+}
+
+/*============================================================================*
+ * do_vfs_server_close_file()                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Stops tracking a file that a client has closed.
+ *
+ * @param h  Header of the request.
+ * @param fd Target file descriptor.
+ */
+static void do_vfs_server_close_file(const message_header *h, int fd)
+{
+	struct lease *l;
+
+	nanvix_semaphore_down(&leases_lock);
+
+		if ((l = do_vfs_server_lease_lookup(h, fd)) != NULL)
+			l->node = -1;
+
+	nanvix_semaphore_up(&leases_lock);
+}
+
+/*============================================================================*
+ * do_vfs_server_open()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Handles an open request.
+ *
+ * @param request  Target request.
+ * @param response Response.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ *
+ * @author Pedro Henrique Penna
+ */
+static int do_vfs_server_open(
+	const struct vfs_message *request,
+	struct vfs_message *response
+)
+{
+	int ret;
+	const int port = request->header.mailbox_port;
+	const nanvix_pid_t pid = request->header.source;
+	const int connection = do_vfs_server_connect(pid, port);
+
+	/* Cannot connect. */
+	if (connection < 0)
+		return (connection);
+
+	/* XXX: forward parameter checking to lower level function. */
+
+	ret = do_vfs_server_open_file(
+		&request->header,
+		connection,
+		request->op.open.filename,
+		request->op.open.oflag,
+		request->op.open.recall
+	);
+
+	/* Operation failed. */
+	if (ret < 0)
+	{
+		do_vfs_server_disconnect(pid, port);
+		return (ret);
+	}
+
+	response->op.ret.fd = ret;
+	do_vfs_server_lease(request, connection, ret, response);
+
+	return (0);
+}
+
+/*============================================================================*
+ * do_vfs_server_close()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Handles a close request.
+ *
+ * @param request Target request.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ *
+ * @author Pedro Henrique Penna
+ */
+static int do_vfs_server_close(const struct vfs_message *request)
+{
+	int ret;
+	const int port = request->header.mailbox_port;
+	const nanvix_pid_t pid = request->header.source;
+	const int connection = do_vfs_server_lookup(pid, port);
+
+	/* XXX: forwarding parameter checking to lower level function. */
+
+	ret = vfs_close(
+		connection,
+		request->op.close.fd
+	);
+
+	/* Operation failed. */
+	if (ret < 0)
+		return (ret);
+
+	do_vfs_server_close_file(&request->header, request->op.close.fd);
+	do_vfs_server_disconnect(pid, port);
+
+	return (0);
+}
+
+/*============================================================================*
+ * do_vfs_server_seek()                                                       *
+ *============================================================================*/
+
 /**
- * @brief Buffer for Read/Write Requests
+ * @brief Handles an seek request.
+ *
+ * @param request  Target request.
+ * @param response Response.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ *
+ * @author Pedro Henrique Penna
  */
-static char buffer[NANVIX_FS_BLOCK_SIZE];
+static int do_vfs_server_seek(
+	const struct vfs_message *request,
+	struct vfs_message *response
+)
+{
+	off_t ret;
+	const int port = request->header.mailbox_port;
+	const nanvix_pid_t pid = request->header.source;
+	const int connection = do_vfs_server_lookup(pid, port);
+
+	/* XXX: forward parameter checking to lower level function. */
+
+	ret = vfs_seek(
+		connection,
+		request->op.seek.fd,
+		request->op.seek.offset,
+		request->op.seek.whence
+	);
+
+	/* Operation failed. */
+	if (ret < 0)
+		return (ret);
+
+	response->op.ret.offset = ret;
+	do_vfs_server_lease(request, connection, request->op.seek.fd, response);
+
+	return (0);
+}
 
 /*============================================================================*
- * do_vfs_server_open()                                                       *
+ * do_vfs_server_copy_range()                                                 *
  *============================================================================*/
 
 /**
- * @brief Handles an open request.
+ * @brief Handles a copy range request.
+ *
+ * @param request  Target request.
+ * @param response Response.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+static int do_vfs_server_copy_range(
+	const struct vfs_message *request,
+	struct vfs_message *response
+)
+{
+	ssize_t ret;
+	const int port = request->header.mailbox_port;
+	const nanvix_pid_t pid = request->header.source;
+	const int connection = do_vfs_server_lookup(pid, port);
+
+	ret = vfs_copy_range(
+		connection,
+		request->op.copy.fd_in,
+		request->op.copy.off_in,
+		request->op.copy.fd_out,
+		request->op.copy.off_out,
+		request->op.copy.n
+	);
+
+	/* Operation failed. */
+	if (ret < 0)
+		return (ret);
+
+	response->op.ret.count = ret;
+	do_vfs_server_lease(request, connection, request->op.copy.fd_out, response);
+
+	return (0);
+}
+
+/*============================================================================*
+ * do_vfs_server_write()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Handles a write request.
+ *
+ * Both VFS_WRITE and VFS_PWRITE requests are handled here.
+ *
+ * @param request  Target request.
+ * @param response Response.
+ * @param buffer   Working buffer.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ *
+ * @author Pedro Henrique Penna
+ */
+static int do_vfs_server_write(
+	const struct vfs_message *request,
+	struct vfs_message *response,
+	char *buffer
+)
+{
+	ssize_t ret;
+	const int port = request->header.mailbox_port;
+	const nanvix_pid_t pid = request->header.source;
+	const int connection = do_vfs_server_lookup(pid, port);
+
+	/* Invalid write size. */
+	if ((request->op.write.n == 0) || (request->op.write.n > NANVIX_FS_BLOCK_SIZE))
+		return (-EINVAL);
+
+	/* XXX: forward parameter checking to lower level function. */
+
+	do_vfs_server_recv(request, buffer, request->op.write.n);
+
+	/* Positional write. */
+	if (request->header.opcode == VFS_PWRITE)
+	{
+		ret = vfs_pwrite(
+			connection,
+			request->op.write.fd,
+			buffer,
+			request->op.write.n,
+			request->op.write.offset
+		);
+	}
+	else
+	{
+		ret = vfs_write(
+			connection,
+			request->op.write.fd,
+			buffer,
+			request->op.write.n
+		);
+	}
+
+	/* Operation failed. */
+	if (ret < 0)
+		return (ret);
+
+	response->op.ret.count = ret;
+	do_vfs_server_lease(request, connection, request->op.write.fd, response);
+
+	return (0);
+}
+
+/*============================================================================*
+ * do_vfs_server_read()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Handles a read request.
+ *
+ * Both VFS_READ and VFS_PREAD requests are handled here.
+ *
+ * @param request  Target request.
+ * @param response Response.
+ * @param buffer   Working buffer.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ *
+ * @author Pedro Henrique Penna
+ */
+static int do_vfs_server_read(
+	const struct vfs_message *request,
+	struct vfs_message *response,
+	char *buffer
+)
+{
+	ssize_t ret;
+	const int port = request->header.mailbox_port;
+	const nanvix_pid_t pid = request->header.source;
+	const int connection = do_vfs_server_lookup(pid, port);
+
+	/* Invalid read size. */
+	if ((request->op.read.n == 0) || (request->op.read.n > NANVIX_FS_BLOCK_SIZE))
+		return (-EINVAL);
+
+	/* XXX: forward parameter checking to lower level function. */
+
+	/* Read data before shipping it. */
+	if (request->header.opcode == VFS_PREAD)
+	{
+		ret = vfs_pread(
+			connection,
+			request->op.read.fd,
+			buffer,
+			request->op.read.n,
+			request->op.read.offset
+		);
+	}
+	else
+	{
+		ret = vfs_read(
+			connection,
+			request->op.read.fd,
+			buffer,
+			request->op.read.n
+		);
+	}
+
+	/* Do not leak data of previous requests. */
+	if (ret < (ssize_t) request->op.read.n)
+	{
+		size_t count = (ret < 0) ? 0 : (size_t) ret;
+
+		umemset(&buffer[count], 0, request->op.read.n - count);
+	}
+
+	do_vfs_server_send(request, buffer, request->op.read.n);
+
+	/* Operation failed. */
+	if (ret < 0)
+		return (ret);
+
+	response->op.ret.count = ret;
+	do_vfs_server_lease(request, connection, request->op.read.fd, response);
+
+	return (0);
+}
+
+/*============================================================================*
+ * do_vfs_server_stat()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Handles a stat request.
+ *
+ * @param request  Target request.
+ * @param response Response.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+static int do_vfs_server_stat(
+	const struct vfs_message *request,
+	struct vfs_message *response
+)
+{
+	int ret;
+	int connection;
+	char filename[NANVIX_NAME_MAX];
+	const int port = request->header.mailbox_port;
+	const nanvix_pid_t pid = request->header.source;
+
+	ustrncpy(filename, request->op.stat.filename, NANVIX_NAME_MAX);
+	filename[NANVIX_NAME_MAX - 1] = '\0';
+
+	/* Stat requests do not need an opened file. */
+	if ((connection = do_vfs_server_connect(pid, port)) < 0)
+		return (connection);
+
+	ret = vfs_stat(connection, filename, &response->op.ret.st);
+
+	do_vfs_server_disconnect(pid, port);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * do_vfs_server_multi()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Handles a compound request.
+ *
+ * @param request  Target request.
+ * @param response Response.
+ * @param buffer   Working buffer.
+ *
+ * Operations are received through the input portal, carried out in
+ * order, and shipped back along with their results. A failed operation
+ * does not prevent others from being carried out. The data handshake
+ * is carried out even if the request is rejected, so that the client
+ * is not left waiting for it.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+static int do_vfs_server_multi(
+	const struct vfs_message *request,
+	struct vfs_message *response,
+	char *buffer
+)
+{
+	int connection;
+	size_t size;
+	struct vfs_multi_op *ops;
+	struct vfs_message reply;
+	const int n = request->op.multi.n;
+	const int port = request->header.mailbox_port;
+	const nanvix_pid_t pid = request->header.source;
+
+	ops = (struct vfs_multi_op *) buffer;
+
+	/* Invalid number of operations. */
+	if ((n <= 0) || (n > VFS_MULTI_MAX))
+	{
+		size = ((n > 0) ? VFS_MULTI_MAX : 0)*sizeof(struct vfs_multi_op);
+		do_vfs_server_recv(request, buffer, size);
+		do_vfs_server_send(request, buffer, size);
+		return (-EINVAL);
+	}
+
+	size = n*sizeof(struct vfs_multi_op);
+	do_vfs_server_recv(request, buffer, size);
+
+	/* Stat requests do not need an opened file. */
+	if ((connection = do_vfs_server_connect(pid, port)) < 0)
+	{
+		for (int i = 0; i < n; i++)
+			ops[i].ret = connection;
+		do_vfs_server_send(request, buffer, size);
+		return (connection);
+	}
+
+	for (int i = 0; i < n; i++)
+	{
+		ops[i].filename[NANVIX_NAME_MAX - 1] = '\0';
+
+		switch (ops[i].opcode)
+		{
+			case VFS_OPEN:
+				ops[i].ret = do_vfs_server_open_file(
+					&request->header,
+					connection,
+					ops[i].filename,
+					ops[i].oflag,
+					request->op.multi.recall
+				);
+
+				/* Each opened file holds the connection. */
+				if (ops[i].ret >= 0)
+				{
+					uassert(do_vfs_server_connect(pid, port) >= 0);
+					do_vfs_server_lease(request, connection, ops[i].ret, &reply);
+					ops[i].lease = reply.op.ret.lease;
+					ops[i].version = reply.op.ret.version;
+				}
+				break;
+
+			case VFS_STAT:
+				ops[i].ret = vfs_stat(connection, ops[i].filename, &ops[i].st);
+				break;
+
+			default:
+				ops[i].ret = -ENOSYS;
+				break;
+		}
+	}
+
+	do_vfs_server_send(request, buffer, size);
+
+	do_vfs_server_disconnect(pid, port);
+
+	response->op.ret.count = n;
+
+	return (0);
+}
+
+/*============================================================================*
+ * do_vfs_server_getdents()                                                   *
+ *============================================================================*/
+
+/**
+ * @brief Handles a get directory entries request.
  *
  * @param request  Target request.
  * @param response Response.
+ * @param buffer   Working buffer.
+ *
+ * The client is acknowledged even if the request is rejected, so that
+ * it is not left waiting for the entries.
  *
  * @returns Upon successful completion, zero is returned. Upon failure,
  * a negative error code is returned instead.
- *
- * @author Pedro Henrique Penna
  */
-static int do_vfs_server_open(
+static int do_vfs_server_getdents(
 	const struct vfs_message *request,
-	struct vfs_message *response
+	struct vfs_message *response,
+	char *buffer
 )
 {
 	int ret;
+	size_t size;
 	const int port = request->header.mailbox_port;
 	const nanvix_pid_t pid = request->header.source;
-	const int connection = connect(pid, port);
+	const int connection = do_vfs_server_lookup(pid, port);
 
-	/* XXX: forward parameter checking to lower level function. */
+	/* Invalid number of entries. */
+	if ((request->op.getdents.n <= 0) || (request->op.getdents.n > (int) VFS_GETDENTS_MAX))
+	{
+		size = ((request->op.getdents.n > 0) ? VFS_GETDENTS_MAX : 0)*sizeof(struct vfs_dirent);
+		umemset(buffer, 0, size);
+		do_vfs_server_send(request, buffer, size);
+		return (-EINVAL);
+	}
+
+	size = request->op.getdents.n*sizeof(struct vfs_dirent);
 
-	ret = vfs_open(
+	ret = vfs_getdents(
 		connection,
-		request->op.open.filename,
-		request->op.open.oflag,
-		0
+		request->op.getdents.fd,
+		(struct vfs_dirent *) buffer,
+		request->op.getdents.n
 	);
 
+	do_vfs_server_send(request, buffer, size);
+
 	/* Operation failed. */
 	if (ret < 0)
-	{
-		disconnect(pid, port);
 		return (ret);
-	}
 
-	response->op.ret.fd = ret;
+	response->op.ret.count = ret;
+	do_vfs_server_lease(request, connection, request->op.getdents.fd, response);
 
 	return (0);
 }
 
 /*============================================================================*
- * do_vfs_server_close()                                                      *
+ * do_vfs_server_handle()                                                     *
  *============================================================================*/
 
 /**
- * @brief Handles a close request.
+ * @brief Handles a file system request.
  *
  * @param request Target request.
+ * @param buffer  Working buffer.
+ */
+static void do_vfs_server_handle(const struct vfs_message *request, char *buffer)
+{
+	int reply = 0;
+	int ret = -ENOSYS;
+	struct vfs_message response;
+
+	/* No lease unless explicitly granted. */
+	response.op.ret.offset = -1;
+	response.op.ret.lease = VFS_LEASE_NONE;
+	response.op.ret.version = 0;
+
+	/* Handle request. */
+	switch (request->header.opcode)
+	{
+		case VFS_CREAT:
+			reply = 1;
+			break;
+
+		case VFS_OPEN:
+			ret = do_vfs_server_open(request, &response);
+			reply = 1;
+			break;
+
+		case VFS_UNLINK:
+			reply = 1;
+			break;
+
+		case VFS_CLOSE:
+			ret = do_vfs_server_close(request);
+			reply = 1;
+			break;
+
+		case VFS_LINK:
+			reply = 1;
+			break;
+
+		case VFS_TRUNCATE:
+			reply = 1;
+			break;
+
+		case VFS_STAT:
+			ret = do_vfs_server_stat(request, &response);
+			reply = 1;
+			break;
+
+		case VFS_READ:
+		case VFS_PREAD:
+			ret = do_vfs_server_read(request, &response, buffer);
+			reply = 1;
+			break;
+
+		case VFS_WRITE:
+		case VFS_PWRITE:
+			ret = do_vfs_server_write(request, &response, buffer);
+			reply = 1;
+			break;
+
+		case VFS_SEEK:
+			reply = 1;
+			ret = do_vfs_server_seek(request, &response);
+			break;
+
+		case VFS_COPY_RANGE:
+			ret = do_vfs_server_copy_range(request, &response);
+			reply = 1;
+			break;
+
+		case VFS_MULTI:
+			ret = do_vfs_server_multi(request, &response, buffer);
+			reply = 1;
+			break;
+
+		case VFS_GETDENTS:
+			ret = do_vfs_server_getdents(request, &response, buffer);
+			reply = 1;
+			break;
+
+		default:
+			break;
+	}
+
+	/* No reply? */
+	if (!reply)
+		return;
+
+	response.op.ret.status = ret;
+	message_header_build(
+		&response.header,
+		(ret < 0) ? VFS_FAIL : VFS_SUCCESS
+	);
+
+	do_vfs_server_reply(request, &response);
+}
+
+/*============================================================================*
+ * do_vfs_server_enqueue()                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Places a request in a queue of pending requests.
  *
- * @returns Upon successful completion, zero is returned. Upon failure,
- * a negative error code is returned instead.
+ * @param q       Target queue.
+ * @param request Target request.
  *
- * @author Pedro Henrique Penna
+ * The calling thread blocks while the queue is full.
  */
-static int do_vfs_server_close(const struct vfs_message *request)
+static void do_vfs_server_enqueue(struct queue *q, const struct vfs_message *request)
 {
-	int ret;
-	const int port = request->header.mailbox_port;
-	const nanvix_pid_t pid = request->header.source;
-	const int connection = lookup(pid, port);
+	nanvix_semaphore_down(&q->nslots);
+	nanvix_semaphore_down(&q->lock);
 
-	/* XXX: forwarding parameter checking to lower level function. */
+		umemcpy(&q->requests[q->tail], request, sizeof(struct vfs_message));
+		q->tail = (q->tail + 1)%NANVIX_VFS_QUEUE_LENGTH;
 
-	ret = vfs_close(
-		connection,
-		request->op.close.fd
-	);
+	nanvix_semaphore_up(&q->lock);
+	nanvix_semaphore_up(&q->nrequests);
+}
 
-	/* Operation failed. */
-	if (ret < 0)
-		return (ret);
+/*============================================================================*
+ * do_vfs_server_dequeue()                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Takes a request from a queue of pending requests.
+ *
+ * @param q       Target queue.
+ * @param request Store location for the request.
+ *
+ * The calling thread blocks while the queue is empty.
+ */
+static void do_vfs_server_dequeue(struct queue *q, struct vfs_message *request)
+{
+	nanvix_semaphore_down(&q->nrequests);
+	nanvix_semaphore_down(&q->lock);
 
-	disconnect(pid, port);
+		umemcpy(request, &q->requests[q->head], sizeof(struct vfs_message));
+		q->head = (q->head + 1)%NANVIX_VFS_QUEUE_LENGTH;
 
-	return (0);
+	nanvix_semaphore_up(&q->lock);
+	nanvix_semaphore_up(&q->nslots);
 }
 
 /*============================================================================*
- * do_vfs_server_seek()                                                       *
+ * do_vfs_server_idle()                                                       *
  *============================================================================*/
 
 /**
- * @brief Handles an seek request.
+ * @brief Asserts whether the queue of pending requests is empty.
  *
- * @param request  Target request.
- * @param response Response.
+ * @returns Non-zero if there are no pending requests, and zero
+ * otherwise.
+ */
+static int do_vfs_server_idle(void)
+{
+	int idle;
+
+	nanvix_semaphore_down(&queue.lock);
+		idle = (queue.head == queue.tail);
+	nanvix_semaphore_up(&queue.lock);
+
+	return (idle);
+}
+
+/*============================================================================*
+ * do_vfs_server_worker()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Worker thread.
  *
- * @returns Upon successful completion, zero is returned. Upon failure,
- * a negative error code is returned instead.
+ * @param args Target worker.
  *
- * @author Pedro Henrique Penna
+ * @returns Always returns NULL.
  */
-static int do_vfs_server_seek(
-	const struct vfs_message *request,
-	struct vfs_message *response
-)
+static void *do_vfs_server_worker(void *args)
 {
-	off_t ret;
-	const int port = request->header.mailbox_port;
-	const nanvix_pid_t pid = request->header.source;
-	const int connection = lookup(pid, port);
+	int err;
+	struct worker *worker = args;
+	struct vfs_message request;
 
-	/* XXX: forward parameter checking to lower level function. */
+	uassert(__stdsync_setup() == 0);
+	uassert(__stdmailbox_setup() == 0);
+	uassert(__stdportal_setup() == 0);
 
-	ret = vfs_seek(
-		connection,
-		request->op.seek.fd,
-		request->op.seek.offset,
-		request->op.seek.whence
-	);
+	while (1)
+	{
+		do_vfs_server_dequeue(&queue, &request);
 
-	/* Operation failed. */
-	if (ret < 0)
-		return (ret);
+		/* Shutdown. */
+		if (request.header.opcode == VFS_EXIT)
+			break;
 
-	response->op.ret.offset = ret;
+		do_vfs_server_request(request.header.source, request.header.mailbox_port);
+		do_vfs_server_handle(&request, worker->buffer);
 
-	return (0);
+		/*
+		 * Group commit: metadata updates of all requests that
+		 * were served back to back reach the log at once.
+		 */
+		if (do_vfs_server_idle() && ((err = vfs_commit()) < 0))
+			uprintf("[nanvix][vfs] failed to commit journal (err=%d)", err);
+	}
+
+	uassert(__stdportal_cleanup() == 0);
+	uassert(__stdmailbox_cleanup() == 0);
+	uassert(__stdsync_cleanup() == 0);
+
+	return (NULL);
 }
 
 /*============================================================================*
- * do_vfs_server_write()                                                      *
+ * do_vfs_server_writeback()                                                  *
  *============================================================================*/
 
 /**
- * @brief Handles an write request.
+ * @brief Searches for the recalled lease holder that sent a write back.
  *
- * @param request  Target request.
- * @param response Response.
+ * @param request Target request.
  *
- * @returns Upon successful completion, zero is returned. Upon failure,
- * a negative error code is returned instead.
+ * @returns If the sender of @p request was recalled for the current
+ * sequence number of the recall slot, the index of the lease holder is
+ * returned. Otherwise, a negative error code is returned instead.
  *
- * @author Pedro Henrique Penna
+ * @note The table of leases should be locked.
  */
-static int do_vfs_server_write(
-	const struct vfs_message *request,
-	struct vfs_message *response
-)
+static int do_vfs_server_writeback_target(const struct vfs_message *request)
 {
-	ssize_t ret;
-	const int port = request->header.mailbox_port;
-	const nanvix_pid_t pid = request->header.source;
-	const int connection = lookup(pid, port);
+	const int tag = request->op.recall.tag;
 
-	/* Invalid write size. */
-	if ((request->op.write.n == 0) || (request->op.write.n > NANVIX_FS_BLOCK_SIZE))
+	/* Invalid tag. */
+	if (!WITHIN(tag, 0, NANVIX_VFS_NR_WORKERS))
 		return (-EINVAL);
 
-	/* XXX: forward parameter checking to lower level function. */
+	/* Stale recall. */
+	if (!recalls[tag].used || (recalls[tag].seq != request->op.recall.seq))
+		return (-EINVAL);
 
-	/* Allow remote write. */
-	uassert(
-		kportal_allow(
-			server.inportal,
-			request->header.source,
-			request->header.portal_port
-		) == 0
-	);
+	for (int i = 0; i < recalls[tag].ntargets; i++)
+	{
+		/* Found. */
+		if ((recalls[tag].targets[i].node == request->header.source) &&
+			(recalls[tag].targets[i].port == request->op.recall.port) &&
+			(recalls[tag].targets[i].fd == request->op.recall.fd) &&
+			!recalls[tag].targets[i].done)
+			return (i);
+	}
 
-	/* Read data in. */
-	uassert(
-		kportal_read(
-			server.inportal,
-			buffer,
-			request->op.write.n
-		) == (ssize_t) request->op.write.n
-	);
+	return (-ENOENT);
+}
+
+/**
+ * @brief Handles a write back of a recalled lease.
+ *
+ * @param request Target request.
+ *
+ * Lease holders write back deferred data one page at a time, on behalf
+ * of the connection through which they opened the file, and they then
+ * send a last request with no data. Data is always taken in, so that
+ * the sender is not left waiting, but it is only written if the sender
+ * holds a connection. Write back errors are handed to the opener that
+ * issued the recall.
+ */
+static void do_vfs_server_writeback_handle(const struct vfs_message *request)
+{
+	int i;
+	ssize_t ret;
+	int connection;
+	const int tag = request->op.recall.tag;
+	const size_t n = request->op.recall.n;
+
+	/* Lease holder is done. */
+	if (n == 0)
+	{
+		nanvix_semaphore_down(&leases_lock);
+
+			if ((i = do_vfs_server_writeback_target(request)) >= 0)
+			{
+				recalls[tag].targets[i].done = 1;
+				nanvix_semaphore_up(&recalls[tag].done);
+			}
+
+		nanvix_semaphore_up(&leases_lock);
+
+		return;
+	}
+
+	/* Invalid write size. */
+	if (n > NANVIX_FS_BLOCK_SIZE)
+		return;
+
+	do_vfs_server_recv(request, writeback.buffer, n);
+
+	/* Unknown client. */
+	if ((connection = do_vfs_server_lookup(request->header.source, request->op.recall.port)) < 0)
+		return;
 
-	ret = vfs_write(
+	ret = vfs_pwrite(
 		connection,
-		request->op.write.fd,
-		buffer,
-		request->op.write.n
+		request->op.recall.fd,
+		writeback.buffer,
+		n,
+		request->op.recall.offset
 	);
 
-	/* Operation failed. */
-	if (ret < 0)
-		return (ret);
+	/* Deferred data is lost. */
+	if (ret != (ssize_t) n)
+	{
+		nanvix_semaphore_down(&leases_lock);
 
-	response->op.ret.count = ret;
+			if (do_vfs_server_writeback_target(request) >= 0)
+				recalls[tag].err = (ret < 0) ? ret : -EIO;
 
-	return (0);
+		nanvix_semaphore_up(&leases_lock);
+	}
+}
+
+/**
+ * @brief Write-back thread.
+ *
+ * @param args Unused.
+ *
+ * @returns Always returns NULL.
+ */
+static void *do_vfs_server_writeback(void *args)
+{
+	struct vfs_message request;
+
+	((void) args);
+
+	uassert(__stdsync_setup() == 0);
+	uassert(__stdmailbox_setup() == 0);
+	uassert(__stdportal_setup() == 0);
+
+	while (1)
+	{
+		do_vfs_server_dequeue(&writebacks, &request);
+
+		/* Shutdown. */
+		if (request.header.opcode == VFS_EXIT)
+			break;
+
+		do_vfs_server_writeback_handle(&request);
+	}
+
+	uassert(__stdportal_cleanup() == 0);
+	uassert(__stdmailbox_cleanup() == 0);
+	uassert(__stdsync_cleanup() == 0);
+
+	return (NULL);
 }
 
 /*============================================================================*
- * do_vfs_server_read()                                                       *
+ * do_vfs_server_workers_start()                                              *
  *============================================================================*/
 
 /**
- * @brief Handles an read request.
+ * @brief Initializes a queue of pending requests.
  *
- * @param request  Target request.
- * @param response Response.
- *
- * @returns Upon successful completion, zero is returned. Upon failure,
- * a negative error code is returned instead.
- *
- * @author Pedro Henrique Penna
+ * @param q Target queue.
  */
-static int do_vfs_server_read(
-	const struct vfs_message *request,
-	struct vfs_message *response
-)
+static void do_vfs_server_queue_init(struct queue *q)
 {
-	ssize_t ret;
-	int outportal;
-	int outbox;
-	struct vfs_message msg;
-	const int port = request->header.mailbox_port;
-	const nanvix_pid_t pid = request->header.source;
-	const int connection = lookup(pid, port);
-
-	/* Invalid read size. */
-	if ((request->op.read.n == 0) || (request->op.read.n > NANVIX_FS_BLOCK_SIZE))
-		return (-EINVAL);
+	q->head = 0;
+	q->tail = 0;
+	nanvix_semaphore_init(&q->lock, 1);
+	nanvix_semaphore_init(&q->nslots, NANVIX_VFS_QUEUE_LENGTH);
+	nanvix_semaphore_init(&q->nrequests, 0);
+}
 
-	/* XXX: forward parameter checking to lower level function. */
+/**
+ * @brief Spawns worker threads.
+ */
+static void do_vfs_server_workers_start(void)
+{
+	do_vfs_server_queue_init(&queue);
+	do_vfs_server_queue_init(&writebacks);
+	nanvix_semaphore_init(&connections_lock, 1);
+	nanvix_semaphore_init(&portal_lock, 1);
+	nanvix_semaphore_init(&channel_lock, 1);
+	nanvix_semaphore_init(&leases_lock, 1);
 
-	uassert((
-		outbox = kmailbox_open(
-			request->header.source,
-			request->header.mailbox_port
-		)) >= 0
-	);
+	for (int i = 0; i < NANVIX_VFS_LEASES_MAX; i++)
+		leases[i].node = -1;
 
-	/* Open portal to remote. */
-	uassert((outportal =
-		kportal_open(
-			knode_get_num(),
-			request->header.source,
-			request->header.portal_port)
-		) >= 0
-	);
+	for (int i = 0; i < NANVIX_VFS_NR_WORKERS; i++)
+	{
+		recalls[i].used = 0;
+		recalls[i].seq = 0;
+		recalls[i].ntargets = 0;
+		nanvix_semaphore_init(&recalls[i].done, 0);
+	}
 
-	/* Build operation header. */
-	message_header_build2(
-		&msg.header,
-		VFS_ACK,
-		kcomm_get_port(outportal, COMM_TYPE_PORTAL)
-	);
+	for (int i = 0; i < NANVIX_VFS_NR_WORKERS; i++)
+		uassert(kthread_create(&workers[i].tid, do_vfs_server_worker, &workers[i]) == 0);
 
-	/* Send acknowledge. */
-	uassert(
-		kmailbox_write(outbox,
-			&msg,
-			sizeof(struct vfs_message)
-		) == sizeof(struct vfs_message)
-	);
+	uassert(kthread_create(&writeback.tid, do_vfs_server_writeback, NULL) == 0);
+}
 
-	/* Write to remote. */
-	uassert(
-		kportal_write(
-			outportal,
-			buffer,
-			request->op.read.n
-		) == (ssize_t) request->op.read.n
-	);
+/*============================================================================*
+ * do_vfs_server_workers_stop()                                               *
+ *============================================================================*/
 
-	/* House keeping. */
-	uassert(kportal_close(outportal) == 0);
-	uassert(kmailbox_close(outbox) == 0);
+/**
+ * @brief Waits for worker threads to finish.
+ *
+ * Workers finish pending requests before they exit.
+ */
+static void do_vfs_server_workers_stop(void)
+{
+	struct vfs_message request;
 
-	ret = vfs_read(
-		connection,
-		request->op.read.fd,
-		buffer,
-		request->op.read.n
-	);
+	message_header_build(&request.header, VFS_EXIT);
 
-	/* Operation failed. */
-	if (ret < 0)
-		return (ret);
+	for (int i = 0; i < NANVIX_VFS_NR_WORKERS; i++)
+		do_vfs_server_enqueue(&queue, &request);
 
-	response->op.ret.count = ret;
+	for (int i = 0; i < NANVIX_VFS_NR_WORKERS; i++)
+		uassert(kthread_join(workers[i].tid, NULL) == 0);
 
-	return (0);
+	do_vfs_server_enqueue(&writebacks, &request);
+	uassert(kthread_join(writeback.tid, NULL) == 0);
 }
 
 /*============================================================================*
- * vfs_loop()                                                                 *
+ * do_vfs_server_loop()                                                       *
  *============================================================================*/
 
 /**
- * @brief Handles file system region requests.
+ * @brief Dispatches file system requests to worker threads.
  *
  * @returns Upon successful completion zero is returned. Upon failure,
  * a negative error code is returned instead.
  */
 static int do_vfs_server_loop(void)
 {
-	int shutdown = 0;
+	struct vfs_message request;
 
-	while (!shutdown)
+	while (1)
 	{
-		int outbox;
-		int reply = 0;
-		int ret = -ENOSYS;
-		struct vfs_message request;
-		struct vfs_message response;
-
 		uassert(
 			kmailbox_read(
 				server.inbox,
@@ -380,87 +1743,26 @@ static int do_vfs_server_loop(void)
 
 		/* TODO check for bad node number. */
 
-		/* Handle request. */
-		switch (request.header.opcode)
-		{
-			case VFS_EXIT:
-				shutdown = 1;
-				break;
-
-			case VFS_CREAT:
-				reply = 1;
-				break;
-
-			case VFS_OPEN:
-				ret = do_vfs_server_open(&request, &response);
-				reply = 1;
-				break;
-
-			case VFS_UNLINK:
-				reply = 1;
-				break;
-
-			case VFS_CLOSE:
-				ret = do_vfs_server_close(&request);
-				reply = 1;
-				break;
-
-			case VFS_LINK:
-				reply = 1;
-				break;
-
-			case VFS_TRUNCATE:
-				reply = 1;
-				break;
-
-			case VFS_STAT:
-				reply = 1;
-				break;
-
-			case VFS_READ:
-				ret = do_vfs_server_read(&request, &response);
-				reply = 1;
-				break;
-
-			case VFS_WRITE:
-				ret = do_vfs_server_write(&request, &response);
-				reply = 1;
-				break;
-
-			case VFS_SEEK:
-				reply = 1;
-				ret = do_vfs_server_seek(&request, &response);
-				break;
+		/* Shutdown. */
+		if (request.header.opcode == VFS_EXIT)
+			break;
 
-			default:
-				break;
+		/* Workers may be waiting for write backs. */
+		if (request.header.opcode == VFS_RECALL_ACK)
+		{
+			do_vfs_server_enqueue(&writebacks, &request);
+			continue;
 		}
 
-		/* No reply? */
-		if (!reply)
-			continue;
+		do_vfs_server_enqueue(&queue, &request);
+	}
 
-		response.op.ret.status = ret;
-		message_header_build(
-			&response.header,
-			(ret < 0) ? VFS_FAIL : VFS_SUCCESS
-		);
+	do_vfs_server_workers_stop();
 
-		uassert((
-			outbox = kmailbox_open(
-				request.header.source,
-				request.header.mailbox_port
-			)) >= 0
-		);
-		uassert(
-			kmailbox_write(
-				outbox,
-				&response,
-				sizeof(struct vfs_message
-			)) == sizeof(struct vfs_message)
-		);
-		uassert(kmailbox_close(outbox) == 0);
-	}
+	uprintf("[nanvix][vfs] %d requests served on %d connections",
+		(int) connections_nrequests(),
+		connections_count()
+	);
 
 #ifndef __SUPPRESS_TESTS
 	vfs_test();
@@ -489,19 +1791,28 @@ static int do_vfs_server_startup(struct nanvix_semaphore *lock)
 	server.inbox = stdinbox_get();
 	server.inportal = stdinportal_get();
 
+	/* Not a VFS node. */
+	if ((server.index = vfs_server_get_index()) < 0)
+		return (-EINVAL);
+
+	server.name = vfs_servers[server.index].name;
+
 	/* Link name. */
 	if ((ret = nanvix_name_link(server.nodenum, server.name)) < 0)
 		return (ret);
 
 	connections_setup();
 	vfs_init();
+	do_vfs_server_workers_start();
 
 	uprintf("[nanvix][vfs] minix file system created");
 
 	uprintf("[nanvix][vfs] server alive");
 	uprintf("[nanvix][vfs] attached to node %d", server.nodenum);
+	uprintf("[nanvix][vfs] serving %s", server.name);
 	uprintf("[nanvix][vfs] listening to mailbox %d", server.inbox);
 	uprintf("[nanvix][vfs] listening to portal %d", server.inportal);
+	uprintf("[nanvix][vfs] %d worker threads", NANVIX_VFS_NR_WORKERS);
 
 	nanvix_semaphore_up(lock);
 
@@ -522,6 +1833,7 @@ static int do_vfs_server_shutdown(void)
 {
 	uprintf("[nanvix][vfs] shutting down server");
 	vfs_shutdown();
+	nanvix_channel_flush();
 
 	return (0);
 }
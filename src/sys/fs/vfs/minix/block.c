@@ -37,20 +37,32 @@
 #define MINIX_BLOCK_ADDRS_PER_BLOCK (MINIX_BLOCK_SIZE/sizeof(minix_block_t))
 
 /*============================================================================*
- * minix_block_alloc()                                                        *
+ * minix_block_alloc_near()                                                   *
  *============================================================================*/
 
 /**
- * The minix_block_alloc() function allocates a file system block in the MINIX
- * file system pointed to by @p sb. Disk block is allocated from the
- * zone map pointed to by @p zmap.
+ * @brief Allocates a file system block close to a goal block.
+ *
+ * @param sb   Target superblock.
+ * @param zmap Target zone map.
+ * @param goal Goal block.
+ * @param pa   Target preallocation window (may be NULL).
+ *
+ * @returns Upon successful completion, the number of the allocated
+ * block is returned. Upon failure, MINIX_BLOCK_NULL is returned
+ * instead.
  */
-minix_block_t minix_block_alloc(
+static minix_block_t minix_block_alloc_near(
 	const struct d_superblock *sb,
-	bitmap_t *zmap
+	bitmap_t *zmap,
+	minix_block_t goal,
+	struct minix_prealloc *pa
 )
 {
 	bitmap_t bit;
+	bitmap_t start;
+	bitmap_t nbits;
+	bitmap_t *rmap;
 
 	/* Invalid superblock. */
 	if (sb == NULL)
@@ -64,51 +76,317 @@ minix_block_t minix_block_alloc(
 	if (zmap == NULL)
 		return (MINIX_BLOCK_NULL);
 
-	/* Allocate block. */
-	bit = bitmap_first_free(zmap, sb->s_bmap_nblocks*MINIX_BLOCK_SIZE);
-	if (bit == BITMAP_FULL)
+	rmap = (pa != NULL) ? pa->rmap : NULL;
+
+	/* Take next block from preallocation window. */
+	if ((pa != NULL) && (pa->count > 0))
 	{
-		uprintf("[nanvix][vfs] minix block overflow");
-		return (MINIX_BLOCK_NULL);
+		if ((goal == MINIX_BLOCK_NULL) || (goal == pa->next))
+		{
+			bit = pa->next - sb->s_first_data_block;
+
+			/*
+			 * Reservations are not seen by allocations that are
+			 * not made on behalf of a file, thus the block may be
+			 * gone already.
+			 */
+			if (!bitmap_check_bit(zmap, bit))
+			{
+				bitmap_set(zmap, bit);
+				if (rmap != NULL)
+					bitmap_clear(rmap, bit);
+				pa->count--;
+				return (pa->next++);
+			}
+
+			minix_block_prealloc_release(sb, zmap, pa);
+		}
+	}
+
+	nbits = sb->s_bmap_nblocks*MINIX_BLOCK_BIT_LENGTH;
+
+	/* Search from goal block onwards. */
+	start = 0;
+	if ((goal != MINIX_BLOCK_NULL) && (goal >= sb->s_first_data_block))
+		start = goal - sb->s_first_data_block;
+
+	/* Allocate block, skipping blocks reserved for other files. */
+	for (bitmap_t nskipped = 0; /* noop */; nskipped++)
+	{
+		bit = bitmap_next_free(zmap, sb->s_bmap_nblocks*MINIX_BLOCK_SIZE, start);
+		if (bit == BITMAP_FULL)
+		{
+			uprintf("[nanvix][vfs] minix block overflow");
+			return (MINIX_BLOCK_NULL);
+		}
+
+		/* Only reserved blocks are left. */
+		if ((rmap == NULL) || !bitmap_check_bit(rmap, bit) || (nskipped == nbits))
+			break;
+
+		start = ((bit + 1) < nbits) ? (bit + 1) : 0;
 	}
 
 	bitmap_set(zmap, bit);
 
+	/* Open a new preallocation window. */
+	if (pa != NULL)
+	{
+		minix_block_prealloc_release(sb, zmap, pa);
+
+		/* Block was reserved for another file. */
+		if (rmap != NULL)
+			bitmap_clear(rmap, bit);
+
+		pa->next = sb->s_first_data_block + bit + 1;
+		for (unsigned i = bit + 1; i < nbits; i++)
+		{
+			/* Run is over. */
+			if (pa->count >= NANVIX_MINIX_PREALLOC_LENGTH)
+				break;
+			if (bitmap_check_bit(zmap, i))
+				break;
+			if ((rmap != NULL) && bitmap_check_bit(rmap, i))
+				break;
+
+			/* Reservations are not persisted. */
+			if (rmap != NULL)
+				bitmap_set(rmap, i);
+			pa->count++;
+		}
+	}
+
 	return (sb->s_first_data_block + bit);
 }
 
 /*============================================================================*
- * minix_block_map()                                                          *
+ * minix_block_alloc()                                                        *
  *============================================================================*/
 
 /**
- * @brief The minix_block_map_alloc() function maps the byte offset @p
- * off in the file pointed to by @p ip. The file system block is mapped in the
- * MINIX file system pointed to by @p sb and allocated in the zone map
- * pointed to by @p zmap if required.
+ * The minix_block_alloc() function allocates a file system block in the MINIX
+ * file system pointed to by @p sb. Disk block is allocated from the
+ * zone map pointed to by @p zmap.
  */
-minix_block_t minix_block_map(
+minix_block_t minix_block_alloc(
+	const struct d_superblock *sb,
+	bitmap_t *zmap
+)
+{
+	return (minix_block_alloc_near(sb, zmap, MINIX_BLOCK_NULL, NULL));
+}
+
+/*============================================================================*
+ * minix_block_prealloc_release()                                             *
+ *============================================================================*/
+
+/**
+ * The minix_block_prealloc_release() function releases the blocks that
+ * are still reserved in the preallocation window pointed to by @p pa,
+ * for the zone map pointed to by @p zmap of the MINIX file system
+ * pointed to by @p sb. Reserved blocks are free in the zone map, thus
+ * only the reservation map of the window is touched.
+ */
+int minix_block_prealloc_release(
+	const struct d_superblock *sb,
+	bitmap_t *zmap,
+	struct minix_prealloc *pa
+)
+{
+	/* Invalid superblock. */
+	if (sb == NULL)
+		return (-EINVAL);
+
+	/* Bad superblock. */
+	if (sb->s_magic != MINIX_SUPER_MAGIC)
+		return (-EINVAL);
+
+	/* Invalid zone map. */
+	if (zmap == NULL)
+		return (-EINVAL);
+
+	/* Invalid preallocation window. */
+	if (pa == NULL)
+		return (-EINVAL);
+
+	/* Release reserved blocks. */
+	for (/* noop */; pa->count > 0; pa->count--, pa->next++)
+	{
+		if (pa->rmap != NULL)
+			bitmap_clear(pa->rmap, pa->next - sb->s_first_data_block);
+	}
+
+	pa->next = MINIX_BLOCK_NULL;
+
+	return (0);
+}
+
+/*============================================================================*
+ * minix_block_map_zone()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Maps an indirect zone.
+ *
+ * @param sb     Target superblock.
+ * @param zmap   Target zone map.
+ * @param zone   Target zone.
+ * @param goal   Goal block for allocation.
+ * @param pa     Target preallocation window (may be NULL).
+ * @param create Create zone?
+ *
+ * @returns The number of the block that holds the target indirect
+ * zone is returned. If the zone is not allocated and @p create is
+ * true, a zero-filled block is allocated for it. Upon failure, or if
+ * the zone is not allocated and @p create is false, MINIX_BLOCK_NULL
+ * is returned instead.
+ */
+static minix_block_t minix_block_map_zone(
 	struct d_superblock *sb,
 	bitmap_t *zmap,
-	struct d_inode *ip,
-	off_t off,
+	minix_block_t zone,
+	minix_block_t goal,
+	struct minix_prealloc *pa,
 	int create
 )
 {
+	minix_block_t buf[MINIX_BLOCK_ADDRS_PER_BLOCK]; /* Working buffer. */
+
+	/* Nothing to do. */
+	if ((zone != MINIX_BLOCK_NULL) || (!create))
+		return (zone);
+
+	/* Allocate zone. */
+	if ((zone = minix_block_alloc_near(sb, zmap, goal, pa)) == MINIX_BLOCK_NULL)
+		return (MINIX_BLOCK_NULL);
+
+	/* Unused entries should be null. */
+	umemset(buf, 0, MINIX_BLOCK_SIZE);
+	journal_write(0, buf, MINIX_BLOCK_SIZE, zone*MINIX_BLOCK_SIZE);
+
+	return (zone);
+}
+
+/*============================================================================*
+ * minix_block_map_indirect()                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Maps an entry of an indirect zone.
+ *
+ * @param sb     Target superblock.
+ * @param zmap   Target zone map.
+ * @param zone   Block that holds the target indirect zone.
+ * @param idx    Index of the target entry.
+ * @param pa     Target preallocation window (may be NULL).
+ * @param create Create entry?
+ * @param len    Store location for the length of the mapped run.
+ *
+ * @returns Upon successful completion, the block number that is
+ * mapped by the entry @p idx of the indirect zone is returned. Upon
+ * failure, MINIX_BLOCK_NULL is returned instead.
+ */
+static minix_block_t minix_block_map_indirect(
+	struct d_superblock *sb,
+	bitmap_t *zmap,
+	minix_block_t zone,
+	minix_block_t idx,
+	struct minix_prealloc *pa,
+	int create,
+	minix_block_t *len
+)
+{
+	off_t off;                                      /* Zone offset.    */
+	minix_block_t goal;                             /* Goal block.     */
 	minix_block_t phys;                             /* Phys. blk. #.   */
-	minix_block_t logic;                            /* Logic. blk. #.  */
 	minix_block_t buf[MINIX_BLOCK_ADDRS_PER_BLOCK]; /* Working buffer. */
 
-	logic = off/MINIX_BLOCK_SIZE;
+	/* Hole. */
+	if (zone == MINIX_BLOCK_NULL)
+		return (MINIX_BLOCK_NULL);
+
+	off = zone*MINIX_BLOCK_SIZE;
+	journal_read(0, buf, MINIX_BLOCK_SIZE, off);
+
+	/* Create direct block, right after the previous one. */
+	if (buf[idx] == MINIX_BLOCK_NULL && create)
+	{
+		goal = ((idx > 0) && (buf[idx - 1] != MINIX_BLOCK_NULL)) ?
+			buf[idx - 1] + 1 : zone + 1;
+		phys = minix_block_alloc_near(sb, zmap, goal, pa);
+		buf[idx] = phys;
+		journal_write(0, buf, MINIX_BLOCK_SIZE, off);
+	}
+
+	/*
+	 * Count physically contiguous blocks, so
+	 * that callers may skip the next lookups.
+	 */
+	if (len != NULL)
+	{
+		*len = (buf[idx] != MINIX_BLOCK_NULL) ? 1 : 0;
+		for (unsigned i = idx + 1; (*len > 0) && (i < MINIX_BLOCK_ADDRS_PER_BLOCK); i++)
+		{
+			if (buf[i] != buf[idx] + *len)
+				break;
+			(*len)++;
+		}
+	}
+
+	return (buf[idx]);
+}
+
+/*============================================================================*
+ * minix_block_map_extent()                                                   *
+ *============================================================================*/
+
+/**
+ * The minix_block_map_extent() function maps the byte offset @p off in
+ * the file pointed to by @p ip. The file system block is mapped in the
+ * MINIX file system pointed to by @p sb and allocated in the zone map
+ * pointed to by @p zmap if required. New blocks are placed right
+ * after the previous block of the file whenever possible, and they are
+ * taken from the preallocation window pointed to by @p pa, if it is
+ * not a NULL pointer. If @p len is not a NULL pointer, the number of
+ * physically contiguous blocks that are mapped from @p off onwards,
+ * within the same zone, is stored in there.
+ */
+minix_block_t minix_block_map_extent(
+	struct d_superblock *sb,
+	bitmap_t *zmap,
+	struct d_inode *ip,
+	struct minix_prealloc *pa,
+	off_t off,
+	int create,
+	minix_block_t *len
+)
+{
+	off_t zoff;                                     /* Zone offset.      */
+	bitmap_t logic;                                 /* Logic. blk. #.    */
+	minix_block_t phys;                             /* Phys. blk. #.     */
+	minix_block_t zone;                             /* Working zone.     */
+	minix_block_t goal;                             /* Goal block.       */
+	minix_block_t dummy;                            /* Dummy run length. */
+	minix_block_t buf[MINIX_BLOCK_ADDRS_PER_BLOCK]; /* Working buffer.   */
 
 	/* Bad superblock. */
 	if (sb->s_magic != MINIX_SUPER_MAGIC)
 		return (MINIX_BLOCK_NULL);
 
+	/* Bad offset. */
+	if (off < 0)
+		return (MINIX_BLOCK_NULL);
+
 	/* File offset too big. */
 	if ((bitmap_t)off >= sb->s_max_size)
 		return (MINIX_BLOCK_NULL);
 
+	if (len == NULL)
+		len = &dummy;
+	*len = 0;
+
+	logic = off/MINIX_BLOCK_SIZE;
+
 	/*
 	 * Create blocks that are
 	 * in a valid offset.
@@ -119,14 +397,24 @@ minix_block_t minix_block_map(
 	/* Direct block. */
 	if (logic < MINIX_NR_ZONES_DIRECT)
 	{
-		/* Create direct block. */
+		/* Create direct block, right after the previous one. */
 		if (ip->i_zones[logic] == MINIX_BLOCK_NULL && create)
 		{
-			phys = minix_block_alloc(sb, zmap);
+			goal = ((logic > 0) && (ip->i_zones[logic - 1] != MINIX_BLOCK_NULL)) ?
+				ip->i_zones[logic - 1] + 1 : MINIX_BLOCK_NULL;
+			phys = minix_block_alloc_near(sb, zmap, goal, pa);
 			ip->i_zones[logic] = phys;
 		}
 
-		return (ip->i_zones[logic]);
+		/* Count physically contiguous blocks. */
+		if ((phys = ip->i_zones[logic]) != MINIX_BLOCK_NULL)
+		{
+			*len = 1;
+			while ((logic + *len < MINIX_NR_ZONES_DIRECT) && (ip->i_zones[logic + *len] == phys + *len))
+				(*len)++;
+		}
+
+		return (phys);
 	}
 
 	logic -= MINIX_NR_ZONES_DIRECT;
@@ -134,37 +422,69 @@ minix_block_t minix_block_map(
 	/* Single indirect block. */
 	if (logic < MINIX_NR_SINGLE)
 	{
-		/* Create single indirect block. */
-		if (ip->i_zones[MINIX_ZONE_SINGLE] == MINIX_BLOCK_NULL && create)
-		{
-			phys = minix_block_alloc(sb, zmap);
-			ip->i_zones[MINIX_ZONE_SINGLE] = phys;
-		}
+		goal = (ip->i_zones[MINIX_ZONE_SINGLE - 1] != MINIX_BLOCK_NULL) ?
+			ip->i_zones[MINIX_ZONE_SINGLE - 1] + 1 : MINIX_BLOCK_NULL;
+		zone = minix_block_map_zone(sb, zmap, ip->i_zones[MINIX_ZONE_SINGLE], goal, pa, create);
+		ip->i_zones[MINIX_ZONE_SINGLE] = zone;
 
-		/* We cannot go any further. */
-		if ((phys = ip->i_zones[MINIX_ZONE_SINGLE]) == MINIX_BLOCK_NULL)
-			upanic("invalid offset");
+		return (minix_block_map_indirect(sb, zmap, zone, logic, pa, create, len));
+	}
 
-		off = phys*MINIX_BLOCK_SIZE;
-		bdev_read(0, (char *)buf, MINIX_BLOCK_SIZE, off);
+	logic -= MINIX_NR_SINGLE;
 
-		/* Create direct block. */
-		if (buf[logic] == MINIX_BLOCK_NULL && create)
+	/* Double indirect block. */
+	if (logic < MINIX_NR_DOUBLE)
+	{
+		zone = minix_block_map_zone(sb, zmap, ip->i_zones[MINIX_ZONE_DOUBLE], MINIX_BLOCK_NULL, pa, create);
+		ip->i_zones[MINIX_ZONE_DOUBLE] = zone;
+
+		/* Hole. */
+		if (zone == MINIX_BLOCK_NULL)
+			return (MINIX_BLOCK_NULL);
+
+		zoff = zone*MINIX_BLOCK_SIZE;
+		journal_read(0, buf, MINIX_BLOCK_SIZE, zoff);
+
+		/* Create single indirect block. */
+		if (buf[logic/MINIX_NR_SINGLE] == MINIX_BLOCK_NULL && create)
 		{
-			phys = minix_block_alloc(sb, zmap);
-			buf[logic] = phys;
-			bdev_write(0, (char *) buf, MINIX_BLOCK_SIZE, off);
+			buf[logic/MINIX_NR_SINGLE] = minix_block_map_zone(sb, zmap, MINIX_BLOCK_NULL, MINIX_BLOCK_NULL, pa, create);
+			journal_write(0, buf, MINIX_BLOCK_SIZE, zoff);
 		}
 
-		return (buf[logic]);
+		return (
+			minix_block_map_indirect(sb, zmap,
+				buf[logic/MINIX_NR_SINGLE],
+				logic%MINIX_NR_SINGLE,
+				pa,
+				create,
+				len
+			)
+		);
 	}
 
-	logic -= MINIX_NR_SINGLE;
+	return (MINIX_BLOCK_NULL);
+}
 
-	/* Double indirect zone. */
-	upanic("double indect zone");
+/*============================================================================*
+ * minix_block_map()                                                          *
+ *============================================================================*/
 
-	return (MINIX_BLOCK_NULL);
+/**
+ * @brief The minix_block_map_alloc() function maps the byte offset @p
+ * off in the file pointed to by @p ip. The file system block is mapped in the
+ * MINIX file system pointed to by @p sb and allocated in the zone map
+ * pointed to by @p zmap if required.
+ */
+minix_block_t minix_block_map(
+	struct d_superblock *sb,
+	bitmap_t *zmap,
+	struct d_inode *ip,
+	off_t off,
+	int create
+)
+{
+	return (minix_block_map_extent(sb, zmap, ip, NULL, off, create, NULL));
 }
 
 /*============================================================================*
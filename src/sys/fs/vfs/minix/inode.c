@@ -101,7 +101,7 @@ int minix_inode_read(
 
 	/* Read inode. */
 	offset = minix_inode_offset(sb, num);
-	if (bdev_read(dev, (char *)ip, sizeof(struct d_inode), offset) < 0)
+	if (journal_read(dev, ip, sizeof(struct d_inode), offset) < 0)
 		return (-EAGAIN);
 
 	return (0);
@@ -145,7 +145,7 @@ int minix_inode_write(
 
 	/* Write inode. */
 	offset = minix_inode_offset(sb, num);
-	if (bdev_write(dev, (char *)ip, sizeof(struct d_inode), offset) < 0)
+	if (journal_write(dev, ip, sizeof(struct d_inode), offset) < 0)
 		return (-EAGAIN);
 
 	return (0);
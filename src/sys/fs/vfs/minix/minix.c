@@ -126,7 +126,7 @@ off_t minix_dirent_search(
 			continue;
 		}
 
-		uassert(bdev_read(dev, (char *)&d, sizeof(struct d_dirent), base + off) == sizeof(struct d_dirent));
+		uassert(journal_read(dev, &d, sizeof(struct d_dirent), base + off) == sizeof(struct d_dirent));
 
 		/* Valid entry. */
 		if (d.d_ino != MINIX_INODE_NULL)
@@ -224,18 +224,21 @@ int minix_dirent_add(
 		return (-EAGAIN);
 
 	/* Read directory entry. */
-	uassert(bdev_read(dev, (char *)&d, sizeof(struct d_dirent), off) == sizeof(struct d_dirent));
+	uassert(journal_read(dev, &d, sizeof(struct d_dirent), off) == sizeof(struct d_dirent));
 
 	/* Set attributes. */
 	d.d_ino = num;
 	ustrncpy(d.d_name, name, MINIX_NAME_MAX);
 
 	/* Write directory entry. */
-	uassert(bdev_write(dev, (char *)&d, sizeof(struct d_dirent), off) == sizeof(struct d_dirent));
+	uassert(journal_write(dev, &d, sizeof(struct d_dirent), off) == sizeof(struct d_dirent));
 
 	dip->i_nlinks++;
 	dip->i_time = 0;
 
+	/* Drop cached lookups. */
+	dcache_invalidate(dev, name);
+
 	return (0);
 }
 
@@ -293,7 +296,7 @@ int minix_dirent_remove(
 		return (-ENOENT);
 
 	/* Read directory entry. */
-	uassert(bdev_read(dev, (char *)&d, sizeof(struct d_dirent), off) == sizeof(struct d_dirent));
+	uassert(journal_read(dev, &d, sizeof(struct d_dirent), off) == sizeof(struct d_dirent));
 
 	/* Read inode. */
 	if (minix_inode_read(dev, super, &ip, d.d_ino) < 0)
@@ -317,7 +320,10 @@ int minix_dirent_remove(
 	ustrncpy(d.d_name, "", MINIX_NAME_MAX);
 
 	/* Write directory entry. */
-	uassert(bdev_write(dev, (char *)&d, sizeof(struct d_dirent), off) == sizeof(struct d_dirent));
+	uassert(journal_write(dev, &d, sizeof(struct d_dirent), off) == sizeof(struct d_dirent));
+
+	/* Drop cached lookups. */
+	dcache_invalidate(dev, name);
 
 	return (0);
 }
@@ -330,7 +336,8 @@ int minix_dirent_remove(
  * The minix_mkfs() function creates a MINIX file system in the device
  * @p dev. The file system is formatted to feature @p ninode inodes, @p
  * nblocks @p nblocks. Furthermore, the user ID and the user group ID of
- * the file system are set to @p uid, and @p gid, respectively.
+ * the file system are set to @p uid, and @p gid, respectively. Only
+ * metadata is written, the remainder of the device is discarded.
  */
 int minix_mkfs(
 	dev_t dev,
@@ -341,7 +348,6 @@ int minix_mkfs(
 )
 {
 	size_t size;                    /* Size of file system.            */
-	char buf[MINIX_BLOCK_SIZE];     /* Writing buffer.                 */
 	minix_block_t imap_nblocks;     /* Number of inodes map blocks.    */
 	minix_block_t bmap_nblocks;     /* Number of block map blocks.     */
 	minix_block_t inode_nblocks;    /* Number of inode blocks.         */
@@ -373,10 +379,13 @@ int minix_mkfs(
 	size = nblocks;                    /* data blocks  */
 	size <<= MINIX_BLOCK_SIZE_LOG2;
 
-	/* Fill file system with zeros. */
-	umemset(buf, 0, MINIX_BLOCK_SIZE);
-	for (size_t off = 0; off < size; off += MINIX_BLOCK_SIZE)
-		uassert(bdev_write(dev, buf, MINIX_BLOCK_SIZE, off) == MINIX_BLOCK_SIZE);
+	/*
+	 * Discard old contents of the device. Discarded blocks read
+	 * as zeros, thus neither the inode table nor data blocks have
+	 * to be written here. Maps are written in a single batch by
+	 * minix_super_write().
+	 */
+	uassert(bdev_discard(dev, 0, size) == 0);
 
 	/* Write superblock. */
 	super.s_ninodes = ninodes;
@@ -424,6 +433,33 @@ int minix_mkfs(
 	return (0);
 }
 
+/*============================================================================*
+ * minix_probe()                                                              *
+ *============================================================================*/
+
+/**
+ * The minix_probe() function checks if the device @p dev holds a MINIX
+ * file system, by looking for a valid superblock in there.
+ */
+int minix_probe(dev_t dev)
+{
+	struct d_superblock super;
+
+	/* Read superblock. */
+	if (bdev_read(dev, (char *)&super, sizeof(struct d_superblock), 1*MINIX_BLOCK_SIZE) < 0)
+		return (-EIO);
+
+	/* Bad superblock. */
+	if (super.s_magic != MINIX_SUPER_MAGIC)
+		return (-EINVAL);
+
+	/* Bad maps. */
+	if ((super.s_imap_nblocks == 0) || (super.s_bmap_nblocks == 0))
+		return (-EINVAL);
+
+	return (0);
+}
+
 /*============================================================================*
  * minix_sync()                                                               *
  *============================================================================*/
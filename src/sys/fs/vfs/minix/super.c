@@ -56,7 +56,7 @@ int minix_super_read(
 		return (-EINVAL);
 
 	/* Superblock */
-	err = bdev_read(
+	err = journal_read(
 		dev,
 		(char *)sb,
 		sizeof(struct d_superblock),
@@ -79,7 +79,7 @@ int minix_super_read(
 	}
 
 	/* I-Node Map */
-	err = bdev_read(
+	err = journal_read(
 		dev,
 		(char *)*imap,
 		sb->s_imap_nblocks*MINIX_BLOCK_SIZE,
@@ -98,7 +98,7 @@ int minix_super_read(
 	}
 
 	/* Zone Map */
-	err = bdev_read(
+	err = journal_read(
 		dev,
 		(char *)*zmap,
 		sb->s_bmap_nblocks*MINIX_BLOCK_SIZE,
@@ -145,7 +145,7 @@ int minix_super_write(
 		return (-EINVAL);
 
 	/* Superblock */
-	err = bdev_write(
+	err = journal_write(
 		dev,
 		(char *)sb,
 		sizeof(struct d_superblock),
@@ -161,7 +161,7 @@ int minix_super_write(
 		return (-EINVAL);
 
 	/* I-Node Map */
-	err = bdev_write(
+	err = journal_write(
 		dev,
 		(char *)imap,
 		sb->s_imap_nblocks*MINIX_BLOCK_SIZE,
@@ -173,7 +173,7 @@ int minix_super_write(
 		return (err);
 
 	/* Zone Map */
-	err = bdev_write(
+	err = journal_write(
 		dev,
 		(char *)zmap,
 		sb->s_bmap_nblocks*MINIX_BLOCK_SIZE,
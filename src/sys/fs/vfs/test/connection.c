@@ -0,0 +1,247 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __VFS_SERVER
+
+#include <nanvix/servers/connection.h>
+#include <nanvix/servers/vfs.h>
+#include <nanvix/ulib.h>
+#include <posix/errno.h>
+
+/**
+ * @brief Number of connections used in tests.
+ */
+#define TEST_CONNECTIONS 8
+
+/**
+ * @brief Number of rounds in stress tests.
+ */
+#define TEST_ROUNDS 16
+
+/**
+ * @brief Base PID of remotes used in tests.
+ */
+#define TEST_PID 1000
+
+/**
+ * @brief Port of remotes used in tests.
+ */
+#define TEST_PORT 1
+
+/*============================================================================*
+ * Connection Tests                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Asserts that a connection is listed as active.
+ *
+ * @param remote PID of the remote.
+ * @param port   Remote port number.
+ *
+ * @returns Non-zero if the target connection is listed as active, and
+ * zero otherwise.
+ */
+static int test_connection_is_active(nanvix_pid_t remote, int port)
+{
+	int found = 0;
+
+	for (int i = 0; i < connections_count(); i++)
+	{
+		const struct connection *conn;
+
+		uassert((conn = connections_get(i)) != NULL);
+
+		if ((conn->remote == remote) && (conn->port == port))
+			found++;
+	}
+
+	uassert(found <= 1);
+
+	return (found);
+}
+
+/**
+ * @brief API Test: Connect/Disconnect
+ */
+static void test_api_connection_connect_disconnect(void)
+{
+	int i;
+	int n0;
+
+	n0 = connections_count();
+
+	uassert((i = connect(TEST_PID, TEST_PORT)) >= 0);
+	uassert(lookup(TEST_PID, TEST_PORT) == i);
+	uassert(connection_get_port(i) == TEST_PORT);
+	uassert(connection_get_remote(i) == TEST_PID);
+	uassert(connections_count() == n0 + 1);
+	uassert(test_connection_is_active(TEST_PID, TEST_PORT));
+
+	/* Connections are reference counted. */
+	uassert(connect(TEST_PID, TEST_PORT) == i);
+	uassert(lookup(TEST_PID, TEST_PORT) == i);
+	uassert(connections_count() == n0 + 1);
+	uassert(disconnect(TEST_PID, TEST_PORT) == 0);
+	uassert(lookup(TEST_PID, TEST_PORT) == i);
+
+	uassert(disconnect(TEST_PID, TEST_PORT) == 0);
+	uassert(lookup(TEST_PID, TEST_PORT) == -ENOENT);
+	uassert(connections_count() == n0);
+	uassert(!test_connection_is_active(TEST_PID, TEST_PORT));
+}
+
+/**
+ * @brief API Test: Request Accounting
+ */
+static void test_api_connection_request(void)
+{
+	int i;
+	unsigned nrequests;
+	const struct connection *conn = NULL;
+
+	nrequests = connections_nrequests();
+
+	uassert((i = connect(TEST_PID, TEST_PORT)) >= 0);
+	uassert(connection_request(TEST_PID, TEST_PORT) == i);
+	uassert(connection_request(TEST_PID, TEST_PORT) == i);
+
+	/* Lookups are not requests. */
+	uassert(lookup(TEST_PID, TEST_PORT) == i);
+
+	for (int j = 0; j < connections_count(); j++)
+	{
+		conn = connections_get(j);
+		if ((conn->remote == TEST_PID) && (conn->port == TEST_PORT))
+			break;
+	}
+
+	uassert(conn != NULL);
+	uassert(conn->nrequests == 2);
+	uassert(connections_nrequests() == nrequests + 2);
+
+	uassert(disconnect(TEST_PID, TEST_PORT) == 0);
+
+	/* Requests of unknown remotes are not accounted. */
+	uassert(connection_request(TEST_PID, TEST_PORT) == -ENOENT);
+	uassert(connections_nrequests() == nrequests + 2);
+}
+
+/**
+ * @brief Fault Test: Invalid Connect/Disconnect
+ */
+static void test_fault_connection_inval(void)
+{
+	uassert(connect(-1, TEST_PORT) == -EINVAL);
+	uassert(connect(TEST_PID, -1) == -EINVAL);
+	uassert(lookup(-1, TEST_PORT) == -EINVAL);
+	uassert(lookup(TEST_PID, -1) == -EINVAL);
+	uassert(disconnect(-1, TEST_PORT) == -EINVAL);
+	uassert(disconnect(TEST_PID, -1) == -EINVAL);
+	uassert(disconnect(TEST_PID, TEST_PORT) == -ENOENT);
+	uassert(connection_get_remote(-1) == -EINVAL);
+	uassert(connection_get_remote(NANVIX_CONNECTIONS_MAX) == -EINVAL);
+	uassert(connections_get(-1) == NULL);
+	uassert(connections_get(connections_count()) == NULL);
+}
+
+/**
+ * @brief Stress Test: Connect/Disconnect Churn
+ *
+ * Connections are opened in order and closed in an interleaved order,
+ * so that the active list is swap-removed from both ends. Connections
+ * that are still open should keep their index.
+ */
+static void test_stress_connection_churn(void)
+{
+	int n0;
+	int idx[TEST_CONNECTIONS];
+
+	n0 = connections_count();
+	uassert(n0 + TEST_CONNECTIONS <= NANVIX_CONNECTIONS_MAX);
+
+	for (int k = 0; k < TEST_ROUNDS; k++)
+	{
+		/* Open connections. */
+		for (int i = 0; i < TEST_CONNECTIONS; i++)
+		{
+			uassert((idx[i] = connect(TEST_PID + i, TEST_PORT + k)) >= 0);
+			uassert(lookup(TEST_PID + i, TEST_PORT + k) == idx[i]);
+		}
+
+		uassert(connections_count() == n0 + TEST_CONNECTIONS);
+
+		/* Close connections, odd ones first. */
+		for (int j = 0; j < TEST_CONNECTIONS; j++)
+		{
+			int i = ((2*j + 1) < TEST_CONNECTIONS) ?
+				(2*j + 1) : (2*j - TEST_CONNECTIONS);
+
+			uassert(disconnect(TEST_PID + i, TEST_PORT + k) == 0);
+			uassert(lookup(TEST_PID + i, TEST_PORT + k) == -ENOENT);
+			uassert(!test_connection_is_active(TEST_PID + i, TEST_PORT + k));
+			uassert(connections_count() == n0 + TEST_CONNECTIONS - j - 1);
+
+			/* Remaining connections should be untouched. */
+			for (int l = j + 1; l < TEST_CONNECTIONS; l++)
+			{
+				int m = ((2*l + 1) < TEST_CONNECTIONS) ?
+					(2*l + 1) : (2*l - TEST_CONNECTIONS);
+
+				uassert(lookup(TEST_PID + m, TEST_PORT + k) == idx[m]);
+				uassert(test_connection_is_active(TEST_PID + m, TEST_PORT + k));
+			}
+		}
+
+		uassert(connections_count() == n0);
+	}
+}
+
+/**
+ * @brief Connection Tests
+ */
+static struct
+{
+	void (*func)(void); /**< Test Function */
+	const char *name;   /**< Test Name     */
+} connection_tests[] = {
+	{ test_api_connection_connect_disconnect, "[connection][api] connect/disconnect " },
+	{ test_api_connection_request,            "[connection][api] request accounting " },
+	{ test_fault_connection_inval,            "[connection][fault] invalid arguments" },
+	{ test_stress_connection_churn,           "[connection][stress] churn           " },
+	{ NULL,                                    NULL                                   },
+};
+
+/**
+ * @brief Runs regression tests on the Table of Connections
+ */
+void test_connection(void)
+{
+	for (int i = 0; connection_tests[i].func != NULL; i++)
+	{
+		connection_tests[i].func();
+
+		uprintf("[nanvix][vfs]%s passed", connection_tests[i].name);
+	}
+}
@@ -0,0 +1,211 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __VFS_SERVER
+
+#include <nanvix/servers/vfs.h>
+#include <nanvix/config.h>
+#include <nanvix/ulib.h>
+#include <posix/errno.h>
+
+/**
+ * @brief Directory used in tests.
+ */
+#define TEST_DIR 1
+
+/*============================================================================*
+ * Directory Cache Tests                                                      *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Insert/Lookup
+ */
+static void test_api_dcache_insert_lookup(void)
+{
+	ino_t num;
+	const char *name = "test-file";
+
+	uassert(dcache_insert(NANVIX_ROOT_DEV, TEST_DIR, name, 2) == 0);
+	uassert(dcache_lookup(NANVIX_ROOT_DEV, TEST_DIR, name, &num) == 0);
+	uassert(num == 2);
+
+	/* Other directory. */
+	uassert(dcache_lookup(NANVIX_ROOT_DEV, TEST_DIR + 1, name, &num) == -ENOENT);
+
+	dcache_invalidate(NANVIX_ROOT_DEV, name);
+	uassert(dcache_lookup(NANVIX_ROOT_DEV, TEST_DIR, name, &num) == -ENOENT);
+}
+
+/**
+ * @brief API Test: Negative Entry
+ */
+static void test_api_dcache_negative(void)
+{
+	ino_t num;
+	const char *name = "test-file";
+
+	uassert(dcache_insert(NANVIX_ROOT_DEV, TEST_DIR, name, MINIX_INODE_NULL) == 0);
+	uassert(dcache_lookup(NANVIX_ROOT_DEV, TEST_DIR, name, &num) == 0);
+	uassert(num == MINIX_INODE_NULL);
+
+	dcache_invalidate(NANVIX_ROOT_DEV, name);
+}
+
+/**
+ * @brief API Test: Invalidation on Directory Entry Add/Remove
+ */
+static void test_api_dcache_dirent_add_remove(void)
+{
+	ino_t num;
+	minix_ino_t ino;
+	const char *filename = "test-file";
+
+	uassert((
+		ino = minix_inode_alloc(
+			fs_root.dev,
+			&fs_root.super->data,
+			fs_root.super->imap,
+			0, 0, 0)
+		) != MINIX_INODE_NULL
+	);
+
+		uassert(dcache_insert(fs_root.dev, MINIX_INODE_ROOT, filename, MINIX_INODE_NULL) == 0);
+
+		uassert((
+			minix_dirent_add(
+				fs_root.dev,
+				&fs_root.super->data,
+				fs_root.super->bmap,
+				inode_disk_get(fs_root.root),
+				filename,
+				ino)
+			) == 0
+		);
+
+		uassert(dcache_lookup(fs_root.dev, MINIX_INODE_ROOT, filename, &num) == -ENOENT);
+		uassert(dcache_insert(fs_root.dev, MINIX_INODE_ROOT, filename, ino) == 0);
+
+		uassert((
+			minix_dirent_remove(
+				fs_root.dev,
+				&fs_root.super->data,
+				fs_root.super->bmap,
+				inode_disk_get(fs_root.root),
+				filename)
+			) == 0
+		);
+
+		uassert(dcache_lookup(fs_root.dev, MINIX_INODE_ROOT, filename, &num) == -ENOENT);
+
+	uassert((
+		minix_inode_free(
+			&fs_root.super->data,
+			fs_root.super->imap,
+			ino)
+		) == 0
+	);
+}
+
+/**
+ * @brief Fault Injection Test: Invalid Insert
+ */
+static void test_fault_dcache_insert_inval(void)
+{
+	uassert(dcache_insert(NANVIX_ROOT_DEV, TEST_DIR, NULL, 2) == -EINVAL);
+	uassert(dcache_insert(NANVIX_ROOT_DEV, TEST_DIR, "very-long-file-name", 2) == -ENAMETOOLONG);
+}
+
+/**
+ * @brief Fault Injection Test: Invalid Lookup
+ */
+static void test_fault_dcache_lookup_inval(void)
+{
+	ino_t num;
+
+	uassert(dcache_lookup(NANVIX_ROOT_DEV, TEST_DIR, NULL, &num) == -EINVAL);
+	uassert(dcache_lookup(NANVIX_ROOT_DEV, TEST_DIR, "test-file", NULL) == -EINVAL);
+}
+
+/**
+ * @brief Stress Test: Insert/Lookup
+ */
+static void test_stress_dcache_insert_lookup(void)
+{
+	ino_t num;
+	char name[MINIX_NAME_MAX];
+
+	/* Overflow the cache. */
+	for (int i = 0; i < 2*NANVIX_DCACHE_LENGTH; i++)
+	{
+		usprintf(name, "file-%d", i);
+		uassert(dcache_insert(NANVIX_ROOT_DEV, TEST_DIR, name, i + 1) == 0);
+	}
+
+	/* Most recently inserted entries are kept. */
+	for (int i = NANVIX_DCACHE_LENGTH; i < 2*NANVIX_DCACHE_LENGTH; i++)
+	{
+		usprintf(name, "file-%d", i);
+		uassert(dcache_lookup(NANVIX_ROOT_DEV, TEST_DIR, name, &num) == 0);
+		uassert(num == (ino_t)(i + 1));
+	}
+
+	dcache_invalidate(NANVIX_ROOT_DEV, NULL);
+
+	for (int i = 0; i < 2*NANVIX_DCACHE_LENGTH; i++)
+	{
+		usprintf(name, "file-%d", i);
+		uassert(dcache_lookup(NANVIX_ROOT_DEV, TEST_DIR, name, &num) == -ENOENT);
+	}
+}
+
+/**
+ * @brief Directory Cache Tests
+ */
+static struct
+{
+	void (*func)(void); /**< Test Function */
+	const char *name;   /**< Test Name     */
+} dcache_tests[] = {
+	{ test_api_dcache_insert_lookup,     "[dcache][api] insert/lookup      " },
+	{ test_api_dcache_negative,          "[dcache][api] negative entry     " },
+	{ test_api_dcache_dirent_add_remove, "[dcache][api] dirent add/remove  " },
+	{ test_fault_dcache_insert_inval,    "[dcache][fault] invalid insert   " },
+	{ test_fault_dcache_lookup_inval,    "[dcache][fault] invalid lookup   " },
+	{ test_stress_dcache_insert_lookup,  "[dcache][stress] insert/lookup   " },
+	{ NULL,                               NULL                               },
+};
+
+/**
+ * @brief Runs regression tests on Directory Cache
+ */
+void test_dcache(void)
+{
+	for (int i = 0; dcache_tests[i].func != NULL; i++)
+	{
+		dcache_tests[i].func();
+
+		uprintf("[nanvix][vfs]%s passed", dcache_tests[i].name);
+	}
+}
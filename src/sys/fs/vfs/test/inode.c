@@ -915,6 +915,70 @@ static void test_stress_inode_touch_write3(void)
 	}
 }
 
+/**
+ * @brief Number of inodes used in reclaim tests.
+ */
+#define TEST_RECLAIM_NINODES \
+	(NANVIX_INODES_TABLE_LENGTH + NANVIX_INODES_TABLE_LENGTH/2)
+
+/**
+ * @brief Stress Test: Inode Reclaim
+ */
+static void test_stress_inode_reclaim(void)
+{
+	struct inode *ip;
+	minix_ino_t inos[TEST_RECLAIM_NINODES];
+
+	uassert(fprocess_launch(CONNECTION) == 0);
+
+	/* Create linked inodes. */
+	for (int i = 0; i < TEST_RECLAIM_NINODES; i++)
+	{
+		uassert((
+			inos[i] = minix_inode_alloc(
+				fs_root.dev,
+				&fs_root.super->data,
+				fs_root.super->imap,
+				0, 0, 0)
+			) != MINIX_INODE_NULL
+		);
+	}
+
+	/* Cycle through more inodes than the table holds. */
+	for (int j = 0; j < 2; j++)
+	{
+		for (int i = 0; i < TEST_RECLAIM_NINODES; i++)
+		{
+			/* get */
+			ip = inode_get(
+				&fs_root,
+				inos[i]
+			);
+			uassert(curr_proc->errcode == 0);
+			uassert(inode_get_num(ip) == inos[i]);
+
+			/* put */
+			inode_put(
+				&fs_root,
+				ip
+			);
+			uassert(curr_proc->errcode == 0);
+		}
+	}
+
+	/* House keeping. */
+	for (int i = 0; i < TEST_RECLAIM_NINODES; i++)
+	{
+		uassert((
+			minix_inode_free(
+				&fs_root.super->data,
+				fs_root.super->imap,
+				inos[i])
+			) == 0
+		);
+	}
+}
+
 /*============================================================================*
  * Test Driver                                                                *
  *============================================================================*/
@@ -951,6 +1015,7 @@ static struct
 	{ test_stress_inode_touch_write1,   "[inode][stress] touch write one step    " },
 	{ test_stress_inode_touch_write2,   "[inode][stress] touch write two steps   " },
 	{ test_stress_inode_touch_write3,   "[inode][stress] touch write three steps " },
+	{ test_stress_inode_reclaim,        "[inode][stress] reclaim                 " },
 	{ NULL,                              NULL                                      },
 };
 
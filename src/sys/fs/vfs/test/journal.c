@@ -0,0 +1,500 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __VFS_SERVER
+
+#include <nanvix/servers/vfs.h>
+#include <nanvix/config.h>
+#include <nanvix/dev.h>
+#include <nanvix/ulib.h>
+#include <posix/errno.h>
+
+/**
+ * @brief Size of updates used in tests.
+ */
+#define TEST_UPDATE_SIZE sizeof(struct d_inode)
+
+/**
+ * @brief Number of updates used in benchmarks.
+ */
+#define TEST_NUPDATES (MINIX_BLOCK_SIZE/TEST_UPDATE_SIZE)
+
+/**
+ * @brief Number of iterations for benchmark tests.
+ */
+#define NITERATIONS 4
+
+/**
+ * @brief Images of the journal device.
+ */
+static char images[2][NANVIX_JOURNAL_SIZE];
+
+/*============================================================================*
+ * Helper Functions                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Allocates a zeroed block in the root file system.
+ *
+ * @returns The offset of the allocated block.
+ */
+static off_t test_journal_block_alloc(void)
+{
+	off_t off;
+	minix_block_t blk;
+	char buf[MINIX_BLOCK_SIZE];
+
+	uassert((blk = minix_block_alloc(&fs_root.super->data, fs_root.super->bmap)) != MINIX_BLOCK_NULL);
+	off = blk*MINIX_BLOCK_SIZE;
+
+	umemset(buf, 0, MINIX_BLOCK_SIZE);
+	uassert(journal_sync(NANVIX_ROOT_DEV, MINIX_BLOCK_SIZE, off) == 0);
+	uassert(bdev_write(NANVIX_ROOT_DEV, buf, MINIX_BLOCK_SIZE, off) == MINIX_BLOCK_SIZE);
+
+	return (off);
+}
+
+/**
+ * @brief Releases a block of the root file system.
+ *
+ * @param off Offset of the target block.
+ */
+static void test_journal_block_free(off_t off)
+{
+	uassert(minix_block_free_direct(&fs_root.super->data, fs_root.super->bmap, off/MINIX_BLOCK_SIZE) == 0);
+}
+
+/**
+ * @brief Asserts that a buffer is filled with some value.
+ *
+ * @param buf Target buffer.
+ * @param n   Size of the target buffer.
+ * @param c   Expected value.
+ */
+static void test_journal_check(const char *buf, size_t n, char c)
+{
+	for (size_t i = 0; i < n; i++)
+		uassert(buf[i] == c);
+}
+
+/**
+ * @brief Takes an image of the journal device.
+ *
+ * @param image Store location for the image.
+ */
+static void test_journal_snapshot(char *image)
+{
+	uassert(bdev_read(NANVIX_JOURNAL_DEV, image, NANVIX_JOURNAL_SIZE, 0) == NANVIX_JOURNAL_SIZE);
+}
+
+/**
+ * @brief Remounts the journal as if the system had crashed.
+ *
+ * @param image Image of the journal device at the time of the crash.
+ * @param offs  Offsets of the blocks that had not been updated.
+ * @param n     Number of blocks.
+ *
+ * The journal is unmounted, which checkpoints it. The journal device
+ * and the home locations of the given blocks are then brought back to
+ * their state at the time of the crash, and the journal is mounted
+ * again, which replays the log.
+ */
+static void test_journal_crash(const char *image, const off_t *offs, int n)
+{
+	char buf[MINIX_BLOCK_SIZE];
+
+	uassert(journal_unmount(NANVIX_ROOT_DEV) == 0);
+
+		uassert(bdev_write(NANVIX_JOURNAL_DEV, image, NANVIX_JOURNAL_SIZE, 0) == NANVIX_JOURNAL_SIZE);
+		uassert(bdev_flush(NANVIX_JOURNAL_DEV) == 0);
+
+		umemset(buf, 0, MINIX_BLOCK_SIZE);
+		for (int i = 0; i < n; i++)
+			uassert(bdev_write(NANVIX_ROOT_DEV, buf, MINIX_BLOCK_SIZE, offs[i]) == MINIX_BLOCK_SIZE);
+		uassert(bdev_flush(NANVIX_ROOT_DEV) == 0);
+
+	uassert(journal_mount(NANVIX_ROOT_DEV) == 0);
+}
+
+/*============================================================================*
+ * Journal Tests                                                              *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Write/Commit/Checkpoint
+ */
+static void test_api_journal_write_checkpoint(void)
+{
+	off_t off;
+	char buf[TEST_UPDATE_SIZE];
+
+	off = test_journal_block_alloc();
+
+	umemset(buf, 1, TEST_UPDATE_SIZE);
+	uassert(journal_write(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, off) == TEST_UPDATE_SIZE);
+
+	/* Update is logged, but not on the device yet. */
+	uassert(bdev_read(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, off) == TEST_UPDATE_SIZE);
+	test_journal_check(buf, TEST_UPDATE_SIZE, 0);
+	uassert(journal_read(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, off) == TEST_UPDATE_SIZE);
+	test_journal_check(buf, TEST_UPDATE_SIZE, 1);
+
+	/* Commit does not touch home locations. */
+	uassert(journal_commit() == 0);
+	uassert(bdev_read(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, off) == TEST_UPDATE_SIZE);
+	test_journal_check(buf, TEST_UPDATE_SIZE, 0);
+
+	/* Checkpoint does. */
+	uassert(journal_checkpoint() == 0);
+	uassert(bdev_read(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, off) == TEST_UPDATE_SIZE);
+	test_journal_check(buf, TEST_UPDATE_SIZE, 1);
+
+	test_journal_block_free(off);
+}
+
+/**
+ * @brief API Test: Absorb Updates
+ */
+static void test_api_journal_absorb(void)
+{
+	off_t off;
+	char buf[TEST_UPDATE_SIZE];
+	struct journal_stats s0, s1;
+
+	off = test_journal_block_alloc();
+
+	uassert(journal_stats_get(&s0) == 0);
+
+		umemset(buf, 1, TEST_UPDATE_SIZE);
+		uassert(journal_write(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, off) == TEST_UPDATE_SIZE);
+		umemset(buf, 2, TEST_UPDATE_SIZE);
+		uassert(journal_write(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, off) == TEST_UPDATE_SIZE);
+
+	uassert(journal_stats_get(&s1) == 0);
+
+	/* Second update was absorbed by the first record. */
+	uassert(s1.nrecords == s0.nrecords + 1);
+	uassert(s1.nabsorbed == s0.nabsorbed + 1);
+	uassert(journal_read(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, off) == TEST_UPDATE_SIZE);
+	test_journal_check(buf, TEST_UPDATE_SIZE, 2);
+
+	uassert(journal_checkpoint() == 0);
+	uassert(bdev_read(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, off) == TEST_UPDATE_SIZE);
+	test_journal_check(buf, TEST_UPDATE_SIZE, 2);
+
+	test_journal_block_free(off);
+}
+
+/**
+ * @brief API Test: Sync Range
+ */
+static void test_api_journal_sync(void)
+{
+	off_t off;
+	char buf[TEST_UPDATE_SIZE];
+
+	off = test_journal_block_alloc();
+
+	umemset(buf, 1, TEST_UPDATE_SIZE);
+	uassert(journal_write(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, off) == TEST_UPDATE_SIZE);
+
+	/* Disjoint range. */
+	uassert(journal_sync(NANVIX_ROOT_DEV, TEST_UPDATE_SIZE, off + TEST_UPDATE_SIZE) == 0);
+	uassert(bdev_read(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, off) == TEST_UPDATE_SIZE);
+	test_journal_check(buf, TEST_UPDATE_SIZE, 0);
+
+	/* Overlapping range. */
+	uassert(journal_sync(NANVIX_ROOT_DEV, 1, off + TEST_UPDATE_SIZE - 1) == 0);
+	uassert(bdev_read(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, off) == TEST_UPDATE_SIZE);
+	test_journal_check(buf, TEST_UPDATE_SIZE, 1);
+
+	test_journal_block_free(off);
+}
+
+/**
+ * @brief API Test: Replay Committed Updates
+ */
+static void test_api_journal_replay(void)
+{
+	off_t off;
+	char buf[TEST_UPDATE_SIZE];
+
+	/* Log holds our records only. */
+	uassert(journal_checkpoint() == 0);
+
+	off = test_journal_block_alloc();
+
+	umemset(buf, 1, TEST_UPDATE_SIZE);
+	uassert(journal_write(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, off) == TEST_UPDATE_SIZE);
+	uassert(journal_commit() == 0);
+
+	/* Crash before checkpoint. */
+	test_journal_snapshot(images[0]);
+	test_journal_crash(images[0], &off, 1);
+
+	/* Committed update was replayed. */
+	uassert(bdev_read(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, off) == TEST_UPDATE_SIZE);
+	test_journal_check(buf, TEST_UPDATE_SIZE, 1);
+
+	test_journal_block_free(off);
+}
+
+/**
+ * @brief Fault Test: Do Not Replay Uncommitted Updates
+ */
+static void test_fault_journal_uncommitted(void)
+{
+	off_t offs[2];
+	char buf[TEST_UPDATE_SIZE];
+
+	/* Log holds our records only. */
+	uassert(journal_checkpoint() == 0);
+
+	offs[0] = test_journal_block_alloc();
+	offs[1] = test_journal_block_alloc();
+
+	umemset(buf, 1, TEST_UPDATE_SIZE);
+	uassert(journal_write(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, offs[0]) == TEST_UPDATE_SIZE);
+	uassert(journal_commit() == 0);
+	umemset(buf, 2, TEST_UPDATE_SIZE);
+	uassert(journal_write(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, offs[1]) == TEST_UPDATE_SIZE);
+
+	/* Crash before second commit. */
+	test_journal_snapshot(images[0]);
+	test_journal_crash(images[0], offs, 2);
+
+	uassert(bdev_read(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, offs[0]) == TEST_UPDATE_SIZE);
+	test_journal_check(buf, TEST_UPDATE_SIZE, 1);
+	uassert(bdev_read(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, offs[1]) == TEST_UPDATE_SIZE);
+	test_journal_check(buf, TEST_UPDATE_SIZE, 0);
+
+	test_journal_block_free(offs[1]);
+	test_journal_block_free(offs[0]);
+}
+
+/**
+ * @brief Fault Test: Do Not Commit Operations Halfway
+ */
+static void test_fault_journal_full(void)
+{
+	off_t offs[2];
+	char buf[MINIX_BLOCK_SIZE];
+
+	/* Log holds our records only. */
+	uassert(journal_checkpoint() == 0);
+
+	offs[0] = test_journal_block_alloc();
+	offs[1] = test_journal_block_alloc();
+
+	/*
+	 * Overlapping updates are never absorbed, thus
+	 * each operation takes up more than half of the log.
+	 */
+	journal_begin();
+	umemset(buf, 1, MINIX_BLOCK_SIZE);
+	for (int i = 0; i < 14; i++)
+	{
+		const size_t n = (i & 1) ? MINIX_BLOCK_SIZE/2 : MINIX_BLOCK_SIZE;
+		uassert(journal_write(NANVIX_ROOT_DEV, buf, n, offs[1]) == (ssize_t) n);
+	}
+
+	/* Log fills up in the middle of the second operation. */
+	journal_begin();
+	umemset(buf, 2, MINIX_BLOCK_SIZE);
+	for (int i = 0; i < 6; i++)
+	{
+		const size_t n = (i & 1) ? MINIX_BLOCK_SIZE/2 : MINIX_BLOCK_SIZE;
+		uassert(journal_write(NANVIX_ROOT_DEV, buf, n, offs[0]) == (ssize_t) n);
+	}
+
+	/* Crash before second commit. */
+	test_journal_snapshot(images[0]);
+	test_journal_crash(images[0], offs, 2);
+
+	uassert(bdev_read(NANVIX_ROOT_DEV, buf, MINIX_BLOCK_SIZE, offs[1]) == MINIX_BLOCK_SIZE);
+	test_journal_check(buf, MINIX_BLOCK_SIZE, 1);
+	uassert(bdev_read(NANVIX_ROOT_DEV, buf, MINIX_BLOCK_SIZE, offs[0]) == MINIX_BLOCK_SIZE);
+	test_journal_check(buf, MINIX_BLOCK_SIZE, 0);
+
+	test_journal_block_free(offs[1]);
+	test_journal_block_free(offs[0]);
+}
+
+/**
+ * @brief Fault Test: Do Not Replay Torn Commits
+ */
+static void test_fault_journal_torn(void)
+{
+	off_t offs[2];
+	size_t start, end;
+	char buf[TEST_UPDATE_SIZE];
+
+	/* Log holds our records only. */
+	uassert(journal_checkpoint() == 0);
+
+	offs[0] = test_journal_block_alloc();
+	offs[1] = test_journal_block_alloc();
+
+	umemset(buf, 1, TEST_UPDATE_SIZE);
+	uassert(journal_write(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, offs[0]) == TEST_UPDATE_SIZE);
+	uassert(journal_commit() == 0);
+	test_journal_snapshot(images[0]);
+
+	umemset(buf, 2, TEST_UPDATE_SIZE);
+	uassert(journal_write(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, offs[1]) == TEST_UPDATE_SIZE);
+	uassert(journal_commit() == 0);
+	test_journal_snapshot(images[1]);
+
+	/* Find out where the second commit went. */
+	for (start = 0; images[0][start] == images[1][start]; start++)
+		uassert(start < NANVIX_JOURNAL_SIZE - 1);
+	for (end = NANVIX_JOURNAL_SIZE; images[0][end - 1] == images[1][end - 1]; end--)
+		/* noop */ ;
+
+	/* Crash halfway through the second commit. */
+	umemcpy(&images[0][start], &images[1][start], (end - start)/2);
+	test_journal_crash(images[0], offs, 2);
+
+	uassert(bdev_read(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, offs[0]) == TEST_UPDATE_SIZE);
+	test_journal_check(buf, TEST_UPDATE_SIZE, 1);
+	uassert(bdev_read(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, offs[1]) == TEST_UPDATE_SIZE);
+	test_journal_check(buf, TEST_UPDATE_SIZE, 0);
+
+	test_journal_block_free(offs[1]);
+	test_journal_block_free(offs[0]);
+}
+
+/**
+ * @brief Fault Test: Invalid Write
+ */
+static void test_fault_journal_write_inval(void)
+{
+	char buf[TEST_UPDATE_SIZE];
+
+	uassert(journal_write(NANVIX_ROOT_DEV, NULL, TEST_UPDATE_SIZE, 0) == -EINVAL);
+	uassert(journal_write(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, -1) == -EINVAL);
+}
+
+/**
+ * @brief Fault Test: Invalid Read
+ */
+static void test_fault_journal_read_inval(void)
+{
+	uassert(journal_read(NANVIX_ROOT_DEV, NULL, TEST_UPDATE_SIZE, 0) == -EINVAL);
+	uassert(journal_stats_get(NULL) == -EINVAL);
+}
+
+/**
+ * @brief Fault Test: Invalid Mount/Unmount
+ */
+static void test_fault_journal_mount_inval(void)
+{
+	uassert(journal_mount(NANVIX_JOURNAL_DEV) == -EINVAL);
+	uassert(journal_mount(NANVIX_SCRATCH_DEV) == -EBUSY);
+	uassert(journal_unmount(NANVIX_SCRATCH_DEV) == -EINVAL);
+}
+
+/**
+ * @brief Benchmark Test: Group Commit
+ */
+static void test_benchmark_journal_group_commit(void)
+{
+	off_t off;
+	uint64_t t0, t1;
+	uint64_t cycles_direct;
+	uint64_t cycles_journal;
+	char buf[TEST_UPDATE_SIZE];
+
+	off = test_journal_block_alloc();
+	umemset(buf, 1, TEST_UPDATE_SIZE);
+
+	cycles_direct = 0;
+	cycles_journal = 0;
+	for (int i = 0; i < NITERATIONS; i++)
+	{
+		/* One device write per update. */
+		kclock(&t0);
+			for (unsigned j = 0; j < TEST_NUPDATES; j++)
+			{
+				uassert(bdev_write(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, off + j*TEST_UPDATE_SIZE) == TEST_UPDATE_SIZE);
+				uassert(bdev_flush(NANVIX_ROOT_DEV) == 0);
+			}
+		kclock(&t1);
+		cycles_direct += (t1 - t0);
+
+		/* One log write for all updates. */
+		kclock(&t0);
+			for (unsigned j = 0; j < TEST_NUPDATES; j++)
+				uassert(journal_write(NANVIX_ROOT_DEV, buf, TEST_UPDATE_SIZE, off + j*TEST_UPDATE_SIZE) == TEST_UPDATE_SIZE);
+			uassert(journal_commit() == 0);
+		kclock(&t1);
+		cycles_journal += (t1 - t0);
+
+		uassert(journal_checkpoint() == 0);
+	}
+
+	uprintf("[nanvix][vfs][journal] %d updates: direct %d cycles, group commit %d cycles",
+		(int) TEST_NUPDATES,
+		(int)(cycles_direct/NITERATIONS),
+		(int)(cycles_journal/NITERATIONS)
+	);
+
+	test_journal_block_free(off);
+}
+
+/**
+ * @brief Journal Tests
+ */
+static struct
+{
+	void (*func)(void); /**< Test Function */
+	const char *name;   /**< Test Name     */
+} journal_tests[] = {
+	{ test_api_journal_write_checkpoint,   "[journal][api] write/checkpoint     " },
+	{ test_api_journal_absorb,             "[journal][api] absorb updates       " },
+	{ test_api_journal_sync,               "[journal][api] sync range           " },
+	{ test_api_journal_replay,             "[journal][api] replay               " },
+	{ test_fault_journal_uncommitted,      "[journal][fault] uncommitted replay " },
+	{ test_fault_journal_torn,             "[journal][fault] torn commit replay " },
+	{ test_fault_journal_full,             "[journal][fault] full log           " },
+	{ test_fault_journal_write_inval,      "[journal][fault] invalid write      " },
+	{ test_fault_journal_read_inval,       "[journal][fault] invalid read       " },
+	{ test_fault_journal_mount_inval,      "[journal][fault] invalid mount      " },
+	{ test_benchmark_journal_group_commit, "[journal][benchmark] group commit   " },
+	{ NULL,                                 NULL                                 },
+};
+
+/**
+ * @brief Runs regression tests on Journal
+ */
+void test_journal(void)
+{
+	for (int i = 0; journal_tests[i].func != NULL; i++)
+	{
+		journal_tests[i].func();
+
+		uprintf("[nanvix][vfs]%s passed", journal_tests[i].name);
+	}
+}
@@ -59,6 +59,233 @@ static void test_api_minix_block_alloc_free(void)
 	);
 }
 
+/**
+ * @brief API Test: Block Map
+ */
+static void test_api_minix_block_map(void)
+{
+	struct d_inode ip;
+	minix_block_t len;
+	minix_block_t blks[3];
+	minix_block_t buf[MINIX_NR_SINGLE];
+	const off_t offs[3] = {
+		0,
+		MINIX_NR_ZONES_DIRECT*MINIX_BLOCK_SIZE,
+		(MINIX_NR_ZONES_DIRECT + MINIX_NR_SINGLE)*MINIX_BLOCK_SIZE
+	};
+
+	umemset(&ip, 0, sizeof(struct d_inode));
+
+	/* Direct, single indirect and double indirect zones. */
+	for (int i = 0; i < 3; i++)
+	{
+		uassert((
+			blks[i] = minix_block_map_extent(
+				&fs_root.super->data,
+				fs_root.super->bmap,
+				&ip,
+				NULL,
+				offs[i],
+				1,
+				&len
+			)) != MINIX_BLOCK_NULL
+		);
+		uassert(len >= 1);
+		uassert(
+			minix_block_map(
+				&fs_root.super->data,
+				fs_root.super->bmap,
+				&ip,
+				offs[i],
+				0
+			) == blks[i]
+		);
+	}
+
+	/* Hole. */
+	uassert(
+		minix_block_map(
+			&fs_root.super->data,
+			fs_root.super->bmap,
+			&ip,
+			offs[2] + MINIX_BLOCK_SIZE,
+			0
+		) == MINIX_BLOCK_NULL
+	);
+
+	/* House keeping. */
+	uassert(journal_read(NANVIX_ROOT_DEV, buf, MINIX_BLOCK_SIZE, ip.i_zones[MINIX_ZONE_DOUBLE]*MINIX_BLOCK_SIZE) == MINIX_BLOCK_SIZE);
+	uassert(minix_block_free_direct(&fs_root.super->data, fs_root.super->bmap, buf[0]) == 0);
+	uassert(minix_block_free_direct(&fs_root.super->data, fs_root.super->bmap, ip.i_zones[MINIX_ZONE_DOUBLE]) == 0);
+	uassert(minix_block_free_direct(&fs_root.super->data, fs_root.super->bmap, ip.i_zones[MINIX_ZONE_SINGLE]) == 0);
+	for (int i = 0; i < 3; i++)
+		uassert(minix_block_free_direct(&fs_root.super->data, fs_root.super->bmap, blks[i]) == 0);
+}
+
+/**
+ * @brief API Test: Block Map Interleaved
+ */
+static void test_api_minix_block_map_interleaved(void)
+{
+	minix_block_t len;
+	struct d_inode ips[2];
+	struct minix_prealloc pas[2];
+
+	umemset(ips, 0, sizeof(ips));
+	umemset(pas, 0, sizeof(pas));
+	pas[0].rmap = fs_root.super->rmap;
+	pas[1].rmap = fs_root.super->rmap;
+
+	/* Interleaved writers. */
+	for (int i = 0; i < NANVIX_MINIX_PREALLOC_LENGTH; i++)
+	{
+		for (int j = 0; j < 2; j++)
+		{
+			uassert(
+				minix_block_map_extent(
+					&fs_root.super->data,
+					fs_root.super->bmap,
+					&ips[j],
+					&pas[j],
+					i*MINIX_BLOCK_SIZE,
+					1,
+					NULL
+				) != MINIX_BLOCK_NULL
+			);
+		}
+	}
+
+	/* Files should be contiguous. */
+	for (int j = 0; j < 2; j++)
+	{
+		uassert(
+			minix_block_map_extent(
+				&fs_root.super->data,
+				fs_root.super->bmap,
+				&ips[j],
+				NULL,
+				0,
+				0,
+				&len
+			) != MINIX_BLOCK_NULL
+		);
+		uassert(len == NANVIX_MINIX_PREALLOC_LENGTH);
+	}
+
+	/* House keeping. */
+	for (int j = 0; j < 2; j++)
+	{
+		uassert(minix_block_prealloc_release(&fs_root.super->data, fs_root.super->bmap, &pas[j]) == 0);
+		for (int i = 0; i < NANVIX_MINIX_PREALLOC_LENGTH; i++)
+			uassert(minix_block_free_direct(&fs_root.super->data, fs_root.super->bmap, ips[j].i_zones[i]) == 0);
+	}
+}
+
+/**
+ * @brief Writes two interleaved files and counts their extents.
+ *
+ * @param ips Target inodes.
+ * @param pas Target preallocation windows (may be NULL).
+ *
+ * @returns The number of extents of both files, which is the number of
+ * block map lookups and device operations for reading them back.
+ */
+static int test_minix_block_map_extents(struct d_inode *ips, struct minix_prealloc *pas)
+{
+	int nextents;
+	minix_block_t len;
+
+	/* Interleaved writers. */
+	for (int i = 0; i < MINIX_NR_ZONES_DIRECT; i++)
+	{
+		for (int j = 0; j < 2; j++)
+		{
+			uassert(
+				minix_block_map_extent(
+					&fs_root.super->data,
+					fs_root.super->bmap,
+					&ips[j],
+					(pas != NULL) ? &pas[j] : NULL,
+					i*MINIX_BLOCK_SIZE,
+					1,
+					NULL
+				) != MINIX_BLOCK_NULL
+			);
+		}
+	}
+
+	/* Walk extents. */
+	nextents = 0;
+	for (int j = 0; j < 2; j++)
+	{
+		for (int i = 0; i < MINIX_NR_ZONES_DIRECT; i += len)
+		{
+			uassert(
+				minix_block_map_extent(
+					&fs_root.super->data,
+					fs_root.super->bmap,
+					&ips[j],
+					NULL,
+					i*MINIX_BLOCK_SIZE,
+					0,
+					&len
+				) != MINIX_BLOCK_NULL
+			);
+			uassert(len > 0);
+			nextents++;
+		}
+	}
+
+	return (nextents);
+}
+
+/**
+ * @brief API Test: Block Map Preallocation
+ */
+static void test_api_minix_block_map_prealloc(void)
+{
+	int nextents[2];
+	struct d_inode ips[2][2];
+	struct minix_prealloc pas[2];
+
+	umemset(ips, 0, sizeof(ips));
+	umemset(pas, 0, sizeof(pas));
+	pas[0].rmap = fs_root.super->rmap;
+	pas[1].rmap = fs_root.super->rmap;
+
+	nextents[0] = test_minix_block_map_extents(ips[0], NULL);
+	nextents[1] = test_minix_block_map_extents(ips[1], pas);
+
+	uprintf("[nanvix][vfs][minix] %d blocks: %d extents without windows, %d with windows",
+		2*MINIX_NR_ZONES_DIRECT, nextents[0], nextents[1]
+	);
+
+	uassert(nextents[1] < nextents[0]);
+
+	/* Reservations should not reach the zone map. */
+	for (int j = 0; j < 2; j++)
+	{
+		for (minix_block_t i = 0; i < pas[j].count; i++)
+		{
+			minix_block_t bit = pas[j].next + i - fs_root.super->data.s_first_data_block;
+
+			uassert(!bitmap_check_bit(fs_root.super->bmap, bit));
+			uassert(bitmap_check_bit(fs_root.super->rmap, bit));
+		}
+	}
+
+	/* House keeping. */
+	for (int j = 0; j < 2; j++)
+	{
+		uassert(minix_block_prealloc_release(&fs_root.super->data, fs_root.super->bmap, &pas[j]) == 0);
+		for (int k = 0; k < 2; k++)
+		{
+			for (int i = 0; i < MINIX_NR_ZONES_DIRECT; i++)
+				uassert(minix_block_free_direct(&fs_root.super->data, fs_root.super->bmap, ips[k][j].i_zones[i]) == 0);
+		}
+	}
+}
+
 /**
  * @brief API Test: Inode Alloc/Free
  */
@@ -1386,6 +1613,56 @@ static void test_stress_minix_inode_read_write_interleaved2(void)
 	}
 }
 
+/**
+ * @brief Number of iterations for benchmark tests.
+ */
+#define NITERATIONS 4
+
+/**
+ * @brief Benchmark Test: File System Creation
+ */
+static void test_benchmark_minix_mkfs(void)
+{
+	uint64_t t0, t1;
+	uint64_t cycles;
+	char buf[MINIX_BLOCK_SIZE];
+	const off_t last = NANVIX_DISK_SIZE - MINIX_BLOCK_SIZE;
+
+	cycles = 0;
+	for (int i = 0; i < NITERATIONS; i++)
+	{
+		/* Dirty last block of the device. */
+		umemset(buf, 1, MINIX_BLOCK_SIZE);
+		uassert(bdev_write(NANVIX_SCRATCH_DEV, buf, MINIX_BLOCK_SIZE, last) == MINIX_BLOCK_SIZE);
+
+		kclock(&t0);
+			uassert(
+				minix_mkfs(
+					NANVIX_SCRATCH_DEV,
+					NANVIX_NR_INODES,
+					NANVIX_DISK_SIZE/MINIX_BLOCK_SIZE,
+					0,
+					0
+				) == 0
+			);
+		kclock(&t1);
+
+		cycles += (t1 - t0);
+
+		uassert(minix_probe(NANVIX_SCRATCH_DEV) == 0);
+
+		/* Stale data should have been discarded. */
+		uassert(bdev_read(NANVIX_SCRATCH_DEV, buf, MINIX_BLOCK_SIZE, last) == MINIX_BLOCK_SIZE);
+		for (int j = 0; j < MINIX_BLOCK_SIZE; j++)
+			uassert(buf[j] == 0);
+	}
+
+	uprintf("[nanvix][vfs][minix] mkfs %d KB in %d cycles",
+		NANVIX_DISK_SIZE/1024,
+		(int)(cycles/NITERATIONS)
+	);
+}
+
 /**
  * @brief MINIX File System Tests
  */
@@ -1395,6 +1672,9 @@ static struct
 	const char *name;   /**< Test Name     */
 } minix_tests[] = {
 	{ test_api_minix_block_alloc_free,                "[minix][api] block alloc/free                 " },
+	{ test_api_minix_block_map,                       "[minix][api] block map                        " },
+	{ test_api_minix_block_map_interleaved,           "[minix][api] block map interleaved            " },
+	{ test_api_minix_block_map_prealloc,              "[minix][api] block map prealloc               " },
 	{ test_api_minix_inode_alloc_free,                "[minix][api] inode alloc/free                 " },
 	{ test_api_minix_inode_read_write,                "[minix][api] inode read/write                 " },
 	{ test_api_minix_dirent_add_remove,               "[minix][api] dirent add/remove                " },
@@ -1420,6 +1700,7 @@ static struct
 	{ test_stress_minix_inode_alloc_free_interleaved2,"[minix][stress] inode alloc/free interleaved 2" },
 	{ test_stress_minix_inode_read_write_interleaved1,"[minix][stress] inode read/write interleaved 1" },
 	{ test_stress_minix_inode_read_write_interleaved2,"[minix][stress] inode read/write interleaved 2" },
+	{ test_benchmark_minix_mkfs,                      "[minix][benchmark] mkfs                       " },
 	{ NULL,                                 NULL                                    },
 };
 
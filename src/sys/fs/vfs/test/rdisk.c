@@ -0,0 +1,151 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __VFS_SERVER
+
+#include <nanvix/servers/vfs.h>
+#include <nanvix/servers/rmem.h>
+#include <dev/rdisk.h>
+#include <nanvix/config.h>
+#include <nanvix/dev.h>
+#include <nanvix/ulib.h>
+#include <posix/errno.h>
+
+/**
+ * @brief Buffer for Read/Write Tests
+ */
+static char data[2*NANVIX_FS_BLOCK_SIZE];
+
+/*============================================================================*
+ * Remote Disk Tests                                                          *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Read/Write to Remote Disk
+ */
+static void test_api_rdisk_read_write(void)
+{
+	off_t off;
+
+	/* Straddle a remote page boundary. */
+	off = RMEM_BLOCK_SIZE - NANVIX_FS_BLOCK_SIZE;
+
+	umemset(data, 1, sizeof(data));
+	uassert(rdisk_write(NANVIX_SCRATCH_DEV, data, sizeof(data), off) == sizeof(data));
+	uassert(rdisk_flush(NANVIX_SCRATCH_DEV) == 0);
+	umemset(data, 0, sizeof(data));
+	uassert(rdisk_read(NANVIX_SCRATCH_DEV, data, sizeof(data), off) == sizeof(data));
+
+	/* Checksum. */
+	for (size_t i = 0; i < sizeof(data); i++)
+		uassert(data[i] == 1);
+}
+
+/**
+ * @brief Fault Injection Test: Invalid Read
+ */
+static void test_fault_rdisk_read_inval(void)
+{
+	uassert(rdisk_read(-1, data, sizeof(data), 0) == -EINVAL);
+	uassert(rdisk_read(NANVIX_NR_RDISKS, data, sizeof(data), 0) == -EINVAL);
+	uassert(rdisk_read(NANVIX_SCRATCH_DEV, NULL, sizeof(data), 0) == -EINVAL);
+	uassert(rdisk_read(NANVIX_SCRATCH_DEV, data, -1, 0) == -EINVAL);
+	uassert(rdisk_read(NANVIX_SCRATCH_DEV, data, NANVIX_RDISK_SIZE + 1, 0) == -EINVAL);
+	uassert(rdisk_read(NANVIX_SCRATCH_DEV, data, NANVIX_RDISK_SIZE, 1) == -EINVAL);
+	uassert(rdisk_read(NANVIX_SCRATCH_DEV, data, NANVIX_RDISK_SIZE, -1) == -EINVAL);
+}
+
+/**
+ * @brief Fault Injection Test: Invalid Write
+ */
+static void test_fault_rdisk_write_inval(void)
+{
+	uassert(rdisk_write(-1, data, sizeof(data), 0) == -EINVAL);
+	uassert(rdisk_write(NANVIX_NR_RDISKS, data, sizeof(data), 0) == -EINVAL);
+	uassert(rdisk_write(NANVIX_SCRATCH_DEV, NULL, sizeof(data), 0) == -EINVAL);
+	uassert(rdisk_write(NANVIX_SCRATCH_DEV, data, -1, 0) == -EINVAL);
+	uassert(rdisk_write(NANVIX_SCRATCH_DEV, data, NANVIX_RDISK_SIZE + 1, 0) == -EINVAL);
+	uassert(rdisk_write(NANVIX_SCRATCH_DEV, data, NANVIX_RDISK_SIZE, 1) == -EINVAL);
+	uassert(rdisk_write(NANVIX_SCRATCH_DEV, data, NANVIX_RDISK_SIZE, -1) == -EINVAL);
+}
+
+/**
+ * @brief Stress Test: Read/Write to Remote Disk
+ */
+static void test_stress_rdisk_read_write(void)
+{
+	/* Touch more pages than the cache holds. */
+	for (int j = 0; j < 2*NANVIX_RDISK_CACHE_LENGTH; j++)
+	{
+		umemset(data, j, sizeof(data));
+		uassert(rdisk_write(NANVIX_SCRATCH_DEV, data, sizeof(data), j*RMEM_BLOCK_SIZE) == sizeof(data));
+	}
+
+	for (int j = 0; j < 2*NANVIX_RDISK_CACHE_LENGTH; j++)
+	{
+		uassert(rdisk_read(NANVIX_SCRATCH_DEV, data, sizeof(data), j*RMEM_BLOCK_SIZE) == sizeof(data));
+
+		/* Checksum. */
+		for (size_t i = 0; i < sizeof(data); i++)
+			uassert(data[i] == (char) j);
+	}
+}
+
+/**
+ * @brief Remote Disk Tests
+ */
+static struct
+{
+	void (*func)(void); /**< Test Function */
+	const char *name;   /**< Test Name     */
+} rdisk_tests[] = {
+	{ test_api_rdisk_read_write,    "[rdisk][api]    read/write"    },
+	{ test_fault_rdisk_read_inval,  "[rdisk][fault]  invalid read"  },
+	{ test_fault_rdisk_write_inval, "[rdisk][fault]  invalid write" },
+	{ test_stress_rdisk_read_write, "[rdisk][stress] read/write"    },
+	{ NULL,                          NULL                           },
+};
+
+/**
+ * @brief Runs regression tests on Remote Disk.
+ */
+void test_rdisk(void)
+{
+	/* Root device is not a remote disk. */
+#if !(NANVIX_VFS_RDISK)
+	rdisk_init();
+#endif
+
+	for (int i = 0; rdisk_tests[i].func != NULL; i++)
+	{
+		rdisk_tests[i].func();
+
+		uprintf("[nanvix][vfs]%s passed", rdisk_tests[i].name);
+	}
+
+#if !(NANVIX_VFS_RDISK)
+	rdisk_shutdown();
+#endif
+}
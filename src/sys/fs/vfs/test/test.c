@@ -24,10 +24,14 @@
 
 /* Import definitions. */
 extern void test_ramdisk(void);
+extern void test_rdisk(void);
 extern void test_bcache(void);
+extern void test_dcache(void);
+extern void test_journal(void);
 extern void test_minix(void);
 extern void test_inode();
 extern void test_vfs(void);
+extern void test_connection(void);
 
 /**
  * @brief Runs regression tests on VFS.
@@ -36,7 +40,11 @@ void vfs_test(void)
 {
 	test_vfs();
 	test_inode();
+	test_dcache();
+	test_journal();
 	test_minix();
 	test_bcache();
 	test_ramdisk();
+	test_rdisk();
+	test_connection();
 }
@@ -26,10 +26,12 @@
 #define __VFS_SERVER
 
 #include <nanvix/servers/vfs.h>
+#include <nanvix/sys/thread.h>
 #include <nanvix/config.h>
 #include <nanvix/dev.h>
 #include <nanvix/ulib.h>
 #include <posix/errno.h>
+#include <posix/sys/stat.h>
 #include <posix/fcntl.h>
 #include <posix/unistd.h>
 
@@ -65,6 +67,34 @@ static void test_api_vfs_open_close(void)
 	uassert(vfs_close(CONNECTION, fd) == 0);
 }
 
+/**
+ * @brief Number of Files Opened at Once
+ */
+#define TEST_OPEN_MANY (NANVIX_OPEN_MAX/4)
+
+/**
+ * @brief API Test: Open Many Files
+ */
+static void test_api_vfs_open_many(void)
+{
+	int fd;
+	int fds[TEST_OPEN_MANY];
+	const char *filename = "disk";
+
+	for (int i = 0; i < TEST_OPEN_MANY; i++)
+		uassert((fds[i] = vfs_open(CONNECTION, filename, O_RDONLY, 0)) >= 0);
+
+	/* Lowest-numbered free file descriptor is reused. */
+	for (int i = TEST_OPEN_MANY/2; i < TEST_OPEN_MANY; i += TEST_OPEN_MANY/4)
+	{
+		uassert(vfs_close(CONNECTION, fds[i]) == 0);
+		uassert((fd = vfs_open(CONNECTION, filename, O_RDONLY, 0)) == fds[i]);
+	}
+
+	for (int i = 0; i < TEST_OPEN_MANY; i++)
+		uassert(vfs_close(CONNECTION, fds[i]) == 0);
+}
+
 /**
  * @brief API Test: Seek Read/Write Pointer of a File
  */
@@ -109,6 +139,138 @@ static void test_api_vfs_read_write(void)
 	uassert(vfs_close(CONNECTION, fd) == 0);
 }
 
+/**
+ * @brief API Test: Copy Data Between Files
+ */
+static void test_api_vfs_copy_range(void)
+{
+	int fd1, fd2;
+	off_t off1, off2;
+	const char *filename = "disk";
+
+	off1 = fs_root.super->data.s_first_data_block*NANVIX_FS_BLOCK_SIZE;
+	off2 = off1 + NANVIX_FS_BLOCK_SIZE;
+
+	uassert((fd1 = vfs_open(CONNECTION, filename, O_RDONLY, 0)) >= 0);
+	uassert((fd2 = vfs_open(CONNECTION, filename, O_RDWR, 0)) >= 0);
+
+		umemset(data, 2, NANVIX_FS_BLOCK_SIZE);
+		uassert(vfs_pwrite(CONNECTION, fd2, data, NANVIX_FS_BLOCK_SIZE, off1) == NANVIX_FS_BLOCK_SIZE);
+
+		uassert(vfs_copy_range(CONNECTION, fd1, off1, fd2, off2, NANVIX_FS_BLOCK_SIZE) == NANVIX_FS_BLOCK_SIZE);
+
+		/* Overlapping ranges. */
+		uassert(vfs_copy_range(CONNECTION, fd2, off1, fd2, off1 + 1, NANVIX_FS_BLOCK_SIZE) == -EINVAL);
+
+		umemset(data, 0, NANVIX_FS_BLOCK_SIZE);
+		uassert(vfs_pread(CONNECTION, fd2, data, NANVIX_FS_BLOCK_SIZE, off2) == NANVIX_FS_BLOCK_SIZE);
+
+		/* Checksum. */
+		for (size_t i = 0; i < sizeof(data); i++)
+			uassert(data[i] == 2);
+
+		/* Restore data. */
+		umemset(data, 1, NANVIX_FS_BLOCK_SIZE);
+		uassert(vfs_pwrite(CONNECTION, fd2, data, NANVIX_FS_BLOCK_SIZE, off1) == NANVIX_FS_BLOCK_SIZE);
+
+	uassert(vfs_close(CONNECTION, fd2) == 0);
+	uassert(vfs_close(CONNECTION, fd1) == 0);
+}
+
+/**
+ * @brief API Test: Get Attributes of a File
+ */
+static void test_api_vfs_stat(void)
+{
+	struct vfs_stat st;
+
+	uassert(vfs_stat(CONNECTION, "disk", &st) == 0);
+	uassert(S_ISBLK(st.mode));
+
+	uassert(vfs_stat(CONNECTION, ".", &st) == 0);
+	uassert(S_ISDIR(st.mode));
+	uassert(st.ino == MINIX_INODE_ROOT);
+}
+
+/**
+ * @brief API Test: Get Entries of a Directory
+ */
+static void test_api_vfs_getdents(void)
+{
+	int fd;
+	int n;
+	int found = 0;
+	struct vfs_dirent dirents[4];
+
+	/* Directories are read-only. */
+	uassert(vfs_open(CONNECTION, ".", O_RDWR, 0) == -EISDIR);
+
+	uassert((fd = vfs_open(CONNECTION, ".", O_RDONLY, 0)) >= 0);
+
+		while ((n = vfs_getdents(CONNECTION, fd, dirents, 4)) > 0)
+		{
+			for (int i = 0; i < n; i++)
+			{
+				if (ustrcmp(dirents[i].d_name, "disk") == 0)
+				{
+					uassert(S_ISBLK(dirents[i].d_stat.mode));
+					found++;
+				}
+			}
+		}
+
+		uassert(n == 0);
+		uassert(found == 1);
+
+	uassert(vfs_close(CONNECTION, fd) == 0);
+}
+
+/**
+ * @brief Reader thread for concurrent tests.
+ *
+ * @param args Connection of the reader.
+ *
+ * @returns Always returns NULL.
+ */
+static void *test_vfs_reader(void *args)
+{
+	int fd;
+	int connection = *((int *) args);
+	char buf[NANVIX_FS_BLOCK_SIZE];
+
+	uassert((fd = vfs_open(connection, "disk", O_RDONLY, 0)) >= 0);
+
+		for (int i = 0; i < 8; i++)
+		{
+			uassert(vfs_seek(connection, fd, fs_root.super->data.s_first_data_block*NANVIX_FS_BLOCK_SIZE, SEEK_SET) >= 0);
+			uassert(vfs_read(connection, fd, buf, NANVIX_FS_BLOCK_SIZE) == NANVIX_FS_BLOCK_SIZE);
+
+			/* Checksum. */
+			for (size_t j = 0; j < sizeof(buf); j++)
+				uassert(buf[j] == 1);
+
+			/* Each thread has its own current process. */
+			uassert(fprocess_fd_get(fd) != NULL);
+		}
+
+	uassert(vfs_close(connection, fd) == 0);
+
+	return (NULL);
+}
+
+/**
+ * @brief API Test: Concurrent Reads
+ */
+static void test_api_vfs_read_concurrent(void)
+{
+	kthread_t tid;
+	int connections[2] = { CONNECTION, CONNECTION + 1 };
+
+	uassert(kthread_create(&tid, test_vfs_reader, &connections[1]) == 0);
+	test_vfs_reader(&connections[0]);
+	uassert(kthread_join(tid, NULL) == 0);
+}
+
 /*============================================================================*
  * Stress Tests                                                               *
  *============================================================================*/
@@ -121,10 +283,15 @@ static struct
 	void (*func)(void); /**< Test Function */
 	const char *name;   /**< Test Name     */
 } vfs_tests[] = {
-	{ test_api_vfs_open_close, "[vfs][api] open/close" },
-	{ test_api_vfs_seek,       "[vfs][api] seek      " },
-	{ test_api_vfs_read_write, "[vfs][api] read/write" },
-	{ NULL,                     NULL                   },
+	{ test_api_vfs_open_close,      "[vfs][api] open/close     " },
+	{ test_api_vfs_open_many,       "[vfs][api] open many      " },
+	{ test_api_vfs_seek,            "[vfs][api] seek           " },
+	{ test_api_vfs_read_write,      "[vfs][api] read/write     " },
+	{ test_api_vfs_copy_range,      "[vfs][api] copy range     " },
+	{ test_api_vfs_stat,            "[vfs][api] stat           " },
+	{ test_api_vfs_getdents,        "[vfs][api] getdents       " },
+	{ test_api_vfs_read_concurrent, "[vfs][api] concurrent read" },
+	{ NULL,                          NULL                        },
 };
 
 /**
@@ -41,6 +41,8 @@
  */
 int vfs_open(int connection, const char *filename, int oflag, mode_t mode)
 {
+	int ret;
+
 	/* Invalid file name. */
 	if (filename == NULL)
 		return (-EINVAL);
@@ -49,7 +51,11 @@ int vfs_open(int connection, const char *filename, int oflag, mode_t mode)
 	if (fprocess_launch(connection) < 0)
 		return (-EINVAL);
 
-	return (fs_open(filename, oflag, mode));
+	fs_lock();
+		ret = fs_open(filename, oflag, mode);
+	fs_unlock();
+
+	return (ret);
 }
 
 /*============================================================================*
@@ -61,6 +67,8 @@ int vfs_open(int connection, const char *filename, int oflag, mode_t mode)
  */
 int vfs_close(int connection, int fd)
 {
+	int ret;
+
 	/* Invalid file descriptor. */
 	if (!WITHIN(fd, 0, NANVIX_OPEN_MAX))
 		return (-EINVAL);
@@ -69,7 +77,11 @@ int vfs_close(int connection, int fd)
 	if (fprocess_launch(connection) < 0)
 		return (-EINVAL);
 
-	return (fs_close(fd));
+	fs_lock();
+		ret = fs_close(fd);
+	fs_unlock();
+
+	return (ret);
 }
 
 /*============================================================================*
@@ -78,6 +90,9 @@ int vfs_close(int connection, int fd)
 
 /**
  * @see fs_read().
+ *
+ * Reads do not acquire the file system lock. The lock of the target
+ * inode suffices, thus reads of different files run concurrently.
  */
 ssize_t vfs_read(int connection, int fd, void *buf, size_t n)
 {
@@ -105,6 +120,161 @@ ssize_t vfs_read(int connection, int fd, void *buf, size_t n)
  */
 ssize_t vfs_write(int connection, int fd, void *buf, size_t n)
 {
+	ssize_t ret;
+
+	/* Invalid file descriptor. */
+	if (!WITHIN(fd, 0, NANVIX_OPEN_MAX))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	/* Launch process. */
+	if (fprocess_launch(connection) < 0)
+		return (-EINVAL);
+
+	fs_lock();
+		ret = fs_write(fd, buf, n);
+	fs_unlock();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * vfs_pread()                                                                *
+ *============================================================================*/
+
+/**
+ * @see fs_pread().
+ *
+ * Like vfs_read(), this function does not acquire the file system lock.
+ */
+ssize_t vfs_pread(int connection, int fd, void *buf, size_t n, off_t off)
+{
+	/* Invalid file descriptor. */
+	if (!WITHIN(fd, 0, NANVIX_OPEN_MAX))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	/* Launch process. */
+	if (fprocess_launch(connection) < 0)
+		return (-EINVAL);
+
+	return (fs_pread(fd, buf, n, off));
+}
+
+/*============================================================================*
+ * vfs_pwrite()                                                               *
+ *============================================================================*/
+
+/**
+ * @see fs_pwrite().
+ */
+ssize_t vfs_pwrite(int connection, int fd, void *buf, size_t n, off_t off)
+{
+	ssize_t ret;
+
+	/* Invalid file descriptor. */
+	if (!WITHIN(fd, 0, NANVIX_OPEN_MAX))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	/* Launch process. */
+	if (fprocess_launch(connection) < 0)
+		return (-EINVAL);
+
+	fs_lock();
+		ret = fs_pwrite(fd, buf, n, off);
+	fs_unlock();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * vfs_copy_range()                                                           *
+ *============================================================================*/
+
+/**
+ * @see fs_copy_range().
+ */
+ssize_t vfs_copy_range(
+	int connection,
+	int fd_in,
+	off_t off_in,
+	int fd_out,
+	off_t off_out,
+	size_t n
+)
+{
+	ssize_t ret;
+
+	/* Invalid file descriptor. */
+	if (!WITHIN(fd_in, 0, NANVIX_OPEN_MAX) || !WITHIN(fd_out, 0, NANVIX_OPEN_MAX))
+		return (-EINVAL);
+
+	/* Invalid copy size. */
+	if (n > NANVIX_MAX_FILE_SIZE)
+		return (-EFBIG);
+
+	/* Launch process. */
+	if (fprocess_launch(connection) < 0)
+		return (-EINVAL);
+
+	fs_lock();
+		ret = fs_copy_range(fd_in, off_in, fd_out, off_out, n);
+	fs_unlock();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * vfs_stat()                                                                 *
+ *============================================================================*/
+
+/**
+ * @see fs_stat().
+ */
+int vfs_stat(int connection, const char *filename, struct vfs_stat *buf)
+{
+	int ret;
+
+	/* Invalid filename. */
+	if (filename == NULL)
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	/* Launch process. */
+	if (fprocess_launch(connection) < 0)
+		return (-EINVAL);
+
+	fs_lock();
+		ret = fs_stat(filename, buf);
+	fs_unlock();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * vfs_fstat()                                                                *
+ *============================================================================*/
+
+/**
+ * @see fs_fstat().
+ */
+int vfs_fstat(int connection, int fd, struct vfs_stat *buf)
+{
+	int ret;
+
 	/* Invalid file descriptor. */
 	if (!WITHIN(fd, 0, NANVIX_OPEN_MAX))
 		return (-EINVAL);
@@ -117,7 +287,45 @@ ssize_t vfs_write(int connection, int fd, void *buf, size_t n)
 	if (fprocess_launch(connection) < 0)
 		return (-EINVAL);
 
-	return (fs_write(fd, buf, n));
+	fs_lock();
+		ret = fs_fstat(fd, buf);
+	fs_unlock();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * vfs_getdents()                                                             *
+ *============================================================================*/
+
+/**
+ * @see fs_getdents().
+ */
+int vfs_getdents(int connection, int fd, struct vfs_dirent *dirp, int n)
+{
+	int ret;
+
+	/* Invalid file descriptor. */
+	if (!WITHIN(fd, 0, NANVIX_OPEN_MAX))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (dirp == NULL)
+		return (-EINVAL);
+
+	/* Invalid number of entries. */
+	if ((n <= 0) || (n > (int) VFS_GETDENTS_MAX))
+		return (-EINVAL);
+
+	/* Launch process. */
+	if (fprocess_launch(connection) < 0)
+		return (-EINVAL);
+
+	fs_lock();
+		ret = fs_getdents(fd, dirp, n);
+	fs_unlock();
+
+	return (ret);
 }
 
 /*============================================================================*
@@ -129,6 +337,8 @@ ssize_t vfs_write(int connection, int fd, void *buf, size_t n)
  */
 off_t vfs_seek(int connection, int fd, off_t offset, int whence)
 {
+	off_t ret;
+
 	/* Invalid file descriptor. */
 	if (!WITHIN(fd, 0, NANVIX_OPEN_MAX))
 		return (-EINVAL);
@@ -137,7 +347,59 @@ off_t vfs_seek(int connection, int fd, off_t offset, int whence)
 	if (fprocess_launch(connection) < 0)
 		return (-EINVAL);
 
-	return (fs_lseek(fd, offset, whence));
+	fs_lock();
+		ret = fs_lseek(fd, offset, whence);
+	fs_unlock();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * vfs_lease()                                                                *
+ *============================================================================*/
+
+/**
+ * @see fs_lease().
+ */
+int vfs_lease(int connection, int fd, unsigned *version)
+{
+	int ret;
+
+	/* Invalid file descriptor. */
+	if (!WITHIN(fd, 0, NANVIX_OPEN_MAX))
+		return (-EINVAL);
+
+	/* Invalid version. */
+	if (version == NULL)
+		return (-EINVAL);
+
+	/* Launch process. */
+	if (fprocess_launch(connection) < 0)
+		return (-EINVAL);
+
+	fs_lock();
+		ret = fs_lease(fd, version);
+	fs_unlock();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * vfs_commit()                                                               *
+ *============================================================================*/
+
+/**
+ * @see journal_commit().
+ */
+int vfs_commit(void)
+{
+	int ret;
+
+	fs_lock();
+		ret = journal_commit();
+	fs_unlock();
+
+	return (ret);
 }
 
 /*============================================================================*
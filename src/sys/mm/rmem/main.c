@@ -274,12 +274,10 @@ static inline int do_rmem_write(const struct rmem_message *request)
 {
 	int ret = 0;
 	rpage_t _blknum;
-	int remote = request->header.source;
 	rpage_t blknum = request->blknum;
-	int remote_port = request->header.portal_port;
 
 	rmem_debug("write() nodenum=%d blknum=%x",
-		remote,
+		request->header.source,
 		blknum
 	);
 
@@ -303,9 +301,9 @@ static inline int do_rmem_write(const struct rmem_message *request)
 		ret = -EFAULT;
 	}
 
-	uassert(kportal_allow(inportal, remote, remote_port) == 0);
 	uassert(
-		kportal_read(
+		nanvix_channel_accept(
+			&request->header,
 			inportal,
 			&rmem.blocks[_blknum*RMEM_BLOCK_SIZE],
 			RMEM_BLOCK_SIZE
@@ -322,9 +320,7 @@ static inline int do_rmem_write(const struct rmem_message *request)
 /**
  * @brief Handles a read request.
  *
- * @param remote Remote client.
- * @param blknum Number of the target block.
- * @param outbox Output mailbox to remote client.
+ * @param request Target request.
  *
  * @returns Upon successful completion, zero is returned. Upon
  * failure, a negative error code is returned instead.
@@ -332,16 +328,12 @@ static inline int do_rmem_write(const struct rmem_message *request)
 static inline int do_rmem_read(const struct rmem_message *request)
 {
 	int ret = 0;
-	int outbox;
-	int outportal;
 	rpage_t _blknum;
 	struct rmem_message msg;
-	int remote = request->header.source;
 	rpage_t blknum = request->blknum;
-	int outport = request->header.portal_port;
 
 	rmem_debug("read() nodenum=%d blknum=%x",
-		remote,
+		request->header.source,
 		blknum
 	);
 
@@ -365,43 +357,21 @@ static inline int do_rmem_read(const struct rmem_message *request)
 		ret = -EFAULT;
 	}
 
-	uassert((
-		outbox = kmailbox_open(
-			request->header.source,
-			request->header.mailbox_port
-		)) >= 0
-	);
-
 	/* Build operation header. */
 	msg.header.source = knode_get_num();
 	msg.header.opcode = RMEM_ACK;
 
-	uassert((outportal =
-		kportal_open(
-			knode_get_num(),
-			remote,
-			outport)
-		) >= 0
-	);
-	msg.header.portal_port = kcomm_get_port(outportal, COMM_TYPE_PORTAL);
+	/* Send acknowledge and data. */
 	uassert(
-		kmailbox_write(outbox,
+		nanvix_channel_reply_data(
+			&request->header,
 			&msg,
-			sizeof(struct rmem_message)
-		) == sizeof(struct rmem_message)
-	);
-	uassert(
-		kportal_write(
-			outportal,
+			sizeof(struct rmem_message),
 			&rmem.blocks[_blknum*RMEM_BLOCK_SIZE],
 			RMEM_BLOCK_SIZE
-		) == RMEM_BLOCK_SIZE
+		) == 0
 	);
 
-	/* House keeping. */
-	uassert(kportal_close(outportal) == 0);
-	uassert(kmailbox_close(outbox) == 0);
-
 	return (ret);
 }
 
@@ -418,25 +388,40 @@ static inline int do_rmem_read(const struct rmem_message *request)
 static int do_rmem_loop(void)
 {
 	int shutdown = 0;
+	int head = 0;
+	int count = 0;
+	static struct rmem_message requests[NANVIX_MAILBOX_BATCH_MAX];
 	uint64_t t0, t1;
 
 	kclock(&stats.tstart);
 
 	while(!shutdown)
 	{
-		int outbox;
 		int reply = 0;
 		int ret = -ENOSYS;
 		struct rmem_message request;
 		struct rmem_message response;
 
-		uassert(
-			kmailbox_read(
-				inbox,
-				&request,
-				sizeof(struct rmem_message)
-			) == sizeof(struct rmem_message)
-		);
+		/* Drain a batch of requests. */
+		if (head == count)
+		{
+			uassert((
+				count = nanvix_mailbox_read_batch(
+					inbox,
+					inportal,
+					requests,
+					sizeof(struct rmem_message),
+					NANVIX_MAILBOX_BATCH_MAX
+				)) >= 0
+			);
+			head = 0;
+
+			/* Malformed batch was dropped. */
+			if (count == 0)
+				continue;
+		}
+
+		request = requests[head++];
 
 		rmem_debug("rmem request source=%d port=%d opcode=%d",
 			request.header.source,
@@ -507,20 +492,13 @@ static int do_rmem_loop(void)
 			request.header.opcode
 		);
 
-		uassert((
-			outbox = kmailbox_open(
-				request.header.source,
-				request.header.mailbox_port
-			)) >= 0
-		);
 		uassert(
-			kmailbox_write(
-				outbox,
+			nanvix_channel_reply(
+				&request.header,
 				&response,
-				sizeof(struct rmem_message
-			)) == sizeof(struct rmem_message)
+				sizeof(struct rmem_message)
+			) == 0
 		);
-		uassert(kmailbox_close(outbox) == 0);
 	}
 
 	/* Dump statistics. */
@@ -626,6 +604,8 @@ static int do_rmem_startup(struct nanvix_semaphore *lock)
  */
 static int do_rmem_shutdown(void)
 {
+	nanvix_channel_flush();
+
 	return (0);
 }
 
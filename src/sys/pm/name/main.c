@@ -49,22 +49,76 @@
  */
 static int nr_registration = 0;
 
+/**
+ * @brief Generation of names.
+ *
+ * @details The generation is bumped whenever a name is added or
+ * removed, and it is sent back in every reply, so that clients may
+ * tell when their cached lookups went stale.
+ */
+static unsigned generation = 0;
+
 /**
  * @brief Inbox.
  */
 static int inbox = -1;
 
+/**
+ * @brief ID of this server.
+ *
+ * @details Server zero is the primary server. It handles updates to
+ * the table of names and propagates them to the other servers, which
+ * serve lookups from their own copy of the table.
+ */
+static int serverid = -1;
+
+/**
+ * @brief Outboxes to other servers.
+ */
+static int replicas[NAME_SERVERS_NUM] = {
+	[0 ... (NAME_SERVERS_NUM - 1)] = -1
+};
+
+/**
+ * @brief Number of hash buckets in the lookup table.
+ */
+#define NAME_HASH_LENGTH (NANVIX_PNAME_MAX/2)
+
 /**
  * @brief Lookup table of process names.
  */
 static struct {
-	int nodenum;                     /**< NoC nodenum.              */
-	int port_nr;                     /**< Server connection.        */
-	char name[NANVIX_PROC_NAME_MAX]; /**< Process name.             */
-	uint64_t timestamp;              /**< Timestamp for heartbeats. */
-	int refcount;                    /**< Link reference counter.   */
+	int nodenum;                     /**< NoC nodenum.                   */
+	int port_nr;                     /**< Server connection.             */
+	char name[NANVIX_PROC_NAME_MAX]; /**< Process name.                  */
+	uint64_t timestamp;              /**< Last heartbeat (zero if none). */
+	int refcount;                    /**< Link reference counter.        */
+	int hnext;                       /**< Next in name bucket.           */
+	int nnext;                       /**< Next in node bucket.           */
 } procs[NANVIX_PNAME_MAX];
 
+/**
+ * @brief Hash buckets of names.
+ */
+static int name_buckets[NAME_HASH_LENGTH];
+
+/**
+ * @brief Hash buckets of node numbers.
+ */
+static int node_buckets[NAME_HASH_LENGTH];
+
+/**
+ * @brief List of free entries in the lookup table.
+ *
+ * @details Free entries are chained through their name links.
+ */
+static int free_head = -1;
+
+/**
+ * @brief Time of the last sweep of expired names.
+ */
+static uint64_t last_sweep = 0;
+
 /**
  * @brief Server stats.
  */
@@ -73,7 +127,406 @@ static struct
 	int nlinks;         /**< Number of name link requests.   */
 	int nunlinks;       /**< Number of unlink name requests. */
 	int nlookups;       /**< Number of lookup requests.      */
-} stats = { 0, 0, 0};
+	int nupdates;       /**< Number of replica updates.      */
+	int nexpired;       /**< Number of expired names.        */
+} stats = { 0, 0, 0, 0, 0};
+
+/*===================================================================*
+ * name_hash()                                                       *
+ *===================================================================*/
+
+/**
+ * @brief Hashes a name.
+ *
+ * @param name Target name.
+ *
+ * @returns The hash value of @p name.
+ */
+static unsigned name_hash(const char *name)
+{
+	unsigned hash = 5381;
+
+	for (int i = 0; (i < NANVIX_PROC_NAME_MAX) && (name[i] != '\0'); i++)
+		hash = ((hash << 5) + hash) + name[i];
+
+	return (hash%NAME_HASH_LENGTH);
+}
+
+/*===================================================================*
+ * node_hash()                                                       *
+ *===================================================================*/
+
+/**
+ * @brief Hashes a node number.
+ *
+ * @param nodenum Target node number.
+ *
+ * @returns The hash value of @p nodenum.
+ */
+static inline unsigned node_hash(int nodenum)
+{
+	return ((unsigned) nodenum%NAME_HASH_LENGTH);
+}
+
+/*===================================================================*
+ * name_search()                                                     *
+ *===================================================================*/
+
+/**
+ * @brief Searches for a name in the lookup table.
+ *
+ * @param name Target name.
+ *
+ * @returns If @p name is linked, the index of its entry in the lookup
+ * table is returned. Otherwise, a negative number is returned instead.
+ */
+static int name_search(const char *name)
+{
+	for (int i = name_buckets[name_hash(name)]; i >= 0; i = procs[i].hnext)
+	{
+		/* Found. */
+		if (!ustrcmp(procs[i].name, name))
+			return (i);
+	}
+
+	return (-1);
+}
+
+/*===================================================================*
+ * name_insert()                                                     *
+ *===================================================================*/
+
+/**
+ * @brief Takes a free entry of the lookup table.
+ *
+ * @param name    Name.
+ * @param nodenum NoC node.
+ * @param port_nr Port of the connection.
+ *
+ * @returns Upon successful completion, the index of the entry is
+ * returned. Upon failure, a negative number is returned instead.
+ */
+static int name_insert(const char *name, int nodenum, int port_nr)
+{
+	int idx;
+	unsigned hash;
+
+	/* No entry available. */
+	if ((idx = free_head) < 0)
+		return (-1);
+
+	free_head = procs[idx].hnext;
+
+	ustrcpy(procs[idx].name, name);
+	procs[idx].nodenum = nodenum;
+	procs[idx].port_nr = port_nr;
+	procs[idx].timestamp = 0;
+
+	hash = name_hash(name);
+	procs[idx].hnext = name_buckets[hash];
+	name_buckets[hash] = idx;
+
+	hash = node_hash(nodenum);
+	procs[idx].nnext = node_buckets[hash];
+	node_buckets[hash] = idx;
+
+	return (idx);
+}
+
+/*===================================================================*
+ * name_remove()                                                     *
+ *===================================================================*/
+
+/**
+ * @brief Releases an entry of the lookup table.
+ *
+ * @param idx Index of target entry.
+ */
+static void name_remove(int idx)
+{
+	int *p;
+
+	/* Unlink from name bucket. */
+	for (p = &name_buckets[name_hash(procs[idx].name)]; *p >= 0; p = &procs[*p].hnext)
+	{
+		if (*p == idx)
+		{
+			*p = procs[idx].hnext;
+			break;
+		}
+	}
+
+	/* Unlink from node bucket. */
+	for (p = &node_buckets[node_hash(procs[idx].nodenum)]; *p >= 0; p = &procs[*p].nnext)
+	{
+		if (*p == idx)
+		{
+			*p = procs[idx].nnext;
+			break;
+		}
+	}
+
+	ustrcpy(procs[idx].name, "");
+	procs[idx].nodenum = -1;
+	procs[idx].port_nr = -1;
+	procs[idx].nnext = -1;
+	procs[idx].hnext = free_head;
+	free_head = idx;
+}
+
+/*===================================================================*
+ * name_server_get_id()                                              *
+ *===================================================================*/
+
+/**
+ * @brief Gets the ID of this server.
+ */
+static int name_server_get_id(void)
+{
+	int nodenum;
+
+	nodenum = knode_get_num();
+
+	/* Search for server. */
+	for (int i = 0; i < NAME_SERVERS_NUM; i++)
+	{
+		/* Found. */
+		if (nodenum == name_servers[i].nodenum)
+			return (i);
+	}
+
+	/* Should not happen. */
+	return (-1);
+}
+
+/*===================================================================*
+ * name_send()                                                       *
+ *===================================================================*/
+
+/**
+ * @brief Sends a message to another name server.
+ *
+ * @param i   ID of the target server.
+ * @param msg Target message.
+ *
+ * A replica that cannot be reached misses the message. Its outbox is
+ * opened again on the next message, and the replica catches up once
+ * it resyncs.
+ *
+ * @returns Upon successful completion zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ *
+ * @note Only the primary server may send messages to replicas.
+ */
+static int name_send(int i, const struct name_message *msg)
+{
+	/* Other servers are up only after the first ring is. */
+	if (replicas[i] < 0)
+	{
+		replicas[i] = kmailbox_open(
+			name_servers[i].nodenum,
+			name_servers[i].portnum
+		);
+
+		/* Replica is unreachable. */
+		if (replicas[i] < 0)
+			return (replicas[i]);
+	}
+
+	/* Replica is unreachable. */
+	if (kmailbox_write(replicas[i], msg, sizeof(struct name_message)) != sizeof(struct name_message))
+	{
+		kmailbox_close(replicas[i]);
+		replicas[i] = -1;
+		return (-EAGAIN);
+	}
+
+	return (0);
+}
+
+/*===================================================================*
+ * name_broadcast()                                                  *
+ *===================================================================*/
+
+/**
+ * @brief Sends a message to all other name servers.
+ *
+ * @param msg Target message.
+ *
+ * @note Only the primary server may broadcast.
+ */
+static void name_broadcast(const struct name_message *msg)
+{
+	for (int i = 1; i < NAME_SERVERS_NUM; i++)
+	{
+		if (name_send(i, msg) < 0)
+			uprintf("[nanvix][name] replica %d is unreachable", i);
+	}
+}
+
+/*===================================================================*
+ * name_propagate()                                                  *
+ *===================================================================*/
+
+/**
+ * @brief Propagates a change of the table of names.
+ *
+ * @param name    Name that changed.
+ * @param nodenum NoC node of @p name, or -1 if it was unlinked.
+ *
+ * The change is propagated before the request that caused it is
+ * answered, thus a client that looks the name up afterwards sees the
+ * change regardless of the server that it queries.
+ */
+static void name_propagate(const char *name, int nodenum)
+{
+	struct name_message msg;
+
+	message_header_build(&msg.header, NAME_UPDATE);
+	ustrcpy(msg.op.update.name, name);
+	msg.op.update.nodenum = nodenum;
+	msg.op.update.generation = generation;
+
+	name_broadcast(&msg);
+}
+
+/*===================================================================*
+ * name_snapshot()                                                   *
+ *===================================================================*/
+
+/**
+ * @brief Sends the table of names to a replica.
+ *
+ * @param nodenum NoC node of the replica.
+ *
+ * Each name is sent as an update. Changes that follow are broadcast
+ * after the snapshot, thus the replica applies them on top of it.
+ *
+ * @returns Upon successful completion zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ *
+ * @note Only the primary server sends snapshots.
+ */
+static int name_snapshot(int nodenum)
+{
+	int ret;
+	int replica = -1;
+	struct name_message msg;
+
+	/* Search for replica. */
+	for (int i = 1; i < NAME_SERVERS_NUM; i++)
+	{
+		if (name_servers[i].nodenum == nodenum)
+			replica = i;
+	}
+
+	/* Not a replica. */
+	if (replica < 0)
+		return (-EINVAL);
+
+	message_header_build(&msg.header, NAME_UPDATE);
+	msg.op.update.generation = generation;
+
+	for (int i = 0; i < NANVIX_PNAME_MAX; i++)
+	{
+		/* Free entry. */
+		if (procs[i].nodenum < 0)
+			continue;
+
+		ustrcpy(msg.op.update.name, procs[i].name);
+		msg.op.update.nodenum = procs[i].nodenum;
+
+		if ((ret = name_send(replica, &msg)) < 0)
+			return (ret);
+	}
+
+	return (0);
+}
+
+/*===================================================================*
+ * name_sweep()                                                      *
+ *===================================================================*/
+
+/**
+ * @brief Removes names whose heartbeats stopped.
+ *
+ * Names of processes that never sent a heartbeat do not expire. Sweeps
+ * are at least NANVIX_NAME_SWEEP_INTERVAL cycles apart, and they only
+ * run when a request arrives, thus a name may outlive its timeout on an
+ * idle server. Expired names are propagated as if they were unlinked,
+ * thus replicas drop them and clients drop their cached lookups on the
+ * next reply that they get.
+ *
+ * @note Only the primary server sweeps.
+ */
+static void name_sweep(void)
+{
+	uint64_t now;
+
+	kclock(&now);
+
+	/* Not yet. */
+	if ((now - last_sweep) < NANVIX_NAME_SWEEP_INTERVAL)
+		return;
+
+	last_sweep = now;
+
+	for (int i = 0; i < NANVIX_PNAME_MAX; i++)
+	{
+		char name[NANVIX_PROC_NAME_MAX];
+
+		/* Free entry or no heartbeats. */
+		if ((procs[i].nodenum < 0) || (procs[i].timestamp == 0))
+			continue;
+
+		/* Alive. */
+		if ((now - procs[i].timestamp) < NANVIX_NAME_HEARTBEAT_TIMEOUT)
+			continue;
+
+		uprintf("[nanvix][name] %s expired", procs[i].name);
+
+		ustrcpy(name, procs[i].name);
+		nr_registration -= procs[i].refcount;
+		procs[i].refcount = 0;
+		name_remove(i);
+
+		stats.nexpired++;
+		generation++;
+		name_propagate(name, -1);
+	}
+}
+
+/*===================================================================*
+ * name_resync()                                                     *
+ *===================================================================*/
+
+/**
+ * @brief Asks the primary server for a snapshot of the table of names.
+ *
+ * The snapshot is applied as updates arrive. Until then, the replica
+ * serves lookups from what it has.
+ *
+ * @note Only replicas resync.
+ */
+static void name_resync(void)
+{
+	int outbox;
+	struct name_message msg;
+
+	message_header_build(&msg.header, NAME_SYNC);
+
+	/* Primary server is unreachable. */
+	if ((outbox = kmailbox_open(name_servers[0].nodenum, name_servers[0].portnum)) < 0)
+	{
+		uprintf("[nanvix][name] cannot resync with primary server");
+		return;
+	}
+
+	if (kmailbox_write(outbox, &msg, sizeof(struct name_message)) != sizeof(struct name_message))
+		uprintf("[nanvix][name] cannot resync with primary server");
+
+	uassert(kmailbox_close(outbox) == 0);
+}
 
 /*===================================================================*
  * do_name_init()                                                    *
@@ -85,23 +538,42 @@ static struct
 static void do_name_init(struct nanvix_semaphore *lock)
 {
 	/* Initialize lookup table. */
-	for (int i = 0; i < NANVIX_PNAME_MAX; i++)
+	for (int i = 0; i < NAME_HASH_LENGTH; i++)
+	{
+		name_buckets[i] = -1;
+		node_buckets[i] = -1;
+	}
+	for (int i = NANVIX_PNAME_MAX - 1; i >= 0; i--)
 	{
 		procs[i].nodenum   = -1;
 		procs[i].port_nr   = -1;
 		procs[i].timestamp =  0;
 		procs[i].refcount  =  0;
+		procs[i].nnext     = -1;
+		procs[i].hnext     = free_head;
+		free_head = i;
 	}
 
-	procs[0].nodenum  = knode_get_num();
-	procs[0].port_nr  = kthread_self();
+	uassert(sizeof(struct name_message) <= NANVIX_MAILBOX_MESSAGE_SIZE);
+	uassert((serverid = name_server_get_id()) >= 0);
+
+	uassert(
+		name_insert(
+			"/io0",
+			name_servers[0].nodenum,
+			(serverid == 0) ? kthread_self() : -1
+		) == 0
+	);
 	procs[0].refcount = 1;
-	ustrcpy(procs[0].name, "/io0");
 
 	uassert((inbox = stdinbox_get()) >= 0);
 
+	/* Replicas catch up with the primary server. */
+	if (serverid != 0)
+		name_resync();
+
 	/* Unblock spawner. */
-	uprintf("[nanvix][name] server alive");
+	uprintf("[nanvix][name] server %d alive", serverid);
 	uprintf("[nanvix][name] listening to mailbox %d", inbox);
 	uprintf("[nanvix][name] attached to node %d", knode_get_num());
 
@@ -127,6 +599,7 @@ static int do_name_lookup(
 )
 {
 	int ret;
+	int idx;
 	const char *name;
 
 	name = request->op.lookup.name;
@@ -140,17 +613,154 @@ static int do_name_lookup(
 		return (ret);
 
 	/* Search for portal name. */
-	for (int i = 0; i < NANVIX_PNAME_MAX; i++)
+	if ((idx = name_search(name)) < 0)
+		return (-ENOENT);
+
+	response->op.ret.nodenum = procs[idx].nodenum;
+
+	return (0);
+}
+
+/*=======================================================================*
+ * do_name_lookup_multi()                                                *
+ *=======================================================================*/
+
+/**
+ * @brief Converts many names into NoC node numbers.
+ *
+ * @param request  Request.
+ * @param response Response.
+ *
+ * @returns Upon successful completion zero is returned. Upon failure, a
+ * negative error code is returned instead. The outcome of each lookup
+ * is reported separately in @p response.
+ */
+static int do_name_lookup_multi(
+	const struct name_message *request,
+	struct name_message *response
+)
+{
+	int count;
+	size_t off;
+	const char *names;
+
+	names = request->op.lookup_multi.names;
+	count = request->op.lookup_multi.count;
+
+	/* Invalid number of names. */
+	if ((count <= 0) || (count > NAME_LOOKUP_MULTI_MAX))
+		return (-EINVAL);
+
+	off = 0;
+	for (int i = 0; i < count; i++)
 	{
-		/* Found. */
-		if (!ustrcmp(name, procs[i].name))
+		int idx;
+		size_t len;
+		const char *name;
+
+		/* Find end of name. */
+		for (len = 0; (off + len) < NAME_PACKED_SIZE; len++)
 		{
-			response->op.ret.nodenum = procs[i].nodenum;
-			return (0);
+			if (names[off + len] == '\0')
+				break;
 		}
+
+		/* Bad packing. */
+		if ((off + len) >= NAME_PACKED_SIZE)
+			return (-EINVAL);
+
+		name = &names[off];
+		off += len + 1;
+
+		stats.nlookups++;
+		name_debug("lookup name=%s", name);
+
+		/* Invalid name. */
+		if ((response->op.ret.data.nodenums[i] = nanvix_name_is_valid(name)) < 0)
+			continue;
+
+		response->op.ret.data.nodenums[i] = ((idx = name_search(name)) < 0) ?
+			-ENOENT : procs[idx].nodenum;
 	}
 
-	return (-ENOENT);
+	return (0);
+}
+
+/*=======================================================================*
+ * do_name_list()                                                        *
+ *=======================================================================*/
+
+/**
+ * @brief Lists names that start with a prefix.
+ *
+ * @param request  Request.
+ * @param response Response.
+ *
+ * As many names as fit in a message are listed, starting at the entry
+ * of the lookup table pointed to by the cursor of the request. The
+ * cursor from which the listing should be resumed is sent back.
+ *
+ * @returns Upon successful completion zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ */
+static int do_name_list(
+	const struct name_message *request,
+	struct name_message *response
+)
+{
+	int cursor;
+	size_t off;
+	size_t plen;
+	const char *prefix;
+
+	prefix = request->op.list.prefix;
+	cursor = request->op.list.cursor;
+	response->op.ret.data.list.cursor = -1;
+	response->op.ret.data.list.count = 0;
+
+	name_debug("list prefix=%s", prefix);
+
+	/* Invalid cursor. */
+	if ((cursor < 0) || (cursor >= NANVIX_PNAME_MAX))
+		return (-EINVAL);
+
+	/* Prefix too long. */
+	for (plen = 0; plen < NANVIX_PROC_NAME_MAX; plen++)
+	{
+		if (prefix[plen] == '\0')
+			break;
+	}
+	if (plen == NANVIX_PROC_NAME_MAX)
+		return (-ENAMETOOLONG);
+
+	off = 0;
+	for (int i = cursor; i < NANVIX_PNAME_MAX; i++)
+	{
+		size_t len;
+
+		/* Skip free entries. */
+		if (procs[i].nodenum < 0)
+			continue;
+
+		/* Skip names that do not match. */
+		if (ustrncmp(procs[i].name, prefix, plen))
+			continue;
+
+		len = ustrlen(procs[i].name);
+
+		/* No room left. */
+		if ((off + len + 1) > NAME_PACKED_SIZE)
+		{
+			response->op.ret.data.list.cursor = i;
+			break;
+		}
+
+		umemcpy(&response->op.ret.data.list.names[off], procs[i].name, len + 1);
+		response->op.ret.data.list.count++;
+		off += len + 1;
+	}
+
+	return (0);
 }
 
 /*=======================================================================*
@@ -193,38 +803,21 @@ static int do_name_link(const struct name_message *request)
 		return (-EINVAL);
 
 	/* Check if the name is already in use. */
-	for (int i = 0; i < NANVIX_PNAME_MAX; i++)
+	if ((index = name_search(name)) >= 0)
 	{
-		if (ustrcmp(procs[i].name, name) == 0)
-		{
-			/* Confirm connection. */
-			if ((procs[i].nodenum == nodenum) && (procs[i].port_nr == remote_port))
-			{
-				index = i;
-				goto connect;
-			}
-			else
-				return (-EINVAL);
-		}
-	}
+		/* Confirm connection. */
+		if ((procs[index].nodenum == nodenum) && (procs[index].port_nr == remote_port))
+			goto connect;
 
-	/* Find index. */
-	for (int i = 0; i < NANVIX_PNAME_MAX; i++)
-	{
-		/* Found. */
-		if (procs[i].nodenum < 0)
-		{
-			index = i;
-			goto found;
-		}
+		return (-EINVAL);
 	}
 
-	return (-EINVAL);
+	/* Take a free entry. */
+	if ((index = name_insert(name, nodenum, remote_port)) < 0)
+		return (-EINVAL);
 
-found:
-	ustrcpy(procs[index].name, name);
-	procs[index].nodenum = nodenum;
-	procs[index].port_nr = remote_port;
+	generation++;
+	name_propagate(name, nodenum);
 
 connect:
 	procs[index].refcount++;
@@ -249,6 +842,7 @@ connect:
 static int do_name_unlink(const struct name_message *request)
 {
 	int ret;
+	int idx;
 	uint8_t remote_port;
 	const char *name;
 
@@ -263,34 +857,24 @@ static int do_name_unlink(const struct name_message *request)
 		return (ret);
 
 	/* Search for name */
-	for (int i = 0; i < NANVIX_PNAME_MAX; i++)
-	{
-		/* Skip invalid entries. */
-		if (procs[i].nodenum < 0)
-			continue;
+	if ((idx = name_search(name)) < 0)
+		return (-ENOENT);
 
-		/* Found*/
-		if (ustrcmp(procs[i].name, name) == 0)
-		{
-			/* Checks if it is the same port that linked this name. */
-			if (procs[i].port_nr != remote_port)
-				return (-EINVAL);
-
-			nr_registration--;
+	/* Checks if it is the same port that linked this name. */
+	if (procs[idx].port_nr != remote_port)
+		return (-EINVAL);
 
-			/* Checks if it was the last reference to this name link. */
-			if ((--procs[i].refcount) == 0)
-			{
-				ustrcpy(procs[i].name, "");
-				procs[i].nodenum = -1;
-				procs[i].port_nr = -1;
-			}
+	nr_registration--;
 
-			return (0);
-		}
+	/* Checks if it was the last reference to this name link. */
+	if ((--procs[idx].refcount) == 0)
+	{
+		name_remove(idx);
+		generation++;
+		name_propagate(name, -1);
 	}
 
-	return (-ENOENT);
+	return (0);
 }
 
 /*=======================================================================*
@@ -300,7 +884,13 @@ static int do_name_unlink(const struct name_message *request)
 /**
  * @brief Updates the heartbeat of a process.
  *
- * @param request,
+ * @param request Request.
+ *
+ * The time of arrival is recorded, rather than the timestamp sent by
+ * the client, because clocks of different nodes are not in sync. Once
+ * a process sends a heartbeat, the names that it linked through the
+ * same port expire if it stops doing so. Other processes in the same
+ * node are not affected.
  *
  * @returns Upon successful completion zero is returned. Upon failure, a
  * negative error code is returned instead.
@@ -308,28 +898,83 @@ static int do_name_unlink(const struct name_message *request)
 static int do_name_heartbeat(const struct name_message *request)
 {
 	int nodenum;
-	uint64_t timestamp;
+	int ret = -ENOENT;
+	uint64_t now;
+	uint8_t remote_port;
 
-	timestamp = request->op.heartbeat.timestamp;
 	nodenum = request->header.source;
+	remote_port = request->header.mailbox_port;
 
-	name_debug("heartbeat nodenum=%d timestap=%l", nodenum, timestamp);
+	name_debug("heartbeat nodenum=%d timestap=%l", nodenum, request->op.heartbeat.timestamp);
 
 	/* Invalid node number. */
 	if (!proc_is_valid(nodenum))
 		return (-EINVAL);
 
+	kclock(&now);
+
 	/* Record timestamp. */
-	for (int i = 0; i < NANVIX_PNAME_MAX; i++)
+	for (int i = node_buckets[node_hash(nodenum)]; i >= 0; i = procs[i].nnext)
 	{
-		if (procs[i].nodenum == nodenum)
+		if ((procs[i].nodenum == nodenum) && (procs[i].port_nr == remote_port))
 		{
-			procs[i].timestamp = timestamp;
-			return (0);
+			procs[i].timestamp = now;
+			ret = 0;
 		}
 	}
 
-	return (-EINVAL);
+	return (ret);
+}
+
+/*=======================================================================*
+ * do_name_update()                                                      *
+ *=======================================================================*/
+
+/**
+ * @brief Applies a change propagated by the primary server.
+ *
+ * @param request Request.
+ *
+ * @returns Upon successful completion zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ */
+static int do_name_update(const struct name_message *request)
+{
+	int ret;
+	int idx;
+	int nodenum;
+	const char *name;
+
+	name = request->op.update.name;
+	nodenum = request->op.update.nodenum;
+
+	stats.nupdates++;
+	name_debug("update nodenum=%d name=%s", nodenum, name);
+
+	/* Not sent by the primary server. */
+	if ((serverid == 0) || (request->header.source != name_servers[0].nodenum))
+		return (-EINVAL);
+
+	/* Invalid name. */
+	if ((ret = nanvix_name_is_valid(name)) < 0)
+		return (ret);
+
+	/* Drop old entry. */
+	if ((idx = name_search(name)) >= 0)
+		name_remove(idx);
+
+	/* Add new entry. */
+	if (nodenum >= 0)
+	{
+		if ((idx = name_insert(name, nodenum, -1)) < 0)
+			return (-EINVAL);
+
+		procs[idx].refcount = 1;
+	}
+
+	generation = request->op.update.generation;
+
+	return (0);
 }
 
 /*===================================================================*
@@ -369,6 +1014,10 @@ int do_name_server(struct nanvix_semaphore *lock)
 		uprintf("name request %s", debug_str);
 		#endif
 
+		/* Expire names. */
+		if (serverid == 0)
+			name_sweep();
+
 		/* Handle name requests. */
 		switch (request.header.opcode)
 		{
@@ -378,24 +1027,52 @@ int do_name_server(struct nanvix_semaphore *lock)
 				reply = 1;
 				break;
 
+			/* Lookup many names. */
+			case NAME_LOOKUP_MULTI:
+				ret = do_name_lookup_multi(&request, &response);
+				reply = 1;
+				break;
+
+			/* List names. */
+			case NAME_LIST:
+				ret = do_name_list(&request, &response);
+				reply = 1;
+				break;
+
 			/* Add name. */
 			case NAME_LINK:
-				ret = do_name_link(&request);
+				ret = (serverid == 0) ? do_name_link(&request) : -ENOTSUP;
 				reply = 1;
 				break;
 
 			/* Remove name. */
 			case NAME_UNLINK:
 				stats.nunlinks++;
-				ret = do_name_unlink(&request);
+				ret = (serverid == 0) ? do_name_unlink(&request) : -ENOTSUP;
 				reply = 1;
 				break;
 
+			/* Heartbeat. */
 			case NAME_ALIVE:
-				uassert((ret = do_name_heartbeat(&request)) == 0);
+				if (serverid == 0)
+					ret = do_name_heartbeat(&request);
+				break;
+
+			/* Apply change. */
+			case NAME_UPDATE:
+				if ((ret = do_name_update(&request)) < 0)
+					name_debug("bad update from nodenum=%d", request.header.source);
+				break;
+
+			/* Resync replica. */
+			case NAME_SYNC:
+				if ((serverid == 0) && ((ret = name_snapshot(request.header.source)) < 0))
+					uprintf("[nanvix][name] cannot resync node %d", request.header.source);
 				break;
 
 			case NAME_EXIT:
+				if (serverid == 0)
+					name_broadcast(&request);
 				shutdown = 1;
 				break;
 
@@ -409,6 +1086,7 @@ int do_name_server(struct nanvix_semaphore *lock)
 			continue;
 
 		response.op.ret.errcode = ret;
+		response.op.ret.generation = generation;
 		message_header_build(
 			&response.header,
 			(ret < 0) ? NAME_FAIL : NAME_SUCCESS
@@ -430,9 +1108,16 @@ int do_name_server(struct nanvix_semaphore *lock)
 		uassert(kmailbox_close(outbox) == 0);
 	}
 
+	/* Close outboxes to other servers. */
+	for (int i = 1; i < NAME_SERVERS_NUM; i++)
+	{
+		if (replicas[i] >= 0)
+			uassert(kmailbox_close(replicas[i]) == 0);
+	}
+
 	/* Dump statistics. */
-	uprintf("[nanvix][name] links=%d lookups=%d unlinks=%d",
-			stats.nlinks, stats.nlookups, stats.nunlinks
+	uprintf("[nanvix][name] links=%d lookups=%d unlinks=%d updates=%d expired=%d",
+			stats.nlinks, stats.nlookups, stats.nunlinks, stats.nupdates, stats.nexpired
 	);
 
 	return (0);
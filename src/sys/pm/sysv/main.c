@@ -74,7 +74,7 @@ static int do_shm_open(struct sysv_message *request, struct sysv_message *respon
 		return (ret);
 
 	response->payload.ret.ipcid = ret;
-	uassert(connect(request->header.source, request->header.mailbox_port) == 0);
+	uassert(connect(request->header.source, request->header.mailbox_port) >= 0);
 
 	return (0);
 }
@@ -127,7 +127,7 @@ static int do_shm_create(struct sysv_message *request, struct sysv_message *resp
 		return (ret);
 
 	response->payload.ret.ipcid = ret;
-	uassert(connect(request->header.source, request->header.mailbox_port) == 0);
+	uassert(connect(request->header.source, request->header.mailbox_port) >= 0);
 
 	return (0);
 }
@@ -191,7 +191,6 @@ static int do_shm_inval(struct sysv_message *request, struct sysv_message *respo
 	int nremotes;
 	int shmid;
 	rpage_t page;
-	struct connection remotes[NANVIX_PROC_MAX];
 
 	shmid = request->payload.shm.inval.shmid;
 	page = request->payload.shm.inval.page;
@@ -202,7 +201,7 @@ static int do_shm_inval(struct sysv_message *request, struct sysv_message *respo
 		page
 	);
 
-	nremotes = get_connections(remotes);
+	nremotes = connections_count();
 
 	/* Broadcast invalidation signal. */
 	for (int i = 0; i < nremotes; i++)
@@ -219,7 +218,7 @@ static int do_shm_inval(struct sysv_message *request, struct sysv_message *respo
 
 		uassert((
 			outbox = kmailbox_open(
-				remotes[i].remote,
+				connections_get(i)->remote,
 				NANVIX_SHM_SNOOPER_PORT_NUM	
 			)) >= 0
 		);
@@ -347,18 +346,10 @@ static int do_sysv_msg_send(const struct sysv_message *request)
 	 * not the operation has succeeded.
 	 */
 
-	/* Allow remote write. */
-	uassert(
-		kportal_allow(
-			server.inportal,
-			request->header.source,
-			request->header.portal_port
-		) == 0
-	);
-
 	/* Read data in. */
 	uassert(
-		kportal_read(
+		nanvix_channel_accept(
+			&request->header,
 			server.inportal,
 			msgp,
 			request->payload.msg.send.msgsz
@@ -386,8 +377,6 @@ static int do_sysv_msg_send(const struct sysv_message *request)
 static int do_sysv_msg_receive(const struct sysv_message *request)
 {
 	int ret;
-	int outportal;
-	int outbox;
 	void *msgp;
 	struct sysv_message msg;
 
@@ -403,50 +392,20 @@ static int do_sysv_msg_receive(const struct sysv_message *request)
 	if (ret < 0)
 		return (ret);
 
-	uassert((
-		outbox = kmailbox_open(
-			request->header.source,
-			request->header.mailbox_port
-		)) >= 0
-	);
-
-	/* Open portal to remote. */
-	uassert((outportal =
-		kportal_open(
-			knode_get_num(),
-			request->header.source,
-			request->header.portal_port)
-		) >= 0
-	);
-
 	/* Build operation header. */
-	message_header_build2(
-		&msg.header,
-		SYSV_ACK,
-		kcomm_get_port(outportal, COMM_TYPE_PORTAL)
-	);
+	message_header_build(&msg.header, SYSV_ACK);
 
-	/* Send acknowledge. */
+	/* Send acknowledge and data. */
 	uassert(
-		kmailbox_write(outbox,
+		nanvix_channel_reply_data(
+			&request->header,
 			&msg,
-			sizeof(struct sysv_message)
-		) == sizeof(struct sysv_message)
-	);
-
-	/* Write to remote. */
-	uassert(
-		kportal_write(
-			outportal,
+			sizeof(struct sysv_message),
 			msgp,
 			request->payload.msg.receive.msgsz
-		) == (ssize_t) request->payload.msg.receive.msgsz
+		) == 0
 	);
 
-	/* House keeping. */
-	uassert(kportal_close(outportal) == 0);
-	uassert(kmailbox_close(outbox) == 0);
-
 	return (ret);
 }
 
@@ -544,50 +503,54 @@ static int do_sysv_sem_close(const struct sysv_message *request)
  */
 static int do_sysv_sem_operate(const struct sysv_message *request)
 {
-	int outbox;
+	int ret;
+	int connection;
+	message_header to;
 	struct sysv_message response;
 	const int port = request->header.mailbox_port;
 	const nanvix_pid_t pid = request->header.source;
-	int connection = connect(pid, port);
 
-	connection = do_sem_operate(
-		connection,
+	/* Semaphore not opened. */
+	if ((connection = lookup(pid, port)) < 0)
+		return (connection);
+
+	/*
+	 * Connections are identified to the semaphore service by their
+	 * index plus one, since zero means that no connection is involved.
+	 */
+	ret = do_sem_operate(
+		connection + 1,
 		request->payload.sem.operate.semid,
 		&request->payload.sem.operate.sembuf
 	);
 
 	/* Operation failed. */
-	if (connection < 0)
-		return (connection);
+	if (ret < 0)
+		return (ret);
 
 	/* Block. */
-	if (connection == pid)
+	if (ret == (connection + 1))
 		return (1);
 
 	/*  Operation completed. */
-	if (connection == 0)
+	if (ret == 0)
 		return (0);
 
 	/* Unblock remote. */
-	response.payload.ret.status = connection;
+	response.payload.ret.status = 0;
 	message_header_build(
 		&response.header,
 		SYSV_SUCCESS
 	);
-	uassert((
-		outbox = kmailbox_open(
-			connection,
-			connection_get_port(connection)
-		)) >= 0
-	);
+	to.source = connection_get_remote(ret - 1);
+	to.mailbox_port = connection_get_port(ret - 1);
 	uassert(
-		kmailbox_write(
-			outbox,
+		nanvix_channel_reply(
+			&to,
 			&response,
-			sizeof(struct sysv_message
-		)) == sizeof(struct sysv_message)
+			sizeof(struct sysv_message)
+		) == 0
 	);
-	uassert(kmailbox_close(outbox) == 0);
 
 	return (0);
 }
@@ -605,22 +568,37 @@ static int do_sysv_sem_operate(const struct sysv_message *request)
 static int do_sysv_server_loop(void)
 {
 	int shutdown = 0;
+	int head = 0;
+	int count = 0;
+	static struct sysv_message requests[NANVIX_MAILBOX_BATCH_MAX];
 
 	while (!shutdown)
 	{
-		int outbox;
 		int reply = 0;
 		int ret = -ENOSYS;
 		struct sysv_message request;
 		struct sysv_message response;
 
-		uassert(
-			kmailbox_read(
-				server.inbox,
-				&request,
-				sizeof(struct sysv_message)
-			) == sizeof(struct sysv_message)
-		);
+		/* Drain a batch of requests. */
+		if (head == count)
+		{
+			uassert((
+				count = nanvix_mailbox_read_batch(
+					server.inbox,
+					server.inportal,
+					requests,
+					sizeof(struct sysv_message),
+					NANVIX_MAILBOX_BATCH_MAX
+				)) >= 0
+			);
+			head = 0;
+
+			/* Malformed batch was dropped. */
+			if (count == 0)
+				continue;
+		}
+
+		request = requests[head++];
 
 		sysv_debug("sysv request source=%d port=%d opcode=%d",
 			request.header.source,
@@ -630,6 +608,8 @@ static int do_sysv_server_loop(void)
 
 		/* TODO check for bad node number. */
 
+		connection_request(request.header.source, request.header.mailbox_port);
+
 		/* Handle request. */
 		switch (request.header.opcode)
 		{
@@ -725,20 +705,13 @@ static int do_sysv_server_loop(void)
 			(ret < 0) ? SYSV_FAIL : SYSV_SUCCESS
 		);
 
-		uassert((
-			outbox = kmailbox_open(
-				request.header.source,
-				request.header.mailbox_port
-			)) >= 0
-		);
 		uassert(
-			kmailbox_write(
-				outbox,
+			nanvix_channel_reply(
+				&request.header,
 				&response,
-				sizeof(struct sysv_message
-			)) == sizeof(struct sysv_message)
+				sizeof(struct sysv_message)
+			) == 0
 		);
-		uassert(kmailbox_close(outbox) == 0);
 	}
 
 #ifndef __SUPPRESS_TESTS
@@ -803,6 +776,11 @@ static int do_sysv_server_startup(struct nanvix_semaphore *lock)
 static int do_sysv_server_shutdown(void)
 {
 	uprintf("[nanvix][sysv] shutting down server");
+	uprintf("[nanvix][sysv] %d requests served on %d connections",
+		(int) connections_nrequests(),
+		connections_count()
+	);
+	nanvix_channel_flush();
 
 	return (0);
 }
@@ -26,6 +26,7 @@
 #define __NEED_RESOURCE
 #define __SYSV_SERVER
 
+#include <nanvix/runtime/utils.h>
 #include <nanvix/servers/sysv.h>
 #include <nanvix/types.h>
 #include <nanvix/ulib.h>
@@ -61,6 +62,11 @@ static struct resource_pool pool = {
 	mqueues, NANVIX_MSG_MAX , sizeof(struct msg)
 };
 
+/**
+ * @brief Index of free message queues.
+ */
+static struct resource_index pool_index = RESOURCE_INDEX_INITIALIZER(&pool);
+
 /*============================================================================*
  * do_msg_get()                                                               *
  *============================================================================*/
@@ -111,7 +117,7 @@ int do_msg_get(key_t key, int msgflg)
 		return (-ENOENT);
 
 	/* Allocate  message queue. */
-	if ((msgid = resource_alloc(&pool)) < 0)
+	if ((msgid = resource_index_alloc(&pool_index)) < 0)
 		return (-ENOMEM);
 
 	mqueues[msgid].key = key;
@@ -148,7 +154,7 @@ int do_msg_close(int msgid)
 
 	/* Release message queue. */
 	if (mqueues[msgid].refcount == 0)
-		resource_free(&pool, msgid);
+		resource_index_free(&pool_index, msgid);
 
 	return (0);
 }
@@ -283,4 +289,6 @@ void do_msg_init(void)
 		mqueues[i].buf = msgbuf_alloc();
 		mqueues[i].resource = RESOURCE_INITIALIZER;
 	}
+
+	resource_index_reset(&pool_index);
 }
@@ -26,6 +26,7 @@
 #define __NEED_RESOURCE
 #define __SYSV_SERVER
 
+#include <nanvix/runtime/utils.h>
 #include <nanvix/servers/sysv.h>
 #include <nanvix/types.h>
 #include <nanvix/ulib.h>
@@ -66,6 +67,11 @@ static struct resource_pool pool = {
 	semaphores, NANVIX_SEM_MAX , sizeof(struct sem)
 };
 
+/**
+ * @brief Index of free semaphores.
+ */
+static struct resource_index pool_index = RESOURCE_INDEX_INITIALIZER(&pool);
+
 /*============================================================================*
  * do_sem_get()                                                               *
  *============================================================================*/
@@ -116,7 +122,7 @@ int do_sem_get(key_t key, int semflg)
 		return (-ENOENT);
 
 	/* Allocate semaphore. */
-	if ((semid = resource_alloc(&pool)) < 0)
+	if ((semid = resource_index_alloc(&pool_index)) < 0)
 		return (-ENOSPC);
 
 	semaphores[semid].key = key;
@@ -155,7 +161,7 @@ int do_sem_close(int semid)
 
 	/* Release semaphore. */
 	if (semaphores[semid].refcount == 0)
-		resource_free(&pool, semid);
+		resource_index_free(&pool_index, semid);
 
 	return (0);
 }
@@ -323,6 +329,8 @@ void do_sem_init(void)
 		semaphores[i].resource = RESOURCE_INITIALIZER;
 	}
 
+	resource_index_reset(&pool_index);
+
 	/* Initialize table of sleeping conncetions. */
 	for (int i = 0; i < NANVIX_PROC_MAX; i++)
 		sleeping[i].semid = -1;
@@ -28,6 +28,7 @@
 #define __NEED_MM_RMEM_STUB
 
 #include <nanvix/runtime/mm.h>
+#include <nanvix/runtime/utils.h>
 #include <nanvix/servers/sysv.h>
 #include <nanvix/sys/noc.h>
 #include <nanvix/types.h>
@@ -61,6 +62,11 @@ static struct resource_pool pool = {
 	regions, NANVIX_SHM_MAX, sizeof(struct region)
 };
 
+/**
+ * @brief Index of free shared memory regions.
+ */
+static struct resource_index pool_index = RESOURCE_INDEX_INITIALIZER(&pool);
+
 /*============================================================================*
  * shm_is_remove()                                                            *
  *============================================================================*/
@@ -264,7 +270,7 @@ int shm_alloc(void)
 {
 	int shmid;
 
-	if ((shmid = resource_alloc(&pool)) < 0)
+	if ((shmid = resource_index_alloc(&pool_index)) < 0)
 		return (-1);
 
 	regions[shmid].refcount = 1;
@@ -283,7 +289,7 @@ int shm_alloc(void)
  */
 static void shm_free(int shmid)
 {
-	resource_free(&pool, shmid);
+	resource_index_free(&pool_index, shmid);
 }
 
 /*============================================================================*
@@ -630,4 +636,6 @@ void shm_init(void)
 		regions[i].resource = RESOURCE_INITIALIZER;
 		regions[i].page = RMEM_NULL;
 	}
+
+	resource_index_reset(&pool_index);
 }
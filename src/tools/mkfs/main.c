@@ -0,0 +1,449 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Offline MINIX file system builder.
+ *
+ * This tool runs on the host. It formats a MINIX file system image with
+ * the same layout as minix_mkfs(), optionally populates its root
+ * directory with host files, and emits the image as a C source file
+ * that is linked into the VFS server, when NANVIX_VFS_IMAGE is enabled.
+ */
+
+/* Must come first. */
+#define __NEED_LIMITS_FS
+
+#include <nanvix/limits/fs.h>
+#include <nanvix/config.h>
+#include <fs/minix.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @name File Modes
+ *
+ * @details Same values as in <posix/sys/stat.h>.
+ */
+/**@{*/
+#define MKFS_IFREG 0100000 /**< Regular file.       */
+#define MKFS_IFBLK 0060000 /**< Block special file. */
+#define MKFS_IFDIR 0040000 /**< Directory.          */
+#define MKFS_MODE  0755    /**< Access permissions.  */
+/**@}*/
+
+/**
+ * @brief Default number of blocks.
+ */
+#define MKFS_NR_BLOCKS (NANVIX_DISK_SIZE/MINIX_BLOCK_SIZE)
+
+/**
+ * @brief Default number of inodes.
+ */
+#define MKFS_NR_INODES NANVIX_NR_INODES
+
+/**
+ * @brief Number of bits in a block.
+ */
+#define MKFS_BLOCK_BITS (8*MINIX_BLOCK_SIZE)
+
+/**
+ * @brief Rounds up a division.
+ */
+#define ROUND(x) (((x) == 0) ? 1 : (x))
+
+/**
+ * @brief Image being built.
+ */
+static struct
+{
+	unsigned char *data;       /**< Raw data.        */
+	size_t size;               /**< Size (in bytes). */
+	struct d_superblock super; /**< Superblock.      */
+	unsigned char *imap;       /**< Inode map.       */
+	unsigned char *bmap;       /**< Block map.       */
+} image;
+
+/*============================================================================*
+ * Helpers                                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Prints an error message and exits.
+ */
+static void die(const char *msg, const char *arg)
+{
+	fprintf(stderr, "mkfs: %s%s%s\n", msg, (arg != NULL) ? ": " : "", (arg != NULL) ? arg : "");
+	exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief Gets a pointer to a block of the image.
+ */
+static void *block_get(minix_block_t num)
+{
+	if ((size_t)(num + 1)*MINIX_BLOCK_SIZE > image.size)
+		die("block out of range", NULL);
+
+	return (&image.data[num*MINIX_BLOCK_SIZE]);
+}
+
+/**
+ * @brief Allocates a block of the image.
+ */
+static minix_block_t block_alloc(void)
+{
+	unsigned nbits;
+
+	nbits = image.super.s_bmap_nblocks*MKFS_BLOCK_BITS;
+
+	for (unsigned bit = 0; bit < nbits; bit++)
+	{
+		/* Used block. */
+		if (image.bmap[bit/8] & (1 << (bit%8)))
+			continue;
+
+		/* Past the end of the device. */
+		if ((size_t)(image.super.s_first_data_block + bit + 1)*MINIX_BLOCK_SIZE > image.size)
+			break;
+
+		image.bmap[bit/8] |= (1 << (bit%8));
+
+		return (image.super.s_first_data_block + bit);
+	}
+
+	die("file system full", NULL);
+
+	return (MINIX_BLOCK_NULL);
+}
+
+/**
+ * @brief Gets a pointer to an inode of the image.
+ */
+static struct d_inode *inode_get(minix_ino_t num)
+{
+	unsigned idx;
+	unsigned per_block;
+
+	num--;
+	per_block = MINIX_BLOCK_SIZE/sizeof(struct d_inode);
+	idx = 2 + image.super.s_imap_nblocks + image.super.s_bmap_nblocks + num/per_block;
+
+	return ((struct d_inode *)block_get(idx) + num%per_block);
+}
+
+/**
+ * @brief Allocates an inode of the image.
+ */
+static minix_ino_t inode_alloc(uint16_t mode)
+{
+	struct d_inode *ip;
+
+	for (unsigned bit = 0; bit < image.super.s_ninodes; bit++)
+	{
+		/* Used inode. */
+		if (image.imap[bit/8] & (1 << (bit%8)))
+			continue;
+
+		image.imap[bit/8] |= (1 << (bit%8));
+
+		ip = inode_get(bit + 1);
+		memset(ip, 0, sizeof(struct d_inode));
+		ip->i_mode = mode;
+		ip->i_nlinks = 1;
+
+		return (bit + 1);
+	}
+
+	die("out of inodes", NULL);
+
+	return (MINIX_INODE_NULL);
+}
+
+/**
+ * @brief Maps a logic block of an inode, allocating it if required.
+ */
+static minix_block_t inode_map(struct d_inode *ip, unsigned logic)
+{
+	minix_block_t *zone;
+
+	/* Direct zone. */
+	if (logic < MINIX_NR_ZONES_DIRECT)
+	{
+		if (ip->i_zones[logic] == MINIX_BLOCK_NULL)
+			ip->i_zones[logic] = block_alloc();
+		return (ip->i_zones[logic]);
+	}
+
+	logic -= MINIX_NR_ZONES_DIRECT;
+
+	/* Single indirect zone. */
+	if (logic < MINIX_NR_SINGLE)
+	{
+		if (ip->i_zones[MINIX_ZONE_SINGLE] == MINIX_BLOCK_NULL)
+			ip->i_zones[MINIX_ZONE_SINGLE] = block_alloc();
+		zone = block_get(ip->i_zones[MINIX_ZONE_SINGLE]);
+		if (zone[logic] == MINIX_BLOCK_NULL)
+			zone[logic] = block_alloc();
+		return (zone[logic]);
+	}
+
+	logic -= MINIX_NR_SINGLE;
+
+	/* Double indirect zone. */
+	if (logic < MINIX_NR_DOUBLE)
+	{
+		if (ip->i_zones[MINIX_ZONE_DOUBLE] == MINIX_BLOCK_NULL)
+			ip->i_zones[MINIX_ZONE_DOUBLE] = block_alloc();
+		zone = block_get(ip->i_zones[MINIX_ZONE_DOUBLE]);
+		if (zone[logic/MINIX_NR_SINGLE] == MINIX_BLOCK_NULL)
+			zone[logic/MINIX_NR_SINGLE] = block_alloc();
+		zone = block_get(zone[logic/MINIX_NR_SINGLE]);
+		if (zone[logic%MINIX_NR_SINGLE] == MINIX_BLOCK_NULL)
+			zone[logic%MINIX_NR_SINGLE] = block_alloc();
+		return (zone[logic%MINIX_NR_SINGLE]);
+	}
+
+	die("file too big", NULL);
+
+	return (MINIX_BLOCK_NULL);
+}
+
+/**
+ * @brief Appends data to an inode.
+ */
+static void inode_append(struct d_inode *ip, const void *buf, size_t n)
+{
+	size_t chunk;
+	const char *p = buf;
+
+	for (size_t i = 0; i < n; i += chunk)
+	{
+		unsigned off = ip->i_size%MINIX_BLOCK_SIZE;
+
+		chunk = MINIX_BLOCK_SIZE - off;
+		if (chunk > n - i)
+			chunk = n - i;
+
+		memcpy((char *)block_get(inode_map(ip, ip->i_size/MINIX_BLOCK_SIZE)) + off, &p[i], chunk);
+		ip->i_size += chunk;
+	}
+}
+
+/**
+ * @brief Adds an entry to a directory.
+ */
+static void dirent_add(minix_ino_t dir, const char *name, minix_ino_t num)
+{
+	struct d_dirent d;
+
+	if (strlen(name) > MINIX_NAME_MAX)
+		die("name too long", name);
+
+	memset(&d, 0, sizeof(struct d_dirent));
+	d.d_ino = num;
+	strncpy(d.d_name, name, MINIX_NAME_MAX);
+
+	inode_append(inode_get(dir), &d, sizeof(struct d_dirent));
+	inode_get(dir)->i_nlinks++;
+}
+
+/*============================================================================*
+ * Image Building                                                             *
+ *============================================================================*/
+
+/**
+ * @brief Formats the image.
+ */
+static void mkfs(unsigned nblocks, unsigned ninodes)
+{
+	minix_ino_t num;
+	unsigned inode_nblocks;
+
+	image.size = (size_t) nblocks*MINIX_BLOCK_SIZE;
+	if ((image.data = calloc(nblocks, MINIX_BLOCK_SIZE)) == NULL)
+		die("out of memory", NULL);
+
+	/* Same dimensions as minix_mkfs(). */
+	inode_nblocks = ROUND((ninodes*sizeof(struct d_inode))/MINIX_BLOCK_SIZE);
+	image.super.s_ninodes = ninodes;
+	image.super.s_nblocks = nblocks;
+	image.super.s_imap_nblocks = ROUND(ninodes/MKFS_BLOCK_BITS);
+	image.super.s_bmap_nblocks = ROUND(nblocks/MKFS_BLOCK_BITS);
+	image.super.s_first_data_block = 2 +
+		image.super.s_imap_nblocks +
+		image.super.s_bmap_nblocks +
+		inode_nblocks;
+	image.super.s_max_size = NANVIX_MAX_FILE_SIZE;
+	image.super.s_magic = MINIX_SUPER_MAGIC;
+
+	if ((size_t) image.super.s_first_data_block*MINIX_BLOCK_SIZE >= image.size)
+		die("device too small", NULL);
+
+	image.imap = block_get(2);
+	image.bmap = block_get(2 + image.super.s_imap_nblocks);
+
+	/* Root directory. */
+	if ((num = inode_alloc(MKFS_IFDIR | MKFS_MODE)) != MINIX_INODE_ROOT)
+		die("bad root inode", NULL);
+	dirent_add(MINIX_INODE_ROOT, ".", MINIX_INODE_ROOT);
+	dirent_add(MINIX_INODE_ROOT, "..", MINIX_INODE_ROOT);
+
+	/* Disk device. */
+	num = inode_alloc(MKFS_IFBLK | MKFS_MODE);
+	inode_get(num)->i_size = image.size;
+	dirent_add(MINIX_INODE_ROOT, "disk", num);
+}
+
+/**
+ * @brief Copies a host file into the root directory of the image.
+ */
+static void populate(const char *path)
+{
+	FILE *fp;
+	size_t n;
+	minix_ino_t num;
+	const char *name;
+	char buf[MINIX_BLOCK_SIZE];
+
+	name = ((name = strrchr(path, '/')) != NULL) ? name + 1 : path;
+
+	if ((fp = fopen(path, "rb")) == NULL)
+		die("cannot open", path);
+
+	num = inode_alloc(MKFS_IFREG | MKFS_MODE);
+	while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+		inode_append(inode_get(num), buf, n);
+	fclose(fp);
+
+	dirent_add(MINIX_INODE_ROOT, name, num);
+}
+
+/**
+ * @brief Emits the image as a C source file.
+ */
+static void emit(const char *path)
+{
+	FILE *fp;
+	size_t used;
+
+	/* Trailing zeros need not be stored, the RAM disk is cleared at boot. */
+	for (used = image.size; (used > 0) && (image.data[used - 1] == 0); used--)
+		/* noop */;
+
+	if ((fp = fopen(path, "w")) == NULL)
+		die("cannot create", path);
+
+	fprintf(fp, "/* Generated by the Nanvix mkfs tool. Do not edit. */\n\n");
+	fprintf(fp, "const unsigned long nanvix_ramdisk_image_size = %zu;\n\n", used);
+	fprintf(fp, "const unsigned char nanvix_ramdisk_image[%zu] = {", ROUND(used));
+	for (size_t i = 0; i < used; i++)
+		fprintf(fp, "%s0x%02x,", (i%12 == 0) ? "\n\t" : " ", image.data[i]);
+	fprintf(fp, "\n};\n");
+
+	fclose(fp);
+}
+
+/**
+ * @brief Writes the raw image to a host file.
+ */
+static void emit_raw(const char *path)
+{
+	FILE *fp;
+
+	if ((fp = fopen(path, "wb")) == NULL)
+		die("cannot create", path);
+
+	if (fwrite(image.data, 1, image.size, fp) != image.size)
+		die("cannot write", path);
+
+	fclose(fp);
+}
+
+/*============================================================================*
+ * main()                                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Builds a MINIX file system image.
+ */
+int main(int argc, char *const argv[])
+{
+	int opt;
+	const char *out = NULL;
+	const char *raw = NULL;
+	unsigned nblocks = MKFS_NR_BLOCKS;
+	unsigned ninodes = MKFS_NR_INODES;
+
+	while ((opt = getopt(argc, argv, "b:i:o:r:")) != -1)
+	{
+		switch (opt)
+		{
+			case 'b':
+				nblocks = strtoul(optarg, NULL, 0);
+				break;
+
+			case 'i':
+				ninodes = strtoul(optarg, NULL, 0);
+				break;
+
+			case 'o':
+				out = optarg;
+				break;
+
+			case 'r':
+				raw = optarg;
+				break;
+
+			default:
+				fprintf(stderr, "usage: %s [-b nblocks] [-i ninodes] [-r raw] -o image.c [file...]\n", argv[0]);
+				return (EXIT_FAILURE);
+		}
+	}
+
+	/* Bad dimensions. */
+	if ((nblocks == 0) || (nblocks > UINT16_MAX) || (ninodes == 0) || (ninodes > UINT16_MAX))
+		die("bad file system dimensions", NULL);
+
+	/* Nothing to emit. */
+	if ((out == NULL) && (raw == NULL))
+		die("missing output file", NULL);
+
+	mkfs(nblocks, ninodes);
+
+	for (int i = optind; i < argc; i++)
+		populate(argv[i]);
+
+	memcpy(block_get(1), &image.super, sizeof(struct d_superblock));
+
+	if (out != NULL)
+		emit(out);
+	if (raw != NULL)
+		emit_raw(raw);
+
+	free(image.data);
+
+	return (EXIT_SUCCESS);
+}
@@ -117,6 +117,335 @@ static void test_api_nanvix_vfs_read_write(void)
 	uassert(nanvix_vfs_close(fd) == 0);
 }
 
+/*============================================================================*
+ * Positional Read/Write                                                      *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Positional Read/Write from/to a File
+ */
+static void test_api_nanvix_vfs_pread_pwrite(void)
+{
+	int fd;
+	const char *filename = "disk";
+
+	uassert((fd = nanvix_vfs_open(filename, O_RDWR)) >= 0);
+
+		/* Write */
+		umemset(data, 2, NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_pwrite(fd, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_seek(fd, 0, SEEK_CUR) == 0);
+
+		/* Read. */
+		umemset(data, 0, NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_pread(fd, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_seek(fd, 0, SEEK_CUR) == 0);
+
+		/* Checksum. */
+		for (size_t i = 0; i < sizeof(data); i++)
+			uassert(data[i] == 2);
+
+	uassert(nanvix_vfs_close(fd) == 0);
+}
+
+/*============================================================================*
+ * Vectored Read/Write                                                        *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Vectored Read/Write from/to a File
+ */
+static void test_api_nanvix_vfs_readv_writev(void)
+{
+	int fd;
+	const char *filename = "disk";
+	struct nanvix_iovec iov[3];
+
+	iov[0].iov_base = &data[0];
+	iov[0].iov_len = 16;
+	iov[1].iov_base = &data[16];
+	iov[1].iov_len = 0;
+	iov[2].iov_base = &data[16];
+	iov[2].iov_len = NANVIX_FS_BLOCK_SIZE - 16;
+
+	uassert((fd = nanvix_vfs_open(filename, O_RDWR)) >= 0);
+
+		/* Write */
+		for (size_t i = 0; i < sizeof(data); i++)
+			data[i] = (char) i;
+		uassert(nanvix_vfs_seek(fd, TEST_FILE_OFFSET, SEEK_SET) >= 0);
+		uassert(nanvix_vfs_writev(fd, iov, 3) == NANVIX_FS_BLOCK_SIZE);
+
+		/* Read. */
+		umemset(data, 0, NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_seek(fd, TEST_FILE_OFFSET, SEEK_SET) >= 0);
+		uassert(nanvix_vfs_readv(fd, iov, 3) == NANVIX_FS_BLOCK_SIZE);
+
+		/* Checksum. */
+		for (size_t i = 0; i < sizeof(data); i++)
+			uassert(data[i] == (char) i);
+
+	uassert(nanvix_vfs_close(fd) == 0);
+}
+
+/*============================================================================*
+ * Copy Range                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Copy Data Between Files
+ */
+static void test_api_nanvix_vfs_copy_range(void)
+{
+	int fd1, fd2;
+	const char *filename = "disk";
+
+	uassert((fd1 = nanvix_vfs_open(filename, O_RDONLY)) >= 0);
+	uassert((fd2 = nanvix_vfs_open(filename, O_RDWR)) >= 0);
+
+		/* Write */
+		umemset(data, 3, NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_pwrite(fd2, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+
+		/* Copy. */
+		uassert(nanvix_vfs_seek(fd2, TEST_FILE_OFFSET + NANVIX_FS_BLOCK_SIZE, SEEK_SET) >= 0);
+		uassert(nanvix_vfs_copy_range(fd1, TEST_FILE_OFFSET, fd2, -1, NANVIX_FS_BLOCK_SIZE) == NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_seek(fd2, 0, SEEK_CUR) == TEST_FILE_OFFSET + 2*NANVIX_FS_BLOCK_SIZE);
+
+		/* Read. */
+		umemset(data, 0, NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_pread(fd2, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET + NANVIX_FS_BLOCK_SIZE) == NANVIX_FS_BLOCK_SIZE);
+
+		/* Checksum. */
+		for (size_t i = 0; i < sizeof(data); i++)
+			uassert(data[i] == 3);
+
+	uassert(nanvix_vfs_close(fd2) == 0);
+	uassert(nanvix_vfs_close(fd1) == 0);
+}
+
+/*============================================================================*
+ * Compound Requests                                                          *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Open/Stat Several Files at Once
+ */
+static void test_api_nanvix_vfs_multi(void)
+{
+	int fds[3];
+	int status[3];
+	struct vfs_stat st[3];
+	const char *filenames[3] = { "disk", "missing", "disk" };
+
+	uassert(nanvix_vfs_stat_multi(filenames, st, status, 3) == 0);
+	uassert((status[0] == 0) && (status[2] == 0));
+	uassert(status[1] == -ENOENT);
+	uassert(st[0].ino == st[2].ino);
+
+	uassert(nanvix_vfs_open_multi(filenames, O_RDONLY, fds, 3) == 0);
+	uassert((fds[0] >= 0) && (fds[2] >= 0) && (fds[0] != fds[2]));
+	uassert(fds[1] == -ENOENT);
+
+	uassert(nanvix_vfs_read(fds[0], data, NANVIX_FS_BLOCK_SIZE) == NANVIX_FS_BLOCK_SIZE);
+
+	uassert(nanvix_vfs_close(fds[2]) == 0);
+	uassert(nanvix_vfs_close(fds[0]) == 0);
+}
+
+/*============================================================================*
+ * Directory Listing                                                          *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Get Entries of a Directory
+ */
+static void test_api_nanvix_vfs_getdents(void)
+{
+	int fd;
+	int n;
+	int nentries = 0;
+	struct vfs_dirent dirents[8];
+
+	uassert((fd = nanvix_vfs_open(".", O_RDONLY)) >= 0);
+
+		while ((n = nanvix_vfs_getdents(fd, dirents, 8)) > 0)
+			nentries += n;
+
+		/* At least ".", ".." and "disk". */
+		uassert(n == 0);
+		uassert(nentries >= 3);
+
+	uassert(nanvix_vfs_close(fd) == 0);
+}
+
+/*============================================================================*
+ * Leases                                                                     *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Re-read Cached Data
+ */
+static void test_api_nanvix_vfs_lease_read(void)
+{
+	int fd;
+	struct vfs_cache_stats before, after;
+
+	uassert((fd = nanvix_vfs_open("disk", O_RDONLY)) >= 0);
+
+		uassert(nanvix_vfs_pread(fd, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+
+		/* Sole reader re-reads from the cache. */
+		uassert(nanvix_vfs_stats(&before) == 0);
+		uassert(nanvix_vfs_pread(fd, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_stats(&after) == 0);
+		uassert(after.nhits > before.nhits);
+		uassert(after.nmisses == before.nmisses);
+
+	uassert(nanvix_vfs_close(fd) == 0);
+}
+
+/**
+ * @brief API Test: No Lease Under Write Sharing
+ */
+static void test_api_nanvix_vfs_lease_shared(void)
+{
+	int fd1, fd2;
+	struct vfs_cache_stats before, after;
+
+	uassert((fd1 = nanvix_vfs_open("disk", O_RDONLY)) >= 0);
+	uassert((fd2 = nanvix_vfs_open("disk", O_RDWR)) >= 0);
+
+		/* Reads go to the server. */
+		uassert(nanvix_vfs_stats(&before) == 0);
+		uassert(nanvix_vfs_pread(fd1, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_pread(fd1, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_stats(&after) == 0);
+		uassert(after.nhits == before.nhits);
+
+	uassert(nanvix_vfs_close(fd2) == 0);
+	uassert(nanvix_vfs_close(fd1) == 0);
+}
+
+/**
+ * @brief API Test: Write-Behind
+ */
+static void test_api_nanvix_vfs_lease_write(void)
+{
+	int fd;
+	struct vfs_cache_stats before, after;
+
+	uassert((fd = nanvix_vfs_open("disk", O_RDWR)) >= 0);
+
+		/* Sole writer defers writes. */
+		umemset(data, 6, NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_stats(&before) == 0);
+		uassert(nanvix_vfs_pwrite(fd, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_stats(&after) == 0);
+		uassert(after.nflushes == before.nflushes);
+
+		/* Deferred writes are written back on fsync. */
+		uassert(nanvix_vfs_fsync(fd) == 0);
+		uassert(nanvix_vfs_stats(&after) == 0);
+		uassert(after.nflushes == (before.nflushes + 1));
+
+		/* And on close. */
+		umemset(data, 7, NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_pwrite(fd, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+
+	uassert(nanvix_vfs_close(fd) == 0);
+	uassert(nanvix_vfs_stats(&after) == 0);
+	uassert(after.nflushes == (before.nflushes + 2));
+
+	uassert((fd = nanvix_vfs_open("disk", O_RDONLY)) >= 0);
+
+		umemset(data, 0, NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_pread(fd, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+		for (size_t i = 0; i < sizeof(data); i++)
+			uassert(data[i] == 7);
+
+	uassert(nanvix_vfs_close(fd) == 0);
+}
+
+/**
+ * @brief API Test: Recall Stale Leases
+ */
+static void test_api_nanvix_vfs_lease_recall(void)
+{
+	int fd1, fd2;
+	struct vfs_cache_stats before, after;
+
+	uassert((fd1 = nanvix_vfs_open("disk", O_RDWR)) >= 0);
+
+		/* Cache dirty data. */
+		umemset(data, 8, NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_pwrite(fd1, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+
+		/* Conflicting open recalls the lease. */
+		uassert(nanvix_vfs_stats(&before) == 0);
+		uassert((fd2 = nanvix_vfs_open("disk", O_RDWR)) >= 0);
+		uassert(nanvix_vfs_stats(&after) == 0);
+		uassert(after.nrecalls > before.nrecalls);
+		uassert(after.nflushes > before.nflushes);
+
+		/* Recalled data was written back. */
+		umemset(data, 0, NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_pread(fd2, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+		for (size_t i = 0; i < sizeof(data); i++)
+			uassert(data[i] == 8);
+
+		/* Recalled reader sees new data. */
+		umemset(data, 9, NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_pwrite(fd2, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+		umemset(data, 0, NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_pread(fd1, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+		for (size_t i = 0; i < sizeof(data); i++)
+			uassert(data[i] == 9);
+
+	uassert(nanvix_vfs_close(fd2) == 0);
+	uassert(nanvix_vfs_close(fd1) == 0);
+}
+
+/*============================================================================*
+ * Mount Table                                                                *
+ *============================================================================*/
+
+#if (VFS_SERVERS_NUM > 1)
+
+/**
+ * @brief API Test: Route Files to Servers
+ */
+static void test_api_nanvix_vfs_mount(void)
+{
+	int fd0, fd1;
+
+	uassert((fd0 = nanvix_vfs_open("disk", O_RDWR)) >= 0);
+	uassert((fd1 = nanvix_vfs_open("/vfs1/disk", O_RDWR)) >= 0);
+	uassert(fd0 != fd1);
+
+		/* Each server owns its own device. */
+		umemset(data, 4, NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_pwrite(fd0, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+		umemset(data, 5, NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_pwrite(fd1, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+
+		uassert(nanvix_vfs_pread(fd0, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+		for (size_t i = 0; i < sizeof(data); i++)
+			uassert(data[i] == 4);
+
+		uassert(nanvix_vfs_pread(fd1, data, NANVIX_FS_BLOCK_SIZE, TEST_FILE_OFFSET) == NANVIX_FS_BLOCK_SIZE);
+		for (size_t i = 0; i < sizeof(data); i++)
+			uassert(data[i] == 5);
+
+		/* Data does not cross servers. */
+		uassert(nanvix_vfs_copy_range(fd0, TEST_FILE_OFFSET, fd1, TEST_FILE_OFFSET, NANVIX_FS_BLOCK_SIZE) == -EXDEV);
+
+	uassert(nanvix_vfs_close(fd1) == 0);
+	uassert(nanvix_vfs_close(fd0) == 0);
+}
+
+#endif
+
 /*============================================================================*
  * API Tests                                                                  *
  *============================================================================*/
@@ -125,10 +454,22 @@ static void test_api_nanvix_vfs_read_write(void)
  * @brief Virtual File System Tests
  */
 struct test tests_vfs_api[] = {
-	{ test_api_nanvix_vfs_open_close, "[vfs][api] open/close" },
-	{ test_api_nanvix_vfs_seek,       "[vfs][api] seek      " },
-	{ test_api_nanvix_vfs_read_write, "[vfs][api] read/write" },
-	{ NULL,                            NULL                   },
+	{ test_api_nanvix_vfs_open_close,   "[vfs][api] open/close  " },
+	{ test_api_nanvix_vfs_seek,         "[vfs][api] seek        " },
+	{ test_api_nanvix_vfs_read_write,   "[vfs][api] read/write  " },
+	{ test_api_nanvix_vfs_pread_pwrite, "[vfs][api] pread/pwrite" },
+	{ test_api_nanvix_vfs_readv_writev, "[vfs][api] readv/writev" },
+	{ test_api_nanvix_vfs_copy_range,   "[vfs][api] copy range  " },
+	{ test_api_nanvix_vfs_multi,        "[vfs][api] multi       " },
+	{ test_api_nanvix_vfs_getdents,     "[vfs][api] getdents    " },
+	{ test_api_nanvix_vfs_lease_read,   "[vfs][api] lease read  " },
+	{ test_api_nanvix_vfs_lease_shared, "[vfs][api] lease shared" },
+	{ test_api_nanvix_vfs_lease_write,  "[vfs][api] lease write " },
+	{ test_api_nanvix_vfs_lease_recall, "[vfs][api] lease recall" },
+#if (VFS_SERVERS_NUM > 1)
+	{ test_api_nanvix_vfs_mount,        "[vfs][api] mount table " },
+#endif
+	{ NULL,                              NULL                     },
 };
 
 #endif
@@ -196,6 +196,52 @@ static void test_fault_nanvix_vfs_write_bad(void)
 	uassert(nanvix_vfs_close(fd) == 0);
 }
 
+/*============================================================================*
+ * Compound Requests                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Fault Injection Test: Invalid Compound Requests
+ */
+static void test_fault_nanvix_vfs_multi_invalid(void)
+{
+	int fds[1];
+	int status[1];
+	struct vfs_stat st[1];
+	const char *filenames[1] = { "disk" };
+
+	uassert(nanvix_vfs_open_multi(NULL, O_RDONLY, fds, 1) == -EINVAL);
+	uassert(nanvix_vfs_open_multi(filenames, O_RDONLY, NULL, 1) == -EINVAL);
+	uassert(nanvix_vfs_open_multi(filenames, O_RDONLY, fds, -1) == -EINVAL);
+	uassert(nanvix_vfs_stat_multi(NULL, st, status, 1) == -EINVAL);
+	uassert(nanvix_vfs_stat_multi(filenames, st, status, -1) == -EINVAL);
+}
+
+/*============================================================================*
+ * Get Directory Entries                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Fault Injection Test: Invalid Get Directory Entries
+ */
+static void test_fault_nanvix_vfs_getdents_invalid(void)
+{
+	int fd;
+	struct vfs_dirent dirp[1];
+
+	uassert((fd = nanvix_vfs_open(".", O_RDONLY)) >= 0);
+
+		uassert(nanvix_vfs_getdents(-1, dirp, 1) == -EINVAL);
+		uassert(nanvix_vfs_getdents(fd, NULL, 1) == -EINVAL);
+		uassert(nanvix_vfs_getdents(fd, dirp, 0) == -EINVAL);
+		uassert(nanvix_vfs_getdents(fd, dirp, -1) == -EINVAL);
+
+		/* Server is still in sync. */
+		uassert(nanvix_vfs_getdents(fd, dirp, 1) >= 0);
+
+	uassert(nanvix_vfs_close(fd) == 0);
+}
+
 /*============================================================================*
  * Fault Injection Tests                                                      *
  *============================================================================*/
@@ -204,17 +250,19 @@ static void test_fault_nanvix_vfs_write_bad(void)
  * @brief Virtual File System Tests
  */
 struct test tests_vfs_fault[] = {
-	{ test_fault_nanvix_vfs_open_invalid,  "[vfs][fault] invalid open  " },
-	{ test_fault_nanvix_vfs_open_bad,      "[vfs][fault] bad open      " },
-	{ test_fault_nanvix_vfs_close_invalid, "[vfs][fault] invalid close " },
-	{ test_fault_nanvix_vfs_close_bad,     "[vfs][fault] bad close     " },
-	{ test_fault_nanvix_vfs_seek_invalid,  "[vfs][fault] invalid seek  " },
-	{ test_fault_nanvix_vfs_seek_bad,      "[vfs][fault] bad seek      " },
-	{ test_fault_nanvix_vfs_read_invalid,  "[vfs][fault] invalid read  " },
-	{ test_fault_nanvix_vfs_read_bad,      "[vfs][fault] bad read      " },
-	{ test_fault_nanvix_vfs_write_invalid, "[vfs][fault] invalid write " },
-	{ test_fault_nanvix_vfs_write_bad,     "[vfs][fault] bad write     " },
-	{ NULL,                                 NULL                         },
+	{ test_fault_nanvix_vfs_open_invalid,     "[vfs][fault] invalid open    " },
+	{ test_fault_nanvix_vfs_open_bad,         "[vfs][fault] bad open        " },
+	{ test_fault_nanvix_vfs_close_invalid,    "[vfs][fault] invalid close   " },
+	{ test_fault_nanvix_vfs_close_bad,        "[vfs][fault] bad close       " },
+	{ test_fault_nanvix_vfs_seek_invalid,     "[vfs][fault] invalid seek    " },
+	{ test_fault_nanvix_vfs_seek_bad,         "[vfs][fault] bad seek        " },
+	{ test_fault_nanvix_vfs_read_invalid,     "[vfs][fault] invalid read    " },
+	{ test_fault_nanvix_vfs_read_bad,         "[vfs][fault] bad read        " },
+	{ test_fault_nanvix_vfs_write_invalid,    "[vfs][fault] invalid write   " },
+	{ test_fault_nanvix_vfs_write_bad,        "[vfs][fault] bad write       " },
+	{ test_fault_nanvix_vfs_multi_invalid,    "[vfs][fault] invalid multi   " },
+	{ test_fault_nanvix_vfs_getdents_invalid, "[vfs][fault] invalid getdents" },
+	{ NULL,                                    NULL                            },
 };
 
 #endif
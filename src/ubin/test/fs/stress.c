@@ -61,25 +61,89 @@ static void test_stress_nanvix_vfs_open_close(void)
 	int fd;
 	const char *filename = "disk";
 
-	for (int i = 0; i < NANVIX_OPEN_MAX; i++)
+	for (int i = 0; i < NANVIX_VFS_OPEN_MAX; i++)
 	{
 		uassert((fd = nanvix_vfs_open(filename, O_RDONLY)) >= 0);
 		uassert(nanvix_vfs_close(fd) == 0);
 	}
 
-	for (int i = 0; i < NANVIX_OPEN_MAX; i++)
+	for (int i = 0; i < NANVIX_VFS_OPEN_MAX; i++)
 	{
 		uassert((fd = nanvix_vfs_open(filename, O_WRONLY)) >= 0);
 		uassert(nanvix_vfs_close(fd) == 0);
 	}
 
-	for (int i = 0; i < NANVIX_OPEN_MAX; i++)
+	for (int i = 0; i < NANVIX_VFS_OPEN_MAX; i++)
 	{
 		uassert((fd = nanvix_vfs_open(filename, O_RDWR)) >= 0);
 		uassert(nanvix_vfs_close(fd) == 0);
 	}
 }
 
+/*============================================================================*
+ * Open/Close Churn                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Number of Files Kept Opened During Churn
+ */
+#define TEST_CHURN_NFILES (NANVIX_VFS_OPEN_MAX/2)
+
+/**
+ * @brief Stress Test: Open/Close Files While Many Are Opened
+ *
+ * Files are closed and reopened at random while the table of file
+ * descriptors is kept half full, so that the cost of allocating a file
+ * descriptor may be compared with the one of an empty table.
+ */
+static void test_stress_nanvix_vfs_open_close_churn(void)
+{
+	int i;
+	unsigned seed;
+	uint64_t t0, t1;
+	uint64_t tempty, tchurn;
+	static int fds[TEST_CHURN_NFILES];
+	const char *filename = "disk";
+
+	/* Empty table. */
+	kclock(&t0);
+	for (i = 0; i < TEST_NITERATIONS; i++)
+	{
+		uassert((fds[0] = nanvix_vfs_open(filename, O_RDONLY)) >= 0);
+		uassert(nanvix_vfs_close(fds[0]) == 0);
+	}
+	kclock(&t1);
+	tempty = t1 - t0;
+
+	for (i = 0; i < TEST_CHURN_NFILES; i++)
+		uassert((fds[i] = nanvix_vfs_open(filename, O_RDONLY)) >= 0);
+
+	/* Half-full table. */
+	seed = 13;
+	kclock(&t0);
+	for (i = 0; i < TEST_NITERATIONS; i++)
+	{
+		int j;
+
+		seed = seed*1103515245 + 12345;
+		j = (seed >> 16) % TEST_CHURN_NFILES;
+
+		uassert(nanvix_vfs_close(fds[j]) == 0);
+		uassert((fds[j] = nanvix_vfs_open(filename, O_RDONLY)) >= 0);
+	}
+	kclock(&t1);
+	tchurn = t1 - t0;
+
+	for (i = 0; i < TEST_CHURN_NFILES; i++)
+		uassert(nanvix_vfs_close(fds[i]) == 0);
+
+	uprintf("[vfs][stress] open/close churn: empty %d, %d opened %d cycles",
+		(int) (tempty/TEST_NITERATIONS),
+		TEST_CHURN_NFILES,
+		(int) (tchurn/TEST_NITERATIONS)
+	);
+}
+
 /*============================================================================*
  * Seek                                                                       *
  *============================================================================*/
@@ -138,6 +202,125 @@ static void test_stress_nanvix_vfs_read_write(void)
 	uassert(nanvix_vfs_close(fd) == 0);
 }
 
+/*============================================================================*
+ * Random Read                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Number of Blocks Spanned by Random Reads
+ */
+#define TEST_RANDOM_NBLOCKS 32
+
+/**
+ * @brief Stress Test: Random Block Reads from a File
+ *
+ * Reads with seek() followed by read() are compared against pread().
+ */
+static void test_stress_nanvix_vfs_read_random(void)
+{
+	int fd;
+	off_t off;
+	unsigned seed;
+	uint64_t t0, t1;
+	uint64_t tseek, tpread;
+	const char *filename = "disk";
+
+	uassert((fd = nanvix_vfs_open(filename, O_RDONLY)) >= 0);
+
+	/* Seek and read. */
+	seed = 13;
+	kclock(&t0);
+	for (int i = 0; i < TEST_NITERATIONS; i++)
+	{
+		seed = seed*1103515245 + 12345;
+		off = (off_t) ((seed >> 16) % TEST_RANDOM_NBLOCKS)*NANVIX_FS_BLOCK_SIZE;
+		uassert(nanvix_vfs_seek(fd, off, SEEK_SET) == off);
+		uassert(nanvix_vfs_read(fd, data, NANVIX_FS_BLOCK_SIZE) == NANVIX_FS_BLOCK_SIZE);
+	}
+	kclock(&t1);
+	tseek = t1 - t0;
+
+	/* Positional read. */
+	seed = 13;
+	kclock(&t0);
+	for (int i = 0; i < TEST_NITERATIONS; i++)
+	{
+		seed = seed*1103515245 + 12345;
+		off = (off_t) ((seed >> 16) % TEST_RANDOM_NBLOCKS)*NANVIX_FS_BLOCK_SIZE;
+		uassert(nanvix_vfs_pread(fd, data, NANVIX_FS_BLOCK_SIZE, off) == NANVIX_FS_BLOCK_SIZE);
+	}
+	kclock(&t1);
+	tpread = t1 - t0;
+
+	uassert(nanvix_vfs_close(fd) == 0);
+
+	uprintf("[vfs][stress] random read: seek+read %d, pread %d cycles",
+		(int) (tseek/TEST_NITERATIONS),
+		(int) (tpread/TEST_NITERATIONS)
+	);
+}
+
+/*============================================================================*
+ * Copy Range                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Number of Blocks Copied
+ */
+#define TEST_COPY_NBLOCKS 16
+
+/**
+ * @brief Stress Test: Copy Data Between Files
+ *
+ * Copies through the client with read() and write() are compared
+ * against server-side copies with copy_range().
+ */
+static void test_stress_nanvix_vfs_copy_range(void)
+{
+	int fd;
+	off_t src, dest;
+	uint64_t t0, t1;
+	uint64_t tclient, tserver;
+	const char *filename = "disk";
+
+	src = TEST_FILE_OFFSET;
+	dest = TEST_FILE_OFFSET + TEST_COPY_NBLOCKS*NANVIX_FS_BLOCK_SIZE;
+
+	uassert((fd = nanvix_vfs_open(filename, O_RDWR)) >= 0);
+
+	/* Copy through client. */
+	kclock(&t0);
+	for (int i = 0; i < TEST_COPY_NBLOCKS; i++)
+	{
+		uassert(nanvix_vfs_pread(fd, data, NANVIX_FS_BLOCK_SIZE, src + i*NANVIX_FS_BLOCK_SIZE) == NANVIX_FS_BLOCK_SIZE);
+		uassert(nanvix_vfs_pwrite(fd, data, NANVIX_FS_BLOCK_SIZE, dest + i*NANVIX_FS_BLOCK_SIZE) == NANVIX_FS_BLOCK_SIZE);
+	}
+	uassert(nanvix_vfs_seek(fd, 0, SEEK_CUR) >= 0); /* Flush deferred writes. */
+	kclock(&t1);
+	tclient = t1 - t0;
+
+	/* Copy in server. */
+	kclock(&t0);
+	uassert(
+		nanvix_vfs_copy_range(
+			fd,
+			src,
+			fd,
+			dest,
+			TEST_COPY_NBLOCKS*NANVIX_FS_BLOCK_SIZE
+		) == TEST_COPY_NBLOCKS*NANVIX_FS_BLOCK_SIZE
+	);
+	kclock(&t1);
+	tserver = t1 - t0;
+
+	uassert(nanvix_vfs_close(fd) == 0);
+
+	uprintf("[vfs][stress] copy: read+write %d, copy range %d cycles",
+		(int) tclient,
+		(int) tserver
+	);
+}
+
 /*============================================================================*
  * Stress Tests                                                               *
  *============================================================================*/
@@ -146,10 +329,13 @@ static void test_stress_nanvix_vfs_read_write(void)
  * @brief Virtual File System Tests
  */
 struct test tests_vfs_stress[] = {
-	{ test_stress_nanvix_vfs_open_close, "[vfs][stress] open/close" },
-	{ test_stress_nanvix_vfs_seek,       "[vfs][stress] seek      " },
-	{ test_stress_nanvix_vfs_read_write, "[vfs][stress] read/write" },
-	{ NULL,                            NULL                   },
+	{ test_stress_nanvix_vfs_open_close,       "[vfs][stress] open/close      " },
+	{ test_stress_nanvix_vfs_open_close_churn, "[vfs][stress] open/close churn" },
+	{ test_stress_nanvix_vfs_seek,             "[vfs][stress] seek            " },
+	{ test_stress_nanvix_vfs_read_write,       "[vfs][stress] read/write      " },
+	{ test_stress_nanvix_vfs_read_random,      "[vfs][stress] random read     " },
+	{ test_stress_nanvix_vfs_copy_range,       "[vfs][stress] copy range      " },
+	{ NULL,                                     NULL                           },
 };
 
 #endif
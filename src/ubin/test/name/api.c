@@ -27,7 +27,9 @@
 #define __NEED_NAME_SERVICE
 
 #include <nanvix/runtime/pm/name.h>
+#include <nanvix/runtime/pm.h>
 #include <nanvix/sys/noc.h>
+#include <nanvix/config.h>
 #include <nanvix/limits.h>
 #include <nanvix/ulib.h>
 #include "../test.h"
@@ -93,10 +95,152 @@ static void test_name_lookup(void)
 	TEST_ASSERT(nanvix_name_unlink(pathname) == 0);
 }
 
+/*============================================================================*
+ * API Test: Cached Lookup                                                    *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Cached Lookup
+ */
+static void test_name_lookup_cached(void)
+{
+	int nodenum;
+	char pathname[NANVIX_PROC_NAME_MAX];
+
+	nodenum = knode_get_num();
+
+	ustrcpy(pathname, "cool-name");
+	TEST_ASSERT(nanvix_name_lookup(pathname) < 0);
+	TEST_ASSERT(nanvix_name_link(nodenum, pathname) == 0);
+	TEST_ASSERT(nanvix_name_lookup(pathname) == nodenum);
+	TEST_ASSERT(nanvix_name_lookup(pathname) == nodenum);
+	TEST_ASSERT(nanvix_name_invalidate(pathname) == 0);
+	TEST_ASSERT(nanvix_name_lookup(pathname) == nodenum);
+	TEST_ASSERT(nanvix_name_unlink(pathname) == 0);
+	TEST_ASSERT(nanvix_name_lookup(pathname) < 0);
+}
+
+/*============================================================================*
+ * API Test: Lookup After Update                                              *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Lookup After Update
+ *
+ * Lookups may be answered by a replica of the name server, thus they
+ * should see updates made through the primary server right away.
+ */
+static void test_name_lookup_update(void)
+{
+	int nodenum;
+	char pathname[NANVIX_PROC_NAME_MAX];
+
+	nodenum = knode_get_num();
+
+	ustrcpy(pathname, "cool-name");
+	for (int i = 0; i < 4; i++)
+	{
+		TEST_ASSERT(nanvix_name_link(nodenum, pathname) == 0);
+		TEST_ASSERT(nanvix_name_lookup(pathname) == nodenum);
+		TEST_ASSERT(nanvix_name_unlink(pathname) == 0);
+		TEST_ASSERT(nanvix_name_lookup(pathname) < 0);
+	}
+}
+
+/*============================================================================*
+ * API Test: Batched Lookup                                                   *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Batched Lookup
+ */
+static void test_name_lookup_multi(void)
+{
+	int nodenum;
+	int nodenums[3];
+	const char *names[3] = { "cool-name0", "cool-name1", "missing-name" };
+
+	nodenum = knode_get_num();
+
+	TEST_ASSERT(nanvix_name_link(nodenum, names[0]) == 0);
+	TEST_ASSERT(nanvix_name_link(nodenum, names[1]) == 0);
+	TEST_ASSERT(nanvix_name_invalidate(NULL) == 0);
+
+	TEST_ASSERT(nanvix_name_lookup_multi(names, nodenums, 3) == 0);
+	TEST_ASSERT(nodenums[0] == nodenum);
+	TEST_ASSERT(nodenums[1] == nodenum);
+	TEST_ASSERT(nodenums[2] < 0);
+
+	TEST_ASSERT(nanvix_name_unlink(names[1]) == 0);
+	TEST_ASSERT(nanvix_name_unlink(names[0]) == 0);
+}
+
+/*============================================================================*
+ * API Test: List                                                             *
+ *============================================================================*/
+
+/**
+ * @brief API Test: List
+ */
+static void test_name_list(void)
+{
+	int nodenum;
+	int nnames;
+	char pathname[NANVIX_PROC_NAME_MAX];
+	static char names[NANVIX_PNAME_MAX][NANVIX_PROC_NAME_MAX];
+
+	nodenum = knode_get_num();
+
+	for (int i = 0; i < 4; i++)
+	{
+		usprintf(pathname, "cool-name%d", i);
+		TEST_ASSERT(nanvix_name_link(nodenum, pathname) == 0);
+	}
+
+	TEST_ASSERT((nnames = nanvix_name_list("cool-", names, NANVIX_PNAME_MAX)) == 4);
+	for (int i = 0; i < nnames; i++)
+		TEST_ASSERT(ustrncmp(names[i], "cool-name", 9) == 0);
+
+	/* Everything. */
+	TEST_ASSERT(nanvix_name_list("", names, NANVIX_PNAME_MAX) > 4);
+
+	for (int i = 0; i < 4; i++)
+	{
+		usprintf(pathname, "cool-name%d", i);
+		TEST_ASSERT(nanvix_name_unlink(pathname) == 0);
+	}
+
+	TEST_ASSERT(nanvix_name_list("cool-", names, NANVIX_PNAME_MAX) == 0);
+}
+
 /*============================================================================*
  * API Test: Heartbeat                                                        *
  *============================================================================*/
 
+/**
+ * @brief Stops the heartbeat clock of the process name.
+ *
+ * Heartbeats refresh every name that is linked through the same port,
+ * including the name of the process itself. Once the tests send a
+ * heartbeat, the process name would expire as well, thus it is linked
+ * again, which drops its heartbeat timestamp.
+ */
+static void test_name_pname_reset(void)
+{
+	const char *pname;
+
+	pname = nanvix_getpname();
+
+	/* Unnamed process. */
+	if (pname[0] == '\0')
+		return;
+
+	/* The process name may have expired already. */
+	nanvix_name_unlink(pname);
+
+	TEST_ASSERT(nanvix_name_link(knode_get_num(), pname) == 0);
+}
+
 /**
  * @brief API Test: Lookup
  */
@@ -111,6 +255,64 @@ static void test_name_heartbeat(void)
 	TEST_ASSERT(nanvix_name_link(nodenum, pathname) == 0);
 	TEST_ASSERT(nanvix_name_heartbeat() == 0);
 	TEST_ASSERT(nanvix_name_unlink(pathname) == 0);
+
+	test_name_pname_reset();
+}
+
+/*============================================================================*
+ * API Test: Alive                                                            *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Alive
+ */
+static void test_name_alive(void)
+{
+	int nodenum;
+	char pathname[NANVIX_PROC_NAME_MAX];
+
+	nodenum = knode_get_num();
+
+	ustrcpy(pathname, "cool-name");
+	TEST_ASSERT(nanvix_name_link(nodenum, pathname) == 0);
+	TEST_ASSERT(nanvix_name_alive(pathname) == 0);
+	TEST_ASSERT(nanvix_name_unlink(pathname) == 0);
+	TEST_ASSERT(nanvix_name_alive(pathname) < 0);
+}
+
+/*============================================================================*
+ * API Test: Expire                                                           *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Expire
+ */
+static void test_name_expire(void)
+{
+	int nodenum;
+	uint64_t t0, t1;
+	char pathname[NANVIX_PROC_NAME_MAX];
+
+	nodenum = knode_get_num();
+
+	ustrcpy(pathname, "cool-name");
+	TEST_ASSERT(nanvix_name_link(nodenum, pathname) == 0);
+	TEST_ASSERT(nanvix_name_heartbeat() == 0);
+	TEST_ASSERT(nanvix_name_alive(pathname) == 0);
+
+	/* Stop sending heartbeats. */
+	kclock(&t0);
+	do
+		kclock(&t1);
+	while ((t1 - t0) <= (NANVIX_NAME_HEARTBEAT_TIMEOUT + NANVIX_NAME_SWEEP_INTERVAL));
+
+	/* Any request to the primary server triggers a sweep. */
+	TEST_ASSERT(nanvix_name_link(nodenum, "other-name") == 0);
+	TEST_ASSERT(nanvix_name_alive(pathname) < 0);
+	TEST_ASSERT(nanvix_name_unlink(pathname) < 0);
+	TEST_ASSERT(nanvix_name_unlink("other-name") == 0);
+
+	test_name_pname_reset();
 }
 
 /*============================================================================*
@@ -121,9 +323,15 @@ static void test_name_heartbeat(void)
  * @brief Unit tests.
  */
 struct test tests_name_api[] = {
-	{ test_name_link_unlink, "link unlink"    },
-	{ test_name_double_link, "double link"    },
-	{ test_name_lookup,      "lookup"         },
-	{ test_name_heartbeat,   "heartbeat"      },
-	{ NULL,                   NULL            }
+	{ test_name_link_unlink,   "link unlink"         },
+	{ test_name_double_link,   "double link"         },
+	{ test_name_lookup,        "lookup"              },
+	{ test_name_lookup_cached, "cached lookup"       },
+	{ test_name_lookup_update, "lookup after update" },
+	{ test_name_lookup_multi,  "batched lookup"      },
+	{ test_name_list,          "list"                },
+	{ test_name_heartbeat,     "heartbeat"           },
+	{ test_name_alive,         "alive"               },
+	{ test_name_expire,        "expire"              },
+	{ NULL,                     NULL                 }
 };
@@ -158,6 +158,68 @@ static void test_name_invalid_lookup(void)
 }
 
 
+/*============================================================================*
+ * Fault Injection Test: Invalid Batched Lookup                               *
+ *============================================================================*/
+
+/**
+ * @brief Fault Injection Test: Invalid Batched Lookup
+ */
+static void test_name_invalid_lookup_multi(void)
+{
+	int nodenums[2];
+	const char *names[2] = { "", NULL };
+
+	TEST_ASSERT(nanvix_name_lookup_multi(NULL, nodenums, 1) < 0);
+	TEST_ASSERT(nanvix_name_lookup_multi(names, NULL, 1) < 0);
+	TEST_ASSERT(nanvix_name_lookup_multi(names, nodenums, -1) < 0);
+
+	/* Invalid names are reported one by one. */
+	TEST_ASSERT(nanvix_name_lookup_multi(names, nodenums, 2) == 0);
+	TEST_ASSERT(nodenums[0] < 0);
+	TEST_ASSERT(nodenums[1] < 0);
+}
+
+/*============================================================================*
+ * Fault Injection Test: Invalid List                                         *
+ *============================================================================*/
+
+/**
+ * @brief Fault Injection Test: Invalid List
+ */
+static void test_name_invalid_list(void)
+{
+	char pathname[NANVIX_PROC_NAME_MAX + 1];
+	static char names[1][NANVIX_PROC_NAME_MAX];
+
+	umemset(pathname, 'a', NANVIX_PROC_NAME_MAX);
+	pathname[NANVIX_PROC_NAME_MAX] = '\0';
+
+	TEST_ASSERT(nanvix_name_list(NULL, names, 1) < 0);
+	TEST_ASSERT(nanvix_name_list("", NULL, 1) < 0);
+	TEST_ASSERT(nanvix_name_list("", names, -1) < 0);
+	TEST_ASSERT(nanvix_name_list(pathname, names, 1) < 0);
+}
+
+/*============================================================================*
+ * Fault Injection Test: Invalid Alive                                        *
+ *============================================================================*/
+
+/**
+ * @brief Fault Injection Test: Invalid Alive
+ */
+static void test_name_invalid_alive(void)
+{
+	char pathname[NANVIX_PROC_NAME_MAX + 1];
+
+	umemset(pathname, 1, NANVIX_PROC_NAME_MAX + 1);
+
+	TEST_ASSERT(nanvix_name_alive(pathname) < 0);
+	TEST_ASSERT(nanvix_name_alive(NULL) < 0);
+	TEST_ASSERT(nanvix_name_alive("") < 0);
+	TEST_ASSERT(nanvix_name_alive("missing_name") < 0);
+}
+
 /*============================================================================*
  * Fault Injection Driver Table                                               *
  *============================================================================*/
@@ -166,12 +228,15 @@ static void test_name_invalid_lookup(void)
  * @brief Unit tests.
  */
 struct test tests_name_fault[] = {
-	{ test_name_invalid_link,   "invalid link"   },
-	{ test_name_bad_link,       "bad link"       },
-	{ test_name_invalid_unlink, "invalid unlink" },
-	{ test_name_bad_unlink,     "bad unlink"     },
-	{ test_name_double_unlink,  "double unlink"  },
-	{ test_name_invalid_lookup, "invalid lookup" },
-	{ test_name_bad_lookup,     "bad lookup"     },
-	{ NULL,                      NULL            },
+	{ test_name_invalid_link,         "invalid link"           },
+	{ test_name_bad_link,             "bad link"               },
+	{ test_name_invalid_unlink,       "invalid unlink"         },
+	{ test_name_bad_unlink,           "bad unlink"             },
+	{ test_name_double_unlink,        "double unlink"          },
+	{ test_name_invalid_lookup,       "invalid lookup"         },
+	{ test_name_bad_lookup,           "bad lookup"             },
+	{ test_name_invalid_lookup_multi, "invalid batched lookup" },
+	{ test_name_invalid_list,         "invalid list"           },
+	{ test_name_invalid_alive,        "invalid alive"          },
+	{ NULL,                            NULL                    },
 };
@@ -37,6 +37,11 @@
  */
 #define NITERATIONS 100
 
+/**
+ * @brief Number of names in batched lookups.
+ */
+#define NNAMES 8
+
 /*============================================================================*
  * Lookup                                                                     *
  *============================================================================*/
@@ -59,6 +64,120 @@ static void test_name_lookup(void)
 	TEST_ASSERT(nanvix_name_unlink(pathname) == 0);
 }
 
+/*============================================================================*
+ * Lookup at Full Occupancy                                                   *
+ *============================================================================*/
+
+/**
+ * @brief Lookup at Full Occupancy
+ *
+ * The table of names is filled up, and lookups of the name linked last
+ * are timed. The lookup cache is dropped before each lookup, so that
+ * every lookup reaches the name server.
+ */
+static void test_name_lookup_full(void)
+{
+	int nodenum;
+	int nnames;
+	uint64_t t0, t1;
+	char pathname[NANVIX_PROC_NAME_MAX];
+
+	nodenum = knode_get_num();
+
+	/* Fill up table of names. */
+	for (nnames = 0; nnames < NANVIX_PNAME_MAX; nnames++)
+	{
+		usprintf(pathname, "cool-name%d", nnames);
+		if (nanvix_name_link(nodenum, pathname) < 0)
+			break;
+	}
+
+	TEST_ASSERT(nnames > 0);
+	usprintf(pathname, "cool-name%d", nnames - 1);
+
+	kclock(&t0);
+	for (int i = 0; i < NITERATIONS; i++)
+	{
+		TEST_ASSERT(nanvix_name_invalidate(NULL) == 0);
+		TEST_ASSERT(nanvix_name_lookup(pathname) == nodenum);
+	}
+	kclock(&t1);
+
+	for (int i = 0; i < nnames; i++)
+	{
+		usprintf(pathname, "cool-name%d", i);
+		TEST_ASSERT(nanvix_name_unlink(pathname) == 0);
+	}
+
+	uprintf("[name][stress] lookup with %d names linked: %d cycles",
+		nnames,
+		(int) ((t1 - t0)/NITERATIONS)
+	);
+}
+
+/*============================================================================*
+ * Batched Lookup                                                             *
+ *============================================================================*/
+
+/**
+ * @brief Batched Lookup
+ *
+ * A few names are linked, and they are resolved one at a time and then
+ * in a single batch, as in the runtime setup.
+ * The lookup cache is dropped before each round, so that every lookup
+ * reaches the name server.
+ */
+static void test_name_lookup_multi(void)
+{
+	int nodenum;
+	uint64_t t0, t1;
+	uint64_t tsingle, tmulti;
+	int nodenums[NNAMES];
+	const char *names[NNAMES];
+	char pathnames[NNAMES][NANVIX_PROC_NAME_MAX];
+
+	nodenum = knode_get_num();
+
+	for (int i = 0; i < NNAMES; i++)
+	{
+		usprintf(pathnames[i], "cool-name%d", i);
+		names[i] = pathnames[i];
+		TEST_ASSERT(nanvix_name_link(nodenum, pathnames[i]) == 0);
+	}
+
+	/* One name at a time. */
+	kclock(&t0);
+	for (int i = 0; i < NITERATIONS; i++)
+	{
+		TEST_ASSERT(nanvix_name_invalidate(NULL) == 0);
+		for (int j = 0; j < NNAMES; j++)
+			TEST_ASSERT(nanvix_name_lookup(names[j]) == nodenum);
+	}
+	kclock(&t1);
+	tsingle = t1 - t0;
+
+	/* Single batch. */
+	kclock(&t0);
+	for (int i = 0; i < NITERATIONS; i++)
+	{
+		TEST_ASSERT(nanvix_name_invalidate(NULL) == 0);
+		TEST_ASSERT(nanvix_name_lookup_multi(names, nodenums, NNAMES) == 0);
+		for (int j = 0; j < NNAMES; j++)
+			TEST_ASSERT(nodenums[j] == nodenum);
+	}
+	kclock(&t1);
+	tmulti = t1 - t0;
+
+	for (int i = 0; i < NNAMES; i++)
+		TEST_ASSERT(nanvix_name_unlink(pathnames[i]) == 0);
+
+	uprintf("[name][stress] lookup of %d names: per-name %d, batched %d cycles",
+		NNAMES,
+		(int) (tsingle/NITERATIONS),
+		(int) (tmulti/NITERATIONS)
+	);
+}
+
 /*============================================================================*
  * Heartbeat                                                                  *
  *============================================================================*/
@@ -89,8 +208,10 @@ static void test_name_heartbeat(void)
  * @brief Unit tests.
  */
 struct test tests_name_stress[] = {
-	{ test_name_lookup,    "lookup"    },
-	{ test_name_heartbeat, "heartbeat" },
-	{ NULL,                 NULL       },
+	{ test_name_lookup,       "lookup"              },
+	{ test_name_lookup_full,  "lookup (full table)" },
+	{ test_name_lookup_multi, "lookup (batched)"    },
+	{ test_name_heartbeat,    "heartbeat"           },
+	{ NULL,                    NULL                 },
 };
 
@@ -25,6 +25,7 @@
 #define __NEED_MM_RMEM_STUB
 
 #include <nanvix/runtime/mm.h>
+#include <nanvix/limits.h>
 #include <nanvix/ulib.h>
 #include "../../test.h"
 
@@ -48,6 +49,33 @@ static void test_rmem_stub_alloc_free(void)
 	TEST_ASSERT(nanvix_rmem_free(blknum) == 0);
 }
 
+/*============================================================================*
+ * API Test: Batched Alloc                                                    *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Batched Alloc
+ */
+static void test_rmem_stub_alloc_multi(void)
+{
+	rpage_t blknums[NANVIX_MAILBOX_BATCH_MAX];
+
+	/* Packed in a mailbox message. */
+	TEST_ASSERT(nanvix_rmem_alloc_multi(blknums, 2) == 2);
+	for (int i = 0; i < 2; i++)
+		TEST_ASSERT(nanvix_rmem_free(blknums[i]) == 0);
+
+	/* Spilled to a portal. */
+	TEST_ASSERT(nanvix_rmem_alloc_multi(blknums, NANVIX_MAILBOX_BATCH_MAX) == NANVIX_MAILBOX_BATCH_MAX);
+	for (int i = 0; i < NANVIX_MAILBOX_BATCH_MAX; i++)
+	{
+		for (int j = 0; j < i; j++)
+			TEST_ASSERT(blknums[i] != blknums[j]);
+	}
+	for (int i = 0; i < NANVIX_MAILBOX_BATCH_MAX; i++)
+		TEST_ASSERT(nanvix_rmem_free(blknums[i]) == 0);
+}
+
 /*============================================================================*
  * API Test: Read Write                                                       *
  *============================================================================*/
@@ -186,9 +214,10 @@ static void test_rmem_stub_consistency(void)
  * @brief Unit tests.
  */
 struct test tests_rmem_stub_api[] = {
-	{ test_rmem_stub_alloc_free,  "alloc/free"  },
-	{ test_rmem_stub_read_write,  "read/write"  },
-	{ test_rmem_stub_stats,       "stats"       },
-	{ test_rmem_stub_consistency, "consistency" },
-	{ NULL,                       NULL          },
+	{ test_rmem_stub_alloc_free,  "alloc/free"    },
+	{ test_rmem_stub_alloc_multi, "batched alloc" },
+	{ test_rmem_stub_read_write,  "read/write"    },
+	{ test_rmem_stub_stats,       "stats"         },
+	{ test_rmem_stub_consistency, "consistency"   },
+	{ NULL,                       NULL            },
 };
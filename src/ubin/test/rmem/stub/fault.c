@@ -23,8 +23,11 @@
  */
 
 #define __NEED_MM_RMEM_STUB
+#define __NEED_RMEM_SERVER
 
 #include <nanvix/runtime/mm.h>
+#include <nanvix/runtime/pm.h>
+#include <nanvix/limits.h>
 #include <nanvix/ulib.h>
 #include <posix/errno.h>
 #include "../../test.h"
@@ -150,6 +153,80 @@ static void test_rmem_stub_invalid_stats(void)
 	TEST_ASSERT(nanvix_rmem_stats(NULL) == -EINVAL);
 }
 
+/*============================================================================*
+ * Fault Injection Test: Invalid Batched Alloc                                *
+ *============================================================================*/
+
+/**
+ * @brief Fault Injection Test: Invalid Batched Alloc
+ */
+static void test_rmem_stub_invalid_alloc_multi(void)
+{
+	rpage_t blknums[1];
+
+	TEST_ASSERT(nanvix_rmem_alloc_multi(NULL, 1) == -EINVAL);
+	TEST_ASSERT(nanvix_rmem_alloc_multi(blknums, 0) == -EINVAL);
+	TEST_ASSERT(nanvix_rmem_alloc_multi(blknums, NANVIX_MAILBOX_BATCH_MAX + 1) == -EINVAL);
+}
+
+/*============================================================================*
+ * Fault Injection Test: Bad Batch                                            *
+ *============================================================================*/
+
+/**
+ * @brief Fault Injection Test: Bad Batch
+ *
+ * Malformed batches are sent to a remote memory server, which should
+ * drop them and keep serving requests.
+ */
+static void test_rmem_stub_bad_batch(void)
+{
+	int chid;
+	struct message_batch batch;
+	struct rmem_message msg;
+	struct rmem_message spill[2];
+
+	TEST_ASSERT((chid = nanvix_channel_connect(
+		rmem_servers[0].name,
+		rmem_servers[0].portnum)) >= 0
+	);
+
+	/* Empty batch. */
+	message_header_build(&batch.header, MESSAGE_BATCH);
+	batch.size = sizeof(struct rmem_message);
+	batch.count = 0;
+	batch.spilled = 0;
+	TEST_ASSERT(nanvix_channel_send(chid, &batch, sizeof(struct message_batch)) == 0);
+
+	/* Batch larger than a mailbox message. */
+	batch.count = NANVIX_MAILBOX_BATCH_MAX + 1;
+	TEST_ASSERT(nanvix_channel_send(chid, &batch, sizeof(struct message_batch)) == 0);
+
+	/* Batch of messages with bad size. */
+	batch.size = sizeof(struct rmem_message) + 1;
+	batch.count = 1;
+	TEST_ASSERT(nanvix_channel_send(chid, &batch, sizeof(struct message_batch)) == 0);
+
+	/* Spilled batch with inline messages, whose data should be drained. */
+	umemset(spill, 0, sizeof(spill));
+	message_header_build2(&batch.header, MESSAGE_BATCH, nanvix_channel_get_port(chid));
+	batch.size = sizeof(struct rmem_message);
+	batch.count = 1;
+	batch.spilled = 2;
+	TEST_ASSERT(nanvix_channel_send(chid, &batch, sizeof(struct message_batch)) == 0);
+	TEST_ASSERT(nanvix_channel_write(chid, spill, sizeof(spill)) == (ssize_t) sizeof(spill));
+
+	/* Server should be alive. */
+	message_header_build(&msg.header, RMEM_ALLOC);
+	TEST_ASSERT(nanvix_channel_call(chid, &msg, sizeof(struct rmem_message)) == 0);
+	TEST_ASSERT(msg.errcode == 0);
+	message_header_build(&msg.header, RMEM_MEMFREE);
+	TEST_ASSERT(nanvix_channel_call(chid, &msg, sizeof(struct rmem_message)) == 0);
+	TEST_ASSERT(msg.errcode == 0);
+
+	TEST_ASSERT(nanvix_channel_disconnect(chid) == 0);
+}
+
 /*============================================================================*
  * Test Driver Table                                                          *
  *============================================================================*/
@@ -158,12 +235,14 @@ static void test_rmem_stub_invalid_stats(void)
  * @brief Unit tests.
  */
 struct test tests_rmem_stub_fault[] = {
-	{ test_rmem_stub_invalid_free,  "invalid free " },
-	{ test_rmem_stub_bad_free,      "bad free     " },
-	{ test_rmem_stub_invalid_write, "invalid write" },
-	{ test_rmem_stub_bad_write,     "bad write    " },
-	{ test_rmem_stub_invalid_read,  "invalid read " },
-	{ test_rmem_stub_bad_read,      "bad read     " },
-	{ test_rmem_stub_invalid_stats, "invalid stats" },
-	{ NULL,                          NULL           },
+	{ test_rmem_stub_invalid_free,        "invalid free         " },
+	{ test_rmem_stub_bad_free,            "bad free             " },
+	{ test_rmem_stub_invalid_write,       "invalid write        " },
+	{ test_rmem_stub_bad_write,           "bad write            " },
+	{ test_rmem_stub_invalid_read,        "invalid read         " },
+	{ test_rmem_stub_bad_read,            "bad read             " },
+	{ test_rmem_stub_invalid_stats,       "invalid stats        " },
+	{ test_rmem_stub_invalid_alloc_multi, "invalid batched alloc" },
+	{ test_rmem_stub_bad_batch,           "bad batch            " },
+	{ NULL,                                NULL                   },
 };
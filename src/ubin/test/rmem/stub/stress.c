@@ -23,8 +23,11 @@
  */
 
 #define __NEED_MM_RMEM_STUB
+#define __NEED_RMEM_SERVER
 
 #include <nanvix/runtime/mm.h>
+#include <nanvix/runtime/pm.h>
+#include <nanvix/sys/noc.h>
 #include <nanvix/ulib.h>
 #include "../../test.h"
 
@@ -402,6 +405,214 @@ static void test_rmem_stub_consistency2(void)
 	}
 }
 
+/*============================================================================*
+ * Stress Test: Latency                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Number of iterations for latency tests.
+ */
+#define NUM_ITERATIONS 128
+
+/**
+ * @brief Reads a remote block through a channel.
+ *
+ * @param chid   ID of the target channel.
+ * @param blknum Number of the target block.
+ */
+static void test_rmem_stub_read_raw(int chid, rpage_t blknum)
+{
+	struct rmem_message msg;
+
+	message_header_build(&msg.header, RMEM_READ);
+	msg.blknum = blknum;
+
+	TEST_ASSERT(nanvix_channel_call(chid, &msg, sizeof(struct rmem_message)) == 0);
+	TEST_ASSERT(msg.header.opcode == RMEM_ACK);
+	TEST_ASSERT(
+		nanvix_channel_read(
+			chid,
+			buffer1,
+			RMEM_BLOCK_SIZE,
+			msg.header.portal_port
+		) == RMEM_BLOCK_SIZE
+	);
+	TEST_ASSERT(nanvix_channel_recv(chid, &msg, sizeof(struct rmem_message)) == 0);
+	TEST_ASSERT(msg.errcode == 0);
+}
+
+/**
+ * @brief Stress Test: Latency
+ *
+ * Remote blocks are read through a channel that is kept connected
+ * across requests, and then through a channel that is connected and
+ * disconnected on every request, so that the cost of setting up
+ * connectors once per request may be compared with the one of
+ * persistent channels.
+ */
+static void test_rmem_stub_latency(void)
+{
+	int chid;
+	int serverid;
+	rpage_t blknum;
+	uint64_t t0, t1;
+	uint64_t tpersistent, tonce;
+
+	TEST_ASSERT((blknum = nanvix_rmem_alloc()) != RMEM_NULL);
+	serverid = RMEM_BLOCK_SERVER(blknum);
+
+	/* Persistent channel. */
+	TEST_ASSERT((chid = nanvix_channel_connect(
+		rmem_servers[serverid].name,
+		rmem_servers[serverid].portnum)) >= 0
+	);
+	kclock(&t0);
+	for (int i = 0; i < NUM_ITERATIONS; i++)
+		test_rmem_stub_read_raw(chid, blknum);
+	kclock(&t1);
+	tpersistent = t1 - t0;
+	TEST_ASSERT(nanvix_channel_disconnect(chid) == 0);
+
+	/* One channel per request. */
+	kclock(&t0);
+	for (int i = 0; i < NUM_ITERATIONS; i++)
+	{
+		TEST_ASSERT((chid = nanvix_channel_connect(
+			rmem_servers[serverid].name,
+			rmem_servers[serverid].portnum)) >= 0
+		);
+		test_rmem_stub_read_raw(chid, blknum);
+		TEST_ASSERT(nanvix_channel_disconnect(chid) == 0);
+	}
+	kclock(&t1);
+	tonce = t1 - t0;
+
+	TEST_ASSERT(nanvix_rmem_free(blknum) == 0);
+
+	uprintf("[rmem][stress] read latency: persistent %d, per request %d cycles",
+		(int) (tpersistent/NUM_ITERATIONS),
+		(int) (tonce/NUM_ITERATIONS)
+	);
+}
+
+/*============================================================================*
+ * Stress Test: Ring Latency                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Writes a remote block through a channel.
+ *
+ * @param chid   ID of the target channel.
+ * @param blknum Number of the target block.
+ */
+static void test_rmem_stub_write_raw(int chid, rpage_t blknum)
+{
+	struct rmem_message msg;
+
+	message_header_build2(&msg.header, RMEM_WRITE, nanvix_channel_get_port(chid));
+	msg.blknum = blknum;
+
+	TEST_ASSERT(nanvix_channel_send(chid, &msg, sizeof(struct rmem_message)) == 0);
+	TEST_ASSERT(nanvix_channel_write(chid, buffer1, RMEM_BLOCK_SIZE) == RMEM_BLOCK_SIZE);
+	TEST_ASSERT(nanvix_channel_recv(chid, &msg, sizeof(struct rmem_message)) == 0);
+	TEST_ASSERT(msg.errcode == 0);
+}
+
+/**
+ * @brief Sends a control request to a remote memory server.
+ *
+ * @param chid   ID of the target channel.
+ * @param opcode Target operation.
+ * @param blknum Number of the target block.
+ *
+ * @returns The number of the block in the reply of the server.
+ */
+static rpage_t test_rmem_stub_control_raw(int chid, int opcode, rpage_t blknum)
+{
+	struct rmem_message msg;
+
+	message_header_build(&msg.header, opcode);
+	msg.blknum = blknum;
+
+	TEST_ASSERT(nanvix_channel_call(chid, &msg, sizeof(struct rmem_message)) == 0);
+	TEST_ASSERT(msg.errcode == 0);
+
+	return (msg.blknum);
+}
+
+/**
+ * @brief Stress Test: Ring Latency
+ *
+ * Remote blocks are written to and read from the remote memory server
+ * that lives in the same node, first through the ring of the channel
+ * and then through portals.
+ */
+static void test_rmem_stub_ring_latency(void)
+{
+	int chid;
+	int serverid;
+	rpage_t blknum;
+	uint64_t t0, t1;
+	uint64_t cycles[2][2];
+
+	/* Look for a server in this node. */
+	for (serverid = 0; serverid < RMEM_SERVERS_NUM; serverid++)
+	{
+		if (rmem_servers[serverid].nodenum == knode_get_num())
+			break;
+	}
+
+	/* No server in this node. */
+	if (serverid == RMEM_SERVERS_NUM)
+	{
+		uprintf("[rmem][stress] no server in this node, skipping");
+		return;
+	}
+
+	TEST_ASSERT((chid = nanvix_channel_connect(
+		rmem_servers[serverid].name,
+		rmem_servers[serverid].portnum)) >= 0
+	);
+
+	blknum = test_rmem_stub_control_raw(chid, RMEM_ALLOC, RMEM_NULL);
+	TEST_ASSERT(blknum != RMEM_NULL);
+
+	for (int ring = 1; ring >= 0; ring--)
+	{
+		/* Platform has no rings. */
+		if (nanvix_channel_set_ring(chid, ring) < 0)
+		{
+			cycles[ring][0] = cycles[ring][1] = 0;
+			continue;
+		}
+
+		kclock(&t0);
+		for (int i = 0; i < NUM_ITERATIONS; i++)
+			test_rmem_stub_write_raw(chid, blknum);
+		kclock(&t1);
+		cycles[ring][0] = t1 - t0;
+
+		kclock(&t0);
+		for (int i = 0; i < NUM_ITERATIONS; i++)
+			test_rmem_stub_read_raw(chid, blknum);
+		kclock(&t1);
+		cycles[ring][1] = t1 - t0;
+	}
+
+	test_rmem_stub_control_raw(chid, RMEM_MEMFREE, blknum);
+
+	TEST_ASSERT(nanvix_channel_disconnect(chid) == 0);
+
+	uprintf("[rmem][stress] write latency: ring %d, portal %d cycles",
+		(int) (cycles[1][0]/NUM_ITERATIONS),
+		(int) (cycles[0][0]/NUM_ITERATIONS)
+	);
+	uprintf("[rmem][stress] read latency: ring %d, portal %d cycles",
+		(int) (cycles[1][1]/NUM_ITERATIONS),
+		(int) (cycles[0][1]/NUM_ITERATIONS)
+	);
+}
+
 /*============================================================================*
  * Test Driver Table                                                          *
  *============================================================================*/
@@ -421,6 +632,8 @@ struct test tests_rmem_stub_stress[] = {
 #endif
 	{ test_rmem_stub_read_write_sequential,  "read/write sequential " },
 	{ test_rmem_stub_read_write_interleaved, "read/write interleaved" },
+	{ test_rmem_stub_latency,                "latency               " },
+	{ test_rmem_stub_ring_latency,           "ring latency          " },
 #if __TEST_READ_WRITE_ALL
 	{ test_rmem_stub_read_write_all,         "read/write all        " },
 #endif
@@ -22,7 +22,11 @@
  * SOFTWARE.
  */
 
+#define __NEED_RESOURCE
+
+#include <nanvix/hal/resource.h>
 #include <nanvix/runtime/pm.h>
+#include <nanvix/runtime/utils.h>
 #include <nanvix/limits.h>
 #include <nanvix/ulib.h>
 #include <posix/errno.h>
@@ -200,6 +204,115 @@ static void test_stress_sem_up_down2(void)
 	uassert(__nanvix_sem_close(semid) == 0);
 }
 
+/*============================================================================*
+ * Resource Pool                                                              *
+ *============================================================================*/
+
+/**
+ * @brief Number of iterations for resource pool tests.
+ */
+#define TEST_POOL_NITERATIONS 128
+
+/**
+ * @brief Length of the resource pool used in tests.
+ */
+#define TEST_POOL_LENGTH RESOURCE_INDEX_MAX
+
+/**
+ * Used for tests.
+ */
+static struct
+{
+	struct resource resource; /**< Underlying resource. */
+} items[TEST_POOL_LENGTH];
+
+/**
+ * Used for tests.
+ */
+static const struct resource_pool items_pool = {
+	items, TEST_POOL_LENGTH, sizeof(items[0])
+};
+
+/**
+ * @brief Measures allocation in a resource pool.
+ *
+ * @param occupancy Percentage of resources that are kept allocated.
+ *
+ * The first resources of the pool are allocated, and then one resource
+ * is allocated and released repeatedly, both with a linear scan of the
+ * pool and with a resource index.
+ */
+static void test_stress_pool_alloc_free(int occupancy)
+{
+	int n;
+	int id;
+	uint64_t t0, t1;
+	uint64_t tscan, tindex;
+	struct resource_index index = RESOURCE_INDEX_INITIALIZER(&items_pool);
+
+	n = (occupancy*TEST_POOL_LENGTH)/100;
+
+	for (int i = 0; i < TEST_POOL_LENGTH; i++)
+		items[i].resource = RESOURCE_INITIALIZER;
+	for (int i = 0; i < n; i++)
+		uassert(resource_alloc(&items_pool) == i);
+
+	/* Linear scan. */
+	kclock(&t0);
+	for (int i = 0; i < TEST_POOL_NITERATIONS; i++)
+	{
+		uassert((id = resource_alloc(&items_pool)) == n);
+		resource_free(&items_pool, id);
+	}
+	kclock(&t1);
+	tscan = t1 - t0;
+
+	/* Resource index. */
+	kclock(&t0);
+	for (int i = 0; i < TEST_POOL_NITERATIONS; i++)
+	{
+		uassert((id = resource_index_alloc(&index)) == n);
+		resource_index_free(&index, id);
+	}
+	kclock(&t1);
+	tindex = t1 - t0;
+
+	for (int i = 0; i < n; i++)
+		resource_index_free(&index, i);
+	uassert(resource_index_alloc(&index) == 0);
+	resource_index_free(&index, 0);
+
+	uprintf("[pool][stress] alloc/free at %d%%: scan %d, index %d cycles",
+		occupancy,
+		(int) (tscan/TEST_POOL_NITERATIONS),
+		(int) (tindex/TEST_POOL_NITERATIONS)
+	);
+}
+
+/**
+ * @brief Stress Test: Alloc / Free at Low Occupancy
+ */
+static void test_stress_pool_alloc_free_low(void)
+{
+	test_stress_pool_alloc_free(10);
+}
+
+/**
+ * @brief Stress Test: Alloc / Free at Medium Occupancy
+ */
+static void test_stress_pool_alloc_free_medium(void)
+{
+	test_stress_pool_alloc_free(50);
+}
+
+/**
+ * @brief Stress Test: Alloc / Free at High Occupancy
+ */
+static void test_stress_pool_alloc_free_high(void)
+{
+	test_stress_pool_alloc_free(99);
+}
+
 /*============================================================================*
  * Test Driver                                                                *
  *============================================================================*/
@@ -212,13 +325,16 @@ struct
 	void (*func)(void); /**< Test Function */
 	const char *name;   /**< Test Name     */
 } tests_sysv_stress[] = {
-	{ test_stress_msg_get_close1,     "[msg][stress] get close 1    " },
-	{ test_stress_msg_get_close2,     "[msg][stress] get close 2    " },
-	{ test_stress_msg_send_receive1,  "[msg][stress] send receive 1 " },
-	{ test_stress_msg_send_receive2,  "[msg][stress] send receive 2 " },
-	{ test_stress_sem_get_close1,     "[sem][stress] get close 1    " },
-	{ test_stress_sem_get_close2,     "[sem][stress] get close 2    " },
-	{ test_stress_sem_up_down1,       "[sem][stress] up down 1      " },
-	{ test_stress_sem_up_down2,       "[sem][stress] up down 2      " },
-	{ NULL,                           NULL                            },
+	{ test_stress_msg_get_close1,         "[msg][stress] get close 1    " },
+	{ test_stress_msg_get_close2,         "[msg][stress] get close 2    " },
+	{ test_stress_msg_send_receive1,      "[msg][stress] send receive 1 " },
+	{ test_stress_msg_send_receive2,      "[msg][stress] send receive 2 " },
+	{ test_stress_sem_get_close1,         "[sem][stress] get close 1    " },
+	{ test_stress_sem_get_close2,         "[sem][stress] get close 2    " },
+	{ test_stress_sem_up_down1,           "[sem][stress] up down 1      " },
+	{ test_stress_sem_up_down2,           "[sem][stress] up down 2      " },
+	{ test_stress_pool_alloc_free_low,    "[pool][stress] alloc free 10%" },
+	{ test_stress_pool_alloc_free_medium, "[pool][stress] alloc free 50%" },
+	{ test_stress_pool_alloc_free_high,   "[pool][stress] alloc free 99%" },
+	{ NULL,                               NULL                            },
 };